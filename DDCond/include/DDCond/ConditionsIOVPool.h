@@ -18,6 +18,8 @@
 
 // C/C++ include files
 #include <map>
+#include <set>
+#include <mutex>
 
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
@@ -42,10 +44,46 @@ namespace DD4hep {
       typedef ConditionsPool*              Element;
       typedef std::map<IOV::Key, Element > Elements;      
 
+      /// Memory and eviction statistics of the pools of one IOV type
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Statistics  {
+      public:
+        /// Number of conditions pools
+        size_t pools        = 0;
+        /// Number of conditions
+        size_t conditions   = 0;
+        /// Approximate memory held by the conditions in bytes
+        size_t bytes        = 0;
+        /// Number of pools evicted to respect the memory budget
+        size_t evictions    = 0;
+        /// Approximate memory released by evictions in bytes
+        size_t evictedBytes = 0;
+        /// Number of evicted pools, which had to be created again
+        size_t reloads      = 0;
+      };
+
       /// Container of IOV dependent conditions pools
       Elements elements;
       const IOVType* type;
-      
+      /// Number of pools evicted to respect the memory budget
+      size_t evictions     = 0;
+      /// Approximate memory released by evictions in bytes
+      size_t evictedBytes  = 0;
+      /// Number of evicted pools, which had to be created again
+      size_t reloads       = 0;
+      /// Keys of evicted pools. Used to count reloads
+      std::set<IOV::Key> evicted;
+
+    protected:
+      /// Lock protecting the registry of user pools
+      std::mutex                         m_userLock;
+      /// Required IOVs of the prepared user pools
+      std::map<const UserPool*,IOV::Key> m_users;
+
     public:
       /// Default constructor
       ConditionsIOVPool(const IOVType* type);
@@ -65,6 +103,20 @@ namespace DD4hep {
       /// Remove all key based pools with an age beyon the minimum age. 
       /** @return Number of conditions cleaned up and removed.                       */
       int clean(int max_age);
+      /// Remove a single pool to respect the memory budget. Pinned pools are kept.
+      /** @return Number of conditions removed.                                       */
+      int evict(ConditionsPool* pool);
+
+      /// Pin the pools containing the required IOV of a prepared user pool
+      void pin(const UserPool* user, const IOV::Key& required);
+      /// Release the pins of a user pool
+      void unpin(const UserPool* user);
+      /// Check if a pool with the given key is used by a prepared user pool
+      bool pinned(const IOV::Key& key);
+      /// Access the memory and eviction statistics
+      Statistics statistics()  const;
+      /// Logical clock for the LRU ordering of pools by their last selection
+      static unsigned long long tick();
     };
 
   } /* End namespace Conditions             */
@@ -19,6 +19,7 @@
 
 // C/C++ include files
 #include <set>
+#include <memory>
 
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
@@ -66,6 +67,63 @@ namespace DD4hep {
         size_t total() const { return selected+computed+loaded; }
       };
 
+      /// Handle to the result of an asynchronous prepare call (future-like)
+      /**
+       *  The slice given to prepareAsync may not be accessed until the
+       *  result was collected with get().
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class AsyncResult  {
+      public:
+        /// Shared state of the asynchronous call (opaque)
+        class State;
+      protected:
+        /// Reference to the shared state
+        std::shared_ptr<State> m_state;
+      public:
+        /// Default constructor: invalid handle
+        AsyncResult() = default;
+        /// Initializing constructor
+        AsyncResult(const std::shared_ptr<State>& state) : m_state(state) {}
+        /// Copy constructor
+        AsyncResult(const AsyncResult& copy) = default;
+        /// Assignment operator
+        AsyncResult& operator=(const AsyncResult& copy) = default;
+        /// Check if the handle refers to a prepare call
+        bool valid() const   {  return m_state.get() != 0;  }
+        /// Check if the result is availible without waiting
+        bool ready() const;
+        /// Wait until the result is availible
+        void wait() const;
+        /// Wait for the result and access it. Exceptions of the prepare call are re-thrown
+        Result get() const;
+      };
+
+      /// Statistics of the asynchronous prepare calls
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class AsyncStatistics  {
+      public:
+        /// Number of asynchronous prepare calls
+        size_t requests  = 0;
+        /// Number of results collected
+        size_t collected = 0;
+        /// Number of results not yet availible when collected
+        size_t stalls    = 0;
+        /// Time spent preparing in the background in seconds
+        double workTime  = 0e0;
+        /// Time the callers waited for the results in seconds
+        double stallTime = 0e0;
+        /// Time saved by preparing in the background (workTime - stallTime) in seconds
+        double savedTime = 0e0;
+      };
+
     public:
 
       /// Static accessor if installed as an extension
@@ -153,6 +211,17 @@ namespace DD4hep {
       /// Prepare all updates to the clients with the defined IOV
       Result prepare(const IOV&              required_validity,
                      ConditionsSlice&        slice)  const;
+
+      /// Prepare all updates to the clients with the defined IOV in the background
+      /** Loading and the computation of derived conditions are executed by a
+       *  separate thread. Typically used to prefetch the conditions of the
+       *  next IOV into a second slice while the current one is still in use.
+       */
+      AsyncResult prepareAsync(const IOV&    required_validity,
+                               ConditionsSlice& slice)  const;
+
+      /// Access the statistics of the asynchronous prepare calls
+      AsyncStatistics asyncStatistics()  const;
     };
   }       /* End namespace Conditions        */
 }         /* End namespace DD4hep            */
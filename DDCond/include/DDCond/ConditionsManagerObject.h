@@ -22,6 +22,7 @@
 
 // C/C++ include files
 #include <vector>
+#include <mutex>
 #include <set>
 
 /// Namespace for the AIDA detector description toolkit
@@ -60,6 +61,8 @@ namespace DD4hep {
       typedef std::set<Listener>                   Listeners;
       typedef dd4hep_ptr<ConditionsDataLoader>     Loader;
       typedef ConditionsManager::Result            Result;
+      typedef ConditionsManager::AsyncResult       AsyncResult;
+      typedef ConditionsManager::AsyncStatistics   AsyncStatistics;
 
     protected:
       /// Reference to main detector description object
@@ -74,6 +77,10 @@ namespace DD4hep {
       bool                   m_doLoad = true;
       /// Property: Flag to indicate if unloaded items should be saved to the slice (or not)
       bool                   m_doOutputUnloaded = false;
+      /// Lock protecting the statistics of asynchronous prepare calls
+      mutable std::mutex     m_asyncLock;
+      /// Statistics of asynchronous prepare calls
+      AsyncStatistics        m_asyncStat;
 
       /// Register callback listener object
       void registerCallee(Listeners& listeners, const Listener& callee, bool add);
@@ -119,6 +126,12 @@ namespace DD4hep {
       /// Register IOV using new string data
       ConditionsPool* registerIOV(const std::string& data);
 
+      /// Access the statistics of asynchronous prepare calls
+      AsyncStatistics asyncStatistics()  const;
+
+      /// Account a collected result of an asynchronous prepare call
+      void asyncCollected(double work_time, double stall_time, bool stalled);
+
       /** Overloadable interface  */
       /// Initialize the object after having set the properties
       virtual void initialize() = 0;
@@ -162,6 +175,10 @@ namespace DD4hep {
       /// Prepare all updates to the clients with the defined IOV
       virtual Result prepare(const IOV& req_iov, ConditionsSlice& slice) = 0;
 
+      /// Prepare all updates to the clients with the defined IOV in the background
+      /** Default implementation: execute prepare() in a separate thread        */
+      virtual AsyncResult prepareAsync(const IOV& req_iov, ConditionsSlice& slice);
+
       /// Clean conditions, which are above the age limit.
       /** @return Number of conditions cleaned/removed from the IOV pool of the given type   */
       virtual int clean(const IOVType* typ, int max_age) = 0;
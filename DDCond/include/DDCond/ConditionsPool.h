@@ -26,6 +26,7 @@ namespace DD4hep {
   namespace Conditions {
 
     // Forward declarations
+    class ConditionsArena;
     class ConditionsSlice;
     class ConditionsIOVPool;
     class ConditionDependency;
@@ -70,6 +71,12 @@ namespace DD4hep {
       IOV*             iov;
       /// Aging value
       int              age_value;
+      /// Memory arena of the conditions hosted. Released in bulk with the pool
+      ConditionsArena* arena;
+      /// Approximate memory held by the conditions of this pool in bytes
+      size_t           bytes;
+      /// Logical time of the last selection (see ConditionsIOVPool::tick)
+      unsigned long long lastUsed;
 
     public:
       /// Listener invocation when a condition is registered to the cache
@@ -171,6 +178,8 @@ namespace DD4hep {
       virtual Condition get(key_type key)  const = 0;
       /// Check if a condition exists in the pool and return it to the caller
       virtual Condition get(const ConditionKey& key)  const = 0;
+      /// Select all conditions contained, passing a predicate
+      virtual size_t select_all(const ConditionsSelect& predicate)  const = 0;
       /// Remove condition by key from pool.
       virtual bool remove(key_type hash_key) = 0;
       /// Remove condition by key from pool.
@@ -0,0 +1,87 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_CONDITIONS_CONDITIONSSNAPSHOT_H
+#define DD4HEP_CONDITIONS_CONDITIONSSNAPSHOT_H
+
+// Framework include files
+#include "DDCond/ConditionsManager.h"
+
+// C/C++ include files
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the geometry part of the AIDA detector description toolkit
+  namespace Conditions {
+
+    /// Forward declarations
+    class UserPool;
+
+    /// Binary snapshot of the conditions of a prepared user pool
+    /**
+     *  The snapshot contains for every condition the key, the IOV, the
+     *  hash of the grammar type name and the payload. Payloads are written
+     *  as binary images if the grammar supports it (trivially copyable
+     *  types, strings, STL containers and ROOT vectors), otherwise in their string representation.
+     *  Unbound conditions are written without payload.
+     *
+     *  The file consists of fixed size tables addressed by offsets:
+     *  header, IOV types, IOVs, condition records, string table and the
+     *  8-byte aligned payload area. On reload the file is mapped into memory
+     *  in one go, the offsets are converted to pointers and the conditions
+     *  are registered to the IOV pools of the conditions manager. A subsequent
+     *  prepare of a user pool with the same IOV then selects all conditions
+     *  without accessing the conditions loader.
+     *
+     *  The format is not portable between architectures with different
+     *  byte order or between builds with different type layouts.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsSnapshot  {
+    public:
+      /// Statistics of a save or load operation
+      class Result  {
+      public:
+        /// Number of conditions written or registered
+        size_t conditions = 0;
+        /// Number of payloads handled as binary image
+        size_t binary     = 0;
+        /// Number of payloads handled in string representation
+        size_t text       = 0;
+        /// Number of conditions skipped (no usable grammar or already present)
+        size_t skipped    = 0;
+        /// Size of the snapshot file in bytes
+        size_t bytes      = 0;
+      };
+
+    public:
+      /// Default constructor
+      ConditionsSnapshot();
+      /// Default destructor
+      virtual ~ConditionsSnapshot();
+      /// Save the conditions of a prepared user pool to file
+      Result save(const UserPool& pool, const std::string& output)  const;
+      /// Load the snapshot and register the conditions to the conditions manager
+      /** If validity is non-NULL, it is set to the interval of validity of
+       *  the user pool when the snapshot was taken.
+       */
+      Result load(const std::string& input, ConditionsManager manager, IOV* validity=0)  const;
+    };
+
+  } /* End namespace Conditions             */
+} /* End namespace DD4hep                   */
+
+#endif /* DD4HEP_CONDITIONS_CONDITIONSSNAPSHOT_H  */
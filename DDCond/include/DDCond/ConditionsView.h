@@ -0,0 +1,274 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSVIEW_H
+#define DDCOND_CONDITIONSVIEW_H
+
+// Framework include files
+#include "DDCond/ConditionsPool.h"
+
+// C/C++ include files
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the geometry part of the AIDA detector description toolkit
+  namespace Conditions {
+
+    // Forward declarations
+    class ConditionsIOVPool;
+
+    /// Immutable, hash indexed snapshot of a prepared user pool
+    /**
+     *  The view is created from a prepared user pool and never changes
+     *  afterwards. Hence any number of threads may access it concurrently
+     *  without locking. The conditions are held in an open addressing
+     *  hash table indexed by the condition key.
+     *
+     *  The conditions pools serving the validity of the view are pinned as
+     *  long as the view lives: they are not evicted by the memory budget
+     *  of the conditions manager.
+     *
+     *  All modifying calls of the user pool interface throw an exception.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsView : public UserPool  {
+    public:
+      /// Hash table entry
+      struct Entry  {
+        key_type           key;
+        Condition::Object* object;
+      };
+
+    protected:
+      /// Hash table with a power-of-2 size. Empty slots have a NULL object
+      std::vector<Entry> m_table;
+      /// Mask to wrap around the end of the table
+      size_t             m_mask  = 0;
+      /// Shift to map the multiplicative hash to the table size
+      unsigned int       m_shift = 63;
+      /// Number of conditions in the view
+      size_t             m_count = 0;
+      /// Reference to the IOV pool holding the pinned conditions pools
+      ConditionsIOVPool* m_iovPool = 0;
+
+      /// Locate the table slot of a condition key
+      const Entry* i_find(key_type key)  const  {
+        if ( m_count )  {
+          for(size_t i = (key*0x9E3779B97F4A7C15ULL)>>m_shift; ; i = (i+1)&m_mask)  {
+            const Entry& e = m_table[i];
+            if ( !e.object ) return 0;
+            if ( e.key == key ) return &e;
+          }
+        }
+        return 0;
+      }
+
+    public:
+      /// Initializing constructor: snapshot of a prepared user pool
+      ConditionsView(ConditionsManager mgr, const UserPool& source);
+      /// Default destructor. Releases the pinned conditions pools
+      virtual ~ConditionsView();
+      /// Print pool content
+      virtual void print(const std::string& opt) const  override;
+      /// Total entry count
+      virtual size_t size()  const  override   {  return m_count;  }
+      /// Full cleanup of all managed conditions: Not allowed
+      virtual void clear()  override;
+      /// Check a condition for existence
+      virtual bool exists(key_type key)  const  override
+      {  return i_find(key) != 0;                            }
+      /// Check a condition for existence
+      virtual bool exists(const ConditionKey& key)  const  override
+      {  return i_find(key.hash) != 0;                       }
+      /// Check if a condition exists in the pool and return it to the caller
+      virtual Condition get(key_type key)  const  override
+      {  const Entry* e = i_find(key);      return e ? e->object : 0;  }
+      /// Check if a condition exists in the pool and return it to the caller
+      virtual Condition get(const ConditionKey& key)  const  override
+      {  const Entry* e = i_find(key.hash); return e ? e->object : 0;  }
+      /// Select all conditions contained, passing a predicate
+      virtual size_t select_all(const ConditionsSelect& predicate)  const  override;
+      /// Remove condition by key from pool: Not allowed
+      virtual bool remove(key_type hash_key)  override;
+      /// Remove condition by key from pool: Not allowed
+      virtual bool remove(const ConditionKey& key)  override;
+      /// Register a new condition to this pool: Not allowed
+      virtual bool insert(Condition cond)  override;
+      /// Prepare user pool for usage: Not allowed
+      virtual Result prepare(const IOV& required, ConditionsSlice& slice, void* user_param)  override;
+      /// Evaluate and register all derived conditions: Not allowed
+      virtual size_t compute(const Dependencies& dependencies, void* user_param, bool force)  override;
+    };
+
+    /// Publisher of conditions views to concurrent readers
+    /**
+     *  The writer prepares a user pool and publishes a snapshot with publish().
+     *  The new view replaces the current one atomically. Readers never lock:
+     *  each reader thread registers once (class Reader) and accesses the
+     *  current view within a read section (class Access).
+     *
+     *  Replaced views are reclaimed using epochs: a read section announces
+     *  the global epoch before loading the current view. A replaced view is
+     *  tagged with the epoch of its replacement and deleted by the writer
+     *  once no read section announcing an older or equal epoch is active.
+     *
+     *  Example:
+     *
+     *     // Writer thread:
+     *     manager.prepare(iov, slice);
+     *     publisher.publish(*slice.pool);
+     *
+     *     // Reader threads:
+     *     ConditionsPublisher::Reader reader(publisher);
+     *     ...
+     *     {
+     *        ConditionsPublisher::Access view(reader);
+     *        Condition c = view->get(key);
+     *     }
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsPublisher  {
+    public:
+      enum {
+        /// Maximal number of concurrently registered readers
+        MAX_READERS = 256
+      };
+
+      /// Reader slot. Padded to avoid false sharing between reader threads
+      struct alignas(64) Slot  {
+        /// Epoch announced by the active read section (0: idle)
+        std::atomic<unsigned long> epoch;
+        /// Flag if the slot is owned by a registered reader
+        std::atomic<bool>          used;
+      };
+
+      /// Registration of a reader thread
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Reader  {
+        friend class ConditionsPublisher;
+        friend class Access;
+        /// Reference to the publisher
+        ConditionsPublisher& m_publisher;
+        /// Reference to the reader slot
+        Slot*                m_slot;
+      public:
+        /// Initializing constructor: acquire a reader slot
+        Reader(ConditionsPublisher& publisher);
+        /// Inhibit copy constructor
+        Reader(const Reader& copy) = delete;
+        /// Default destructor: release the reader slot
+        ~Reader();
+        /// Inhibit assignment
+        Reader& operator=(const Reader& copy) = delete;
+      };
+
+      /// Read section: access to the current view. Keep it short!
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Access  {
+        /// Reference to the reader slot
+        Slot*                 m_slot;
+        /// Reference to the view published when entering the read section
+        const ConditionsView* m_view;
+      public:
+        /// Initializing constructor: enter the read section
+        Access(Reader& reader)  : m_slot(reader.m_slot)  {
+          m_slot->epoch.store(reader.m_publisher.m_epoch.load());
+          m_view = reader.m_publisher.m_current.load();
+        }
+        /// Inhibit copy constructor
+        Access(const Access& copy) = delete;
+        /// Default destructor: leave the read section
+        ~Access()  {  m_slot->epoch.store(0, std::memory_order_release); }
+        /// Inhibit assignment
+        Access& operator=(const Access& copy) = delete;
+        /// Access to the view (may be NULL if nothing was published yet)
+        const ConditionsView* get()  const         {  return m_view;  }
+        /// Access to the view
+        const ConditionsView* operator->()  const  {  return m_view;  }
+      };
+
+      /// Publication statistics
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Statistics  {
+      public:
+        /// Number of views published
+        size_t published = 0;
+        /// Number of replaced views deleted
+        size_t reclaimed = 0;
+        /// Number of replaced views still accessible by readers
+        size_t pending   = 0;
+      };
+
+    protected:
+      typedef std::pair<unsigned long,const ConditionsView*> Retired;
+
+      /// Reader slots
+      Slot                              m_slots[MAX_READERS];
+      /// Global epoch
+      std::atomic<unsigned long>        m_epoch;
+      /// Currently published view
+      std::atomic<const ConditionsView*> m_current;
+      /// Lock serializing the writers. Never taken by readers
+      std::mutex                        m_lock;
+      /// Replaced views waiting for the readers to leave
+      std::vector<Retired>              m_retired;
+      /// Publication statistics
+      Statistics                        m_stat;
+      /// Reference to the conditions manager
+      ConditionsManager                 m_manager;
+
+      /// Delete replaced views no longer accessible. Requires the writer lock
+      size_t i_reclaim();
+
+    public:
+      /// Initializing constructor
+      ConditionsPublisher(ConditionsManager mgr);
+      /// Inhibit copy constructor
+      ConditionsPublisher(const ConditionsPublisher& copy) = delete;
+      /// Default destructor. No reader may be registered anymore
+      virtual ~ConditionsPublisher();
+      /// Inhibit assignment
+      ConditionsPublisher& operator=(const ConditionsPublisher& copy) = delete;
+      /// Create a view of a prepared user pool and publish it. Returns the new view
+      const ConditionsView* publish(const UserPool& pool);
+      /// Publish an existing view. The publisher takes ownership
+      const ConditionsView* publish(ConditionsView* view);
+      /// Delete replaced views no longer accessible. Returns the number of views deleted
+      size_t reclaim();
+      /// Access the publication statistics
+      Statistics statistics();
+    };
+  }        /* End namespace Conditions               */
+}          /* End namespace DD4hep                   */
+#endif     /* DDCOND_CONDITIONSVIEW_H                */
@@ -62,6 +62,8 @@ namespace DD4hep {
       std::string             m_userType;
       /// Property: Conditions loader type (default: "multi" -> DD4hep_Conditions_multi_Loader)
       std::string             m_loaderType;
+      /// Property: Memory budget of all IOV pools in bytes (default: 0 -> no automatic eviction)
+      long                    m_memoryBudget;
 
       /// Collection of IOV types managed
       IOVTypes                m_iovTypes;
@@ -71,6 +73,8 @@ namespace DD4hep {
       dd4hep_mutex_t          m_updateLock;
       /// Lock to protect the pool of all known conditions
       dd4hep_mutex_t          m_poolLock;
+      /// Lock to serialize the preparation of user pools (pin and select) with the eviction of pools
+      dd4hep_mutex_t          m_prepareLock;
       /// Reference to update conditions pool
       dd4hep_ptr<UpdatePool>  m_updatePool;
 
@@ -100,6 +104,11 @@ namespace DD4hep {
       /// Requires EXTERNALLY held lock on update pool!
       Condition __queue_update(Conditions::Entry* data);
 
+      /// Evict the least recently selected unpinned pools until the memory budget is respected
+      /// Requires EXTERNALLY held prepare lock: no user pool may pin or select meanwhile!
+      /** @return Number of conditions removed                                       */
+      size_t __enforce_budget();
+
     public:
       /// Standard constructor
       Manager_Type1(LCDD& lcdd);
@@ -15,6 +15,7 @@
 #include "DDCond/ConditionsDependencyHandler.h"
 #include "DDCond/ConditionsManagerObject.h"
 #include "DD4hep/Printout.h"
+#include "DD4hep/objects/ConditionsArena.h"
 
 using namespace DD4hep;
 using namespace DD4hep::Conditions;
@@ -71,6 +72,8 @@ ConditionsDependencyHandler::do_callback(const ConditionDependency& dep)  const
   try  {
     Condition::iov_type iov(m_pool.validity().iovType);
     ConditionUpdateCall::Context ctxt(*this, dep, m_userParam, iov.reset().invert());
+    // Derived conditions are owned by the IOV pool: allocate them from its arena
+    ConditionsArena::Scope scope(m_iovPool ? m_iovPool->arena : 0);
     Condition          cond = (*dep.callback)(dep.target, ctxt);
     Condition::Object* obj  = cond.ptr();
     if ( obj )  {
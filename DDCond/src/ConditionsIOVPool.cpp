@@ -18,9 +18,17 @@
 #include "DD4hep/objects/ConditionsInterna.h"
 #include "DDCond/ConditionsDataLoader.h"
 
+// C/C++ include files
+#include <atomic>
+
 using namespace DD4hep;
 using namespace DD4hep::Conditions;
 
+namespace {
+  /// Logical clock for the LRU ordering of conditions pools
+  std::atomic<unsigned long long> s_clock(0);
+}
+
 /// Default constructor
 ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ)  {
   InstanceCount::increment(this);
@@ -101,6 +109,7 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
       cond_validity.iov_intersection((*i).first);
       num_selected += pool->select_all(valid);
       pool->age_value = 0;
+      pool->lastUsed  = tick();
     }
   }
   return num_selected;
@@ -123,6 +132,7 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
       cond_validity.iov_intersection(i.first);
       num_selected += pool->select_all(predicate_processor);
       pool->age_value = 0;
+      pool->lastUsed  = tick();
     }
   }
   return num_selected;
@@ -145,8 +155,70 @@ size_t ConditionsIOVPool::select(const IOV& req_validity,
       cond_validity.iov_intersection(i.first);
       valid[i.first] = pool;
       pool->age_value = 0;
+      pool->lastUsed  = tick();
       ++num_selected;
     }
   }
   return num_selected;
 }
+
+/// Remove a single pool to respect the memory budget.
+int ConditionsIOVPool::evict(ConditionsPool* pool)   {
+  // Pins may have been added since the candidate was chosen. Keep the lock
+  // until the pool is gone, so that no new user can pin it meanwhile.
+  std::lock_guard<std::mutex> lock(m_userLock);
+  for(const auto& u : m_users )
+    if ( IOV::key_contains_range(pool->iov->keyData, u.second) ) return 0;
+  Elements::iterator i = elements.find(pool->iov->keyData);
+  if ( i != elements.end() && (*i).second == pool )  {
+    int count = pool->size();
+    elements.erase(i);
+    evicted.insert(pool->iov->keyData);
+    evictedBytes += pool->bytes;
+    ++evictions;
+    printout(DEBUG,"ConditionsIOVPool","+++ Evict pool with IOV: %-32s [%4d entries, %ld bytes]",
+             pool->iov->str().c_str(), count, long(pool->bytes));
+    delete pool;
+    return count;
+  }
+  return 0;
+}
+
+/// Pin the pools containing the required IOV of a prepared user pool
+void ConditionsIOVPool::pin(const UserPool* user, const IOV::Key& required)   {
+  std::lock_guard<std::mutex> lock(m_userLock);
+  m_users[user] = required;
+}
+
+/// Release the pins of a user pool
+void ConditionsIOVPool::unpin(const UserPool* user)   {
+  std::lock_guard<std::mutex> lock(m_userLock);
+  m_users.erase(user);
+}
+
+/// Check if a pool with the given key is used by a prepared user pool
+bool ConditionsIOVPool::pinned(const IOV::Key& key)   {
+  std::lock_guard<std::mutex> lock(m_userLock);
+  for(const auto& u : m_users )
+    if ( IOV::key_contains_range(key, u.second) ) return true;
+  return false;
+}
+
+/// Access the memory and eviction statistics
+ConditionsIOVPool::Statistics ConditionsIOVPool::statistics()  const   {
+  Statistics stat;
+  stat.pools        = elements.size();
+  stat.evictions    = evictions;
+  stat.evictedBytes = evictedBytes;
+  stat.reloads      = reloads;
+  for(const auto& i : elements )  {
+    stat.conditions += i.second->size();
+    stat.bytes      += i.second->bytes;
+  }
+  return stat;
+}
+
+/// Logical clock for the LRU ordering of pools by their last selection
+unsigned long long ConditionsIOVPool::tick()   {
+  return ++s_clock;
+}
@@ -22,12 +22,27 @@
 #include "DDCond/ConditionsManager.h"
 #include "DDCond/ConditionsManagerObject.h"
 
+// C/C++ include files
+#include <chrono>
+#include <future>
+
 using namespace std;
 using namespace DD4hep;
 using namespace DD4hep::Conditions;
 
 DD4HEP_INSTANTIATE_HANDLE_NAMED(ConditionsManagerObject);
 
+/// Shared state of an asynchronous prepare call
+class ConditionsManager::AsyncResult::State  {
+public:
+  /// Result of the prepare call and the time spent in seconds
+  shared_future<pair<Result,double> > future;
+  /// Reference to the manager accounting the call
+  ConditionsManagerObject*            manager = 0;
+  /// Flag to account the call only once
+  once_flag                           collected;
+};
+
 
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
@@ -146,6 +161,75 @@ ConditionsPool* ConditionsManagerObject::registerIOV(const string& data)   {
   return registerIOV(*iov.iovType, iov.keyData);
 }
 
+/// Access the statistics of asynchronous prepare calls
+ConditionsManagerObject::AsyncStatistics ConditionsManagerObject::asyncStatistics()  const   {
+  lock_guard<mutex> lock(m_asyncLock);
+  return m_asyncStat;
+}
+
+/// Account a collected result of an asynchronous prepare call
+void ConditionsManagerObject::asyncCollected(double work_time, double stall_time, bool stalled)   {
+  lock_guard<mutex> lock(m_asyncLock);
+  ++m_asyncStat.collected;
+  if ( stalled ) ++m_asyncStat.stalls;
+  m_asyncStat.workTime  += work_time;
+  m_asyncStat.stallTime += stall_time;
+  m_asyncStat.savedTime += work_time - stall_time;
+}
+
+/// Prepare all updates to the clients with the defined IOV in the background
+ConditionsManagerObject::AsyncResult
+ConditionsManagerObject::prepareAsync(const IOV& req_iov, ConditionsSlice& slice)   {
+  typedef chrono::duration<double> seconds;
+  shared_ptr<AsyncResult::State> state(new AsyncResult::State());
+  ConditionsSlice* slc = &slice;
+  IOV iov(req_iov);
+  state->manager = this;
+  state->future  = async(launch::async, [this, slc, iov]()  {
+      auto   start  = chrono::steady_clock::now();
+      Result result = this->prepare(iov, *slc);
+      return make_pair(result, seconds(chrono::steady_clock::now()-start).count());
+    }).share();
+  lock_guard<mutex> lock(m_asyncLock);
+  ++m_asyncStat.requests;
+  return AsyncResult(state);
+}
+
+/// Check if the result is availible without waiting
+bool ConditionsManager::AsyncResult::ready() const   {
+  if ( !m_state ) return false;
+  return m_state->future.wait_for(chrono::seconds(0)) == future_status::ready;
+}
+
+/// Wait until the result is availible
+void ConditionsManager::AsyncResult::wait() const   {
+  if ( m_state ) m_state->future.wait();
+}
+
+/// Wait for the result and access it. Exceptions of the prepare call are re-thrown
+ConditionsManager::Result ConditionsManager::AsyncResult::get() const   {
+  typedef chrono::duration<double> seconds;
+  if ( !m_state )  {
+    except("ConditionsManager","+++ Attempt to access the result of an invalid asynchronous call.");
+  }
+  State* s = m_state.get();
+  bool stalled = !ready();
+  auto start   = chrono::steady_clock::now();
+  s->future.wait();
+  double stall = seconds(chrono::steady_clock::now()-start).count();
+  try  {
+    const pair<Result,double>& result = s->future.get();
+    call_once(s->collected, [s, &result, stall, stalled]()
+              { s->manager->asyncCollected(result.second, stall, stalled); });
+    return result.first;
+  }
+  catch(...)  {
+    call_once(s->collected, [s, stall, stalled]()
+              { s->manager->asyncCollected(0e0, stall, stalled); });
+    throw;
+  }
+}
+
 /// Default constructor
 ConditionsManager::ConditionsManager(LCDD& lcdd)  {
   assign(ConditionsManager::from(lcdd).ptr(), "ConditionsManager","");
@@ -242,3 +326,14 @@ ConditionsManager::Result
 ConditionsManager::prepare(const IOV& req_iov, ConditionsSlice& slice)  const  {
   return access()->prepare(req_iov, slice);
 }
+
+/// Prepare all updates to the clients with the defined IOV in the background
+ConditionsManager::AsyncResult
+ConditionsManager::prepareAsync(const IOV& req_iov, ConditionsSlice& slice)  const  {
+  return access()->prepareAsync(req_iov, slice);
+}
+
+/// Access the statistics of the asynchronous prepare calls
+ConditionsManager::AsyncStatistics ConditionsManager::asyncStatistics()  const  {
+  return access()->asyncStatistics();
+}
@@ -27,7 +27,8 @@ DD4HEP_INSTANTIATE_HANDLE_NAMED(ConditionsPool);
 
 /// Default constructor
 ConditionsPool::ConditionsPool(ConditionsManager mgr)
-  : NamedObject(), m_manager(mgr), iovType(0), iov(0), age_value(AGE_NONE)
+  : NamedObject(), m_manager(mgr), iovType(0), iov(0), age_value(AGE_NONE),
+    arena(new ConditionsArena()), bytes(0), lastUsed(0)
 {
   InstanceCount::increment(this);
 }
@@ -35,6 +36,8 @@ ConditionsPool::ConditionsPool(ConditionsManager mgr)
 /// Default destructor
 ConditionsPool::~ConditionsPool()   {
   // Should, but cannot clear here, since clear is a virtual overload.
+  // The memory of the arena is released once the last condition is gone.
+  arena->release();
   InstanceCount::decrement(this);
 }
 
@@ -157,7 +157,7 @@ namespace  {
     }
     bool operator()(Condition::Object* c)  const  {
       if ( 0 == (c->flags&Condition::DERIVED) )   {
-        slice->insert(ConditionKey(c->name,c->hash),ConditionsSlice::loadInfo(c->address));
+        slice->insert(ConditionKey(c->name,c->hash),ConditionsSlice::loadInfo(c->address.str()));
         return true;
       }
       //DD4hep::printout(DD4hep::INFO,"Slice","++ Ignore dependent condition: %s",c->name.c_str());
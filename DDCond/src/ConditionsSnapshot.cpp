@@ -0,0 +1,366 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDCond/ConditionsSnapshot.h"
+#include "DDCond/ConditionsPool.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/BasicGrammar.h"
+#include "DD4hep/objects/ConditionsInterna.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Conditions;
+
+namespace {
+
+  const char     s_magic[16] = "DD4hepCondSnap";
+  const uint32_t s_version   = 1;
+  enum _PayloadFormat { FORMAT_NONE = 0, FORMAT_BINARY = 1, FORMAT_TEXT = 2 };
+
+  /// Reference to a string in the string table
+  struct StringRef  {
+    uint32_t offset, length;
+  };
+  /// File header. All offsets relative to the start of the file
+  struct FileHeader  {
+    char     magic[16];
+    uint32_t version, numTypes, numIOVs, numRecords;
+    uint32_t poolType, spare;
+    int64_t  poolFirst, poolSecond;
+    uint64_t typeOffset, iovOffset, recordOffset;
+    uint64_t stringOffset, stringSize, payloadOffset, payloadSize, fileSize;
+  };
+  /// IOV type table entry
+  struct IOVTypeRecord  {
+    uint32_t  type, spare;
+    StringRef name;
+  };
+  /// IOV table entry. The type is the index in the IOV type table
+  struct IOVRecord  {
+    uint32_t type;
+    int32_t  optData;
+    int64_t  first, second;
+  };
+  /// Condition table entry. The iov is the index in the IOV table
+  struct ConditionRecord  {
+    uint64_t  key, grammar, payloadOffset, payloadLength;
+    uint32_t  iov, flags, format, spare;
+    StringRef name, type, address, comment, value;
+  };
+
+  /// Collect the conditions of a user pool
+  struct Collector : public ConditionsSelect  {
+    vector<Condition::Object*>& objects;
+    Collector(vector<Condition::Object*>& o) : objects(o) {}
+    virtual bool operator()(Condition::Object* o) const  { objects.push_back(o); return true; }
+  };
+
+  /// Helper to build the tables of the snapshot in memory
+  struct Writer  {
+    vector<IOVTypeRecord>              types;
+    vector<IOVRecord>                  iovs;
+    vector<ConditionRecord>            records;
+    string                             strings;
+    vector<unsigned char>              payload;
+    map<const IOVType*,uint32_t>       typeIndex;
+    map<pair<uint32_t,IOV::Key>,uint32_t> iovIndex;
+
+    StringRef add(const string& s)  {
+      StringRef r = { uint32_t(strings.length()), uint32_t(s.length()) };
+      strings += s;
+      return r;
+    }
+    uint32_t add(const IOVType* t)  {
+      auto i = typeIndex.find(t);
+      if ( i != typeIndex.end() ) return (*i).second;
+      IOVTypeRecord r;
+      r.type  = t->type;
+      r.spare = 0;
+      r.name = add(t->name);
+      types.push_back(r);
+      return typeIndex[t] = uint32_t(types.size()-1);
+    }
+    uint32_t add(const IOV* iov)  {
+      uint32_t typ = add(iov->iovType);
+      auto key = make_pair(typ, iov->keyData);
+      auto i = iovIndex.find(key);
+      if ( i != iovIndex.end() ) return (*i).second;
+      IOVRecord r;
+      r.type    = typ;
+      r.optData = iov->optData;
+      r.first   = iov->keyData.first;
+      r.second  = iov->keyData.second;
+      iovs.push_back(r);
+      return iovIndex[key] = uint32_t(iovs.size()-1);
+    }
+    /// Align the payload area to 8 bytes
+    void align()  {
+      payload.resize((payload.size()+7)&~size_t(7), 0);
+    }
+  };
+
+  /// Read-only memory mapping of the snapshot file
+  struct Mapping  {
+    void*  address = MAP_FAILED;
+    size_t length  = 0;
+    ~Mapping()  {
+      if ( address != MAP_FAILED ) ::munmap(address, length);
+    }
+  };
+}
+
+/// Default constructor
+ConditionsSnapshot::ConditionsSnapshot()  {
+}
+
+/// Default destructor
+ConditionsSnapshot::~ConditionsSnapshot()   {
+}
+
+/// Save the conditions of a prepared user pool to file
+ConditionsSnapshot::Result ConditionsSnapshot::save(const UserPool& pool, const string& output)  const  {
+  vector<Condition::Object*> objects;
+  Result     result;
+  Writer     w;
+  FileHeader hdr;
+
+  if ( !pool.validity().iovType )  {
+    except("ConditionsSnapshot","++ Cannot save snapshot %s: The user pool is not prepared.", output.c_str());
+  }
+  objects.reserve(pool.size());
+  pool.select_all(Collector(objects));
+  sort(objects.begin(), objects.end(),
+       [](const Condition::Object* a, const Condition::Object* b) { return a->hash < b->hash; });
+  w.records.reserve(objects.size());
+  for(const Condition::Object* o : objects)  {
+    ConditionRecord r;
+    const BasicGrammar* g = o->data.grammar;
+    ::memset(&r, 0, sizeof(r));
+    r.key     = o->hash;
+    r.flags   = o->flags;
+    r.iov     = w.add(o->iov ? o->iov : pool.validityPtr());
+    r.format  = FORMAT_NONE;
+    if ( o->is_bound() && g )  {
+      r.grammar = g->hash();
+      w.align();
+      r.payloadOffset = w.payload.size();
+      if ( g->toBinary(o->data.ptr(), w.payload) )  {
+        r.format = FORMAT_BINARY;
+        ++result.binary;
+      }
+      else  {
+        try  {
+          string rep = g->str(o->data.ptr());
+          w.payload.resize(r.payloadOffset);
+          w.payload.insert(w.payload.end(), rep.begin(), rep.end());
+          r.format = FORMAT_TEXT;
+          ++result.text;
+        }
+        catch(const exception& e)  {
+          w.payload.resize(r.payloadOffset);
+          printout(WARNING,"ConditionsSnapshot","++ Skip condition %s: No binary or string "
+                   "representation of type %s [%s]", o->name.c_str(), g->type_name().c_str(), e.what());
+          ++result.skipped;
+          continue;
+        }
+      }
+      r.payloadLength = w.payload.size() - r.payloadOffset;
+    }
+    r.name    = w.add(o->name);
+    r.type    = w.add(o->type);
+    r.address = w.add(o->address);
+    r.comment = w.add(o->comment);
+    r.value   = w.add(o->value);
+    w.records.push_back(r);
+  }
+
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, s_magic, sizeof(hdr.magic));
+  hdr.version       = s_version;
+  hdr.poolType      = w.add(pool.validity().iovType);
+  hdr.poolFirst     = pool.validity().keyData.first;
+  hdr.poolSecond    = pool.validity().keyData.second;
+  hdr.numTypes      = uint32_t(w.types.size());
+  hdr.numIOVs       = uint32_t(w.iovs.size());
+  hdr.numRecords    = uint32_t(w.records.size());
+  hdr.typeOffset    = sizeof(FileHeader);
+  hdr.iovOffset     = hdr.typeOffset   + w.types.size()*sizeof(IOVTypeRecord);
+  hdr.recordOffset  = hdr.iovOffset    + w.iovs.size()*sizeof(IOVRecord);
+  hdr.stringOffset  = hdr.recordOffset + w.records.size()*sizeof(ConditionRecord);
+  hdr.stringSize    = w.strings.length();
+  hdr.payloadOffset = (hdr.stringOffset + hdr.stringSize + 7)&~uint64_t(7);
+  hdr.payloadSize   = w.payload.size();
+  hdr.fileSize      = hdr.payloadOffset + hdr.payloadSize;
+
+  ofstream out(output.c_str(), ios::binary|ios::trunc);
+  if ( !out.good() )  {
+    except("ConditionsSnapshot","++ Failed to open output file:%s [errno:%d %s]",
+           output.c_str(), errno, ::strerror(errno));
+  }
+  const char pad[8] = {0,0,0,0,0,0,0,0};
+  out.write((const char*)&hdr, sizeof(hdr));
+  if ( !w.types.empty() )
+    out.write((const char*)&w.types[0],   w.types.size()*sizeof(IOVTypeRecord));
+  if ( !w.iovs.empty() )
+    out.write((const char*)&w.iovs[0],    w.iovs.size()*sizeof(IOVRecord));
+  if ( !w.records.empty() )
+    out.write((const char*)&w.records[0], w.records.size()*sizeof(ConditionRecord));
+  out.write(w.strings.c_str(), w.strings.length());
+  out.write(pad, hdr.payloadOffset - hdr.stringOffset - hdr.stringSize);
+  if ( !w.payload.empty() )
+    out.write((const char*)&w.payload[0], w.payload.size());
+  out.close();
+  if ( !out.good() )  {
+    except("ConditionsSnapshot","++ Failed to write output file:%s [errno:%d %s]",
+           output.c_str(), errno, ::strerror(errno));
+  }
+  result.conditions = w.records.size();
+  result.bytes      = hdr.fileSize;
+  printout(INFO,"ConditionsSnapshot","++ Saved %ld conditions of IOV %s to %s [%ld bytes, binary:%ld text:%ld skipped:%ld]",
+           long(result.conditions), pool.validity().str().c_str(), output.c_str(), long(result.bytes),
+           long(result.binary), long(result.text), long(result.skipped));
+  return result;
+}
+
+/// Load the snapshot and register the conditions to the conditions manager
+ConditionsSnapshot::Result
+ConditionsSnapshot::load(const string& input, ConditionsManager manager, IOV* validity)  const  {
+  Result  result;
+  Mapping m;
+  struct stat buff;
+  int fd = ::open(input.c_str(), O_RDONLY);
+
+  if ( fd < 0 )  {
+    except("ConditionsSnapshot","++ Failed to open snapshot file:%s [errno:%d %s]",
+           input.c_str(), errno, ::strerror(errno));
+  }
+  if ( ::fstat(fd, &buff) == 0 && size_t(buff.st_size) >= sizeof(FileHeader) )  {
+    m.length  = buff.st_size;
+    m.address = ::mmap(0, m.length, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if ( m.address == MAP_FAILED )  {
+    except("ConditionsSnapshot","++ Failed to map snapshot file:%s [errno:%d %s]",
+           input.c_str(), errno, ::strerror(errno));
+  }
+
+  // Pointer fix-up: all tables are accessed directly in the mapped image
+  const char*       base = (const char*)m.address;
+  const FileHeader* hdr  = (const FileHeader*)base;
+  if ( ::memcmp(hdr->magic, s_magic, sizeof(s_magic)) != 0 || hdr->version != s_version )  {
+    except("ConditionsSnapshot","++ %s is no conditions snapshot of version %d.", input.c_str(), int(s_version));
+  }
+  else if ( hdr->fileSize != m.length ||
+            hdr->iovOffset     != hdr->typeOffset   + hdr->numTypes*sizeof(IOVTypeRecord) ||
+            hdr->recordOffset  != hdr->iovOffset    + hdr->numIOVs*sizeof(IOVRecord)    ||
+            hdr->stringOffset  != hdr->recordOffset + hdr->numRecords*sizeof(ConditionRecord) ||
+            hdr->payloadOffset <  hdr->stringOffset + hdr->stringSize ||
+            hdr->payloadOffset + hdr->payloadSize != hdr->fileSize ||
+            hdr->poolType >= hdr->numTypes )  {
+    except("ConditionsSnapshot","++ Snapshot file %s is corrupted or truncated.", input.c_str());
+  }
+  const IOVTypeRecord*   types   = (const IOVTypeRecord*)(base+hdr->typeOffset);
+  const IOVRecord*       iovs    = (const IOVRecord*)(base+hdr->iovOffset);
+  const ConditionRecord* records = (const ConditionRecord*)(base+hdr->recordOffset);
+  const char*            strings = base+hdr->stringOffset;
+  const unsigned char*   payload = (const unsigned char*)(base+hdr->payloadOffset);
+  auto str = [&](const StringRef& r)  {
+    if ( uint64_t(r.offset) + r.length > hdr->stringSize )
+      except("ConditionsSnapshot","++ Snapshot file %s: Invalid string reference.", input.c_str());
+    return string(strings+r.offset, r.length);
+  };
+
+  vector<const IOVType*> iov_types(hdr->numTypes, 0);
+  for(uint32_t i=0; i<hdr->numTypes; ++i)  {
+    iov_types[i] = manager.registerIOVType(types[i].type, str(types[i].name)).second;
+    if ( !iov_types[i] )  {
+      except("ConditionsSnapshot","++ Snapshot file %s: Cannot register IOV type %s.",
+             input.c_str(), str(types[i].name).c_str());
+    }
+  }
+  vector<ConditionsPool*> pools(hdr->numIOVs, 0);
+  for(uint32_t i=0; i<hdr->numIOVs; ++i)  {
+    const IOVRecord& r = iovs[i];
+    if ( r.type >= hdr->numTypes )
+      except("ConditionsSnapshot","++ Snapshot file %s: Invalid IOV type reference.", input.c_str());
+    pools[i] = manager.registerIOV(*iov_types[r.type], IOV::Key(r.first, r.second));
+  }
+  for(uint32_t i=0; i<hdr->numRecords; ++i)  {
+    const ConditionRecord& r = records[i];
+    if ( r.iov >= hdr->numIOVs || r.payloadOffset + r.payloadLength > hdr->payloadSize )  {
+      except("ConditionsSnapshot","++ Snapshot file %s: Invalid condition record %d.", input.c_str(), int(i));
+    }
+    ConditionsPool*     pool = pools[r.iov];
+    const BasicGrammar* g    = r.format != FORMAT_NONE ? BasicGrammar::get(r.grammar) : 0;
+    if ( pool->exists(r.key).isValid() )  {
+      ++result.skipped;
+      continue;
+    }
+    else if ( r.format != FORMAT_NONE && !g )  {
+      printout(ERROR,"ConditionsSnapshot","++ Skip condition %s: Unknown data type [%016llX]. "
+               "Is the library defining the grammar loaded?", str(r.name).c_str(), (unsigned long long)r.grammar);
+      ++result.skipped;
+      continue;
+    }
+    ConditionsArena::Scope scope(pool->arena);
+    Condition c(str(r.name), str(r.type));
+    Condition::Object* o = c.ptr();
+    o->hash    = r.key;
+    o->flags   = r.flags;
+    o->address = str(r.address);
+    o->comment = str(r.comment);
+    o->value   = str(r.value);
+    if ( g )  {
+      const unsigned char* data = payload + r.payloadOffset;
+      void* ptr = o->data.bind(g);
+      bool  ok  = false;
+      if ( r.format == FORMAT_BINARY )  {
+        ok = g->fromBinary(ptr, data, r.payloadLength);
+        ++result.binary;
+      }
+      else if ( r.format == FORMAT_TEXT )  {
+        ok = g->fromString(ptr, string((const char*)data, r.payloadLength));
+        ++result.text;
+      }
+      if ( !ok )  {
+        delete o;
+        except("ConditionsSnapshot","++ Snapshot file %s: Failed to restore payload of %s [%s].",
+               input.c_str(), str(r.name).c_str(), g->type_name().c_str());
+      }
+    }
+    manager.registerUnlocked(pool, c);
+    ++result.conditions;
+  }
+  if ( validity )  {
+    *validity = IOV(iov_types[hdr->poolType], IOV::Key(hdr->poolFirst, hdr->poolSecond));
+  }
+  result.bytes = m.length;
+  printout(INFO,"ConditionsSnapshot","++ Loaded %ld conditions from %s [%ld bytes, binary:%ld text:%ld skipped:%ld]",
+           long(result.conditions), input.c_str(), long(result.bytes),
+           long(result.binary), long(result.text), long(result.skipped));
+  return result;
+}
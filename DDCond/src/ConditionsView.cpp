@@ -0,0 +1,219 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDCond/ConditionsView.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DD4hep/InstanceCount.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/objects/ConditionsInterna.h"
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Conditions;
+
+namespace {
+  /// Helper: Collect the conditions of a user pool
+  class ViewCollector : public ConditionsSelect  {
+  public:
+    vector<Condition::Object*>& objects;
+    ViewCollector(vector<Condition::Object*>& o) : objects(o)  {}
+    virtual bool operator()(Condition::Object* cond) const
+    {  if ( cond ) objects.push_back(cond); return true;  }
+  };
+}
+
+/// Initializing constructor: snapshot of a prepared user pool
+ConditionsView::ConditionsView(ConditionsManager mgr, const UserPool& source)
+  : UserPool(mgr)
+{
+  vector<Condition::Object*> objects;
+  objects.reserve(source.size());
+  source.select_all(ViewCollector(objects));
+  m_iov = source.validity();
+  if ( m_iov.iovType )  {
+    // Keep the conditions alive as long as the view exists
+    m_iovPool = mgr.iovPool(*m_iov.iovType);
+    if ( m_iovPool ) m_iovPool->pin(this, m_iov.keyData);
+  }
+  // Hash table with a load factor of at most 50 %
+  size_t len = 2;
+  m_shift = 63;
+  while ( len < 2*objects.size() )  { len <<= 1; --m_shift; }
+  m_table.resize(len, Entry{0,0});
+  m_mask = len-1;
+  for( Condition::Object* o : objects )  {
+    size_t i = (o->hash*0x9E3779B97F4A7C15ULL)>>m_shift;
+    while ( m_table[i].object && m_table[i].key != o->hash ) i = (i+1)&m_mask;
+    if ( !m_table[i].object ) ++m_count;
+    m_table[i].key    = o->hash;
+    m_table[i].object = o;
+  }
+}
+
+/// Default destructor. Releases the pinned conditions pools
+ConditionsView::~ConditionsView()   {
+  if ( m_iovPool ) m_iovPool->unpin(this);
+}
+
+/// Print pool content
+void ConditionsView::print(const string& opt)   const  {
+  printout(INFO,"ConditionsView","+++ %s Conditions view with IOV: %-32s [%4d entries, %d slots]",
+           opt.c_str(), m_iov.str().c_str(), int(m_count), int(m_table.size()));
+  if ( opt == "*" ) {
+    for( const Entry& e : m_table )   {
+      if ( e.object )  {
+        Condition c = e.object;
+        printout(INFO,"ConditionsView","++ %16llX Val:%s %s",e.key, c->value.c_str(), c.str().c_str());
+      }
+    }
+  }
+}
+
+/// Full cleanup of all managed conditions: Not allowed
+void ConditionsView::clear()   {
+  except("ConditionsView","++ Attempt to clear an immutable conditions view.");
+}
+
+/// Select all conditions contained, passing a predicate
+size_t ConditionsView::select_all(const ConditionsSelect& predicate)  const   {
+  size_t count = 0;
+  for( const Entry& e : m_table )
+    if ( e.object && predicate(e.object) ) ++count;
+  return count;
+}
+
+/// Remove condition by key from pool: Not allowed
+bool ConditionsView::remove(key_type hash_key)   {
+  except("ConditionsView","++ Attempt to remove condition %016llX from an immutable view.",hash_key);
+  return false;
+}
+
+/// Remove condition by key from pool: Not allowed
+bool ConditionsView::remove(const ConditionKey& key)   {
+  return remove(key.hash);
+}
+
+/// Register a new condition to this pool: Not allowed
+bool ConditionsView::insert(Condition cond)   {
+  except("ConditionsView","++ Attempt to insert condition %s into an immutable view.",cond.name());
+  return false;
+}
+
+/// Prepare user pool for usage: Not allowed
+UserPool::Result ConditionsView::prepare(const IOV& required, ConditionsSlice&, void*)   {
+  except("ConditionsView","++ Attempt to prepare an immutable view for IOV %s.",required.str().c_str());
+  return Result();
+}
+
+/// Evaluate and register all derived conditions: Not allowed
+size_t ConditionsView::compute(const Dependencies&, void*, bool)   {
+  except("ConditionsView","++ Attempt to compute derived conditions of an immutable view.");
+  return 0;
+}
+
+/// Initializing constructor: acquire a reader slot
+ConditionsPublisher::Reader::Reader(ConditionsPublisher& publisher)
+  : m_publisher(publisher), m_slot(0)
+{
+  for( Slot& s : publisher.m_slots )  {
+    bool expected = false;
+    if ( s.used.compare_exchange_strong(expected, true) )  {
+      m_slot = &s;
+      return;
+    }
+  }
+  except("ConditionsPublisher","++ No free reader slot. Only %d concurrent readers are supported.",
+         int(MAX_READERS));
+}
+
+/// Default destructor: release the reader slot
+ConditionsPublisher::Reader::~Reader()   {
+  m_slot->epoch.store(0);
+  m_slot->used.store(false);
+}
+
+/// Initializing constructor
+ConditionsPublisher::ConditionsPublisher(ConditionsManager mgr)
+  : m_epoch(1), m_current(0), m_manager(mgr)
+{
+  for( Slot& s : m_slots )  {
+    s.epoch.store(0);
+    s.used.store(false);
+  }
+  InstanceCount::increment(this);
+}
+
+/// Default destructor. No reader may be registered anymore
+ConditionsPublisher::~ConditionsPublisher()   {
+  lock_guard<mutex> lock(m_lock);
+  for( const Retired& r : m_retired )
+    delete r.second;
+  m_retired.clear();
+  delete m_current.exchange(0);
+  InstanceCount::decrement(this);
+}
+
+/// Create a view of a prepared user pool and publish it. Returns the new view
+const ConditionsView* ConditionsPublisher::publish(const UserPool& pool)   {
+  return publish(new ConditionsView(m_manager, pool));
+}
+
+/// Publish an existing view. The publisher takes ownership
+const ConditionsView* ConditionsPublisher::publish(ConditionsView* view)   {
+  lock_guard<mutex> lock(m_lock);
+  const ConditionsView* old = m_current.exchange(view);
+  // Readers announcing an epoch beyond this one can only see the new view
+  unsigned long epoch = m_epoch.fetch_add(1);
+  ++m_stat.published;
+  if ( old ) m_retired.push_back(make_pair(epoch, old));
+  i_reclaim();
+  return view;
+}
+
+/// Delete replaced views no longer accessible. Returns the number of views deleted
+size_t ConditionsPublisher::reclaim()   {
+  lock_guard<mutex> lock(m_lock);
+  return i_reclaim();
+}
+
+/// Delete replaced views no longer accessible. Requires the writer lock
+size_t ConditionsPublisher::i_reclaim()   {
+  size_t count = 0;
+  if ( !m_retired.empty() )  {
+    unsigned long oldest = m_epoch.load();
+    for( const Slot& s : m_slots )  {
+      unsigned long e = s.epoch.load();
+      if ( e != 0 && e < oldest ) oldest = e;
+    }
+    for( auto i = m_retired.begin(); i != m_retired.end(); )  {
+      if ( (*i).first < oldest )  {
+        delete (*i).second;
+        i = m_retired.erase(i);
+        ++count;
+        continue;
+      }
+      ++i;
+    }
+    m_stat.reclaimed += count;
+  }
+  return count;
+}
+
+/// Access the publication statistics
+ConditionsPublisher::Statistics ConditionsPublisher::statistics()   {
+  lock_guard<mutex> lock(m_lock);
+  Statistics stat = m_stat;
+  stat.pending = m_retired.size();
+  return stat;
+}
@@ -35,6 +35,9 @@
 #include "DDCond/ConditionsLoaderImp.h"
 #include "DDCond/AlignmentsLoaderImp.h"
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace std;
 using namespace DD4hep;
 using namespace DD4hep::Conditions;
@@ -128,6 +131,15 @@ namespace {
     return false;
   }
 
+  /// Helper: Approximate memory footprint of a condition. Memory owned by the payload is not seen
+  size_t approximate_size(const Condition::Object* o)  {
+    const BasicGrammar* g = o->data.grammar;
+    size_t len = sizeof(*o) + o->name.capacity() + o->type.capacity() +
+      o->value.capacity() + o->validity.capacity();
+    if ( g && g->sizeOf() > DD4HEP_OPAQUEDATA_BUFFER_SIZE ) len += g->sizeOf();
+    return len;
+  }
+
   template <typename PMF>
   void __callListeners(const Manager_Type1::Listeners& listeners, PMF pmf, Condition& cond)  {
     for(const auto& listener : listeners )
@@ -138,7 +150,7 @@ namespace {
 /// Standard constructor
 Manager_Type1::Manager_Type1(LCDD& lcdd_instance)
   : ConditionsManagerObject(lcdd_instance), ObjectExtensions(typeid(Manager_Type1)),
-    m_updateLock(), m_poolLock(), m_updatePool(), m_rawPool(), m_locked(0)
+    m_updateLock(), m_poolLock(), m_prepareLock(), m_updatePool(), m_rawPool(), m_locked(0)
 {
   InstanceCount::increment(this);
   declareProperty("MaxIOVTypes",         m_maxIOVTypes=32);
@@ -146,6 +158,7 @@ Manager_Type1::Manager_Type1(LCDD& lcdd_instance)
   declareProperty("UpdatePoolType",      m_updateType = "DD4hep_ConditionsLinearUpdatePool");
   declareProperty("UserPoolType",        m_userType   = "DD4hep_ConditionsMapUserPool");
   declareProperty("LoaderType",          m_loaderType = "multi");
+  declareProperty("MemoryBudget",        m_memoryBudget = 0);
   m_iovTypes.resize(m_maxIOVTypes,IOVType());
   m_rawPool.resize(m_maxIOVTypes,0);
 }
@@ -244,7 +257,9 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   iov->type      = typ.type;
   iov->keyData   = key;
   cond_pool->iov = iov;
+  cond_pool->lastUsed = ConditionsIOVPool::tick();
   pool->elements.insert(make_pair(key,cond_pool));
+  if ( pool->evicted.erase(key) ) ++pool->reloads;
   return cond_pool;
 }
 
@@ -259,7 +274,7 @@ bool Manager_Type1::registerUnlocked(ConditionsPool* pool, Condition cond)   {
     cond->pool = pool;
     cond->iov  = pool->iov;
     cond->setFlag(Condition::ACTIVE);
-    pool->insert(cond);
+    if ( pool->insert(cond) ) pool->bytes += approximate_size(cond.ptr());
     __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, cond);
     return true;
   }
@@ -277,6 +292,7 @@ bool Manager_Type1::registerUnlocked(ConditionsPool* pool, Condition cond)   {
 Condition Manager_Type1::__queue_update(Conditions::Entry* e)   {
   if ( e )  {
     ConditionsPool*  p = this->ConditionsManagerObject::registerIOV(e->validity);
+    ConditionsArena::Scope scope(p->arena);
     Condition condition(e->name,e->type);
     Condition::Object* c = condition.ptr();
     //c->name = e->name;
@@ -355,7 +371,7 @@ void Manager_Type1::pushUpdates()   {
     if ( !ents.empty() )  {
       for(Condition c : ents )  {
         c->setFlag(Condition::ACTIVE);
-        c->pool->insert(c);
+        if ( c->pool->insert(c) ) c->pool->bytes += approximate_size(c.ptr());
       }
     }
   }
@@ -465,6 +481,43 @@ Manager_Type1::prepare(const IOV& req_iov, ConditionsSlice& slice)
   __get_checked_pool(req_iov, slice.pool);
   /// First push any pending updates and register them to pending pools...
   pushUpdates();
-  /// Now update/fill the user pool
-  return slice.pool->prepare(req_iov, slice);
+  /// Now update/fill the user pool and finally drop old pools if the memory budget
+  /// is exceeded. Both under the prepare lock: a pool may not be evicted while
+  /// another user pool pins it and selects its conditions.
+  dd4hep_lock_t lock(m_prepareLock);
+  Result result = slice.pool->prepare(req_iov, slice);
+  __enforce_budget();
+  return result;
+}
+
+/// Evict the least recently selected unpinned pools until the memory budget is respected
+size_t Manager_Type1::__enforce_budget()   {
+  typedef pair<ConditionsIOVPool*,ConditionsPool*> Candidate;
+  if ( m_memoryBudget <= 0 ) return 0;
+
+  dd4hep_lock_t lock(m_poolLock);
+  vector<Candidate> candidates;
+  size_t total = 0, count = 0, budget = m_memoryBudget;
+  for( ConditionsIOVPool* p : m_rawPool )  {
+    if ( !p ) continue;
+    for( const auto& e : p->elements )  {
+      total += e.second->bytes;
+      if ( !p->pinned(e.first) ) candidates.push_back(make_pair(p,e.second));
+    }
+  }
+  if ( total <= budget ) return 0;
+  sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+       { return a.second->lastUsed < b.second->lastUsed; });
+  for( const auto& c : candidates )  {
+    if ( total <= budget ) break;
+    IOV::Key key   = c.second->iov->keyData;
+    size_t   bytes = c.second->bytes;
+    count += c.first->evict(c.second);
+    // Pools pinned after the selection of the candidates are kept
+    if ( c.first->elements.find(key) == c.first->elements.end() ) total -= bytes;
+  }
+  printout(total > budget ? WARNING : DEBUG,"ConditionsManager",
+           "+++ Evicted %ld conditions. Holding %ld bytes with a budget of %ld bytes.",
+           long(count), long(total), long(budget));
+  return count;
 }
@@ -19,6 +19,9 @@
 #include "DDCond/ConditionsDataLoader.h"
 #include "DD4hep/Printout.h"
 
+// C/C++ include files
+#include <mutex>
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
@@ -30,16 +33,32 @@ namespace DD4hep {
 
     /// Implementation of a stack of conditions assembled before application
     /** 
+     *  Every data source is served by its own loader instance.
+     *  load_many dispatches the required items to all matching sources and
+     *  merges the results. With the property "Threads" > 1 the sources are
+     *  read concurrently.
+     *
      *  \author   M.Frank
      *  \version  1.0
      *  \ingroup  DD4HEP_CONDITIONS
      */
     class ConditionsMultiLoader : public ConditionsDataLoader   {
-      typedef std::map<std::string, ConditionsDataLoader*> Loaders;
       typedef std::map<std::string, ConditionsDataLoader*> OpenSources;
+      /// Access statistics per data source
+      struct Timing  {
+        size_t calls = 0, items = 0;
+        double seconds = 0e0;
+      };
+      typedef std::map<std::string, Timing> Timings;
 
-      Loaders m_loaders;
       OpenSources m_openSources;
+      /// Access statistics per data source
+      Timings     m_timings;
+      /// Lock protecting the access statistics
+      std::mutex  m_lock;
+      /// Property: number of threads reading data sources in parallel (default: 1 -> sequential)
+      int         m_numThreads = 1;
+
       ConditionsDataLoader* load_source(const std::string& nam,const iov_type& req_validity);
 
     public:
@@ -56,14 +75,10 @@ namespace DD4hep {
                                  const iov_type& req_validity,
                                  RangeConditions& conditions);
       /// Optimized update using conditions slice data
-      virtual size_t load_many(  const iov_type& /* req_validity */,
-                                 RequiredItems&  /* work         */,
-                                 LoadedItems&    /* loaded       */,
-                                 iov_type&       /* conditions_validity */)
-      {
-        except("ConditionsLoader","+++ update: Invalid call!");
-        return 0;
-      }
+      virtual size_t load_many(  const iov_type& req_validity,
+                                 RequiredItems&  work,
+                                 LoadedItems&    loaded,
+                                 iov_type&       conditions_validity);
     };
   }     /* End namespace Geometry                     */
 }       /* End namespace DD4hep                       */
@@ -90,6 +105,12 @@ namespace DD4hep {
 #include "DD4hep/PluginCreators.h"
 #include "DDCond/ConditionsManager.h"
 
+// C/C++ include files
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <typeinfo>
+
 // Forward declartions
 using std::string;
 using namespace DD4hep::Conditions;
@@ -107,10 +128,18 @@ DECLARE_LCDD_CONSTRUCTOR(DD4hep_Conditions_multi_Loader,create_loader)
 ConditionsMultiLoader::ConditionsMultiLoader(LCDD& lcdd, ConditionsManager mgr, const string& nam) 
 : ConditionsDataLoader(lcdd, mgr, nam)
 {
+  declareProperty("Threads", m_numThreads);
 }
 
 /// Default Destructor
 ConditionsMultiLoader::~ConditionsMultiLoader() {
+  for(const auto& t : m_timings)  {
+    printout(INFO,"ConditionsMultiLoader","+++ Source %-40s %6ld calls %8ld items %9.3f seconds",
+             t.first.c_str(), long(t.second.calls), long(t.second.items), t.second.seconds);
+  }
+  for(auto& s : m_openSources)
+    delete s.second;
+  m_openSources.clear();
 } 
 
 ConditionsDataLoader* 
@@ -123,24 +152,17 @@ ConditionsMultiLoader::load_source(const std::string& nam,
     if ( idx == string::npos )   {
       except("ConditionsMultiLoader","Invalid data source specification: "+nam);
     }
+    // One loader per source: sources may then be read concurrently
     string ident = nam.substr(0,idx);
-    Loaders::iterator ild = m_loaders.find(ident);
-    ConditionsDataLoader* loader = 0;
-    if ( ild == m_loaders.end() )  {
-      string typ = "DD4hep_Conditions_"+ident+"_Loader";
-      string fac = ident+"_ConditionsDataLoader";
-      const void* argv[] = {fac.c_str(), m_mgr.ptr(), 0};
-      loader = createPlugin<ConditionsDataLoader>(typ,m_lcdd,2,argv);
-      if ( !loader )  {
-        except("ConditionsMultiLoader",
-               "Failed to create conditions loader of type: "+typ+" to read:"+nam);
-      }
-    }
-    else  {
-      loader = (*ild).second;
+    string typ = "DD4hep_Conditions_"+ident+"_Loader";
+    string fac = ident+"_ConditionsDataLoader";
+    const void* argv[] = {fac.c_str(), m_mgr.ptr(), 0};
+    ConditionsDataLoader* loader = createPlugin<ConditionsDataLoader>(typ,m_lcdd,2,argv);
+    if ( !loader )  {
+      except("ConditionsMultiLoader",
+             "Failed to create conditions loader of type: "+typ+" to read:"+nam);
     }
     loader->addSource(nam.substr(idx+1),req_validity);
-    m_loaders[ident] = loader;
     m_openSources[nam] = loader;
     return loader;
   }
@@ -186,3 +208,103 @@ size_t ConditionsMultiLoader::load_single(key_type key,
   }
   return conditions.size() - len;
 }
+
+/// Optimized update using conditions slice data
+size_t ConditionsMultiLoader::load_many(const iov_type& req_validity,
+                                        RequiredItems&  work,
+                                        LoadedItems&    loaded,
+                                        iov_type&       conditions_validity)
+{
+  typedef std::pair<string,ConditionsDataLoader*> Partition;
+  std::vector<Partition>     partitions;
+  std::vector<RequiredItems> requests;
+  size_t len = loaded.size();
+
+  for(Sources::const_iterator i=m_sources.begin(); i != m_sources.end(); ++i)  {
+    const IOV& iov = (*i).second;
+    if ( iov.type == req_validity.type )  {
+      if ( IOV::key_partially_contained(iov.keyData,req_validity.keyData) )  {
+        const string& nam = (*i).first;
+        partitions.push_back(std::make_pair(nam,load_source(nam, iov)));
+      }
+    }
+  }
+  if ( partitions.empty() || work.empty() )  {
+    return 0;
+  }
+  // Items with a load-info string naming the source are only requested from this source.
+  // Without such a hint every source must be asked.
+  requests.resize(partitions.size());
+  for(const auto& w : work)  {
+    const ConditionsLoadInfo* info = w.second ? w.second->loadinfo : 0;
+    bool assigned = false;
+    if ( info && info->type() == typeid(string) )  {
+      const string* src = info->data<string>();
+      for(size_t j=0; j<partitions.size(); ++j)  {
+        if ( src->compare(0,partitions[j].first.length(),partitions[j].first) == 0 )  {
+          requests[j].push_back(w);
+          assigned = true;
+        }
+      }
+    }
+    if ( !assigned )  {
+      for(auto& r : requests) r.push_back(w);
+    }
+  }
+
+  size_t num_threads = m_numThreads > 1 ? size_t(m_numThreads) : 1;
+  num_threads = std::min(num_threads, partitions.size());
+  std::vector<string> errors(num_threads);
+  // Results are kept per source and merged in source order after all workers finished
+  std::vector<LoadedItems> results(partitions.size());
+  std::vector<iov_type>    iovs(partitions.size(), iov_type(req_validity.iovType));
+  auto worker = [&](size_t id)  {
+    try  {
+      for(size_t i=id; i<partitions.size(); i += num_threads)  {
+        if ( requests[i].empty() ) continue;
+        LoadedItems& items = results[i];
+        iov_type&    iov   = iovs[i];
+        auto start = std::chrono::high_resolution_clock::now();
+        iov.reset().invert();
+        partitions[i].second->load_many(req_validity, requests[i], items, iov);
+        std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+        printout(DEBUG,"ConditionsMultiLoader","+++ Loaded %ld of %ld items from %s in %.4f seconds",
+                 long(items.size()), long(requests[i].size()), partitions[i].first.c_str(), secs.count());
+        std::lock_guard<std::mutex> lock(m_lock);
+        Timing& t = m_timings[partitions[i].first];
+        ++t.calls;
+        t.items   += items.size();
+        t.seconds += secs.count();
+      }
+    }
+    catch(const std::exception& e)  {
+      errors[id] = e.what();
+    }
+    catch(...)  {
+      errors[id] = "UNKNOWN exception";
+    }
+  };
+  if ( num_threads > 1 )  {
+    std::vector<std::thread> threads;
+    for(size_t i=0; i<num_threads; ++i)
+      threads.push_back(std::thread(worker,i));
+    for(auto& t : threads)
+      t.join();
+  }
+  else  {
+    worker(0);
+  }
+  for(const auto& e : errors)  {
+    if ( !e.empty() )  {
+      except("ConditionsMultiLoader","+++ Failed to load conditions: %s",e.c_str());
+    }
+  }
+  // Merge independent of the thread scheduling: the first source providing a condition wins
+  for(size_t i=0; i<partitions.size(); ++i)  {
+    if ( !results[i].empty() )  {
+      loaded.insert(results[i].begin(), results[i].end());
+      conditions_validity.iov_intersection(iovs[i].keyData);
+    }
+  }
+  return loaded.size() - len;
+}
@@ -380,6 +380,52 @@ static long ddcond_clean_conditions(lcdd_t& lcdd, int argc, char** argv) {
 }
 DECLARE_APPLY(DD4hep_ConditionsClean,ddcond_clean_conditions)
 
+// ======================================================================================
+/// Plugin entry point: Print memory usage and eviction statistics of the IOV pools
+/**
+ *  Factory: DD4hep_ConditionsStatistics
+ *
+ *  Also prints the time saved and the stalls of asynchronous prepare calls.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/04/2016
+ */
+static long ddcond_conditions_statistics(lcdd_t& lcdd, int /* argc */, char** /* argv */) {
+  typedef std::vector<const IOVType*> _T;
+  ConditionsManager manager = ConditionsManager::from(lcdd);
+  const _T types = manager.iovTypesUsed();
+  ConditionsIOVPool::Statistics total;
+  for( _T::const_iterator i = types.begin(); i != types.end(); ++i )    {
+    const IOVType* type = *i;
+    ConditionsIOVPool* pool = type ? manager.iovPool(*type) : 0;
+    if ( pool )  {
+      ConditionsIOVPool::Statistics s = pool->statistics();
+      printout(INFO,"Statistics","+++ %-16s %6ld pools %8ld conditions %10ld bytes "
+               "Evicted: %6ld pools %10ld bytes %6ld reloads",
+               type->str().c_str(), long(s.pools), long(s.conditions), long(s.bytes),
+               long(s.evictions), long(s.evictedBytes), long(s.reloads));
+      total.pools        += s.pools;
+      total.conditions   += s.conditions;
+      total.bytes        += s.bytes;
+      total.evictions    += s.evictions;
+      total.evictedBytes += s.evictedBytes;
+      total.reloads      += s.reloads;
+    }
+  }
+  printout(INFO,"Statistics","+++ %-16s %6ld pools %8ld conditions %10ld bytes "
+           "Evicted: %6ld pools %10ld bytes %6ld reloads",
+           "Total", long(total.pools), long(total.conditions), long(total.bytes),
+           long(total.evictions), long(total.evictedBytes), long(total.reloads));
+  printout(INFO,"Statistics","+++ Memory budget: %s bytes",manager["MemoryBudget"].str().c_str());
+  ConditionsManager::AsyncStatistics a = manager.asyncStatistics();
+  printout(INFO,"Statistics","+++ Asynchronous prepare: %ld requests %ld collected %ld stalls "
+           "Work: %8.3f sec Stalled: %8.3f sec Saved: %8.3f sec",
+           long(a.requests), long(a.collected), long(a.stalls), a.workTime, a.stallTime, a.savedTime);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_ConditionsStatistics,ddcond_conditions_statistics)
+
 // ======================================================================================
 /// Basic entry point to instantiate the basic DD4hep conditions/alignmants printer
 /**
@@ -227,6 +227,7 @@ namespace DD4hep {
     CurrentPool pool(arg);
 
     pool.set(arg->manager.registerIOV(val));
+    ConditionsArena::Scope scope(arg->pool->arena);
     if ( e.hasAttr(_U(ref)) )  {
       string    ref = e.attr<string>(_U(ref));
       printout(s_parseLevel,"XMLConditions","++ Reading IOV file: %s -> %s",val.c_str(),ref.c_str());
@@ -76,6 +76,8 @@ namespace DD4hep {
       virtual Condition get(key_type hash)  const;
       /// Check if a condition exists in the pool and return it to the caller     
       virtual Condition get(const ConditionKey& key)  const;
+      /// Select all conditions contained, passing a predicate
+      virtual size_t select_all(const ConditionsSelect& predicate)  const;
       /// Remove condition by key from pool.
       virtual bool remove(key_type hash_key);
       /// Remove condition by key from pool.
@@ -226,6 +228,7 @@ void ConditionsMappedUserPool<MAPPING>::print(const std::string& opt)   const  {
 /// Full cleanup of all managed conditions.
 template<typename MAPPING>
 void ConditionsMappedUserPool<MAPPING>::clear()   {
+  if ( m_iovPool ) m_iovPool->unpin(this);
   m_iov = IOV(0);
   m_conditions.clear();
 }
@@ -254,6 +257,15 @@ Condition ConditionsMappedUserPool<MAPPING>::get(const ConditionKey& key)  const
   return i_findCondition(key.hash);
 }
 
+/// Select all conditions contained, passing a predicate
+template<typename MAPPING>
+size_t ConditionsMappedUserPool<MAPPING>::select_all(const ConditionsSelect& predicate)  const   {
+  size_t count = 0;
+  for( const auto& i : m_conditions )
+    if ( predicate(i.second) ) ++count;
+  return count;
+}
+
 /// Register a new condition to this pool
 template<typename MAPPING>
 bool ConditionsMappedUserPool<MAPPING>::insert(Condition cond)   {
@@ -360,6 +372,8 @@ ConditionsMappedUserPool<MAPPING>::prepare_VSN_1(const IOV&              require
   slice_miss_cond.clear();
   slice_miss_calc.clear();
   pool_iov.reset().invert();
+  // All pools serving the required IOV are in use and may not be evicted
+  m_iovPool->pin(this, required.keyData);
   m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
   m_iov = pool_iov;
   _Missing cond_missing(slice_cond.size()+m_conditions.size());
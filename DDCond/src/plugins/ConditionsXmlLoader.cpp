@@ -18,6 +18,11 @@
 #include "DDCond/ConditionsDataLoader.h"
 #include "DD4hep/Printout.h"
 
+// C/C++ include files
+#include <memory>
+#include <mutex>
+#include <ctime>
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
@@ -32,12 +37,31 @@ namespace DD4hep {
      */
     class ConditionsXmlLoader : public ConditionsDataLoader   {
       typedef std::vector<Condition> Buffer;
-      Buffer m_buffer;
+      /// Condition data of a parsed document
+      struct Item  {
+        std::string name, type, value, validity;
+      };
+      /// Cached content of a parsed document. Reparsed if the file was modified
+      struct Document  {
+        time_t                   modified = 0;
+        std::map<key_type, Item> items;
+      };
+      typedef std::map<std::string, std::shared_ptr<const Document> > Documents;
+
+      Buffer     m_buffer;
+      /// Cache of parsed documents keyed by path
+      Documents  m_documents;
+      /// Lock protecting the document cache
+      std::mutex m_lock;
+      /// Statistics: number of documents parsed and number of cache hits
+      size_t     m_parsed = 0, m_cached = 0;
 
       size_t load_source  (const std::string& nam,
                            key_type key,
                            const iov_type& req_validity,
                            RangeConditions& conditions);
+      /// Access the parsed document from the cache. Parse it if not present or modified
+      std::shared_ptr<const Document> document(const std::string& path);
     public:
       /// Default constructor
       ConditionsXmlLoader(LCDD& lcdd, ConditionsManager mgr, const std::string& nam);
@@ -52,14 +76,10 @@ namespace DD4hep {
                                  const iov_type& req_validity,
                                  RangeConditions& conditions);
       /// Optimized update using conditions slice data
-      virtual size_t load_many(  const iov_type& /* req_validity */,
-                                 RequiredItems&  /* work         */,
-                                 LoadedItems&    /* loaded       */,
-                                 iov_type&       /* conditions_validity */)
-      {
-        except("ConditionsLoader","+++ update: Invalid call!");
-        return 0;
-      }
+      virtual size_t load_many(  const iov_type& req_validity,
+                                 RequiredItems&  work,
+                                 LoadedItems&    loaded,
+                                 iov_type&       conditions_validity);
     };
   }    /* End namespace Conditions                */
 }      /* End namespace DD4hep                    */
@@ -71,12 +91,16 @@ namespace DD4hep {
 #include "DD4hep/PluginCreators.h"
 #include "DD4hep/objects/ConditionsInterna.h"
 
+#include "DD4hep/objects/ConditionsArena.h"
+
 #include "XML/XMLElements.h"
 #include "XML/DocumentHandler.h"
 #include "DDCond/ConditionsEntry.h"
+#include "DDCond/ConditionsPool.h"
 
 // C/C++ include files
 #include <string>
+#include <sys/stat.h>
 
 // Forward declartions
 using std::string;
@@ -84,6 +108,10 @@ using namespace DD4hep;
 using namespace DD4hep::Conditions;
 
 namespace {
+  /// Serializes the conversion plugin and the registration of conditions to the manager.
+  /// Documents of different loaders are parsed concurrently.
+  std::mutex s_convertLock;
+
   void* create_loader(DD4hep::Geometry::LCDD& lcdd, int argc, char** argv)   {
     const char* name = argc>0 ? argv[0] : "XMLLoader";
     ConditionsManagerObject* mgr = (ConditionsManagerObject*)(argc>0 ? argv[1] : 0);
@@ -100,8 +128,91 @@ ConditionsXmlLoader::ConditionsXmlLoader(LCDD& lcdd, ConditionsManager mgr, cons
 
 /// Default Destructor
 ConditionsXmlLoader::~ConditionsXmlLoader() {
+  printout(DEBUG,"ConditionsXmlLoader","+++ %s: %ld documents parsed, %ld cache hits.",
+           name(), long(m_parsed), long(m_cached));
 } 
 
+/// Access the parsed document from the cache. Parse it if not present or modified
+std::shared_ptr<const ConditionsXmlLoader::Document>
+ConditionsXmlLoader::document(const string& path)   {
+  struct stat buff;
+  time_t modified = ::stat(path.c_str(), &buff) == 0 ? buff.st_mtime : 0;
+  std::lock_guard<std::mutex> lock(m_lock);
+  Documents::const_iterator i = m_documents.find(path);
+  if ( i != m_documents.end() && (*i).second->modified == modified )  {
+    ++m_cached;
+    return (*i).second;
+  }
+  std::shared_ptr<Document> doc(new Document());
+  XML::DocumentHolder holder(XML::DocumentHandler().load(path));
+  XML::Handle_t       handle = holder.root();
+  ConditionsStack     stack;
+  void*               result = 0;
+  doc->modified = modified;
+  {
+    std::lock_guard<std::mutex> convert(s_convertLock);
+    char* argv[] = { (char*)handle.ptr(), (char*)&stack, 0};
+    result = DD4hep::createPlugin("XMLConditionsParser", m_lcdd, 2, argv, 0);
+  }
+  for (Entry* e : stack)  {
+    string nam = e->detector.path()+"#"+e->name;
+    Item&  itm = doc->items[ConditionKey::hashCode(nam)];
+    itm.name     = nam;
+    itm.type     = e->type;
+    itm.value    = e->value;
+    itm.validity = e->validity;
+    delete e;
+  }
+  if ( result != &m_lcdd )  {
+    except("ConditionsXmlLoader","+++ Failed to convert conditions document %s.",path.c_str());
+  }
+  ++m_parsed;
+  m_documents[path] = doc;
+  return doc;
+}
+
+/// Optimized update using conditions slice data
+size_t ConditionsXmlLoader::load_many(const iov_type& req_validity,
+                                      RequiredItems&  work,
+                                      LoadedItems&    loaded,
+                                      iov_type&       conditions_validity)
+{
+  size_t len = loaded.size();
+  for (const Source& src : m_sources)  {
+    const IOV& src_iov = src.second;
+    if ( src_iov.type != req_validity.type ) continue;
+    if ( !IOV::key_partially_contained(src_iov.keyData,req_validity.keyData) ) continue;
+    std::shared_ptr<const Document> doc = document(src.first);
+    std::lock_guard<std::mutex> lock(s_convertLock);
+    for (const auto& w : work)  {
+      if ( loaded.find(w.first) != loaded.end() ) continue;
+      auto i = doc->items.find(w.first);
+      if ( i == doc->items.end() ) continue;
+      const Item& itm = (*i).second;
+      // Items without own validity are valid for the IOV of the source
+      ConditionsPool* pool = 0;
+      if ( itm.validity.find('#') != string::npos )
+        pool = m_mgr.registerIOV(itm.validity);
+      else if ( src_iov.iovType )
+        pool = m_mgr.registerIOV(*src_iov.iovType, src_iov.keyData);
+      if ( !pool || !IOV::key_contains_range(pool->iov->keyData, req_validity.keyData) ) continue;
+      Condition cond = pool->exists(w.first);
+      if ( !cond.isValid() )  {
+        ConditionsArena::Scope scope(pool->arena);
+        cond = Condition(itm.name, itm.type);
+        cond->value    = itm.value;
+        cond->validity = itm.validity;
+        cond->address  = src.first;
+        cond->hash     = w.first;
+        m_mgr.registerUnlocked(pool, cond);
+      }
+      loaded.insert(std::make_pair(w.first, cond));
+      conditions_validity.iov_intersection(pool->iov->keyData);
+    }
+  }
+  return loaded.size()-len;
+}
+
 size_t ConditionsXmlLoader::load_source(const std::string& nam,
                                         key_type key,
                                         const iov_type& req_validity,
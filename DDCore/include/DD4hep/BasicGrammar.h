@@ -15,6 +15,7 @@
 
 // C/C++ include files
 #include <string>
+#include <vector>
 #include <typeinfo>
 
 /// Namespace for the AIDA detector description toolkit
@@ -35,6 +36,30 @@ namespace DD4hep {
    *   \ingroup DD4HEP
    */
   class BasicGrammar {
+  public:
+    /// Binary hook: append the binary image of the object to the buffer
+    typedef bool (*to_binary_t)(const BasicGrammar& grammar, const void* ptr, std::vector<unsigned char>& buffer);
+    /// Binary hook: set the object from its binary image
+    typedef bool (*from_binary_t)(const BasicGrammar& grammar, void* ptr, const void* buffer, size_t length);
+
+    /// Object life cycle: default construction into allocated memory
+    void        (*construct)(void* ptr) = 0;
+    /// Object life cycle: copy construction into allocated memory
+    void        (*copy)(void* to, const void* from) = 0;
+    /// Object life cycle: destruction. Memory is not released
+    void        (*destruct)(void* ptr) = 0;
+
+  protected:
+    /// Hash value of the type name. Identifies the grammar in persistent data
+    unsigned long long int m_hash = 0;
+    /// Binary serialization hook (optional)
+    mutable to_binary_t    m_toBinary = 0;
+    /// Binary deserialization hook (optional)
+    mutable from_binary_t  m_fromBinary = 0;
+
+    /// Register the grammar instance by the hash value of its type name
+    void registerGrammar(const std::string& type_name);
+
   public:
     /// Default constructor
     BasicGrammar();
@@ -43,6 +68,12 @@ namespace DD4hep {
 
     /// Instance factory
     template <typename TYPE> static const BasicGrammar& instance();
+    /// Access a registered grammar by the hash value of its type name. NULL if unknown
+    static const BasicGrammar* get(unsigned long long int hash_value);
+    /// Binary hook for trivially copyable types: byte-wise copy of the object
+    static bool bytesToBinary(const BasicGrammar& grammar, const void* ptr, std::vector<unsigned char>& buffer);
+    /// Binary hook for trivially copyable types: byte-wise copy of the object
+    static bool bytesFromBinary(const BasicGrammar& grammar, void* ptr, const void* buffer, size_t length);
     /// Error callback on invalid conversion
     static void invalidConversion(const std::type_info& from, const std::type_info& to);
     /// Error callback on invalid conversion
@@ -57,6 +88,20 @@ namespace DD4hep {
     virtual std::string str(const void* ptr) const = 0;
     /// Set value from serialized string. On successful data conversion TRUE is returned.
     virtual bool fromString(void* ptr, const std::string& value) const = 0;
+    /// Serialize an opaque value to its binary image appended to the buffer. FALSE if not supported
+    bool toBinary(const void* ptr, std::vector<unsigned char>& buffer) const;
+    /// Set value from its binary image. FALSE if not supported or if the image is invalid
+    bool fromBinary(void* ptr, const void* buffer, size_t length) const;
+    /// Access the hash value of the type name
+    unsigned long long int hash() const    {  return m_hash;                                }
+    /// Check if the object may be serialized to a binary image
+    bool hasBinary() const                 {  return m_toBinary != 0 && m_fromBinary != 0;  }
+    /// Install the binary (de)serialization hooks. Not thread safe: do it at load time
+    void setBinaryHooks(to_binary_t to, from_binary_t from) const;
+    /// Access the binary serialization hook
+    to_binary_t toBinaryHook() const       {  return m_toBinary;                            }
+    /// Access the binary deserialization hook
+    from_binary_t fromBinaryHook() const   {  return m_fromBinary;                          }
   };
 }      // End namespace DD4hep
 
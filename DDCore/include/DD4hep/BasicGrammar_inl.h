@@ -44,8 +44,11 @@ namespace DD4hep { XmlTools::Evaluator& g4Evaluator();  }
 namespace {  static XmlTools::Evaluator& s__eval(DD4hep::g4Evaluator());  }
 
 // C/C++ include files
+#include <type_traits>
+#include <cstring>
 #include <string>
 #include <vector>
+#include <sstream>
 #include <list>
 #include <set>
 #include <map>
@@ -82,9 +85,190 @@ namespace DD4hep {
     virtual int evaluate(void* ptr, const std::string& value) const;
   };
 
+  /// Binary image of the objects handled by grammars
+  /**
+   *   Trivially copyable types are copied byte-wise. Strings and the STL
+   *   containers supported by the parsers store the number of entries
+   *   (64 bit) followed by the entries. Vectors of trivially copyable types
+   *   are copied in bulk. Other types may be supported by specializations.
+   *   The image is in native byte order.
+   *
+   *   \author  M.Frank
+   *   \version 1.0
+   *   \ingroup DD4HEP
+   */
+  template <typename TYPE> struct GrammarBinary  {
+    enum { supported = std::is_trivially_copyable<TYPE>::value };
+    static void put(const TYPE& val, std::vector<unsigned char>& buff)  {
+      const unsigned char* p = (const unsigned char*)(const void*)&val;
+      buff.insert(buff.end(), p, p+sizeof(TYPE));
+    }
+    static bool get(TYPE& val, const unsigned char*& p, const unsigned char* end)  {
+      if ( size_t(end-p) < sizeof(TYPE) ) return false;
+      ::memcpy((void*)&val, p, sizeof(TYPE));
+      p += sizeof(TYPE);
+      return true;
+    }
+  };
+
+  /// Binary image: number of entries of a container
+  inline void grammar_put_size(size_t num, std::vector<unsigned char>& buff)  {
+    GrammarBinary<unsigned long long>::put(num, buff);
+  }
+
+  /// Binary image: number of entries of a container. Each entry needs at least one byte
+  inline bool grammar_get_size(size_t& num, const unsigned char*& p, const unsigned char* end)  {
+    unsigned long long n = 0;
+    if ( !GrammarBinary<unsigned long long>::get(n, p, end) || n > (unsigned long long)(end-p) ) return false;
+    num = size_t(n);
+    return true;
+  }
+
+  /// Binary image of strings
+  template <> struct GrammarBinary<std::string>  {
+    enum { supported = 1 };
+    static void put(const std::string& val, std::vector<unsigned char>& buff)  {
+      grammar_put_size(val.length(), buff);
+      buff.insert(buff.end(), val.begin(), val.end());
+    }
+    static bool get(std::string& val, const unsigned char*& p, const unsigned char* end)  {
+      size_t n = 0;
+      if ( !grammar_get_size(n, p, end) ) return false;
+      val.assign((const char*)p, n);
+      p += n;
+      return true;
+    }
+  };
+
+  /// Binary image of pairs
+  template <typename K, typename V> struct GrammarBinary<std::pair<K,V> >  {
+    enum { supported = GrammarBinary<K>::supported && GrammarBinary<V>::supported };
+    static void put(const std::pair<K,V>& val, std::vector<unsigned char>& buff)  {
+      GrammarBinary<K>::put(val.first, buff);
+      GrammarBinary<V>::put(val.second, buff);
+    }
+    static bool get(std::pair<K,V>& val, const unsigned char*& p, const unsigned char* end)  {
+      return GrammarBinary<K>::get(val.first, p, end) && GrammarBinary<V>::get(val.second, p, end);
+    }
+  };
+
+  /// Binary image of vectors. Trivially copyable entries are copied in bulk
+  template <typename T> struct GrammarBinary<std::vector<T> >  {
+    enum { supported = GrammarBinary<T>::supported };
+    static void put(const std::vector<T>& val, std::vector<unsigned char>& buff)  {
+      grammar_put_size(val.size(), buff);
+      if ( std::is_trivially_copyable<T>::value )  {
+        const unsigned char* p = (const unsigned char*)(const void*)val.data();
+        buff.insert(buff.end(), p, p+val.size()*sizeof(T));
+        return;
+      }
+      for(const auto& v : val) GrammarBinary<T>::put(v, buff);
+    }
+    static bool get(std::vector<T>& val, const unsigned char*& p, const unsigned char* end)  {
+      size_t n = 0;
+      if ( !grammar_get_size(n, p, end) ) return false;
+      if ( std::is_trivially_copyable<T>::value )  {
+        if ( size_t(end-p) < n*sizeof(T) ) return false;
+        val.resize(n);
+        if ( n > 0 ) ::memcpy((void*)val.data(), p, n*sizeof(T));
+        p += n*sizeof(T);
+        return true;
+      }
+      val.resize(n);
+      for(auto& v : val)
+        if ( !GrammarBinary<T>::get(v, p, end) ) return false;
+      return true;
+    }
+  };
+
+  /// Binary image of bit vectors: one byte per entry
+  template <> struct GrammarBinary<std::vector<bool> >  {
+    enum { supported = 1 };
+    static void put(const std::vector<bool>& val, std::vector<unsigned char>& buff)  {
+      grammar_put_size(val.size(), buff);
+      for(bool v : val) buff.push_back(v ? 1 : 0);
+    }
+    static bool get(std::vector<bool>& val, const unsigned char*& p, const unsigned char* end)  {
+      size_t n = 0;
+      if ( !grammar_get_size(n, p, end) ) return false;
+      val.assign(p, p+n);
+      p += n;
+      return true;
+    }
+  };
+
+  /// Binary image of sequential containers without contiguous storage
+  template <typename CONT> struct GrammarBinarySequence  {
+    typedef typename CONT::value_type value_type;
+    enum { supported = GrammarBinary<value_type>::supported };
+    static void put(const CONT& val, std::vector<unsigned char>& buff)  {
+      grammar_put_size(val.size(), buff);
+      for(const auto& v : val) GrammarBinary<value_type>::put(v, buff);
+    }
+    static bool get(CONT& val, const unsigned char*& p, const unsigned char* end)  {
+      size_t n = 0;
+      if ( !grammar_get_size(n, p, end) ) return false;
+      val.clear();
+      for(size_t i=0; i<n; ++i)  {
+        value_type v;
+        if ( !GrammarBinary<value_type>::get(v, p, end) ) return false;
+        val.insert(val.end(), v);
+      }
+      return true;
+    }
+  };
+  template <typename T> struct GrammarBinary<std::list<T> >  : public GrammarBinarySequence<std::list<T> >  {};
+  template <typename T> struct GrammarBinary<std::deque<T> > : public GrammarBinarySequence<std::deque<T> > {};
+  template <typename T> struct GrammarBinary<std::set<T> >   : public GrammarBinarySequence<std::set<T> >   {};
+
+  /// Binary image of maps
+  template <typename K, typename V> struct GrammarBinary<std::map<K,V> >  {
+    enum { supported = GrammarBinary<K>::supported && GrammarBinary<V>::supported };
+    static void put(const std::map<K,V>& val, std::vector<unsigned char>& buff)  {
+      grammar_put_size(val.size(), buff);
+      for(const auto& v : val)  {
+        GrammarBinary<K>::put(v.first, buff);
+        GrammarBinary<V>::put(v.second, buff);
+      }
+    }
+    static bool get(std::map<K,V>& val, const unsigned char*& p, const unsigned char* end)  {
+      size_t n = 0;
+      if ( !grammar_get_size(n, p, end) ) return false;
+      val.clear();
+      for(size_t i=0; i<n; ++i)  {
+        std::pair<K,V> v;
+        if ( !GrammarBinary<std::pair<K,V> >::get(v, p, end) ) return false;
+        val.insert(val.end(), v);
+      }
+      return true;
+    }
+  };
+
+  namespace  {
+    template <typename TYPE> void grammar_construct(void* p)             {  new(p) TYPE();                     }
+    template <typename TYPE> void grammar_copy(void* t, const void* s)   {  new(t) TYPE(*(const TYPE*)s);      }
+    template <typename TYPE> void grammar_destruct(void* p)              {  ((TYPE*)p)->~TYPE();               }
+    template <typename TYPE> bool grammar_to_binary(const BasicGrammar&, const void* ptr, std::vector<unsigned char>& buff)  {
+      GrammarBinary<TYPE>::put(*(const TYPE*)ptr, buff);
+      return true;
+    }
+    template <typename TYPE> bool grammar_from_binary(const BasicGrammar&, void* ptr, const void* buff, size_t len)  {
+      const unsigned char* p = (const unsigned char*)buff;
+      return GrammarBinary<TYPE>::get(*(TYPE*)ptr, p, p+len) && p == (const unsigned char*)buff+len;
+    }
+  }
+
   /// Standarsd constructor
   template <typename TYPE> Grammar<TYPE>::Grammar() {
     m_typeName = typeName(typeid(TYPE));
+    construct  = grammar_construct<TYPE>;
+    copy       = grammar_copy<TYPE>;
+    destruct   = grammar_destruct<TYPE>;
+    if ( std::is_trivially_copyable<TYPE>::value )
+      setBinaryHooks(bytesToBinary, bytesFromBinary);
+    else if ( GrammarBinary<TYPE>::supported )
+      setBinaryHooks(grammar_to_binary<TYPE>, grammar_from_binary<TYPE>);
+    registerGrammar(m_typeName);
   }
 
   /// Default destructor
@@ -277,11 +461,12 @@ namespace DD4hep {
     while (s[0] == ' ')
       s.erase(0, 1);
 #ifdef DD4HEP_USE_BOOST
-    double result = s__eval.evaluate(s.c_str());
-    if (s__eval.status() != XmlTools::Evaluator::OK) {
+    std::stringstream err;
+    std::pair<int,double> result = s__eval.evaluate(s, err);
+    if (result.first != XmlTools::Evaluator::OK) {
       return 0;
     }
-    *p = (T)result;
+    *p = (T)result.second;
     return 1;
 #else
     return 0;
@@ -319,9 +504,18 @@ namespace DD4hep {
   
 }      // End namespace DD4hep
 
+#define DD4HEP_GRAMMAR_CONCAT_(a,b)  a##b
+#define DD4HEP_GRAMMAR_CONCAT(a,b)   DD4HEP_GRAMMAR_CONCAT_(a,b)
+
+/// Instantiate the grammar at library load time: it must be known to BasicGrammar::get()
+#define DD4HEP_REGISTER_GRAMMAR_TYPE(x)                                 \
+  namespace DD4hep { namespace {                                        \
+    const BasicGrammar& DD4HEP_GRAMMAR_CONCAT(s__grammar_,__COUNTER__) = BasicGrammar::instance<x>(); }}
+
 #define DD4HEP_DEFINE_PARSER_GRAMMAR_TYPE(x)                            \
   namespace DD4hep {                                                    \
-    template<> const BasicGrammar& BasicGrammar::instance<x>()  { static Grammar<x> s; return s;}}
+    template<> const BasicGrammar& BasicGrammar::instance<x>()  { static Grammar<x> s; return s;}} \
+  DD4HEP_REGISTER_GRAMMAR_TYPE(x)
 
 #define DD4HEP_DEFINE_PARSER_GRAMMAR_EVAL(x,func)                       \
   namespace DD4hep {                                                    \
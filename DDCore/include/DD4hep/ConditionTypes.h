@@ -12,4 +12,5 @@
 //==========================================================================
 
 #define DD4HEP_INSTANTIATE_GRAMMAR_TYPE(x)  \
-namespace DD4hep {template<> const BasicGrammar& BasicGrammar::instance<x>()  { static Grammar<x> s; return s;}}
+namespace DD4hep {template<> const BasicGrammar& BasicGrammar::instance<x>()  { static Grammar<x> s; return s;}} \
+DD4HEP_REGISTER_GRAMMAR_TYPE(x)
@@ -0,0 +1,94 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_GEOMETRY_DETELEMENTINDEX_H
+#define DD4HEP_GEOMETRY_DETELEMENTINDEX_H
+
+// Framework include files
+#include "DD4hep/Detector.h"
+
+// C/C++ include files
+#include <unordered_map>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the geometry part of the AIDA detector description toolkit
+  namespace Geometry {
+
+    /// Path index of all detector elements of a detector description
+    /**
+     *  The index is owned by the world detector element. It is built when
+     *  the geometry is closed and updated by DetElement::add for detector
+     *  elements attached afterwards.
+     *
+     *  Every indexed detector element receives a dense numeric identifier
+     *  (see DetElement::index()), which may be used to index flat arrays.
+     *  Absolute detector element paths are resolved with a single hash
+     *  lookup. Elements whose path hash collides with an already indexed
+     *  element are not indexed: lookups then fall back to the tree walk.
+     *
+     *  Note: The index is not protected against concurrent modification.
+     *  Attaching detector elements while other threads resolve paths is
+     *  not supported.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP DD4HEP_GEOMETRY
+     */
+    class DetElementIndex  {
+    public:
+      /// Map of the path hash to the dense identifier
+      typedef std::unordered_map<unsigned long long, unsigned int> Paths;
+
+    protected:
+      /// Detector elements by dense identifier
+      std::vector<DetElement> m_elements;
+      /// Dense identifiers by path hash
+      Paths                   m_paths;
+      /// Number of elements not indexed due to hash collisions
+      size_t                  m_collisions = 0;
+
+      /// Add a single detector element and recursively its children
+      void i_add(DetElement element);
+
+    public:
+      /// Default constructor
+      DetElementIndex() = default;
+      /// Inhibit copy constructor
+      DetElementIndex(const DetElementIndex& copy) = delete;
+      /// Default destructor
+      virtual ~DetElementIndex();
+      /// Inhibit assignment
+      DetElementIndex& operator=(const DetElementIndex& copy) = delete;
+
+      /// Access the index of the detector element tree hosting an element (NULL if not indexed)
+      static DetElementIndex* instance(DetElement element);
+
+      /// Clear the index and index the complete detector element tree
+      void build(DetElement top);
+      /// Add a detector element and all its children to the index
+      void add(DetElement element);
+      /// Number of indexed detector elements
+      size_t size()  const                {  return m_elements.size();  }
+      /// Number of detector elements not indexed due to hash collisions
+      size_t collisions()  const          {  return m_collisions;       }
+      /// Access detector element by its dense identifier
+      DetElement element(size_t id)  const
+      {  return id < m_elements.size() ? m_elements[id] : DetElement();  }
+      /// Access detector element by its absolute path. Invalid handle if not indexed
+      DetElement find(const std::string& path)  const;
+    };
+  }       /* End namespace Geometry               */
+}         /* End namespace DD4hep                 */
+#endif    /* DD4HEP_GEOMETRY_DETELEMENTINDEX_H    */
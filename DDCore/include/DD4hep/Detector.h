@@ -336,6 +336,8 @@ namespace DD4hep {
       unsigned int key()  const;
       /// Access the hierarchical level of the detector element (Only valid once geometry is closed!)
       int level()  const;
+      /// Access the dense identifier of the detector element (Only valid once geometry is closed! -1 otherwise)
+      int index()  const;
       /// Path of the detector element (not necessarily identical to placement path!)
       const std::string& path() const;
       /// Access to the full path to the placed object
@@ -274,6 +274,7 @@ template vector<pair<string, int> >::iterator;
 #pragma link C++ class vector<pair<string, int> >+;
 #pragma link C++ class vector<pair<string, int> >::iterator;
 #pragma link C++ class DD4hep::Geometry::PlacedVolumeExtension::VolIDs+;
+#pragma link C++ class DD4hep::Geometry::PlacedVolumeExtension::Parameterisation+;
 #pragma link C++ class DD4hep::Geometry::PlacedVolumeExtension+;
 #pragma link C++ class vector<DD4hep::Geometry::PlacedVolume>+;
 #pragma link C++ class DD4hep::Handle<TGeoNode>+;
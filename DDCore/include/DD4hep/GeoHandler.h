@@ -17,6 +17,8 @@
 #include <set>
 #include <map>
 #include <vector>
+#include <functional>
+#include <unordered_set>
 
 // Forward declarations
 class TGeoMatrix;
@@ -49,7 +51,14 @@ namespace DD4hep {
      */
     class GeoHandlerTypes {
     public:
+      /// Hash function of handles and raw pointers for unordered containers keyed by the object pointer
+      struct PointerHash  {
+        size_t operator()(const void* p) const  {  return std::hash<const void*>()(p);        }
+        template <typename T> size_t operator()(const Handle<T>& h) const
+        {  return std::hash<const void*>()(h.ptr());  }
+      };
       typedef std::set<Volume> VolumeSet;
+      typedef std::unordered_set<Volume, PointerHash> VolumeHashSet;
       typedef std::vector<Volume> VolumeVector;
       typedef std::set<const TGeoVolume*> ConstVolumeSet;
       typedef std::vector<std::pair<std::string, TGeoMatrix*> > TransformSet;
@@ -58,7 +67,7 @@ namespace DD4hep {
       typedef std::map<SensitiveDetector, ConstVolumeSet> SensitiveVolumes;
       typedef std::map<Region,   ConstVolumeSet> RegionVolumes;
       typedef std::map<LimitSet, ConstVolumeSet> LimitVolumes;
-      typedef std::map<int, std::set<const TGeoNode*> > Data;
+      typedef std::map<int, std::unordered_set<const TGeoNode*> > Data;
       typedef std::set<VisAttr> VisRefs;
       typedef std::set<SensitiveDetector> SensitiveDetectorSet;
       typedef std::set<Region>            RegionSet;
@@ -76,7 +85,7 @@ namespace DD4hep {
       class GeometryInfo {
       public:
         SolidSet solids;
-        VolumeSet volumeSet;
+        VolumeHashSet volumeSet;
         VolumeVector volumes;
         TransformSet trafos;
         VisRefs vis;
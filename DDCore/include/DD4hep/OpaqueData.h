@@ -18,6 +18,16 @@
 #include <vector>
 #include <string>
 
+/// Size of the inline data buffer of opaque data blocks in bytes.
+/** Payloads up to this size are stored inside the data block, larger payloads
+ *  are allocated separately. The default holds any vector and a 3x4 matrix of
+ *  doubles. The value changes the object layout: all clients must be compiled
+ *  with the same value.
+ */
+#ifndef DD4HEP_OPAQUEDATA_BUFFER_SIZE
+#define DD4HEP_OPAQUEDATA_BUFFER_SIZE 96
+#endif
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
@@ -89,8 +99,12 @@ namespace DD4hep {
       BOUND_DATA = 1<<2
     };
     /// Data buffer: plain data are allocated directly on this buffer
-    /** Internal data buffer is sufficient to store any vector  */
-    unsigned char data[sizeof(std::vector<void*>)];
+    /** Internal data buffer is sufficient to store any vector.
+     *  Larger objects are allocated from the active conditions arena.
+     */
+    alignas(double) unsigned char data[DD4HEP_OPAQUEDATA_BUFFER_SIZE];
+    static_assert(DD4HEP_OPAQUEDATA_BUFFER_SIZE >= sizeof(std::vector<void*>),
+                  "The opaque data buffer must at least hold a vector");
     /// Destructor function -- only set if the object is valid
     void (*destruct)(void*);
     /// Constructor function -- only set if the object is valid
@@ -113,6 +127,8 @@ namespace DD4hep {
     bool bind(const BasicGrammar* grammar,
 	      void (*ctor)(void*,const void*),
 	      void (*dtor)(void*));
+    /// Bind data value using the object life cycle functions of the grammar (default constructed)
+    void* bind(const BasicGrammar* grammar);
     /// Bind data value
     template <typename T> T& bind();
     /// Bind data value [Equivalent to set(value)]
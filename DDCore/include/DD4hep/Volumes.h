@@ -21,6 +21,7 @@
 
 // C/C++ include files
 #include <map>
+#include <atomic>
 
 // ROOT include file (includes TGeoVolume + TGeoShape)
 #include "TGeoNode.h"
@@ -107,12 +108,121 @@ namespace DD4hep {
         /// String representation for debugging
         std::string str()  const;
       };
+      /// Compact volume ID storage of placements
+      /**
+       *   Field names are interned in a process wide table and referenced by index.
+       *   Up to INLINE identifiers are stored in place. Longer lists use one exactly
+       *   sized heap block. The VolIDs container is only created on demand by
+       *   PlacedVolume::volIDs() and is then kept up to date with the packed identifiers.
+       *   Frequent readers should use the packed identifiers directly to avoid the
+       *   unpacked copy.
+       *
+       *   \author  M.Frank
+       *   \version 1.0
+       *   \ingroup DD4HEP_GEOMETRY
+       */
+      class PackedVolIDs  {
+      public:
+        enum { INLINE = 3 };
+        /// Packed identifier: index of the interned field name and the field value
+        struct Entry  {
+          unsigned int name;
+          int          value;
+        };
+      private:
+        /// Number of identifiers
+        unsigned int m_size;
+        /// Heap storage if the identifiers do not fit the local buffer
+        Entry*       m_heap;
+        /// Local buffer
+        Entry        m_local[INLINE];
+        /// Unpacked identifiers (only created on demand, published without lock)
+        mutable std::atomic<VolIDs*> m_unpacked;
+      public:
+        /// Default constructor
+        PackedVolIDs() : m_size(0), m_heap(0), m_unpacked(0) {}
+        /// Copy constructor
+        PackedVolIDs(const PackedVolIDs& c);
+        /// Default destructor
+        ~PackedVolIDs();
+        /// Assignment operator
+        PackedVolIDs& operator=(const PackedVolIDs& c);
+        /// Number of identifiers
+        size_t size()  const              {  return m_size;                    }
+        /// Check if identifiers are present
+        bool empty()  const               {  return m_size == 0;               }
+        /// Start of the packed identifiers
+        const Entry* begin()  const       {  return m_heap ? m_heap : m_local; }
+        /// End of the packed identifiers
+        const Entry* end()  const         {  return begin()+m_size;            }
+        /// Heap memory used in addition to the object itself
+        size_t heapBytes()  const;
+        /// Find entry by field name. Returns end() if not present
+        const Entry* find(const std::string& name)  const;
+        /// Add new identifier
+        void push_back(const std::string& name, int value);
+        /// Replace all identifiers
+        void assign(const VolIDs& ids);
+        /// Append the identifiers to a VolIDs container
+        void unpack(VolIDs& ids)  const;
+        /// Access the unpacked identifiers. The container lives as long as this object
+        const VolIDs& unpacked()  const;
+        /// Intern field name. Returns the index of the name in the name table
+        static unsigned int intern(const std::string& name);
+        /// Access interned field name by index
+        static const std::string& name(unsigned int index);
+        /// Number of interned field names
+        static size_t numNames();
+        /// Memory used by the name table
+        static size_t nameTableBytes();
+      };
+      /// Description of replicated placements (divisions and parameterised placements)
+      /**
+       *   All copies of a replicated placement share one extension object.
+       *   The value of the volume ID field of the replication is not stored
+       *   with each copy, but derived from the copy index.
+       *
+       *   \author  M.Frank
+       *   \version 1.0
+       *   \ingroup DD4HEP_GEOMETRY
+       */
+      class Parameterisation  {
+      public:
+        enum Type { DIVISION = 1, PARAMETERISED = 2 };
+        /// Replication type
+        int         type;
+        /// Replication axis of divisions (see Volume::ReplicationAxis)
+        int         axis;
+        /// Number of copies
+        int         count;
+        /// Start of the first division along the axis
+        double      offset;
+        /// Width of one division along the axis
+        double      width;
+        /// Position of the first copy (parameterised placements)
+        Position    start;
+        /// Translation between two consecutive copies (parameterised placements)
+        Position    delta;
+        /// Rotation common to all copies (parameterised placements)
+        Rotation3D  rotation;
+        /// Name of the volume ID field derived from the copy index
+        std::string field;
+        /// Default constructor
+        Parameterisation()
+          : type(0), axis(0), count(0), offset(0e0), width(0e0), start(), delta(), rotation(), field() {}
+        /// Transformation of a given copy relative to the mother (parameterised placements)
+        Transform3D transformation(int copy_index)  const  {
+          return Transform3D(rotation, start + double(copy_index)*delta);
+        }
+      };
       /// Magic word to detect memory corruptions
       unsigned long magic;
       /// Reference count on object (used to implement Grab/Release)
       long   refCount;
-      /// ID container
-      VolIDs volIDs;
+      /// ID container. Placement extensions are not part of the ROOT geometry I/O.
+      PackedVolIDs volIDs;   //!
+      /// Replication parameters (only set for replicated placements)
+      Parameterisation* params;
       /// Default constructor
       PlacedVolumeExtension();
       /// Copy constructor
@@ -120,17 +230,13 @@ namespace DD4hep {
       /// Default destructor
       virtual ~PlacedVolumeExtension();
       /// Assignment operator
-      PlacedVolumeExtension& operator=(const PlacedVolumeExtension& c) {
-        magic = c.magic;
-        volIDs = c.volIDs;
-        return *this;
-      }
+      PlacedVolumeExtension& operator=(const PlacedVolumeExtension& c);
       /// TGeoExtension overload: Method called whenever requiring a pointer to the extension
       virtual TGeoExtension *Grab()  override;
       /// TGeoExtension overload: Method called always when the pointer to the extension is not needed anymore
       virtual void Release() const  override;
       /// Enable ROOT persistency
-      ClassDefOverride(PlacedVolumeExtension,1);
+      ClassDefOverride(PlacedVolumeExtension,3);
     };
 
     /// Handle class holding a placed volume (also called physical volume)
@@ -147,6 +253,7 @@ namespace DD4hep {
       typedef PlacedVolumeExtension Object;
       typedef Object::VolIDs VolIDs;
       typedef Object::VolID  VolID;
+      typedef Object::Parameterisation Parameterisation;
 
       /// Constructor to be used when reading the already parsed DOM tree
       PlacedVolume(const TGeoNode* e)
@@ -181,6 +288,16 @@ namespace DD4hep {
       Volume motherVol() const;
       /// Access to the volume IDs
       const VolIDs& volIDs() const;
+      /// Access to the packed volume IDs without unpacking
+      const Object::PackedVolIDs& packedVolIDs() const;
+      /// Check if the placement is one copy of a replicated placement
+      bool isReplicated() const;
+      /// Access to the replication parameters. Returns 0 for normal placements
+      const Parameterisation* params() const;
+      /// Copy index [0,count) of a replicated placement. Returns -1 for normal placements
+      int copyIndex() const;
+      /// Access to the volume IDs including the field derived from the copy index of replicas
+      VolIDs physVolIDs() const;
       /// String dump
       std::string toString() const;
     };
@@ -249,6 +366,8 @@ namespace DD4hep {
     public:
       typedef Handle<TGeoVolume> Base;
       typedef VolumeExtension Object;
+      /// Axes along which volumes may be divided into replicas
+      enum ReplicationAxis { X_axis = 1, Y_axis, Z_axis, Rho_axis, Phi_axis };
 
     public:
       /// Default constructor
@@ -296,6 +415,30 @@ namespace DD4hep {
       /// Place rotated daughter volume. The position is automatically the identity position
       PlacedVolume placeVolume(const Volume& vol, const Rotation3D& rot) const;
 
+      /// Divide the volume into 'count' replicas of equal width starting at 'offset' along the given axis
+      /** The volume must not have any other daughters. Boxes may be divided along
+       *  the X, Y and Z axis, tubes along Rho, Phi and Z. The replicated cell volume
+       *  is created and accessible from the returned placement. All copies share the
+       *  placement data: volume IDs added to the returned placement apply to all copies.
+       *  If 'field' is not empty, the copy index is used as value of this volume ID field.
+       *  Angles are given in radians.
+       */
+      PlacedVolume divide(const std::string& name, ReplicationAxis axis, int count,
+                          double offset, double width, const std::string& field = "") const;
+      /// Divide the full extent of the volume into 'count' replicas along the given axis
+      PlacedVolume divide(const std::string& name, ReplicationAxis axis, int count,
+                          const std::string& field = "") const;
+      /// Place 'count' copies of a volume. Consecutive copies are translated by 'delta'
+      /** The volume must not have any other daughters. The transformation of
+       *  copy i is Transform3D(rotation(start), translation(start) + i*delta).
+       *  All copies share the placement data as for divisions.
+       */
+      PlacedVolume paramVolume1D(const Volume& vol, int count, const Transform3D& start,
+                                 const Position& delta, const std::string& field = "") const;
+      /// Place 'count' un-rotated copies of a volume. Consecutive copies are translated by 'delta'
+      PlacedVolume paramVolume1D(const Volume& vol, int count, const Position& start,
+                                 const Position& delta, const std::string& field = "") const;
+
       /// Attach attributes to the volume
       const Volume& setAttributes(const LCDD& lcdd, const std::string& region, const std::string& limits,
                                   const std::string& vis) const;
@@ -0,0 +1,211 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// NOTE:
+//
+// This is an internal include file. It should only be included to
+// instantiate code. Otherwise the Conditions include file should be
+// sufficient for all practical purposes.
+//
+//==========================================================================
+#ifndef DD4HEP_CONDITIONS_CONDITIONSARENA_H
+#define DD4HEP_CONDITIONS_CONDITIONSARENA_H
+
+// C/C++ include files
+#include <unordered_set>
+#include <iosfwd>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the conditions part of the AIDA detector description toolkit
+  namespace Conditions   {
+
+    /// Memory arena for condition objects, their payloads and interned strings
+    /**
+     *  Every conditions pool owns an arena. Condition objects and payloads
+     *  exceeding the inline buffer of the opaque data block are allocated from
+     *  the arena of the innermost Scope active in the calling thread. Without
+     *  active scope the memory is taken from the heap.
+     *
+     *  Arena memory is carved from large blocks. Released chunks are recycled
+     *  by free lists per size class. Strings (e.g. condition addresses) are
+     *  interned: identical strings share a single copy.
+     *
+     *  The arena is reference counted: the owning pool, every allocated chunk
+     *  and every interned string reference hold a reference. When the last
+     *  reference is gone, the blocks and the string table are released in one
+     *  go. Normally this happens when an aged pool is deleted together with
+     *  its conditions.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsArena  {
+    public:
+      /// Scope guard: memory allocated by the current thread is taken from the arena
+      /**
+       *  Scopes may be nested. A NULL arena switches to heap allocation.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Scope  {
+        /// Arena active before this scope was entered
+        ConditionsArena* m_previous;
+      public:
+        /// Initializing constructor: activate the arena
+        Scope(ConditionsArena* arena);
+        /// Default destructor: reactivate the previous arena
+        ~Scope();
+      };
+
+      /// Arena usage statistics
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Statistics  {
+      public:
+        /// Number of memory blocks
+        size_t blocks  = 0;
+        /// Total size of the memory blocks in bytes
+        size_t bytes   = 0;
+        /// Number of chunks currently in use
+        size_t chunks  = 0;
+        /// Number of interned strings
+        size_t strings = 0;
+      };
+
+      enum {
+        /// Size granularity of chunks
+        CHUNK_ALIGN = 16,
+        /// Largest chunk served by the arena. Bigger requests go to the heap
+        CHUNK_MAX   = 1024,
+        /// Default size of the memory blocks
+        BLOCK_SIZE  = 64*1024
+      };
+
+    private:
+      /// Lock protecting the blocks, the free lists and the string table
+      std::mutex                      m_lock;
+      /// Reference count
+      std::atomic<long>               m_refCount;
+      /// Size of the memory blocks
+      size_t                          m_blockSize;
+      /// Memory blocks
+      std::vector<void*>              m_blocks;
+      /// Free lists by size class
+      std::vector<void*>              m_free;
+      /// Interned strings
+      std::unordered_set<std::string> m_strings;
+      /// Next free byte of the current block
+      char*                           m_next   = 0;
+      /// Number of free bytes in the current block
+      size_t                          m_left   = 0;
+      /// Number of chunks currently in use
+      size_t                          m_chunks = 0;
+
+      /// Default destructor: release all memory blocks. Only called by release()
+      ~ConditionsArena();
+      /// Allocate a chunk of a given size class
+      void* chunk(size_t len);
+      /// Put a chunk back on the free list of its size class
+      void  recycle(void* ptr, size_t len);
+
+    public:
+      /// Initializing constructor. The caller holds the first reference
+      ConditionsArena(size_t block_size = BLOCK_SIZE);
+      /// Inhibit copy constructor
+      ConditionsArena(const ConditionsArena& copy) = delete;
+      /// Inhibit assignment
+      ConditionsArena& operator=(const ConditionsArena& copy) = delete;
+      /// Add reference
+      void addRef();
+      /// Release reference. The arena is deleted with the last reference
+      void release();
+      /// Access the usage statistics
+      Statistics statistics();
+      /// Intern a string. The pointer is valid as long as the arena lives
+      const std::string* intern(const std::string& value);
+
+      /// Access the arena of the innermost active scope of this thread (NULL if none)
+      static ConditionsArena* current();
+      /// Allocate memory from the current arena or from the heap
+      static void* allocate(size_t len);
+      /// Release memory obtained by allocate()
+      static void  deallocate(void* ptr);
+    };
+
+    /// String interned in the conditions arena of the active scope
+    /**
+     *  Without active arena the string is held privately. Copies are interned
+     *  again in the arena of the active scope.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class InternedString  {
+      /// Reference to the string data
+      const std::string* m_str;
+      /// Arena holding the string. NULL if the string is private
+      ConditionsArena*   m_arena;
+
+      /// Release the string data
+      void reset();
+      /// Set new string data
+      void assign(const std::string& value);
+
+    public:
+      /// Default constructor: empty string
+      InternedString();
+      /// Initializing constructor
+      InternedString(const std::string& value);
+      /// Initializing constructor
+      InternedString(const char* value);
+      /// Copy constructor
+      InternedString(const InternedString& copy);
+      /// Default destructor
+      ~InternedString();
+      /// Assignment operator
+      InternedString& operator=(const InternedString& copy);
+      /// Assignment from string
+      InternedString& operator=(const std::string& value);
+      /// Assignment from string
+      InternedString& operator=(const char* value);
+      /// Access the string value
+      const std::string& str()  const        {  return *m_str;           }
+      /// Conversion to string
+      operator const std::string&()  const   {  return *m_str;           }
+      /// Access to the character data
+      const char* c_str()  const             {  return m_str->c_str();   }
+      /// Length of the string
+      size_t length()  const                 {  return m_str->length();  }
+      /// Check for empty string
+      bool empty()  const                    {  return m_str->empty();   }
+    };
+
+    /// Output of interned strings
+    std::ostream& operator<<(std::ostream& os, const InternedString& value);
+
+  }       /* End namespace Conditions                    */
+}         /* End namespace DD4hep                        */
+#endif    /* DD4HEP_CONDITIONS_CONDITIONSARENA_H         */
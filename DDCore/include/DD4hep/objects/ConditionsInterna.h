@@ -27,6 +27,7 @@
 #include "DD4hep/BasicGrammar.h"
 #include "DD4hep/NamedObject.h"
 #include "DD4hep/objects/OpaqueData_inl.h"
+#include "DD4hep/objects/ConditionsArena.h"
 
 // C/C++ include files
 #include <map>
@@ -106,10 +107,10 @@ namespace DD4hep {
         std::string     value;
         /// Condition validity (in string form)
         std::string     validity;
-        /// Condition address
-        std::string     address;
-        /// Comment string
-        std::string     comment;
+        /// Condition address (interned)
+        InternedString  address;
+        /// Comment string (interned)
+        InternedString  comment;
         /// Data block
         OpaqueDataBlock data;
         /// Reference to conditions pool
@@ -128,6 +129,10 @@ namespace DD4hep {
         ConditionObject(const std::string& nam,const std::string& tit="");
         /// Standard Destructor
         virtual ~ConditionObject();
+        /// Allocation from the conditions arena of the active scope
+        static void* operator new(size_t len)     {  return ConditionsArena::allocate(len);  }
+        /// Release memory to the owning conditions arena
+        static void operator delete(void* ptr)    {  ConditionsArena::deallocate(ptr);       }
         /// Data offset from the opaque data block pointer to the condition
         static size_t offset();
         /// Move data content: 'from' will be reset to NULL
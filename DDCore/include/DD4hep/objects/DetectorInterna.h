@@ -43,6 +43,7 @@ namespace DD4hep {
 
     class LCDD;
     class WorldObject;
+    class DetElementIndex;
     class DetElementObject;
     class SensitiveDetectorObject;
     class VolumeManager_Populator;
@@ -121,6 +122,8 @@ namespace DD4hep {
       int                 level;
       /// Access hash key of this detector element (Only valid once geometry is closed!)
       unsigned int        key;
+      /// Dense identifier assigned by the path index of the world (-1 if not indexed)
+      int                 index; //! not ROOT-persistent
       /// Full path to this detector element. May be invalid
       std::string         path;
       /// The path to the placement of the detector element (if placed)
@@ -243,6 +246,9 @@ namespace DD4hep {
       /// Reference to the alignments manager object
       AlignmentsManagerObject* alignmentsManager;
 
+      /// Path index of all detector elements. Built when the geometry is closed
+      DetElementIndex*         pathIndex; //! not ROOT-persistent
+
     public:
       //@{ Public methods to ease the usage of the data. */
       /// Default constructor
@@ -258,7 +264,7 @@ namespace DD4hep {
     /// Default constructor
     inline WorldObject::WorldObject()
       : DetElementObject(), lcdd(0), 
-      conditionsLoader(0), conditionsManager(0), alignmentsLoader(0), alignmentsManager(0)
+      conditionsLoader(0), conditionsManager(0), alignmentsLoader(0), alignmentsManager(0), pathIndex(0)
       {
       }
 
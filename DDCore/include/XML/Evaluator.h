@@ -14,6 +14,11 @@
 #ifndef XMLTOOLS_EVALUATOR_H
 #define XMLTOOLS_EVALUATOR_H
 
+// C/C++ include files
+#include <string>
+#include <utility>
+#include <iosfwd>
+
 /// Namespace containing XML tools.
 namespace XmlTools {
 
@@ -85,11 +90,32 @@ namespace XmlTools {
      */
     double evaluate(const char * expression);
 
+    /**
+     * Thread safe evaluation of the arithmetic expression.
+     * Unlike evaluate(const char*) the state of the evaluator is not
+     * modified: the status is returned together with the result and
+     * in case of an ERROR the message is printed to the given stream.
+     * Calls are serialised with each other and with modifications
+     * of the dictionary.
+     *
+     * @param  expression input expression.
+     * @param  os         stream receiving the error message.
+     * @return pair of status and result of the evaluation.
+     */
+    std::pair<int,double> evaluate(const std::string& expression, std::ostream& os) const;
+
     /**
      * Returns status of the last operation with the evaluator.
      */
     int status() const;
 
+    /**
+     * Returns the modification count of the dictionary. It changes
+     * whenever a variable, function or environment entry is set or removed.
+     * Results of evaluate() may be cached as long as it does not change.
+     */
+    unsigned long generation() const;
+
     /**
      * Returns position in the input string where the problem occured.
      */
@@ -50,6 +50,14 @@ namespace DD4hep {
       virtual bool load(const std::string& system_id, std::string& data);
       /// Resolve a given URI to a string containing the data with context
       virtual bool load(const std::string& system_id, UserContext* context, std::string& data) = 0;
+      /// Resolve a given URI to a read-only view of the data without copying
+      virtual bool loadView(const std::string& system_id, const char*& data, size_t& length);
+      /// Resolve a given URI to a read-only view of the data without copying (with context)
+      /** The default implementation does not support views and returns false.
+       *  Readers, which keep the data resident in memory (e.g. memory mapped archives)
+       *  may overload this call. The data must stay valid for the lifetime of the reader.
+       */
+      virtual bool loadView(const std::string& system_id, UserContext* context, const char*& data, size_t& length);
       /// Inform reader about a locally (e.g. by XercesC) handled source load
       virtual void parserLoaded(const std::string& system_id);
       /// Inform reader about a locally (e.g. by XercesC) handled source load
@@ -86,6 +94,10 @@ namespace DD4hep {
       virtual bool load(const std::string& system_id, std::string& data)  override;
       /// Resolve a given URI to a string containing the data with context
       virtual bool load(const std::string& system_id, UserContext* context, std::string& data)  override;
+      /// Resolve a given URI to a read-only view of the data without copying
+      virtual bool loadView(const std::string& system_id, const char*& data, size_t& length)  override;
+      /// Resolve a given URI to a read-only view of the data without copying (with context)
+      virtual bool loadView(const std::string& system_id, UserContext* context, const char*& data, size_t& length)  override;
       /// Inform reader about a locally (e.g. by XercesC) handled source load
       virtual void parserLoaded(const std::string& system_id)  override;
       /// Inform reader about a locally (e.g. by XercesC) handled source load
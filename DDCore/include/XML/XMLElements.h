@@ -136,6 +136,36 @@ namespace DD4hep {
     /// Helper function to lookup environment from the expression evaluator
     std::string getEnviron(const std::string& env);
 
+    /// Statistics of the numeric attribute conversions
+    /**
+     *  Counters are kept per thread.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_XML
+     */
+    class ConversionStatistics  {
+    public:
+      /// Number of plain numeric literals converted without the expression evaluator
+      size_t literals  = 0;
+      /// Number of expressions served from the memoised evaluator results
+      size_t memoised  = 0;
+      /// Number of expressions passed to the expression evaluator
+      size_t evaluated = 0;
+    };
+    /// Enable/disable the fast path of attribute conversions. Returns the previous setting  \ingroup DD4HEP_XML
+    /** The fast path converts plain numeric literals directly, memoises the results
+     *  of the expression evaluator until its dictionary changes and caches the
+     *  unicode representation of attribute names. Enabled by default.
+     */
+    bool enableFastConversions(bool value);
+    /// Access the numeric conversion statistics of the calling thread  \ingroup DD4HEP_XML
+    ConversionStatistics& conversionStatistics();
+#ifndef __TIXML__
+    /// Cached unicode representation of an attribute name. NULL if the fast path is disabled  \ingroup DD4HEP_XML
+    const XmlChar* _toXmlTag(const char* name);
+#endif
+
     /// Conversion function from raw unicode string to bool  \ingroup DD4HEP_XML
     bool _toBool(const XmlChar* value);
     /// Conversion function from raw unicode string to int  \ingroup DD4HEP_XML
@@ -471,7 +501,8 @@ namespace DD4hep {
       }
       /// Access typed attribute value by it's name
       template <class T> T attr(const char* name) const {
-        return this->attr<T>(Strng_t(name));
+        const XmlChar* tag = _toXmlTag(name);
+        return tag ? this->attr<T>(tag) : this->attr<T>(Strng_t(name));
       }
       /// Generic attribute setter with text value
       Attribute setAttr(const XmlChar* t, const char* v) const;
@@ -779,7 +810,8 @@ namespace DD4hep {
 #ifndef __TIXML__
       /// Access typed attribute value by it's name
       template <class T> T attr(const char* name) const {
-        return this->attr<T>(Strng_t(name));
+        const XmlChar* tag = _toXmlTag(name);
+        return tag ? this->attr<T>(tag) : this->attr<T>(Strng_t(name));
       }
 #endif
       /// Access attribute name (throws exception if not present)
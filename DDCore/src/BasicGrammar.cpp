@@ -18,6 +18,21 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <cstring>
+#include <mutex>
+#include <map>
+
+namespace {
+  /// Registry of all grammar instances by the hash value of the type name
+  std::map<unsigned long long int, const DD4hep::BasicGrammar*>& grammar_registry()  {
+    static std::map<unsigned long long int, const DD4hep::BasicGrammar*> s_registry;
+    return s_registry;
+  }
+  std::mutex& grammar_registry_lock()  {
+    static std::mutex s_lock;
+    return s_lock;
+  }
+}
 
 /// Default constructor
 DD4hep::BasicGrammar::BasicGrammar()  {
@@ -27,6 +42,56 @@ DD4hep::BasicGrammar::BasicGrammar()  {
 DD4hep::BasicGrammar::~BasicGrammar()   {
 }
 
+/// Register the grammar instance by the hash value of its type name
+void DD4hep::BasicGrammar::registerGrammar(const std::string& type_name)   {
+  std::lock_guard<std::mutex> lock(grammar_registry_lock());
+  m_hash = hash64(type_name);
+  // The first registration wins: the grammar instances are singletons
+  grammar_registry().insert(std::make_pair(m_hash, this));
+}
+
+/// Access a registered grammar by the hash value of its type name. NULL if unknown
+const DD4hep::BasicGrammar* DD4hep::BasicGrammar::get(unsigned long long int hash_value)   {
+  std::lock_guard<std::mutex> lock(grammar_registry_lock());
+  auto i = grammar_registry().find(hash_value);
+  return i == grammar_registry().end() ? 0 : (*i).second;
+}
+
+/// Install the binary (de)serialization hooks. Not thread safe: do it at load time
+void DD4hep::BasicGrammar::setBinaryHooks(to_binary_t to, from_binary_t from) const  {
+  m_toBinary   = to;
+  m_fromBinary = from;
+}
+
+/// Serialize an opaque value to its binary image appended to the buffer. FALSE if not supported
+bool DD4hep::BasicGrammar::toBinary(const void* ptr, std::vector<unsigned char>& buffer) const  {
+  if ( ptr && m_toBinary )  {
+    size_t len = buffer.size();
+    if ( (*m_toBinary)(*this, ptr, buffer) ) return true;
+    buffer.resize(len);
+  }
+  return false;
+}
+
+/// Set value from its binary image. FALSE if not supported or if the image is invalid
+bool DD4hep::BasicGrammar::fromBinary(void* ptr, const void* buffer, size_t length) const  {
+  return ptr && m_fromBinary && (*m_fromBinary)(*this, ptr, buffer, length);
+}
+
+/// Binary hook for trivially copyable types: byte-wise copy of the object
+bool DD4hep::BasicGrammar::bytesToBinary(const BasicGrammar& grammar, const void* ptr, std::vector<unsigned char>& buffer)  {
+  const unsigned char* p = (const unsigned char*)ptr;
+  buffer.insert(buffer.end(), p, p+grammar.sizeOf());
+  return true;
+}
+
+/// Binary hook for trivially copyable types: byte-wise copy of the object
+bool DD4hep::BasicGrammar::bytesFromBinary(const BasicGrammar& grammar, void* ptr, const void* buffer, size_t length)  {
+  if ( length != grammar.sizeOf() ) return false;
+  ::memcpy(ptr, buffer, length);
+  return true;
+}
+
 /// Error callback on invalid conversion
 void DD4hep::BasicGrammar::invalidConversion(const std::string& value, const std::type_info& to) {
   std::string to_name = typeName(to);
@@ -15,6 +15,28 @@
 #include "DD4hep/BasicGrammar_inl.h"
 
 #ifndef DD4HEP_PARSERS_NO_ROOT
+namespace DD4hep {
+  /// Binary image of ROOT 3D and 4D vectors: the plain coordinates
+  template <typename T, int N> struct GrammarBinaryCoordinates  {
+    enum { supported = 1 };
+    static void put(const T& val, std::vector<unsigned char>& buff)  {
+      double c[N];
+      val.GetCoordinates(c);
+      buff.insert(buff.end(), (const unsigned char*)c, (const unsigned char*)(c+N));
+    }
+    static bool get(T& val, const unsigned char*& p, const unsigned char* end)  {
+      double c[N];
+      if ( size_t(end-p) < sizeof(c) ) return false;
+      ::memcpy(c, p, sizeof(c));
+      val.SetCoordinates(c);
+      p += sizeof(c);
+      return true;
+    }
+  };
+  template <> struct GrammarBinary<ROOT::Math::XYZPoint>     : public GrammarBinaryCoordinates<ROOT::Math::XYZPoint,3>     {};
+  template <> struct GrammarBinary<ROOT::Math::XYZVector>    : public GrammarBinaryCoordinates<ROOT::Math::XYZVector,3>    {};
+  template <> struct GrammarBinary<ROOT::Math::PxPyPzEVector>: public GrammarBinaryCoordinates<ROOT::Math::PxPyPzEVector,4>{};
+}
 DD4HEP_DEFINE_PARSER_GRAMMAR_CONT(ROOT::Math::XYZPoint,eval_obj)
 DD4HEP_DEFINE_PARSER_GRAMMAR_CONT(ROOT::Math::XYZVector,eval_obj)
 DD4HEP_DEFINE_PARSER_GRAMMAR_CONT(ROOT::Math::PxPyPzEVector,eval_obj)
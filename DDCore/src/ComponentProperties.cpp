@@ -284,6 +284,9 @@ DD4HEP_DEFINE_PROPERTY_CONT(string)
 typedef map<string, int> map_string_int;
 DD4HEP_DEFINE_PROPERTY_TYPE(map_string_int)
 
+typedef map<string, double> map_string_double;
+DD4HEP_DEFINE_PROPERTY_TYPE(map_string_double)
+
 typedef map<string, string> map_string_string;
 DD4HEP_DEFINE_PROPERTY_TYPE(map_string_string)
 
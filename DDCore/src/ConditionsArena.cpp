@@ -0,0 +1,233 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DD4hep/objects/ConditionsArena.h"
+
+// C/C++ include files
+#include <ostream>
+
+using namespace std;
+using namespace DD4hep::Conditions;
+
+namespace {
+  /// Chunk header: identifies the owning arena. Keeps the payload aligned
+  struct ChunkHeader  {
+    ConditionsArena* arena;
+    size_t           size;
+  };
+  static_assert(sizeof(ChunkHeader) == ConditionsArena::CHUNK_ALIGN, "Bad chunk header size");
+
+  /// Arena of the innermost active scope of this thread
+  thread_local ConditionsArena* s_current = 0;
+
+  /// Shared representation of empty strings
+  const string& empty_string()  {
+    static string s_empty;
+    return s_empty;
+  }
+}
+
+/// Initializing constructor: activate the arena
+ConditionsArena::Scope::Scope(ConditionsArena* arena) : m_previous(s_current)  {
+  s_current = arena;
+}
+
+/// Default destructor: reactivate the previous arena
+ConditionsArena::Scope::~Scope()  {
+  s_current = m_previous;
+}
+
+/// Initializing constructor. The caller holds the first reference
+ConditionsArena::ConditionsArena(size_t block_size)
+  : m_refCount(1), m_blockSize(block_size < 4*CHUNK_MAX ? size_t(4*CHUNK_MAX) : block_size),
+    m_free(CHUNK_MAX/CHUNK_ALIGN+1, (void*)0)
+{
+  InstanceCount::increment(this);
+}
+
+/// Default destructor: release all memory blocks. Only called by release()
+ConditionsArena::~ConditionsArena()  {
+  for(void* b : m_blocks) ::operator delete(b);
+  InstanceCount::decrement(this);
+}
+
+/// Add reference
+void ConditionsArena::addRef()  {
+  ++m_refCount;
+}
+
+/// Release reference. The arena is deleted with the last reference
+void ConditionsArena::release()  {
+  if ( --m_refCount == 0 ) delete this;
+}
+
+/// Access the usage statistics
+ConditionsArena::Statistics ConditionsArena::statistics()  {
+  lock_guard<mutex> lock(m_lock);
+  Statistics s;
+  s.blocks  = m_blocks.size();
+  s.bytes   = m_blocks.size()*m_blockSize;
+  s.chunks  = m_chunks;
+  s.strings = m_strings.size();
+  return s;
+}
+
+/// Intern a string. The pointer is valid as long as the arena lives
+const string* ConditionsArena::intern(const string& value)  {
+  lock_guard<mutex> lock(m_lock);
+  return &(*m_strings.insert(value).first);
+}
+
+/// Allocate a chunk of a given size class
+void* ConditionsArena::chunk(size_t len)  {
+  lock_guard<mutex> lock(m_lock);
+  void*& head = m_free[len/CHUNK_ALIGN];
+  ++m_chunks;
+  if ( head )  {
+    void* p = head;
+    head = *(void**)p;
+    return p;
+  }
+  if ( m_left < len )  {
+    m_next = (char*)::operator new(m_blockSize);
+    m_left = m_blockSize;
+    m_blocks.push_back(m_next);
+  }
+  void* p = m_next;
+  m_next += len;
+  m_left -= len;
+  return p;
+}
+
+/// Put a chunk back on the free list of its size class
+void ConditionsArena::recycle(void* ptr, size_t len)  {
+  lock_guard<mutex> lock(m_lock);
+  void*& head = m_free[len/CHUNK_ALIGN];
+  *(void**)ptr = head;
+  head = ptr;
+  --m_chunks;
+}
+
+/// Access the arena of the innermost active scope of this thread (NULL if none)
+ConditionsArena* ConditionsArena::current()  {
+  return s_current;
+}
+
+/// Allocate memory from the current arena or from the heap
+void* ConditionsArena::allocate(size_t len)  {
+  size_t       siz = (len + sizeof(ChunkHeader) + CHUNK_ALIGN - 1) & ~size_t(CHUNK_ALIGN-1);
+  ChunkHeader* hdr = 0;
+  if ( s_current && siz <= CHUNK_MAX )  {
+    hdr = (ChunkHeader*)s_current->chunk(siz);
+    hdr->arena = s_current;
+    s_current->addRef();
+  }
+  else  {
+    hdr = (ChunkHeader*)::operator new(siz);
+    hdr->arena = 0;
+  }
+  hdr->size = siz;
+  return hdr+1;
+}
+
+/// Release memory obtained by allocate()
+void ConditionsArena::deallocate(void* ptr)  {
+  if ( ptr )  {
+    ChunkHeader* hdr = ((ChunkHeader*)ptr)-1;
+    ConditionsArena* arena = hdr->arena;
+    if ( arena )  {
+      arena->recycle(hdr, hdr->size);
+      arena->release();
+      return;
+    }
+    ::operator delete(hdr);
+  }
+}
+
+/// Default constructor: empty string
+InternedString::InternedString() : m_str(&empty_string()), m_arena(0)  {
+}
+
+/// Initializing constructor
+InternedString::InternedString(const string& value) : m_str(&empty_string()), m_arena(0)  {
+  assign(value);
+}
+
+/// Initializing constructor
+InternedString::InternedString(const char* value) : m_str(&empty_string()), m_arena(0)  {
+  if ( value ) assign(value);
+}
+
+/// Copy constructor
+InternedString::InternedString(const InternedString& copy) : m_str(&empty_string()), m_arena(0)  {
+  assign(*copy.m_str);
+}
+
+/// Default destructor
+InternedString::~InternedString()  {
+  reset();
+}
+
+/// Assignment operator
+InternedString& InternedString::operator=(const InternedString& copy)  {
+  if ( &copy != this ) assign(*copy.m_str);
+  return *this;
+}
+
+/// Assignment from string
+InternedString& InternedString::operator=(const string& value)  {
+  assign(value);
+  return *this;
+}
+
+/// Assignment from string
+InternedString& InternedString::operator=(const char* value)  {
+  value ? assign(value) : reset();
+  return *this;
+}
+
+/// Release the string data
+void InternedString::reset()  {
+  if ( m_arena )
+    m_arena->release();
+  else if ( m_str != &empty_string() )
+    delete m_str;
+  m_str   = &empty_string();
+  m_arena = 0;
+}
+
+/// Set new string data
+void InternedString::assign(const string& value)  {
+  ConditionsArena* arena = ConditionsArena::current();
+  const string*    str   = &empty_string();
+  if ( value.empty() )  {
+    arena = 0;
+  }
+  else if ( arena )  {
+    str = arena->intern(value);
+    arena->addRef();
+  }
+  else  {
+    str = new string(value);
+  }
+  reset();
+  m_str   = str;
+  m_arena = arena;
+}
+
+/// Output of interned strings
+ostream& DD4hep::Conditions::operator<<(ostream& os, const InternedString& value)  {
+  return os << value.str();
+}
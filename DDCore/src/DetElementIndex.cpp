@@ -0,0 +1,84 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/DetElementIndex.h"
+#include "DD4hep/objects/DetectorInterna.h"
+#include "DD4hep/Primitives.h"
+#include "DD4hep/Printout.h"
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Geometry;
+
+/// Default destructor
+DetElementIndex::~DetElementIndex()   {
+}
+
+/// Access the index of the detector element tree hosting an element (NULL if not indexed)
+DetElementIndex* DetElementIndex::instance(DetElement element)   {
+  DetElementObject* o = element.ptr();
+  if ( o )  {
+    // Do not use DetElement::world(): it caches the top of detached trees.
+    while ( o->parent.isValid() ) o = o->parent.ptr();
+    WorldObject* w = dynamic_cast<WorldObject*>(o);
+    return w ? w->pathIndex : 0;
+  }
+  return 0;
+}
+
+/// Clear the index and index the complete detector element tree
+void DetElementIndex::build(DetElement top)   {
+  for( DetElement& de : m_elements ) de->index = -1;
+  m_elements.clear();
+  m_paths.clear();
+  m_collisions = 0;
+  add(top);
+  printout(DEBUG,"DetElementIndex","+++ Indexed %ld detector elements [%ld hash collisions].",
+           long(m_elements.size()), long(m_collisions));
+}
+
+/// Add a detector element and all its children to the index
+void DetElementIndex::add(DetElement element)   {
+  if ( element.isValid() )  {
+    i_add(element);
+  }
+}
+
+/// Add a single detector element and recursively its children
+void DetElementIndex::i_add(DetElement element)   {
+  DetElementObject* o = element.ptr();
+  unsigned int id = m_elements.size();
+  pair<Paths::iterator,bool> r = m_paths.insert(make_pair(hash64(element.path()),id));
+  if ( r.second )  {
+    o->index = id;
+    m_elements.push_back(element);
+  }
+  else if ( m_elements[(*r.first).second].ptr() != o )  {
+    ++m_collisions;
+    printout(WARNING,"DetElementIndex","+++ Path hash of %s collides with %s. Element not indexed.",
+             element.path().c_str(), m_elements[(*r.first).second].path().c_str());
+  }
+  for( const auto& c : o->children )
+    i_add(c.second);
+}
+
+/// Access detector element by its absolute path. Invalid handle if not indexed
+DetElement DetElementIndex::find(const string& path)  const   {
+  Paths::const_iterator i = m_paths.find(hash64(path));
+  if ( i != m_paths.end() )  {
+    const DetElement& de = m_elements[(*i).second];
+    if ( de.path() == path ) return de;
+  }
+  return DetElement();
+}
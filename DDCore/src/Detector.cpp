@@ -17,6 +17,7 @@
 #include "DD4hep/objects/AlignmentsInterna.h"
 #include "DD4hep/AlignmentTools.h"
 #include "DD4hep/DetectorTools.h"
+#include "DD4hep/DetElementIndex.h"
 #include "DD4hep/Printout.h"
 #include "DD4hep/World.h"
 #include "DD4hep/LCDD.h"
@@ -155,6 +156,12 @@ int DetElement::level()  const   {
   return -1;
 }
 
+/// Access the dense identifier of the detector element
+int DetElement::index()  const   {
+  Object* o = ptr();
+  return o ? o->index : -1;
+}
+
 /// Access the full path of the detector element
 const string& DetElement::path() const {
   Object* o = ptr();
@@ -258,6 +265,9 @@ DetElement& DetElement::add(DetElement sdet) {
     pair<Children::iterator, bool> r = object<Object>().children.insert(make_pair(sdet.name(), sdet));
     if (r.second) {
       sdet.access()->parent = *this;
+      // Elements attached after the geometry was closed must be indexed as well
+      DetElementIndex* index = DetElementIndex::instance(*this);
+      if ( index ) index->add(sdet);
       return *this;
     }
     throw runtime_error("DD4hep: DetElement::add: Element " + string(sdet.name()) + 
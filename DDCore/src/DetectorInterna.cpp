@@ -16,6 +16,7 @@
 #include "DD4hep/objects/AlignmentsInterna.h"
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/DetectorTools.h"
+#include "DD4hep/DetElementIndex.h"
 #include "DD4hep/Handle.inl"
 #include "DD4hep/Printout.h"
 #include "TGeoVolume.h"
@@ -62,7 +63,7 @@ SensitiveDetectorObject::~SensitiveDetectorObject() {
 /// Default constructor
 DetElementObject::DetElementObject()
   : NamedObject(), ObjectExtensions(typeid(DetElementObject)), magic(magic_word()),
-    flag(0), id(0), combineHits(0), typeFlag(0), level(-1), key(0), path(), placementPath(),
+    flag(0), id(0), combineHits(0), typeFlag(0), level(-1), key(0), index(-1), path(), placementPath(),
     idealPlace(), placement(), volumeID(0), parent(), children(),
     nominal(), survey(), alignments(), conditions(), worldTrafo()
 {
@@ -73,7 +74,7 @@ DetElementObject::DetElementObject()
 /// Initializing constructor
 DetElementObject::DetElementObject(const std::string& nam, int ident)
   : NamedObject(), ObjectExtensions(typeid(DetElementObject)), magic(magic_word()),
-    flag(0), id(ident), combineHits(0), typeFlag(0), level(-1), key(0), path(), placementPath(),
+    flag(0), id(ident), combineHits(0), typeFlag(0), level(-1), key(0), index(-1), path(), placementPath(),
     idealPlace(), placement(), volumeID(0), parent(), children(),
     nominal(), survey(), alignments(), conditions(), worldTrafo()
 {
@@ -105,6 +106,7 @@ DetElementObject* DetElementObject::clone(int new_id, int flg) const {
   obj->typeFlag    = typeFlag;
   obj->flag        = 0;
   obj->key         = 0;
+  obj->index       = -1;
   obj->level       = -1;
   obj->combineHits = combineHits;
   obj->nominal     = Alignment();
@@ -281,10 +283,11 @@ Conditions::Container DetElementObject::assign_conditions()  {
 /// Initializing constructor
 WorldObject::WorldObject(LCDD& _lcdd, const string& nam) 
   : DetElementObject(nam,0), lcdd(&_lcdd),
-    conditionsLoader(0), conditionsManager(0), alignmentsLoader(0), alignmentsManager(0)
+    conditionsLoader(0), conditionsManager(0), alignmentsLoader(0), alignmentsManager(0), pathIndex(0)
 {
 }
 
 /// Internal object destructor: release extension object(s)
 WorldObject::~WorldObject()  {
+  deletePtr(pathIndex);
 }
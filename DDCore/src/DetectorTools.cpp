@@ -14,6 +14,7 @@
 // Framework include files
 #define DETECTORTOOLS_CPP
 #include "DD4hep/DetectorTools.h"
+#include "DD4hep/DetElementIndex.h"
 #include "DD4hep/Printout.h"
 #include "DD4hep/LCDD.h"
 #include "DD4hep/objects/DetectorInterna.h"
@@ -224,6 +225,12 @@ DetElement DetectorTools::findElement(LCDD& lcdd, const std::string& path)   {
 /// Find DetElement as child of a parent by it's relative or absolute path
 DetElement DetectorTools::findDaughterElement(DetElement parent, const std::string& subpath)  {
   if ( parent.isValid() )   {
+    // Once the geometry is closed paths are resolved by the index. Fall back to the tree walk.
+    DetElementIndex* index = DetElementIndex::instance(parent);
+    if ( index && !subpath.empty() )  {
+      DetElement de = subpath[0] == '/' ? index->find(subpath) : index->find(parent.path()+"/"+subpath);
+      if ( de.isValid() ) return de;
+    }
     size_t idx = subpath.find('/',1);
     if ( subpath[0] == '/' )   {
       DetElement top = topElement(parent);
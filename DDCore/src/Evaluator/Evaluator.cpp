@@ -4,6 +4,13 @@
 #include "XML/Evaluator.h"
 
 #include <iostream>
+#include <atomic>
+#include <mutex>
+#if __cplusplus >= 201402L
+#include <shared_mutex>
+#else
+#include <pthread.h>
+#endif
 #include <cmath>        // for pow()
 #include "stack.src"
 #include "string.src"
@@ -41,12 +48,43 @@ typedef char * pchar;
 typedef hash_map<string,Item> dic_type;
 
 namespace {
+#if __cplusplus >= 201703L
+  typedef std::shared_mutex       shared_mutex_t;
+#elif __cplusplus >= 201402L
+  typedef std::shared_timed_mutex shared_mutex_t;
+#else
+  /// Reader/writer lock for C++11 builds, which have no std::shared_mutex
+  class shared_mutex_t  {
+    pthread_rwlock_t m_lock;
+  public:
+    shared_mutex_t()      { ::pthread_rwlock_init(&m_lock,0);  }
+    ~shared_mutex_t()     { ::pthread_rwlock_destroy(&m_lock); }
+    void lock()           { ::pthread_rwlock_wrlock(&m_lock);  }
+    void unlock()         { ::pthread_rwlock_unlock(&m_lock);  }
+    void lock_shared()    { ::pthread_rwlock_rdlock(&m_lock);  }
+    void unlock_shared()  { ::pthread_rwlock_unlock(&m_lock);  }
+  };
+#endif
+  /// Exclusive lock of the evaluator: modifications of the dictionary and of the evaluator state
+  typedef std::lock_guard<shared_mutex_t> write_lock_t;
+  /// Shared lock of the evaluator: concurrent dictionary lookups and evaluations
+  class read_lock_t  {
+    shared_mutex_t& m_lock;
+  public:
+    read_lock_t(shared_mutex_t& l) : m_lock(l) { m_lock.lock_shared();   }
+    ~read_lock_t()                             { m_lock.unlock_shared(); }
+  };
+
   struct Struct {
     dic_type theDictionary;
     pchar    theExpression;
     pchar    thePosition;
     int      theStatus;
     double   theResult;
+    /// Dictionary generation. Read without lock by the memoised XML attribute conversions
+    std::atomic<unsigned long> theGeneration;
+    /// Evaluations without side effects share the lock, modifications of the dictionary are exclusive
+    shared_mutex_t theLock;
   };
 
   union FCN {
@@ -110,7 +148,7 @@ static int variable(const string & name, double & result,
   dic_type::const_iterator iter = dictionary.find(name);
   if (iter == dictionary.end())
     return EVAL::ERROR_UNKNOWN_VARIABLE;
-  Item item = iter->second;
+  const Item& item = iter->second;
   switch (item.what) {
   case Item::VARIABLE:
     result = item.variable;
@@ -150,7 +188,7 @@ static int function(const string & name, stack<double> & par,
 
   dic_type::const_iterator iter = dictionary.find(sss[npar]+name);
   if (iter == dictionary.end()) return EVAL::ERROR_UNKNOWN_FUNCTION;
-  Item item = iter->second;
+  const Item& item = iter->second;
 
   double pp[MAX_N_PAR];
   for(int i=0; i<npar; i++) { pp[i] = par.top(); par.pop(); }
@@ -228,10 +266,9 @@ static int operand(pchar begin, pchar end, double & result,
     if (c != '_' && !isalnum(c)) break;
     pointer++;
   }
+  // No temporary termination: the text may belong to an expression of the shared dictionary
   c = *pointer;
-  *pointer = '\0';
-  string name(begin);
-  *pointer = c;
+  string name(begin, pointer-begin);
 
   //   G E T   V A R I A B L E
 
@@ -572,6 +609,8 @@ static void setItem(const char * prefix, const char * name,
 
   //   A D D   I T E M   T O   T H E   D I C T I O N A R Y
 
+  write_lock_t guard(s->theLock);
+  ++s->theGeneration;
   string item_name = prefix + string(pointer,n);
   dic_type::iterator iter = (s->theDictionary).find(item_name);
   if (iter != (s->theDictionary).end()) {
@@ -587,6 +626,40 @@ static void setItem(const char * prefix, const char * name,
   }
 }
 
+//---------------------------------------------------------------------------
+static void print_error_status(std::ostream& os, int status, const char* position) {
+  static const char prefix[] = "Evaluator : ";
+  const char* opt = (position ? position : "");
+  switch (status) {
+  case EVAL::ERROR_NOT_A_NAME:
+    os << prefix << "invalid name : " << opt << std::endl;
+    return;
+  case EVAL::ERROR_SYNTAX_ERROR:
+    os << prefix << "systax error"         << std::endl;
+    return;
+  case EVAL::ERROR_UNPAIRED_PARENTHESIS:
+    os << prefix << "unpaired parenthesis" << std::endl;
+    return;
+  case EVAL::ERROR_UNEXPECTED_SYMBOL:
+    os << prefix << "unexpected symbol : " << opt << std::endl;
+    return;
+  case EVAL::ERROR_UNKNOWN_VARIABLE:
+    os << prefix << "unknown variable : " << opt << std::endl;
+    return;
+  case EVAL::ERROR_UNKNOWN_FUNCTION:
+    os << prefix << "unknown function : " << opt << std::endl;
+    return;
+  case EVAL::ERROR_EMPTY_PARAMETER:
+    os << prefix << "empty parameter in function call: " << opt << std::endl;
+    return;
+  case EVAL::ERROR_CALCULATION_ERROR:
+    os << prefix << "calculation error"    << std::endl;
+    return;
+  default:
+    return;
+  }
+}
+
 //---------------------------------------------------------------------------
 namespace XmlTools {
 
@@ -598,6 +671,7 @@ namespace XmlTools {
     s->thePosition   = 0;
     s->theStatus     = OK;
     s->theResult     = 0.0;
+    s->theGeneration = 0;
   }
 
   //---------------------------------------------------------------------------
@@ -613,6 +687,7 @@ namespace XmlTools {
   //---------------------------------------------------------------------------
   double Evaluator::evaluate(const char * expression) {
     Struct * s = reinterpret_cast<Struct*>(p);
+    write_lock_t guard(s->theLock);
     if (s->theExpression != 0) { delete[] s->theExpression; }
     s->theExpression = 0;
     s->thePosition   = 0;
@@ -630,11 +705,34 @@ namespace XmlTools {
     return s->theResult;
   }
 
+  //---------------------------------------------------------------------------
+  std::pair<int,double> Evaluator::evaluate(const std::string& expression, std::ostream& os) const {
+    Struct * s = reinterpret_cast<Struct*>(p);
+    std::string buffer(expression);
+    pchar    begin    = &buffer[0];
+    pchar    position = 0;
+    double   result   = 0.0;
+    int      status   = EVAL::OK;
+    {
+      read_lock_t guard(s->theLock);
+      status = engine(begin, begin+buffer.length()-1, result, position, s->theDictionary);
+    }
+    if ( status != EVAL::OK )  {
+      print_error_status(os, status, position);
+    }
+    return std::make_pair(status, result);
+  }
+
   //---------------------------------------------------------------------------
   int Evaluator::status() const {
     return (reinterpret_cast<Struct*>(p))->theStatus;
   }
 
+  //---------------------------------------------------------------------------
+  unsigned long Evaluator::generation() const {
+    return (reinterpret_cast<Struct*>(p))->theGeneration;
+  }
+
   //---------------------------------------------------------------------------
   int Evaluator::error_position() const {
     return (reinterpret_cast<Struct*>(p))->thePosition - (reinterpret_cast<Struct*>(p))->theExpression;
@@ -642,37 +740,8 @@ namespace XmlTools {
 
   //---------------------------------------------------------------------------
   void Evaluator::print_error() const {
-    char prefix[] = "Evaluator : ";
     Struct * s = reinterpret_cast<Struct*>(p);
-    const char* opt = (s->thePosition ? s->thePosition : "");
-    switch (s->theStatus) {
-    case ERROR_NOT_A_NAME:
-      std::cerr << prefix << "invalid name : " << opt << std::endl;
-      return;
-    case ERROR_SYNTAX_ERROR:
-      std::cerr << prefix << "systax error"         << std::endl;
-      return;
-    case ERROR_UNPAIRED_PARENTHESIS:
-      std::cerr << prefix << "unpaired parenthesis" << std::endl;
-      return;
-    case ERROR_UNEXPECTED_SYMBOL:
-      std::cerr << prefix << "unexpected symbol : " << opt << std::endl;
-      return;
-    case ERROR_UNKNOWN_VARIABLE:
-      std::cerr << prefix << "unknown variable : " << opt << std::endl;
-      return;
-    case ERROR_UNKNOWN_FUNCTION:
-      std::cerr << prefix << "unknown function : " << opt << std::endl;
-      return;
-    case ERROR_EMPTY_PARAMETER:
-      std::cerr << prefix << "empty parameter in function call: " << opt << std::endl;
-      return;
-    case ERROR_CALCULATION_ERROR:
-      std::cerr << prefix << "calculation error"    << std::endl;
-      return;
-    default:
-      return;
-    }
+    print_error_status(std::cerr, s->theStatus, s->thePosition);
   }
 
   //---------------------------------------------------------------------------
@@ -680,12 +749,14 @@ namespace XmlTools {
     Struct* s = reinterpret_cast<Struct*>(p);
     string prefix = "${";
     string item_name = prefix + string(name) + string("}");
+    write_lock_t guard(s->theLock);
     dic_type::iterator iter = (s->theDictionary).find(item_name);
     Item item;
     item.what = Item::STRING;
     item.expression = value;
     item.function = 0;
     item.variable = 0;
+    ++s->theGeneration;
     //std::cout << " ++++++++++++++++++++++++++++ Saving env:" << name << " = " << value << std::endl;
     if (iter != (s->theDictionary).end()) {
       iter->second = item;
@@ -704,6 +775,7 @@ namespace XmlTools {
     Struct* s = reinterpret_cast<Struct*>(p);
     string item_name = name;
     //std::cout << " ++++++++++++++++++++++++++++ Try to resolve env:" << name << std::endl;
+    write_lock_t guard(s->theLock);
     dic_type::iterator iter = (s->theDictionary).find(item_name);
     if (iter != (s->theDictionary).end()) {
       s->theStatus = EVAL::OK;
@@ -766,6 +838,7 @@ namespace XmlTools {
     const char * pointer; int n; REMOVE_BLANKS;
     if (n == 0) return false;
     Struct * s = reinterpret_cast<Struct*>(p);
+    read_lock_t guard(s->theLock);
     return
       ((s->theDictionary).find(string(pointer,n)) == (s->theDictionary).end()) ?
       false : true;
@@ -778,6 +851,7 @@ namespace XmlTools {
     const char * pointer; int n; REMOVE_BLANKS;
     if (n == 0) return false;
     Struct * s = reinterpret_cast<Struct*>(p);
+    read_lock_t guard(s->theLock);
     return ((s->theDictionary).find(sss[npar]+string(pointer,n)) ==
             (s->theDictionary).end()) ? false : true;
   }
@@ -788,6 +862,8 @@ namespace XmlTools {
     const char * pointer; int n; REMOVE_BLANKS;
     if (n == 0) return;
     Struct * s = reinterpret_cast<Struct*>(p);
+    write_lock_t guard(s->theLock);
+    ++s->theGeneration;
     (s->theDictionary).erase(string(pointer,n));
   }
 
@@ -798,13 +874,17 @@ namespace XmlTools {
     const char * pointer; int n; REMOVE_BLANKS;
     if (n == 0) return;
     Struct * s = reinterpret_cast<Struct*>(p);
+    write_lock_t guard(s->theLock);
+    ++s->theGeneration;
     (s->theDictionary).erase(sss[npar]+string(pointer,n));
   }
 
   //---------------------------------------------------------------------------
   void Evaluator::clear() {
     Struct * s = reinterpret_cast<Struct*>(p);
+    write_lock_t guard(s->theLock);
     s->theDictionary.clear();
+    ++s->theGeneration;
     s->theExpression = 0;
     s->thePosition   = 0;
     s->theStatus     = OK;
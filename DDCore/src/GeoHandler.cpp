@@ -93,8 +93,7 @@ GeoHandler& GeoHandler::collect(DetElement element, GeometryInfo& info) {
         Material m(v->GetMedium());
         Volume vol = Ref_t(v);
         // Note : assemblies and the world do not have a real volume nor a material
-        if (info.volumeSet.find(vol) == info.volumeSet.end()) {
-          info.volumeSet.insert(vol);
+        if (info.volumeSet.insert(vol).second) {
           info.volumes.push_back(vol);
         }
         if (m.isValid())
@@ -126,17 +125,25 @@ GeoHandler& GeoHandler::i_collect(const TGeoNode* current, int level, Region rg,
   Region   region = vol.region();
   LimitSet limits = vol.limitSet();
 
+  bool changed = false;
+
   if ( m_propagateRegions )  {
     if ( !region.isValid() && rg.isValid() )   {
       region = rg;
       vol.setRegion(region);
+      changed = true;
     }
     if ( !limits.isValid() && ls.isValid() )  {
       limits = ls;
       vol.setLimitSet(limits);
+      changed = true;
     }
   }
-  (*m_data)[level].insert(current);
+  // The same node is reached once for every placement of its mother volume.
+  // Unless new settings were propagated, the daughters are already collected.
+  if ( !(*m_data)[level].insert(current).second && !changed )  {
+    return *this;
+  }
   //printf("GeoHandler: collect level:%d %s\n",level,current->GetName());
   if (num_children > 0) {
     for (int i = 0; i < num_children; ++i) {
@@ -17,6 +17,7 @@
 #include "XML/Evaluator.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <climits>
 #include <cstring>
 #include <cstdio>
@@ -37,6 +38,19 @@ using namespace std;
 using namespace DD4hep;
 using namespace DD4hep::Geometry;
 
+namespace {
+  /// Thread safe evaluation of an expression. Throws an exception on failure
+  double _evaluate(const string& s, const string& value)  {
+    stringstream err;
+    pair<int,double> result = eval.evaluate(s, err);
+    if (result.first != XmlTools::Evaluator::OK) {
+      cerr << value << ": " << err.str();
+      throw runtime_error("DD4hep: Severe error during expression evaluation of " + value);
+    }
+    return result.second;
+  }
+}
+
 short DD4hep::_toShort(const string& value) {
   string s(value);
   size_t idx = s.find("(int)");
@@ -44,12 +58,7 @@ short DD4hep::_toShort(const string& value) {
     s.erase(idx, 5);
   while (s[0] == ' ')
     s.erase(0, 1);
-  double result = eval.evaluate(s.c_str());
-  if (eval.status() != XmlTools::Evaluator::OK) {
-    cerr << value << ": ";
-    eval.print_error();
-    throw runtime_error("DD4hep: Severe error during expression evaluation of " + value);
-  }
+  double result = _evaluate(s, value);
   return (short) result;
 }
 
@@ -60,12 +69,7 @@ int DD4hep::_toInt(const string& value) {
     s.erase(idx, 5);
   while (s[0] == ' ')
     s.erase(0, 1);
-  double result = eval.evaluate(s.c_str());
-  if (eval.status() != XmlTools::Evaluator::OK) {
-    cerr << value << ": ";
-    eval.print_error();
-    throw runtime_error("DD4hep: Severe error during expression evaluation of " + value);
-  }
+  double result = _evaluate(s, value);
   return (int) result;
 }
 
@@ -76,12 +80,7 @@ long DD4hep::_toLong(const string& value) {
     s.erase(idx, 5);
   while (s[0] == ' ')
     s.erase(0, 1);
-  double result = eval.evaluate(s.c_str());
-  if (eval.status() != XmlTools::Evaluator::OK) {
-    cerr << value << ": ";
-    eval.print_error();
-    throw runtime_error("DD4hep: Severe error during expression evaluation of " + value);
-  }
+  double result = _evaluate(s, value);
   return (long) result;
 }
 
@@ -90,22 +89,12 @@ bool DD4hep::_toBool(const string& value) {
 }
 
 float DD4hep::_toFloat(const string& value) {
-  double result = eval.evaluate(value.c_str());
-  if (eval.status() != XmlTools::Evaluator::OK) {
-    cerr << value << ": ";
-    eval.print_error();
-    throw runtime_error("DD4hep: Severe error during expression evaluation of " + value);
-  }
+  double result = _evaluate(value, value);
   return (float) result;
 }
 
 double DD4hep::_toDouble(const string& value) {
-  double result = eval.evaluate(value.c_str());
-  if (eval.status() != XmlTools::Evaluator::OK) {
-    cerr << value << ": ";
-    eval.print_error();
-    throw runtime_error("DD4hep: Severe error during expression evaluation of " + value);
-  }
+  double result = _evaluate(value, value);
   return result;
 }
 
@@ -29,11 +29,9 @@ SensitiveDetector LCDDHelper::sensitiveDetector(DetElement detector) const    {
     if ( par.ptr() != ptr()->world().ptr() )  {
       PlacedVolume pv = par.placement();
       if ( pv.isValid() )   {
-        const PlacedVolume::VolIDs& ids = pv.volIDs();
-        for(PlacedVolume::VolIDs::const_iterator i=ids.begin(); i!=ids.end();++i)  {
-          if ( (*i).first == "system" )   {
-            return sensitiveDetector(par.name());
-          }
+        const PlacedVolume::Object::PackedVolIDs& ids = pv.packedVolIDs();
+        if ( ids.find("system") != ids.end() )   {
+          return sensitiveDetector(par.name());
         }
       }
     }
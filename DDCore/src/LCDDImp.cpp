@@ -17,6 +17,7 @@
 #include "DD4hep/GeoHandler.h"
 #include "DD4hep/LCDDHelper.h"
 #include "DD4hep/InstanceCount.h"
+#include "DD4hep/DetElementIndex.h"
 #include "DD4hep/objects/VolumeManagerInterna.h"
 #include "DD4hep/objects/DetectorInterna.h"
 #include "LCDDImp.h"
@@ -486,6 +487,12 @@ void LCDDImp::endDocument() {
     ShapePatcher patcher(m_volManager, m_world);
     patcher.patchShapes();
     mapDetectorTypes();
+    // Index all detector elements by path for fast lookup
+    WorldObject* w = dynamic_cast<WorldObject*>(m_world.ptr());
+    if ( w )  {
+      if ( !w->pathIndex ) w->pathIndex = new DetElementIndex();
+      w->pathIndex->build(m_world);
+    }
   }
 }
 
@@ -17,6 +17,7 @@
 #include "DD4hep/OpaqueData.h"
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/objects/OpaqueData_inl.h"
+#include "DD4hep/objects/ConditionsArena.h"
 
 // C/C++ header files
 #include <cstring>
@@ -75,7 +76,7 @@ OpaqueDataBlock::OpaqueDataBlock(const OpaqueDataBlock& c)
 OpaqueDataBlock::~OpaqueDataBlock()   {
   if ( destruct )  {
     (*destruct)(pointer);
-    if ( (type&ALLOC_DATA) == ALLOC_DATA ) ::operator delete(pointer);
+    if ( (type&ALLOC_DATA) == ALLOC_DATA ) Conditions::ConditionsArena::deallocate(pointer);
   }
   pointer = 0;
   grammar = 0;
@@ -105,7 +106,7 @@ OpaqueDataBlock& OpaqueDataBlock::operator=(const OpaqueDataBlock& c)   {
     if ( this->grammar == c.grammar )   {
       if ( destruct )  {
         (*destruct)(pointer);
-        if ( (type&ALLOC_DATA) == ALLOC_DATA ) ::operator delete(pointer);
+        if ( (type&ALLOC_DATA) == ALLOC_DATA ) Conditions::ConditionsArena::deallocate(pointer);
       }
       pointer = 0;
       grammar = 0;
@@ -133,7 +134,7 @@ bool OpaqueDataBlock::bind(const BasicGrammar* g, void (*ctor)(void*,const void*
     destruct = dtor;
     copy     = ctor;
     (len > sizeof(data))
-      ? (pointer=::operator new(len),type=ALLOC_DATA)
+      ? (pointer=Conditions::ConditionsArena::allocate(len),type=ALLOC_DATA)
       : (pointer=data,type=PLAIN_DATA);
     return true;
   }
@@ -146,6 +147,18 @@ bool OpaqueDataBlock::bind(const BasicGrammar* g, void (*ctor)(void*,const void*
   return false;
 }
 
+/// Bind data value using the object life cycle functions of the grammar (default constructed)
+void* OpaqueDataBlock::bind(const BasicGrammar* g)   {
+  if ( !g || !g->construct )  {
+    except("OpaqueData","Cannot bind opaque data without object constructor.");
+  }
+  else if ( this->bind(g, g->copy, g->destruct) )  {
+    (*g->construct)(pointer);
+    return pointer;
+  }
+  return 0;
+}
+
 /// Set data value
 void OpaqueDataBlock::assign(const void* ptr, const type_info& typ)  {
   if ( !grammar )   {
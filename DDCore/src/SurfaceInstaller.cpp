@@ -97,9 +97,8 @@ void SurfaceInstaller::install(DetElement component, PlacedVolume pv)   {
       PlacedVolume placed = *i;
       log << (void*)(placed->GetMatrix()) << " ";
       if ( placed->GetUserExtension() )  {
-        const PlacedVolume::VolIDs& vid = placed.volIDs();
-        for(PlacedVolume::VolIDs::const_iterator j=vid.begin(); j!=vid.end(); ++j)  {
-          log << (*j).first << ":" << (*j).second << " ";
+        for(const auto& j : placed.packedVolIDs())  {
+          log << PlacedVolume::Object::PackedVolIDs::name(j.name) << ":" << j.value << " ";
         }
       }
       log << " ";
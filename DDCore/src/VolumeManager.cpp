@@ -93,7 +93,8 @@ namespace DD4hep {
         size_t count = 0;
         if (node) {
           Volume vol = pv.volume();
-          const VolIDs& pv_ids   = pv.volIDs();
+          // Replicas derive one volume ID field from the copy index
+          VolIDs   pv_ids        = pv.physVolIDs();
           Encoding vol_encoding  = parent_encoding;
           bool     is_sensitive  = vol.isSensitive();
           bool     have_encoding = pv_ids.empty();
@@ -386,25 +387,26 @@ VolumeManager VolumeManager::addSubdetector(DetElement det, Readout ro) {
         throw runtime_error("DD4hep: VolumeManager::addSubdetector: Only subdetectors with a "
                             "valid placement are allowed. [Invalid DetElement:" + det_name + "]");
       }
-      VolIDs::Base::const_iterator vit = pv.volIDs().find("system");
-      if (vit == pv.volIDs().end()) {
+      const PlacedVolume::Object::PackedVolIDs& pv_ids = pv.packedVolIDs();
+      const PlacedVolume::Object::PackedVolIDs::Entry* vit = pv_ids.find("system");
+      if (vit == pv_ids.end()) {
         throw runtime_error("DD4hep: VolumeManager::addSubdetector: Only subdetectors with "
                             "valid placement VolIDs are allowed. [Invalid DetElement:" + det_name + "]");
       }
 
       i = o.subdetectors.insert(make_pair(det, VolumeManager(det,ro))).first;
-      const PlacedVolume::VolID& id = (*vit);
+      const string& id_name = PlacedVolume::Object::PackedVolIDs::name(vit->name);
       VolumeManager m = (*i).second;
-      IDDescriptor::Field field = ro.idSpec().field(id.first);
+      IDDescriptor::Field field = ro.idSpec().field(id_name);
       if (!field) {
         throw runtime_error("DD4hep: VolumeManager::addSubdetector: IdDescriptor of " + 
-                            string(det.name()) + " has no field " + id.first);
+                            string(det.name()) + " has no field " + id_name);
       }
       Object& mo = m._data();
       mo.top = o.top;
       mo.flags = o.flags;
       mo.system = field;
-      mo.sysID = id.second;
+      mo.sysID = vit->value;
       mo.detMask = mo.sysID;
       o.managers[mo.sysID] = m;
       det.callAtUpdate(DetElement::PLACEMENT_CHANGED|DetElement::PLACEMENT_DETECTOR,
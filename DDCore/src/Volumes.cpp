@@ -13,6 +13,7 @@
 
 // Framework include files
 #include "DD4hep/LCDD.h"
+#include "DD4hep/Mutex.h"
 #include "DD4hep/Printout.h"
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/MatrixHelpers.h"
@@ -21,6 +22,7 @@
 // ROOT include files
 #include "TColor.h"
 #include "TGeoShape.h"
+#include "TGeoTube.h"
 #include "TGeoVolume.h"
 #include "TGeoNode.h"
 #include "TGeoMatrix.h"
@@ -31,6 +33,7 @@
 
 // C/C++ include files
 #include <climits>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
@@ -304,22 +307,35 @@ static TGeoVolume* _createTGeoVolumeAssembly(const string& name)  {
 
 /// Default constructor
 PlacedVolumeExtension::PlacedVolumeExtension()
-  : TGeoExtension(), magic(0), refCount(0), volIDs() {
+  : TGeoExtension(), magic(0), refCount(0), volIDs(), params(0) {
   magic = magic_word();
   INCREMENT_COUNTER;
 }
 
 /// Copy constructor
 PlacedVolumeExtension::PlacedVolumeExtension(const PlacedVolumeExtension& c)
-  : TGeoExtension(), magic(c.magic), refCount(0), volIDs(c.volIDs) {
+  : TGeoExtension(), magic(c.magic), refCount(0), volIDs(c.volIDs), params(0) {
+  if ( c.params ) params = new Parameterisation(*c.params);
   INCREMENT_COUNTER;
 }
 
 /// Default destructor
 PlacedVolumeExtension::~PlacedVolumeExtension() {
+  deletePtr(params);
   DECREMENT_COUNTER;
 }
 
+/// Assignment operator
+PlacedVolumeExtension& PlacedVolumeExtension::operator=(const PlacedVolumeExtension& c) {
+  if ( this != &c )  {
+    magic = c.magic;
+    volIDs = c.volIDs;
+    deletePtr(params);
+    if ( c.params ) params = new Parameterisation(*c.params);
+  }
+  return *this;
+}
+
 /// TGeoExtension overload: Method called whenever requiring a pointer to the extension
 TGeoExtension* PlacedVolumeExtension::Grab()   {
   ++this->refCount;
@@ -371,6 +387,177 @@ string PlacedVolumeExtension::VolIDs::str()  const   {
   return str.str();
 }
 
+namespace {
+  /// Process wide table of interned volume ID field names
+  /**
+   *  Names are stored in blocks, which are never relocated. Hence references
+   *  to interned names stay valid and lookups by index need no locking.
+   */
+  class VolIDNameTable  {
+    enum { BLOCK_SIZE = 256, MAX_BLOCKS = 1024 };
+    DD4hep::dd4hep_mutex_t       m_lock;
+    map<string, unsigned int>    m_index;
+    string*                      m_blocks[MAX_BLOCKS];
+    unsigned int                 m_count;
+  public:
+    VolIDNameTable() : m_count(0)  {
+      ::memset(m_blocks, 0, sizeof(m_blocks));
+    }
+    ~VolIDNameTable()  {
+      for(size_t i=0; i<MAX_BLOCKS; ++i) delete [] m_blocks[i];
+    }
+    unsigned int intern(const string& nam)  {
+      DD4hep::dd4hep_lock_t lock(m_lock);
+      map<string, unsigned int>::const_iterator i = m_index.find(nam);
+      if ( i != m_index.end() ) return (*i).second;
+      if ( m_count >= BLOCK_SIZE*MAX_BLOCKS )  {
+        DD4hep::except("PackedVolIDs","+++ Too many different volume ID field names [%d].",int(m_count));
+      }
+      string*& block = m_blocks[m_count/BLOCK_SIZE];
+      if ( !block ) block = new string[BLOCK_SIZE];
+      block[m_count%BLOCK_SIZE] = nam;
+      m_index.insert(make_pair(nam, m_count));
+      return m_count++;
+    }
+    const string& name(unsigned int index)  const  {
+      return m_blocks[index/BLOCK_SIZE][index%BLOCK_SIZE];
+    }
+    size_t size()  const  {
+      return m_count;
+    }
+    size_t bytes()  const  {
+      size_t len = sizeof(*this);
+      for(const auto& i : m_index)
+        len += 2*(i.first.capacity()+1) + 4*sizeof(void*);
+      for(size_t i=0; i<MAX_BLOCKS && m_blocks[i]; ++i)
+        len += BLOCK_SIZE*sizeof(string);
+      return len;
+    }
+    static VolIDNameTable& instance()  {
+      static VolIDNameTable table;
+      return table;
+    }
+  };
+}
+
+/// Copy constructor
+PlacedVolumeExtension::PackedVolIDs::PackedVolIDs(const PackedVolIDs& c)
+  : m_size(0), m_heap(0), m_unpacked(0)
+{
+  *this = c;
+}
+
+/// Default destructor
+PlacedVolumeExtension::PackedVolIDs::~PackedVolIDs()  {
+  if ( m_heap ) delete [] m_heap;
+  delete m_unpacked.load();
+}
+
+/// Assignment operator
+PlacedVolumeExtension::PackedVolIDs&
+PlacedVolumeExtension::PackedVolIDs::operator=(const PackedVolIDs& c)  {
+  if ( this != &c )  {
+    if ( m_heap ) delete [] m_heap;
+    m_heap = 0;
+    m_size = c.m_size;
+    if ( m_size > INLINE ) m_heap = new Entry[m_size];
+    ::memcpy(m_heap ? m_heap : m_local, c.begin(), m_size*sizeof(Entry));
+    // Refresh in place: references handed out by unpacked() stay valid
+    VolIDs* ids = m_unpacked.load();
+    if ( ids )  {
+      ids->clear();
+      unpack(*ids);
+    }
+  }
+  return *this;
+}
+
+/// Heap memory used in addition to the object itself
+size_t PlacedVolumeExtension::PackedVolIDs::heapBytes()  const  {
+  size_t len = m_heap ? m_size*sizeof(Entry) : 0;
+  const VolIDs* ids = m_unpacked.load();
+  if ( ids )
+    len += sizeof(VolIDs) + ids->capacity()*sizeof(VolID);
+  return len;
+}
+
+/// Find entry by field name. Returns end() if not present
+const PlacedVolumeExtension::PackedVolIDs::Entry*
+PlacedVolumeExtension::PackedVolIDs::find(const string& nam)  const  {
+  const VolIDNameTable& table = VolIDNameTable::instance();
+  for(const Entry* e = begin(); e != end(); ++e)
+    if ( table.name(e->name) == nam ) return e;
+  return end();
+}
+
+/// Add new identifier
+void PlacedVolumeExtension::PackedVolIDs::push_back(const string& nam, int value)  {
+  Entry entry = { intern(nam), value };
+  VolIDs* ids = m_unpacked.load();
+  if ( m_size < INLINE && !m_heap )  {
+    m_local[m_size++] = entry;
+  }
+  else  {
+    // Exactly sized heap block: placements typically get all identifiers once
+    Entry* data = new Entry[m_size+1];
+    ::memcpy(data, begin(), m_size*sizeof(Entry));
+    data[m_size++] = entry;
+    if ( m_heap ) delete [] m_heap;
+    m_heap = data;
+  }
+  if ( ids ) ids->push_back(VolID(nam, value));
+}
+
+/// Replace all identifiers
+void PlacedVolumeExtension::PackedVolIDs::assign(const VolIDs& ids)  {
+  PackedVolIDs tmp;
+  for(const auto& i : ids) tmp.push_back(i.first, i.second);
+  *this = tmp;
+}
+
+/// Append the identifiers to a VolIDs container
+void PlacedVolumeExtension::PackedVolIDs::unpack(VolIDs& ids)  const  {
+  const VolIDNameTable& table = VolIDNameTable::instance();
+  ids.reserve(ids.size()+m_size);
+  for(const Entry* e = begin(); e != end(); ++e)
+    ids.push_back(VolID(table.name(e->name), e->value));
+}
+
+/// Access the unpacked identifiers. The container lives as long as this object
+const PlacedVolumeExtension::VolIDs& PlacedVolumeExtension::PackedVolIDs::unpacked()  const  {
+  VolIDs* ids = m_unpacked.load(std::memory_order_acquire);
+  if ( !ids )  {
+    VolIDs* created = new VolIDs();
+    unpack(*created);
+    // Concurrent first readers: the first published container wins, the others are dropped
+    if ( m_unpacked.compare_exchange_strong(ids, created, std::memory_order_acq_rel) )
+      ids = created;
+    else
+      delete created;
+  }
+  return *ids;
+}
+
+/// Intern field name. Returns the index of the name in the name table
+unsigned int PlacedVolumeExtension::PackedVolIDs::intern(const string& nam)  {
+  return VolIDNameTable::instance().intern(nam);
+}
+
+/// Access interned field name by index
+const string& PlacedVolumeExtension::PackedVolIDs::name(unsigned int index)  {
+  return VolIDNameTable::instance().name(index);
+}
+
+/// Number of interned field names
+size_t PlacedVolumeExtension::PackedVolIDs::numNames()  {
+  return VolIDNameTable::instance().size();
+}
+
+/// Memory used by the name table
+size_t PlacedVolumeExtension::PackedVolIDs::nameTableBytes()  {
+  return VolIDNameTable::instance().bytes();
+}
+
 static PlacedVolume::Object* _data(const PlacedVolume& v) {
   PlacedVolume::Object* o = _userExtension(v);
   if (o)
@@ -387,7 +574,7 @@ PlacedVolume::Object* PlacedVolume::data() const   {
 /// Add identifier
 PlacedVolume& PlacedVolume::addPhysVolID(const string& nam, int value) {
   Object* obj = _data(*this);
-  obj->volIDs.push_back(VolID(nam, value));
+  obj->volIDs.push_back(nam, value);
   return *this;
 }
 
@@ -408,17 +595,58 @@ Volume PlacedVolume::motherVol() const {
 
 /// Access to the volume IDs
 const PlacedVolume::VolIDs& PlacedVolume::volIDs() const {
+  return _data(*this)->volIDs.unpacked();
+}
+
+/// Access to the packed volume IDs without unpacking
+const PlacedVolume::Object::PackedVolIDs& PlacedVolume::packedVolIDs() const {
   return _data(*this)->volIDs;
 }
 
+/// Check if the placement is one copy of a replicated placement
+bool PlacedVolume::isReplicated() const {
+  Object* obj = data();
+  return obj && obj->params;
+}
+
+/// Access to the replication parameters. Returns 0 for normal placements
+const PlacedVolume::Parameterisation* PlacedVolume::params() const {
+  Object* obj = data();
+  return obj ? obj->params : 0;
+}
+
+/// Copy index [0,count) of a replicated placement. Returns -1 for normal placements
+int PlacedVolume::copyIndex() const {
+  const Parameterisation* p = params();
+  if ( p )  {
+    // ROOT numbers divisions starting from 1
+    return p->type == Parameterisation::DIVISION ? m_element->GetNumber()-1 : m_element->GetNumber();
+  }
+  return -1;
+}
+
+/// Access to the volume IDs including the field derived from the copy index of replicas
+PlacedVolume::VolIDs PlacedVolume::physVolIDs() const {
+  Object* obj = _data(*this);
+  VolIDs ids;
+  obj->volIDs.unpack(ids);
+  if ( obj->params && !obj->params->field.empty() )  {
+    ids.push_back(VolID(obj->params->field, copyIndex()));
+  }
+  return ids;
+}
+
 /// String dump
 string PlacedVolume::toString() const {
   stringstream s;
   Object* obj = _data(*this);
+  VolIDs  ids = physVolIDs();
   s << m_element->GetName() << ":  vol='" << m_element->GetVolume()->GetName() << "' mat:'" << m_element->GetMatrix()->GetName()
-    << "' volID[" << obj->volIDs.size() << "] ";
-  for (VolIDs::const_iterator i = obj->volIDs.begin(); i != obj->volIDs.end(); ++i)
+    << "' volID[" << ids.size() << "] ";
+  for (VolIDs::const_iterator i = ids.begin(); i != ids.end(); ++i)
     s << (*i).first << "=" << (*i).second << "  ";
+  if ( obj->params )
+    s << "copy " << copyIndex() << " of " << obj->params->count << "  ";
   s << ends;
   return s.str();
 }
@@ -505,6 +733,10 @@ static PlacedVolume _addNode(TGeoVolume* par, TGeoVolume* daughter, TGeoMatrix*
   TGeoVolume* parent = par;
   TObjArray* a = parent->GetNodes();
   Int_t id = a ? a->GetEntries() : 0;
+  if ( id > 0 && PlacedVolume(parent->GetNode(0)).isReplicated() )  {
+    DD4hep::except("Volume","+++ Cannot place %s into volume %s, which contains replicas.",
+                   daughter->GetName(), parent->GetName());
+  }
   if (transform && transform != identityTransform()) {
     string nam = string(daughter->GetName()) + "_placement";
     transform->SetName(nam.c_str());
@@ -551,6 +783,164 @@ PlacedVolume Volume::placeVolume(const Volume& volume, const Rotation3D& rot) co
   return _addNode(m_element, volume, _rotation3D(rot));
 }
 
+namespace {
+  /// Attach the shared placement extension to all copies of a replicated placement
+  void _setReplicaExtension(TGeoVolume* mother, PlacedVolume::Object* ext)  {
+#ifdef DD4HEP_EMULATE_TGEOEXTENSIONS
+    delete ext;
+    DD4hep::except("Volume","+++ Replicated placements in %s require TGeoExtension support.",mother->GetName());
+#else
+    // Cell volumes of divisions are created by ROOT: they must be instrumented
+    TGeoVolume* cell = mother->GetNode(0)->GetVolume();
+    if ( !cell->GetUserExtension() )  {
+      cell->SetUserExtension(new Volume::Object());
+    }
+    for(Int_t i=0, n=mother->GetNdaughters(); i<n; ++i)
+      mother->GetNode(i)->SetUserExtension(ext);
+#endif
+  }
+
+  /// Check preconditions of replicated placements
+  void _checkReplicaMother(TGeoVolume* mother, const char* tag)  {
+    if ( !mother )  {
+      DD4hep::except("Volume","+++ %s: Invalid handle to mother volume.",tag);
+    }
+#ifdef DD4HEP_EMULATE_TGEOEXTENSIONS
+    DD4hep::except("Volume","+++ %s: Replicated placements require TGeoExtension support.",tag);
+#endif
+    if ( mother->IsAssembly() )  {
+      DD4hep::except("Volume","+++ %s: Assembly %s cannot be replicated into.",tag,mother->GetName());
+    }
+    if ( mother->GetNdaughters() > 0 )  {
+      DD4hep::except("Volume","+++ %s: Volume %s already has daughters. Replicas must be the only daughters.",
+                     tag,mother->GetName());
+    }
+  }
+
+  /// Map replication axis to the axis index of the ROOT shape. Returns the axis range in 'lo', 'hi'.
+  int _divisionAxis(TGeoVolume* mother, Volume::ReplicationAxis axis, double& lo, double& hi)  {
+    TGeoShape* sh = mother->GetShape();
+    TClass*    cl = sh ? sh->IsA() : 0;
+    int iaxis = 0;
+    if ( cl == TGeoBBox::Class() )  {
+      if      ( axis == Volume::X_axis ) iaxis = 1;
+      else if ( axis == Volume::Y_axis ) iaxis = 2;
+      else if ( axis == Volume::Z_axis ) iaxis = 3;
+    }
+    else if ( cl == TGeoTube::Class() || cl == TGeoTubeSeg::Class() )  {
+      if      ( axis == Volume::Rho_axis ) iaxis = 1;
+      else if ( axis == Volume::Phi_axis ) iaxis = 2;
+      else if ( axis == Volume::Z_axis )   iaxis = 3;
+    }
+    if ( 0 == iaxis )  {
+      DD4hep::except("Volume","+++ divide: Shape %s of volume %s cannot be divided along axis %d.",
+                     sh ? sh->IsA()->GetName() : "<unknown>", mother->GetName(), int(axis));
+    }
+    sh->GetAxisRange(iaxis, lo, hi);
+    if ( axis == Volume::Phi_axis )  {
+      lo *= DEGREE_2_RAD;
+      hi *= DEGREE_2_RAD;
+    }
+    return iaxis;
+  }
+}
+
+/// Divide the volume into 'count' replicas of equal width starting at 'offset' along the given axis
+PlacedVolume Volume::divide(const string& nam, ReplicationAxis axis, int count,
+                            double offset, double width, const string& field) const
+{
+  TGeoVolume* mother = m_element;
+  double lo = 0e0, hi = 0e0;
+  _checkReplicaMother(mother, "divide");
+  int iaxis = _divisionAxis(mother, axis, lo, hi);
+  if ( count <= 0 || width <= 0e0 )  {
+    except("Volume","+++ divide: Invalid division of %s: %d copies of width %g.",
+           mother->GetName(), count, width);
+  }
+  double start = offset, step = width;
+  if ( axis == Phi_axis )  {
+    start *= RAD_2_DEGREE;
+    step  *= RAD_2_DEGREE;
+  }
+  mother->Divide(nam.c_str(), iaxis, count, start, step);
+  if ( mother->GetNdaughters() != count )  {
+    except("Volume","+++ divide: Failed to divide %s into %d copies along axis %d.",
+           mother->GetName(), count, int(axis));
+  }
+  // All copies share one placement extension
+  PlacedVolume::Object* ext = new PlacedVolume::Object();
+  ext->params = new PlacedVolume::Parameterisation();
+  ext->params->type   = PlacedVolume::Parameterisation::DIVISION;
+  ext->params->axis   = axis;
+  ext->params->count  = count;
+  ext->params->offset = offset;
+  ext->params->width  = width;
+  ext->params->field  = field;
+  _setReplicaExtension(mother, ext);
+  printout(DEBUG,"Volume","+++ Divided %s into %d copies along axis %d [%g,%g] of width %g.",
+           mother->GetName(), count, int(axis), lo, hi, width);
+  return PlacedVolume(mother->GetNode(0));
+}
+
+/// Divide the full extent of the volume into 'count' replicas along the given axis
+PlacedVolume Volume::divide(const string& nam, ReplicationAxis axis, int count, const string& field) const {
+  double lo = 0e0, hi = 0e0;
+  _checkReplicaMother(m_element, "divide");
+  _divisionAxis(m_element, axis, lo, hi);
+  if ( count <= 0 )  {
+    except("Volume","+++ divide: Invalid number of divisions of %s: %d.",m_element->GetName(),count);
+  }
+  return divide(nam, axis, count, lo, (hi-lo)/double(count), field);
+}
+
+/// Place 'count' copies of a volume. Consecutive copies are translated by 'delta'
+PlacedVolume Volume::paramVolume1D(const Volume& entity, int count, const Transform3D& start,
+                                   const Position& delta, const string& field) const
+{
+  TGeoVolume* mother = m_element;
+  _checkReplicaMother(mother, "paramVolume1D");
+  if ( !entity.isValid() || entity->IsAssembly() )  {
+    except("Volume","+++ paramVolume1D: Invalid volume to be placed into %s [Assemblies are not supported].",
+           mother->GetName());
+  }
+  else if ( count <= 0 )  {
+    except("Volume","+++ paramVolume1D: Invalid number of copies for %s: %d.",mother->GetName(),count);
+  }
+  PlacedVolume::Object* ext = new PlacedVolume::Object();
+  ext->params = new PlacedVolume::Parameterisation();
+  ext->params->type  = PlacedVolume::Parameterisation::PARAMETERISED;
+  ext->params->count = count;
+  ext->params->delta = delta;
+  ext->params->field = field;
+  start.GetDecomposition(ext->params->rotation, ext->params->start);
+
+  // Lightweight placements: translations only, all copies share the same rotation
+  TGeoRotation* rot = 0;
+  if ( ext->params->rotation != Rotation3D() )  {
+    TGeoHMatrix* m = _transform(Transform3D(ext->params->rotation));
+    rot = new TGeoRotation(string(entity.name())+"_rotation");
+    rot->SetMatrix(m->GetRotationMatrix());
+    rot->RegisterYourself();
+    delete m;
+  }
+  for(int i=0; i<count; ++i)  {
+    Position    pos = ext->params->start + double(i)*delta;
+    TGeoMatrix* tr  = rot
+      ? (TGeoMatrix*)new TGeoCombiTrans(pos.X(), pos.Y(), pos.Z(), rot)
+      : (TGeoMatrix*)new TGeoTranslation(pos.X(), pos.Y(), pos.Z());
+    mother->AddNode(entity.ptr(), i, tr);
+  }
+  _setReplicaExtension(mother, ext);
+  return PlacedVolume(mother->GetNode(0));
+}
+
+/// Place 'count' un-rotated copies of a volume. Consecutive copies are translated by 'delta'
+PlacedVolume Volume::paramVolume1D(const Volume& entity, int count, const Position& start,
+                                   const Position& delta, const string& field) const
+{
+  return paramVolume1D(entity, count, Transform3D(start), delta, field);
+}
+
 /// Set the volume's material
 const Volume& Volume::setMaterial(const Material& m) const {
   if (m.isValid()) {
@@ -158,7 +158,13 @@ namespace DD4hep {
         /// Entity resolver overload to use uri reader
         InputSource *read_uri(XMLResourceIdentifier *id)   {
           if ( m_reader )   {
+            const char* view = 0;
+            size_t      view_len = 0;
             string buf, systemID(_toString(id->getSystemId()));
+            if ( m_reader->loadView(systemID, view, view_len) )  {
+              // Data are owned by the reader: no copy, no adoption
+              return new MemBufInputSource((const XMLByte*)view,view_len,systemID.c_str(),false);
+            }
             if ( m_reader->load(systemID, buf) )  {
               const XMLByte* input = (const XMLByte*)XMLString::replicate(buf.c_str());
 #if 0
@@ -289,6 +295,11 @@ Document DocumentHandler::load(Handle_t base, const XMLCh* fname, UriReader* rea
     }
     sys = dir + "/" + fn;
 #endif
+    const char* view = 0;
+    size_t      view_len = 0;
+    if ( reader->loadView(sys, view, view_len) )  {
+      return parse(view, view_len, sys.c_str(), reader);
+    }
     if ( reader->load(sys, buf) )  {
 #if 0
       Document doc = parse(buf.c_str(), buf.length(), sys.c_str(), reader);
@@ -323,6 +334,13 @@ Document DocumentHandler::load(const string& fname, UriReader* reader) const   {
       if ( reader ) reader->parserLoaded(path);
     }
     else   {
+      const char* view = 0;
+      size_t      view_len = 0;
+      if ( reader && reader->loadView(fname, view, view_len) )  {
+        MemBufInputSource src((const XMLByte*)view, view_len, fname.c_str(), false);
+        parser->parse(src);
+        return (XmlDocument*)parser->adoptDocument();
+      }
       if ( reader && reader->load(fname, path) )  {
         MemBufInputSource src((const XMLByte*)path.c_str(), path.length(), fname.c_str(), false);
         parser->parse(src);
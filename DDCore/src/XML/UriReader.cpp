@@ -23,6 +23,20 @@ bool DD4hep::XML::UriReader::load(const std::string& system_id, std::string& dat
   return this->load(system_id, context(), data);
 }
 
+/// Resolve a given URI to a read-only view of the data without copying
+bool DD4hep::XML::UriReader::loadView(const std::string& system_id, const char*& data, size_t& length)   {
+  return this->loadView(system_id, context(), data, length);
+}
+
+/// Resolve a given URI to a read-only view of the data without copying (with context)
+bool DD4hep::XML::UriReader::loadView(const std::string& /* system_id */,
+                                      UserContext*       /* context   */,
+                                      const char*&       /* data      */,
+                                      size_t&            /* length    */)
+{
+  return false;
+}
+
 /// Inform reader about a locally (e.g. by XercesC) handled source load
 void DD4hep::XML::UriReader::parserLoaded(const std::string& system_id)  {
   this->parserLoaded(system_id, context());
@@ -54,6 +68,17 @@ bool DD4hep::XML::UriContextReader::load(const std::string& system_id, UserConte
   return m_reader->load(system_id, ctxt, data);
 }
 
+/// Resolve a given URI to a read-only view of the data without copying
+bool DD4hep::XML::UriContextReader::loadView(const std::string& system_id, const char*& data, size_t& length)   {
+  return m_reader->loadView(system_id, context(), data, length);
+}
+
+/// Resolve a given URI to a read-only view of the data without copying (with context)
+bool DD4hep::XML::UriContextReader::loadView(const std::string& system_id, UserContext* ctxt,
+                                             const char*& data, size_t& length)   {
+  return m_reader->loadView(system_id, ctxt, data, length);
+}
+
 /// Inform reader about a locally (e.g. by XercesC) handled source load
 void DD4hep::XML::UriContextReader::parserLoaded(const std::string& system_id)  {
   m_reader->parserLoaded(system_id, context());
@@ -21,7 +21,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstdio>
+#include <cerrno>
 #include <map>
+#include <atomic>
+#include <sstream>
+#include <unordered_map>
 
 using namespace std;
 using namespace DD4hep::XML;
@@ -38,6 +42,85 @@ namespace {
     string r = getEnviron(env);
     return r.empty() ? env : r;
   }
+
+  /// Memoised results of the expression evaluator
+  /** The cache is flushed whenever the evaluator dictionary changes.  */
+  struct EvalCache  {
+    /// Maximal number of cached expressions before the cache is flushed
+    enum { MAX_ENTRIES = 100000 };
+    /// Evaluator dictionary generation the cached results belong to
+    unsigned long generation = ~0UL;
+    /// Cached results by expression
+    unordered_map<string,double> values;
+  };
+  /// Flag to enable/disable the fast path of the attribute conversions (read by all threads)
+  std::atomic<bool> s_fastConversions(true);
+  /// Per-thread conversion statistics
+  thread_local ConversionStatistics s_statistics;
+  /// Per-thread memoised evaluator results
+  thread_local EvalCache s_evalCache;
+
+  /// Convert plain numeric literals like "1", "-2.5" or "1e-3" without the evaluator
+  bool _numericLiteral(const char* s, double& result)  {
+    const char* p = s;
+    while ( *p == ' ' ) ++p;
+    const char* start = p;
+    if ( *p == '+' || *p == '-' ) ++p;
+    bool digits = false;
+    while ( *p >= '0' && *p <= '9' ) { ++p; digits = true; }
+    if ( *p == '.' )  {
+      ++p;
+      while ( *p >= '0' && *p <= '9' ) { ++p; digits = true; }
+    }
+    if ( !digits ) return false;
+    if ( *p == 'e' || *p == 'E' )  {
+      ++p;
+      if ( *p == '+' || *p == '-' ) ++p;
+      if ( !(*p >= '0' && *p <= '9') ) return false;
+      while ( *p >= '0' && *p <= '9' ) ++p;
+    }
+    const char* last = p;
+    while ( *p == ' ' ) ++p;
+    if ( *p != 0 ) return false;
+    char* end = 0;
+    errno = 0;
+    result = ::strtod(start, &end);
+    return errno == 0 && end == last;
+  }
+
+  /// Evaluate an expression. Literals and repeated expressions bypass the evaluator
+  double _evaluate(const string& s)  {
+    EvalCache& cache = s_evalCache;
+    bool fast = s_fastConversions;
+    if ( fast )  {
+      double result = 0e0;
+      if ( _numericLiteral(s.c_str(), result) )  {
+        ++s_statistics.literals;
+        return result;
+      }
+      unsigned long generation = eval.generation();
+      if ( cache.generation != generation || cache.values.size() >= EvalCache::MAX_ENTRIES )  {
+        cache.values.clear();
+        cache.generation = generation;
+      }
+      auto i = cache.values.find(s);
+      if ( i != cache.values.end() )  {
+        ++s_statistics.memoised;
+        return (*i).second;
+      }
+    }
+    stringstream err;
+    pair<int,double> result = eval.evaluate(s, err);
+    if (result.first != XmlTools::Evaluator::OK) {
+      cerr << s << ": " << err.str();
+      throw runtime_error("DD4hep: Severe error during expression evaluation of " + s);
+    }
+    ++s_statistics.evaluated;
+    if ( fast && cache.generation == eval.generation() )  {
+      cache.values.emplace(s, result.second);
+    }
+    return result.second;
+  }
 }
 
 // Shortcuts
@@ -155,8 +238,7 @@ namespace {
       if ( ee )  {
         for(xercesc::DOMElement* elt=ee->getFirstElementChild(); elt; elt=elt->getNextElementSibling()) {
           if ( elt->getParentNode() == ee )   {
-            string child_tag = _toString(elt->getTagName());
-            if ( tag == "*" || child_tag == tag ) ++cnt;
+            if ( tag == "*" || xercesc::XMLString::equals(elt->getTagName(),(const XMLCh*)t.ptr()) ) ++cnt;
           }
         }
       }
@@ -171,8 +253,7 @@ namespace {
         for(xercesc::DOMElement* elt=ee->getFirstElementChild(); elt; elt=elt->getNextElementSibling()) {
           if ( elt->getParentNode() == ee )   {
             if ( tag == "*" ) return _XE(elt);
-            string child_tag = _toString(elt->getTagName());
-            if ( child_tag == tag ) return _XE(elt);
+            if ( xercesc::XMLString::equals(elt->getTagName(),(const XMLCh*)t.ptr()) ) return _XE(elt);
           }
         }
       }
@@ -181,11 +262,32 @@ namespace {
   }
 }
 
+/// Cached unicode representation of an attribute name. NULL if the fast path is disabled
+const XmlChar* DD4hep::XML::_toXmlTag(const char* name)   {
+  // Transcoded names are owned by the calling thread and never released
+  static thread_local unordered_map<string,Strng_t> s_tags;
+  if ( !s_fastConversions || !name ) return 0;
+  auto i = s_tags.find(name);
+  if ( i == s_tags.end() )  {
+    i = s_tags.emplace(name, Strng_t(name)).first;
+  }
+  return (*i).second.ptr();
+}
+
 /// Convert XML char to std::string
 string DD4hep::XML::_toString(const XmlChar *toTranscode) {
-  char *buff = XmlString::transcode(toTranscode);
-  string tmp(buff == 0 ? "" : buff);
-  XmlString::release(&buff);
+  string tmp;
+  const XmlChar* p = toTranscode;
+  if ( s_fastConversions && p )  {
+    // Plain ASCII strings need no transcoding
+    while ( *p && *p < 0x80 ) ++p;
+    if ( *p == 0 ) tmp.assign(toTranscode, p);
+  }
+  if ( !p || *p != 0 )  {
+    char *buff = XmlString::transcode(toTranscode);
+    tmp = buff == 0 ? "" : buff;
+    XmlString::release(&buff);
+  }
   if ( tmp.length()<3 ) return tmp;
   if ( !(tmp[0] == '$' && tmp[1] == '{') ) return tmp;
   tmp = _checkEnviron(tmp);
@@ -287,12 +389,7 @@ long DD4hep::XML::_toLong(const XmlChar* value) {
       s.erase(idx, 6);
     while (s[0] == ' ')
       s.erase(0, 1);
-    double result = eval.evaluate(s.c_str());
-    if (eval.status() != XmlTools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
-      throw runtime_error("DD4hep: Severe error during expression evaluation of " + s);
-    }
+    double result = _evaluate(s);
     return (long) result;
   }
   return -1;
@@ -306,12 +403,7 @@ int DD4hep::XML::_toInt(const XmlChar* value) {
       s.erase(idx, 5);
     while (s[0] == ' ')
       s.erase(0, 1);
-    double result = eval.evaluate(s.c_str());
-    if (eval.status() != XmlTools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
-      throw runtime_error("DD4hep: Severe error during expression evaluation of " + s);
-    }
+    double result = _evaluate(s);
     return (int) result;
   }
   return -1;
@@ -328,13 +420,7 @@ bool DD4hep::XML::_toBool(const XmlChar* value) {
 float DD4hep::XML::_toFloat(const XmlChar* value) {
   if (value) {
     string s = _toString(value);
-    double result = eval.evaluate(s.c_str());
-
-    if (eval.status() != XmlTools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
-      throw runtime_error("DD4hep: Severe error during expression evaluation of " + s);
-    }
+    double result = _evaluate(s);
     return (float) result;
   }
   return 0.0;
@@ -343,12 +429,7 @@ float DD4hep::XML::_toFloat(const XmlChar* value) {
 double DD4hep::XML::_toDouble(const XmlChar* value) {
   if (value) {
     string s = _toString(value);
-    double result = eval.evaluate(s.c_str());
-    if (eval.status() != XmlTools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
-      throw runtime_error("DD4hep: Severe error during expression evaluation of " + s);
-    }
+    double result = _evaluate(s);
     return result;
   }
   return 0.0;
@@ -424,6 +505,16 @@ string DD4hep::XML::getEnviron(const string& env)   {
   }
 }
 
+/// Enable/disable the fast path of attribute conversions. Returns the previous setting
+bool DD4hep::XML::enableFastConversions(bool value)   {
+  return s_fastConversions.exchange(value);
+}
+
+/// Access the numeric conversion statistics of the calling thread
+ConversionStatistics& DD4hep::XML::conversionStatistics()   {
+  return s_statistics;
+}
+
 template <typename B>
 static inline string i_add(const string& a, B b) {
   string r = a;
@@ -606,8 +697,7 @@ XmlElement* NodeList::next() const {
   xercesc::DOMElement *elt = Xml(m_ptr).e;
   for(elt=elt->getNextElementSibling(); elt; elt=elt->getNextElementSibling()) {
     if ( m_tag.str() == "*" ) return m_ptr=Xml(elt).xe;
-    string child_tag = _toString(elt->getTagName());
-    if ( child_tag == m_tag ) return m_ptr=Xml(elt).xe;
+    if ( xercesc::XMLString::equals(elt->getTagName(),(const XMLCh*)m_tag.ptr()) ) return m_ptr=Xml(elt).xe;
   }
   return m_ptr=0;
 #endif
@@ -623,8 +713,7 @@ XmlElement* NodeList::previous() const {
   xercesc::DOMElement *elt = Xml(m_ptr).e;
   for(elt=elt->getPreviousElementSibling(); elt; elt=elt->getPreviousElementSibling()) {
     if ( m_tag.str()=="*" ) return m_ptr=Xml(elt).xe;
-    string child_tag = _toString(elt->getTagName());
-    if ( child_tag == m_tag ) return m_ptr=Xml(elt).xe;
+    if ( xercesc::XMLString::equals(elt->getTagName(),(const XMLCh*)m_tag.ptr()) ) return m_ptr=Xml(elt).xe;
   }
   return m_ptr=0;
 #endif
@@ -107,7 +107,8 @@ void GeometryWalk::walk(DetElement e, VolIDs ids)  const   {
   PlacedVolume pv = e.placement();
   VolIDs child_ids(ids);
   print(e,pv,ids);
-  child_ids.insert(child_ids.end(),pv.volIDs().begin(),pv.volIDs().end());
+  for (const auto& id : pv.packedVolIDs())
+    child_ids.push_back(PlacedVolume::VolID(PlacedVolume::Object::PackedVolIDs::name(id.name),id.value));
   for (_C::const_iterator i=children.begin(); i!=children.end(); ++i)  {
     walk((*i).second,child_ids);
   }
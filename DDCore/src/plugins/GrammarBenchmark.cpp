@@ -0,0 +1,150 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Primitives.h"
+#include "DD4hep/BasicGrammar.h"
+
+// C/C++ include files
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Geometry;
+
+/// Anonymous namespace for plugins
+namespace {
+
+  typedef chrono::duration<double,milli> millisec;
+
+  /// Grammar benchmark: string against binary round trips of grammar objects
+  /**
+   *  A vector<double> with the requested number of entries is converted
+   *  several times to its string representation and back and to its
+   *  binary image and back. The time per round trip and the size of
+   *  the representations are reported. The binary round trip must restore
+   *  the original object. Other container types are checked for
+   *  consistency of the binary round trip only.
+   *
+   *  Usage:
+   *   geoPluginRun -destroy -plugin DD4hep_GrammarBenchmark -entries 10000 -turns 20
+   *
+   *  @author  M.Frank
+   *  @version 1.0
+   */
+  class GrammarBenchmark  {
+    size_t m_entries;
+    int    m_turns;
+  public:
+    /// Initializing constructor
+    GrammarBenchmark(size_t entries, int turns) : m_entries(entries), m_turns(turns) {}
+
+    /// Binary round trip of a single object
+    template <typename T> bool check(const T& value)  const  {
+      const BasicGrammar& g = BasicGrammar::instance<T>();
+      vector<unsigned char> buff;
+      T copy;
+      bool ok = g.toBinary(&value, buff) && g.fromBinary(&copy, buff.data(), buff.size()) && copy == value;
+      printout(ok ? INFO : ERROR,"GrammarBenchmark","+++ Binary round trip of %-48s [%6ld bytes] %s",
+               g.type_name().c_str(), long(buff.size()), ok ? "OK" : "FAILED");
+      return ok;
+    }
+
+    /// Run the benchmark and print the results
+    bool run()  const  {
+      const BasicGrammar& g = BasicGrammar::instance<vector<double> >();
+      vector<double> value(m_entries), text_copy, bin_copy;
+      vector<unsigned char> buff;
+      string rep;
+      bool ok = true;
+
+      // Values with a short text representation: the text round trip should be exact as well
+      for(size_t i=0; i<m_entries; ++i) value[i] = double(i)*0.25 - 1e3;
+      if ( !g.hasBinary() )  {
+        printout(ERROR,"GrammarBenchmark","+++ Grammar %s has no binary hooks.",g.type_name().c_str());
+        return false;
+      }
+      auto start = chrono::steady_clock::now();
+      for(int i=0; i<m_turns; ++i)  {
+        rep = g.str(&value);
+        ok &= g.fromString(&text_copy, rep);
+      }
+      auto stop  = chrono::steady_clock::now();
+      double text_time = millisec(stop-start).count()/m_turns;
+
+      start = chrono::steady_clock::now();
+      for(int i=0; i<m_turns; ++i)  {
+        buff.clear();
+        ok &= g.toBinary(&value, buff);
+        ok &= g.fromBinary(&bin_copy, buff.data(), buff.size());
+      }
+      stop  = chrono::steady_clock::now();
+      double bin_time = millisec(stop-start).count()/m_turns;
+
+      if ( text_copy != value )  {
+        printout(WARNING,"GrammarBenchmark","+++ String round trip of %s changed the value.",g.type_name().c_str());
+      }
+      if ( bin_copy != value )  {
+        printout(ERROR,"GrammarBenchmark","+++ Binary round trip of %s changed the value.",g.type_name().c_str());
+        ok = false;
+      }
+      printout(ALWAYS,"GrammarBenchmark","+++ %s with %ld entries, %d turns:",
+               g.type_name().c_str(), long(m_entries), m_turns);
+      printout(ALWAYS,"GrammarBenchmark","+++ String round trip: %10.4f ms  %9ld bytes",
+               text_time, long(rep.length()));
+      printout(ALWAYS,"GrammarBenchmark","+++ Binary round trip: %10.4f ms  %9ld bytes  Speedup: %8.1f",
+               bin_time, long(buff.size()), bin_time > 0e0 ? text_time/bin_time : 0e0);
+
+      ok &= check(string("Binary image of a string"));
+      ok &= check(vector<int>{1, -2, 3, -4});
+      ok &= check(vector<string>{"a", "", "bcd"});
+      ok &= check(Primitive<double>::string_map_t{{"x", 1.5}, {"yy", -2.5}});
+      ok &= check(Primitive<string>::int_map_t{{1, "one"}, {2, "two"}});
+      ok &= check(Primitive<int>::string_pair_t{"key", 42});
+      return ok;
+    }
+  };
+
+  /// Plugin entry point
+  long grammar_benchmark(LCDD& /* lcdd */, int argc, char** argv)   {
+    long entries = 10000;
+    int  turns   = 20;
+    for(int i=0; i<argc; ++i)  {
+      if      ( ::strncmp(argv[i],"-entries",4)==0 )  entries = ::atol(argv[++i]);
+      else if ( ::strncmp(argv[i],"-turns",4)==0 )    turns   = ::atol(argv[++i]);
+      else  {
+        cout <<
+          "Usage: -plugin DD4hep_GrammarBenchmark -arg [-arg]                        \n"
+          "     -entries <number>  Number of vector entries.      Default: 10000    \n"
+          "     -turns   <number>  Number of round trips.         Default: 20       \n"
+          "\tArguments given: " << arguments(argc,argv) << endl << flush;
+        ::exit(EINVAL);
+      }
+    }
+    if ( entries < 0 || turns <= 0 )  {
+      except("GrammarBenchmark","+++ Invalid arguments: %ld entries and %d turns.", entries, turns);
+    }
+    bool ok = GrammarBenchmark(entries, turns).run();
+    printout(ok ? ALWAYS : ERROR,"GrammarBenchmark","+++ %ld entries converted %d times: Test %s",
+             entries, turns, ok ? "PASSED" : "FAILED");
+    return 1;
+  }
+}
+DECLARE_APPLY(DD4hep_GrammarBenchmark,grammar_benchmark)
@@ -809,11 +809,10 @@ xml_h LCDDConverter::handlePlacement(const string& name,PlacedVolume node) const
     }
     if (geo.doc_root.tag() != "gdml") {
       if (is_placement(node)) {
-        const PlacedVolume::VolIDs& ids = node.volIDs();
-        for (PlacedVolume::VolIDs::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        for (const auto& i : node.packedVolIDs()) {
           xml_h pvid = xml_elt_t(geo.doc, _U(physvolid));
-          pvid.setAttr(_U(field_name), (*i).first);
-          pvid.setAttr(_U(value), (*i).second);
+          pvid.setAttr(_U(field_name), PlacedVolume::Object::PackedVolIDs::name(i.name));
+          pvid.setAttr(_U(value), i.value);
           place.append(pvid);
         }
       }
@@ -0,0 +1,227 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/AlignmentData.h"
+#include "DD4hep/objects/DetectorInterna.h"
+#include "DD4hep/objects/ConditionsInterna.h"
+#include "DD4hep/objects/AlignmentsInterna.h"
+
+// ROOT include files
+#include "TGeoVolume.h"
+#include "TGeoNode.h"
+
+// C/C++ include files
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <set>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Geometry;
+
+/// Anonymous namespace for plugins
+namespace {
+
+  /// Approximate memory overhead of one node of a std::map (colour, parent, left, right)
+  const size_t MAP_NODE = 4*sizeof(void*);
+  /// Capacity of the small string buffer of std::string
+  const size_t SSO_CAPACITY = 15;
+
+  /// Heap memory held by a string. Strings using the small buffer hold none.
+  size_t heap_bytes(const string& s)  {
+    const char* p = s.data();
+    bool local = p >= (const char*)&s && p < (const char*)(&s+1);
+    return local ? 0 : s.capacity()+1;
+  }
+
+  /// Memory counters of one subdetector
+  struct MemoryCounters  {
+    string name;
+    long   placements = 0, placementBytes = 0, unpackedBytes = 0;
+    long   volumes = 0,    volumeBytes = 0;
+    long   elements = 0,   elementBytes = 0;
+    long   conditions = 0, conditionBytes = 0;
+    long   alignments = 0, alignmentBytes = 0;
+    /// Sum of all accounted bytes
+    long total()  const  {
+      return placementBytes + volumeBytes + elementBytes + conditionBytes + alignmentBytes;
+    }
+    /// Accumulate counters
+    MemoryCounters& operator+=(const MemoryCounters& c)  {
+      placements += c.placements;  placementBytes += c.placementBytes;  unpackedBytes += c.unpackedBytes;
+      volumes    += c.volumes;     volumeBytes    += c.volumeBytes;
+      elements   += c.elements;    elementBytes   += c.elementBytes;
+      conditions += c.conditions;  conditionBytes += c.conditionBytes;
+      alignments += c.alignments;  alignmentBytes += c.alignmentBytes;
+      return *this;
+    }
+  };
+
+  /// Memory accounting of the detector description objects per subdetector
+  /**
+   *  Reports the bytes held by
+   *  - placement extensions (including the volume identifiers),
+   *  - volume extensions,
+   *  - DetElement objects,
+   *  - conditions and alignments attached to DetElements.
+   *  Objects shared between subdetectors are accounted to the first subdetector
+   *  using them. For the placements the memory the volume identifiers would
+   *  occupy in the unpacked representation (std::vector<std::pair<std::string,int> >)
+   *  is shown for comparison.
+   *
+   *  Usage:
+   *   geoPluginRun -input <compact.xml> -plugin DD4hep_MemoryAccounting [-detector <name>]
+   *
+   *  @author  M.Frank
+   *  @version 1.0
+   */
+  class MemoryAccounting  {
+    set<const void*> m_seen;
+  public:
+    /// Account all placements inside a logical volume (each volume is visited once)
+    void scanVolume(const TGeoVolume* vol, MemoryCounters& c)  {
+      if ( !m_seen.insert(vol).second ) return;
+      Volume v(vol);
+      if ( v.data() )  {
+        ++c.volumes;
+        c.volumeBytes += sizeof(Volume::Object);
+      }
+      for(Int_t i=0, n=vol->GetNdaughters(); i<n; ++i)  {
+        const TGeoNode*  node = vol->GetNode(i);
+        PlacedVolume     pv(node);
+        PlacedVolume::Object* ext = pv.data();
+        ++c.placements;
+        if ( ext && m_seen.insert(ext).second )  {
+          const PlacedVolume::Object::PackedVolIDs& ids = ext->volIDs;
+          c.placementBytes += sizeof(PlacedVolume::Object) + ids.heapBytes();
+          if ( ext->params )
+            c.placementBytes += sizeof(PlacedVolume::Parameterisation) + heap_bytes(ext->params->field);
+          // Equivalent unpacked container with exponential growth
+          size_t cap = 0;
+          while ( cap < ids.size() ) cap = cap ? 2*cap : 1;
+          c.unpackedBytes += sizeof(PlacedVolume::VolIDs) + cap*sizeof(PlacedVolume::VolID);
+          for(const auto& e : ids)  {
+            const string& nam = PlacedVolume::Object::PackedVolIDs::name(e.name);
+            c.unpackedBytes += nam.length() > SSO_CAPACITY ? nam.length()+1 : 0;
+          }
+          c.unpackedBytes -= sizeof(PlacedVolume::Object::PackedVolIDs) + ids.heapBytes();
+        }
+        scanVolume(node->GetVolume(), c);
+      }
+    }
+    /// Account a DetElement, its conditions, alignments and all children
+    void scanElement(DetElement de, MemoryCounters& c)  {
+      DetElement::Object* o = de.ptr();
+      if ( !o || !m_seen.insert(o).second ) return;
+      ++c.elements;
+      c.elementBytes += sizeof(DetElement::Object);
+      c.elementBytes += heap_bytes(o->name) + heap_bytes(o->type);
+      c.elementBytes += heap_bytes(o->path) + heap_bytes(o->placementPath);
+      c.elementBytes += o->updateCalls.capacity()*sizeof(DetElement::Object::UpdateCall);
+      c.elementBytes += o->extensions.size()*(MAP_NODE+sizeof(DetElement::Extensions::value_type));
+      for(const auto& i : o->children)
+        c.elementBytes += MAP_NODE + sizeof(i) + heap_bytes(i.first);
+
+      if ( o->conditions.isValid() )  {
+        const Conditions::Interna::ConditionContainer* cc = o->conditions.ptr();
+        c.conditions += cc->keys.size();
+        c.conditionBytes += sizeof(*cc) + heap_bytes(cc->name) + heap_bytes(cc->type);
+        for(const auto& k : cc->keys)
+          c.conditionBytes += MAP_NODE + sizeof(k) + heap_bytes(k.second.second);
+      }
+      if ( o->alignments.isValid() )  {
+        const Alignments::Interna::AlignmentContainer* ac = o->alignments.ptr();
+        c.alignments += ac->keys.size();
+        c.alignmentBytes += sizeof(*ac) + heap_bytes(ac->name) + heap_bytes(ac->type);
+        for(const auto& k : ac->keys)
+          c.alignmentBytes += MAP_NODE + sizeof(k) + heap_bytes(k.second.second);
+      }
+      const Alignments::AlignmentData* align[] = { o->nominal.ptr(), o->survey.ptr() };
+      for(size_t i=0; i<sizeof(align)/sizeof(align[0]); ++i)  {
+        if ( align[i] && m_seen.insert(align[i]).second )  {
+          ++c.alignments;
+          c.alignmentBytes += sizeof(Alignments::AlignmentData);
+          c.alignmentBytes += align[i]->nodes.capacity()*sizeof(PlacedVolume);
+        }
+      }
+      for(const auto& i : o->children)
+        scanElement(i.second, c);
+    }
+    /// Account one subdetector
+    MemoryCounters scan(DetElement de)  {
+      MemoryCounters c;
+      PlacedVolume   pv = de.placement();
+      c.name = de.name();
+      if ( pv.isValid() )  {
+        PlacedVolume::Object* ext = pv.data();
+        if ( ext && m_seen.insert(ext).second )  {
+          ++c.placements;
+          c.placementBytes += sizeof(PlacedVolume::Object) + ext->volIDs.heapBytes();
+        }
+        scanVolume(pv->GetVolume(), c);
+      }
+      scanElement(de, c);
+      return c;
+    }
+  };
+
+  /// Print one line of the memory report
+  void print_counters(const MemoryCounters& c)  {
+    printout(ALWAYS,"MemoryAccounting",
+             "%-16s Placements:%9ld %10.3f MB [unpacked IDs:%10.3f MB] Volumes:%7ld %8.3f MB "
+             "DetElements:%7ld %8.3f MB Conditions:%7ld %8.3f MB Alignments:%7ld %8.3f MB Total:%10.3f MB",
+             c.name.c_str(),
+             c.placements, c.placementBytes/1048576e0, (c.placementBytes+c.unpackedBytes)/1048576e0,
+             c.volumes,    c.volumeBytes/1048576e0,
+             c.elements,   c.elementBytes/1048576e0,
+             c.conditions, c.conditionBytes/1048576e0,
+             c.alignments, c.alignmentBytes/1048576e0,
+             c.total()/1048576e0);
+  }
+
+  /// Plugin entry point
+  long memory_accounting(LCDD& lcdd, int argc, char** argv)   {
+    string detector;
+    for(int i=0; i<argc; ++i)  {
+      if ( ::strncmp(argv[i],"-detector",4)==0 )  detector = argv[++i];
+      else  {
+        cout <<
+          "Usage: -plugin DD4hep_MemoryAccounting -arg [-arg]                         \n"
+          "     -detector <string>  Restrict the report to one subdetector.            \n"
+          "\tArguments given: " << arguments(argc,argv) << endl << flush;
+        ::exit(EINVAL);
+      }
+    }
+    MemoryAccounting acc;
+    MemoryCounters   total;
+    total.name = "Total";
+    for(const auto& i : lcdd.world().children())  {
+      if ( detector.empty() || detector == i.first )  {
+        MemoryCounters c = acc.scan(i.second);
+        print_counters(c);
+        total += c;
+      }
+    }
+    print_counters(total);
+    printout(ALWAYS,"MemoryAccounting","%-16s %ld interned volume ID field names: %.3f kB",
+             "Name table", long(PlacedVolume::Object::PackedVolIDs::numNames()),
+             PlacedVolume::Object::PackedVolIDs::nameTableBytes()/1024e0);
+    return 1;
+  }
+}
+DECLARE_APPLY(DD4hep_MemoryAccounting,memory_accounting)
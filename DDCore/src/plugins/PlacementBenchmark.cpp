@@ -0,0 +1,193 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Shapes.h"
+#include "DD4hep/DD4hepUnits.h"
+
+// ROOT include files
+#include "TTimeStamp.h"
+#include "TSystem.h"
+#include "TGeoVolume.h"
+
+// C/C++ include files
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Geometry;
+
+/// Anonymous namespace for plugins
+namespace {
+
+  /// Resident memory of the process in kBytes
+  long resident_memory()  {
+    ProcInfo_t info;
+    gSystem->GetProcInfo(&info);
+    return info.fMemResident;
+  }
+
+  /// Build time and memory of one way to construct a cell layer
+  struct Measurement  {
+    string name;
+    double seconds;
+    long   memory;
+    long   nodes;
+  };
+
+  /// Placement benchmark: build a flat layer of nx times ny cells
+  /**
+   *  The layer is built in three ways:
+   *  - explicit placements of every cell with individual volume IDs,
+   *  - a division of the layer into rows and of the rows into cells,
+   *  - parameterised placements of rows and cells.
+   *  For each the build time and the increase of the resident memory is reported.
+   *
+   *  Usage:
+   *   geoPluginRun -input <compact.xml> -plugin DD4hep_PlacementBenchmark -nx 1000 -ny 1000
+   *
+   *  @author  M.Frank
+   *  @version 1.0
+   */
+  class PlacementBenchmark  {
+    LCDD&  m_lcdd;
+    int    m_nx, m_ny;
+    double m_pitch;
+  public:
+    /// Initializing constructor
+    PlacementBenchmark(LCDD& lcdd, int nx, int ny, double pitch)
+      : m_lcdd(lcdd), m_nx(nx), m_ny(ny), m_pitch(pitch) {}
+
+    /// Layer volume of the proper size
+    Volume layer(const string& nam)  const  {
+      return Volume(nam, Box(m_nx*m_pitch/2, m_ny*m_pitch/2, m_pitch/2), m_lcdd.air());
+    }
+    /// Count all placements below a volume (copies of replicas are counted, but not traversed twice)
+    long count(TGeoVolume* vol)  const   {
+      long num = vol->GetNdaughters();
+      for(Int_t i=0, n=vol->GetNdaughters(); i<n; ++i)  {
+        PlacedVolume pv(vol->GetNode(i));
+        long dau = count(pv->GetVolume());
+        if ( pv.isReplicated() ) return num + n*dau;
+        num += dau;
+      }
+      return num;
+    }
+    /// Check that the cell (ix,iy) carries the expected volume IDs
+    void check(const string& tag, Volume lay, int ix, int iy)  const  {
+      PlacedVolume first = lay->GetNode(0);
+      // Explicit placements: the layer directly contains all cells
+      PlacedVolume row  = first.isReplicated() ? lay->GetNode(ix) : lay->GetNode(ix*m_ny+iy);
+      PlacedVolume cell = first.isReplicated() ? PlacedVolume(row->GetVolume()->GetNode(iy)) : row;
+      PlacedVolume::VolIDs ids = row.physVolIDs();
+      if ( cell.ptr() != row.ptr() )  {
+        PlacedVolume::VolIDs cell_ids = cell.physVolIDs();
+        ids.insert(ids.end(), cell_ids.begin(), cell_ids.end());
+      }
+      if ( ids.size() != 2 || ids[0].second != ix || ids[1].second != iy )  {
+        except("PlacementBenchmark","+++ %s: Wrong volume IDs of cell (%d,%d): %s",
+               tag.c_str(), ix, iy, ids.str().c_str());
+      }
+    }
+    /// Time and memory consumption of a builder function
+    template <typename F> Measurement measure(const string& nam, F builder)  const  {
+      Measurement m;
+      long       mem   = resident_memory();
+      TTimeStamp start;
+      Volume     lay   = (this->*builder)(nam);
+      TTimeStamp stop;
+      m.name    = nam;
+      m.seconds = stop.AsDouble()-start.AsDouble();
+      m.memory  = resident_memory()-mem;
+      m.nodes   = count(lay);
+      check(nam, lay, m_nx/2, m_ny/2);
+      check(nam, lay, m_nx-1, m_ny-1);
+      return m;
+    }
+    /// Explicit placement of every single cell
+    Volume build_explicit(const string& nam)  const  {
+      Volume lay  = layer(nam);
+      Volume cell(nam+"_cell", Box(m_pitch/2, m_pitch/2, m_pitch/2), m_lcdd.air());
+      for(int i=0; i<m_nx; ++i)  {
+        double x = (i+0.5)*m_pitch - m_nx*m_pitch/2;
+        for(int j=0; j<m_ny; ++j)  {
+          double y = (j+0.5)*m_pitch - m_ny*m_pitch/2;
+          PlacedVolume pv = lay.placeVolume(cell, Position(x, y, 0));
+          pv.addPhysVolID("x", i).addPhysVolID("y", j);
+        }
+      }
+      return lay;
+    }
+    /// Division of the layer into rows and of the rows into cells
+    Volume build_division(const string& nam)  const  {
+      Volume lay = layer(nam);
+      PlacedVolume row = lay.divide(nam+"_row", Volume::X_axis, m_nx, "x");
+      row.volume().divide(nam+"_cell", Volume::Y_axis, m_ny, "y");
+      return lay;
+    }
+    /// Parameterised placements of rows and cells
+    Volume build_param(const string& nam)  const  {
+      Volume lay  = layer(nam);
+      Volume row(nam+"_row", Box(m_pitch/2, m_ny*m_pitch/2, m_pitch/2), m_lcdd.air());
+      Volume cell(nam+"_cell", Box(m_pitch/2, m_pitch/2, m_pitch/2), m_lcdd.air());
+      row.paramVolume1D(cell, m_ny, Position(0, (0.5-m_ny/2.0)*m_pitch, 0), Position(0, m_pitch, 0), "y");
+      lay.paramVolume1D(row,  m_nx, Position((0.5-m_nx/2.0)*m_pitch, 0, 0), Position(m_pitch, 0, 0), "x");
+      return lay;
+    }
+    /// Run the benchmark and print the results
+    void run()  const  {
+      vector<Measurement> result;
+      result.push_back(measure("Explicit",       &PlacementBenchmark::build_explicit));
+      result.push_back(measure("Division",       &PlacementBenchmark::build_division));
+      result.push_back(measure("Parameterised",  &PlacementBenchmark::build_param));
+      printout(ALWAYS,"PlacementBenchmark","+++ Layer of %d x %d = %ld cells:", m_nx, m_ny, long(m_nx)*m_ny);
+      for(const auto& m : result)  {
+        printout(ALWAYS,"PlacementBenchmark","+++ %-14s  %10ld placements  Build time: %8.3f sec  Memory: %9ld kB",
+                 m.name.c_str(), m.nodes, m.seconds, m.memory);
+      }
+    }
+  };
+
+  /// Plugin entry point
+  long placement_benchmark(LCDD& lcdd, int argc, char** argv)   {
+    int    nx = 500, ny = 500;
+    double pitch = 1*dd4hep::mm;
+    for(int i=0; i<argc; ++i)  {
+      if      ( ::strncmp(argv[i],"-nx",3)==0 )     nx    = ::atol(argv[++i]);
+      else if ( ::strncmp(argv[i],"-ny",3)==0 )     ny    = ::atol(argv[++i]);
+      else if ( ::strncmp(argv[i],"-pitch",4)==0 )  pitch = ::atof(argv[++i])*dd4hep::mm;
+      else  {
+        cout <<
+          "Usage: -plugin DD4hep_PlacementBenchmark -arg [-arg]                      \n"
+          "     -nx    <number>    Number of cell rows.           Default: 500      \n"
+          "     -ny    <number>    Number of cells per row.       Default: 500      \n"
+          "     -pitch <number>    Cell size in mm.               Default: 1        \n"
+          "\tArguments given: " << arguments(argc,argv) << endl << flush;
+        ::exit(EINVAL);
+      }
+    }
+    if ( nx <= 0 || ny <= 0 || pitch <= 0e0 )  {
+      except("PlacementBenchmark","+++ Invalid layer dimensions: %d x %d cells of %g mm.",
+             nx, ny, pitch/dd4hep::mm);
+    }
+    PlacementBenchmark(lcdd, nx, ny, pitch).run();
+    return 1;
+  }
+}
+DECLARE_APPLY(DD4hep_PlacementBenchmark,placement_benchmark)
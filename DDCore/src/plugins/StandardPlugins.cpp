@@ -19,9 +19,11 @@
 #include "DD4hep/Printout.h"
 #include "DD4hep/DD4hepUnits.h"
 #include "DD4hep/DetectorTools.h"
+#include "DD4hep/DetElementIndex.h"
 #include "DD4hep/PluginCreators.h"
 #include "DD4hep/DD4hepRootPersistency.h"
 #include "XML/DocumentHandler.h"
+#include "XML/Evaluator.h"
 #include "XML/XMLElements.h"
 #include "XML/XMLTags.h"
 #include "../LCDDImp.h"
@@ -36,6 +38,7 @@
 
 // C/C++ include files
 #include <cerrno>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
@@ -44,6 +47,10 @@ using namespace std;
 using namespace DD4hep;
 using namespace DD4hep::Geometry;
 
+namespace DD4hep {
+  XmlTools::Evaluator& evaluator();
+}
+
 /// Basic entry point to create a LCDD instance
 /**
  *  Factory: LCDD_constructor
@@ -565,7 +572,7 @@ static long dump_volume_tree(LCDD& lcdd, int argc, char** argv) {
         }
         // Top level volume! have no volume ids
         if ( m_printVolIDs && ideal && ideal->GetMotherVolume() )  {
-          VIDs vid = pv.volIDs();
+          VIDs vid = pv.physVolIDs();
           if ( !vid.empty() )  {
             sensitive = true;
             log << " VolID: ";
@@ -787,6 +794,172 @@ static long detelement_cache(LCDD& lcdd, int , char** ) {
 }
 DECLARE_APPLY(DD4hepDetElementCache,detelement_cache)
 
+/// Benchmark the resolution of detector element paths
+/**
+ *  Factory: DD4hep_DetElementLookupBenchmark
+ *
+ *  Resolves the paths of all detector elements by walking the tree
+ *  level by level (as done without path index), with DetectorTools::findElement
+ *  and by the dense identifier. Arguments:
+ *
+ *   -turns <number>   Number of passes over all paths (default: 10)
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2016
+ */
+static long detelement_lookup_benchmark(LCDD& lcdd, int argc, char** argv) {
+  typedef chrono::high_resolution_clock clock;
+  struct Actor {
+    vector<DetElement> elements;
+    int                depth = 0;
+    /// Collect all detector elements
+    void collect(DetElement de)   {
+      elements.push_back(de);
+      depth = std::max(depth, de.level());
+      for (const auto& c : de.children() )
+        collect(c.second);
+    }
+    /// Resolve a relative path level by level
+    static DetElement walk(DetElement parent, const string& subpath)   {
+      size_t idx = subpath.find('/');
+      if ( idx == string::npos ) return parent.child(subpath);
+      DetElement node = parent.child(subpath.substr(0,idx));
+      return node.isValid() ? walk(node,subpath.substr(idx+1)) : node;
+    }
+  };
+  long turns = 10;
+  for(int i=0; i<argc; ++i)  {
+    if ( 0 == ::strncmp(argv[i],"-turns",4) && i+1<argc )
+      turns = ::atol(argv[++i]);
+  }
+  Actor actor;
+  DetElement world = lcdd.world();
+  DetElementIndex* index = DetElementIndex::instance(world);
+  if ( !index )  {
+    except("DetElementLookup","+++ The detector element index is not present. Is the geometry closed?");
+  }
+  actor.collect(world);
+  vector<string> paths;
+  for(const auto& de : actor.elements) paths.push_back(de.path());
+
+  size_t errors = 0, len = world.path().length()+1;
+  clock::time_point start = clock::now();
+  for(long t=0; t<turns; ++t)  {
+    for(size_t i=1; i<paths.size(); ++i)
+      if ( !(Actor::walk(world, paths[i].substr(len)) == actor.elements[i]) ) ++errors;
+  }
+  chrono::duration<double> tree = clock::now() - start;
+  start = clock::now();
+  for(long t=0; t<turns; ++t)  {
+    for(size_t i=1; i<paths.size(); ++i)
+      if ( !(DetectorTools::findElement(lcdd, paths[i]) == actor.elements[i]) ) ++errors;
+  }
+  chrono::duration<double> indexed = clock::now() - start;
+  start = clock::now();
+  for(long t=0; t<turns; ++t)  {
+    for(size_t i=1; i<paths.size(); ++i)
+      if ( !(index->element(actor.elements[i].index()) == actor.elements[i]) ) ++errors;
+  }
+  chrono::duration<double> dense = clock::now() - start;
+  double num = double(turns)*double(paths.size()-1);
+  if ( num < 1 ) num = 1;
+  printout(INFO,"DetElementLookup","+++ %ld DetElements, maximal depth %d, %ld turns, %ld hash collisions.",
+           long(paths.size()), actor.depth, turns, long(index->collisions()));
+  printout(INFO,"DetElementLookup","+++ Tree walk:          %9.3f usec/lookup",1e6*tree.count()/num);
+  printout(INFO,"DetElementLookup","+++ Indexed path:       %9.3f usec/lookup  [speedup: %.1f]",
+           1e6*indexed.count()/num, indexed.count() > 0 ? tree.count()/indexed.count() : 0e0);
+  printout(INFO,"DetElementLookup","+++ Dense identifier:   %9.3f usec/lookup",1e6*dense.count()/num);
+  if ( errors )  {
+    except("DetElementLookup","+++ %ld lookups returned the wrong detector element.",long(errors));
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_DetElementLookupBenchmark,detelement_lookup_benchmark)
+
+/// Benchmark the numeric conversion of XML attributes
+/**
+ *  Factory: DD4hep_XMLAttributeBenchmark
+ *
+ *  Converts all numeric attributes of an XML file with and without the
+ *  fast path of the attribute conversions. Constants used by the file
+ *  must be defined, i.e. the geometry should be loaded first. Arguments:
+ *
+ *   -input <file>     XML file to be scanned (usually the compact description)
+ *   -turns <number>   Number of passes over all attributes (default: 10)
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2016
+ */
+static long xml_attribute_benchmark(LCDD& /* lcdd */, int argc, char** argv) {
+  typedef chrono::high_resolution_clock clock;
+  typedef vector<pair<XML::Handle_t,string> > Attributes;
+  struct Actor {
+    XmlTools::Evaluator& eval = evaluator();
+    Attributes           attrs;
+    /// Collect all attributes with numeric value of an element and its children
+    void collect(XML::Handle_t element)   {
+      for(XML::Attribute a : element.attributes() )  {
+        string value = element.attr<string>(a);
+        eval.evaluate(value.c_str());
+        if ( eval.status() == XmlTools::Evaluator::OK )
+          attrs.push_back(make_pair(element,XML::_toString(element.attr_name(a))));
+      }
+      for(XML::Collection_t c(element,_U(star)); c; ++c)
+        collect(c);
+    }
+    /// Convert all collected attributes
+    double convert(long turns)  const  {
+      double sum = 0e0;
+      for(long t=0; t<turns; ++t)  {
+        for(const auto& a : attrs)
+          sum += a.first.attr<double>(a.second.c_str());
+      }
+      return sum;
+    }
+  };
+  string input;
+  long turns = 10;
+  for(int i=0; i<argc; ++i)  {
+    if ( 0 == ::strncmp(argv[i],"-input",4) && i+1<argc )
+      input = argv[++i];
+    else if ( 0 == ::strncmp(argv[i],"-turns",4) && i+1<argc )
+      turns = ::atol(argv[++i]);
+  }
+  if ( input.empty() )  {
+    except("XMLAttributeBenchmark","+++ No input file given. Use -input <file> [-turns <number>]");
+  }
+  Actor actor;
+  XML::DocumentHolder doc(XML::DocumentHandler().load(input));
+  actor.collect(doc.root());
+
+  bool fast = XML::enableFastConversions(false);
+  clock::time_point start = clock::now();
+  double slow_sum = actor.convert(turns);
+  chrono::duration<double> slow = clock::now() - start;
+  XML::enableFastConversions(true);
+  XML::ConversionStatistics stat = XML::conversionStatistics();
+  start = clock::now();
+  double fast_sum = actor.convert(turns);
+  chrono::duration<double> quick = clock::now() - start;
+  XML::enableFastConversions(fast);
+  const XML::ConversionStatistics& s = XML::conversionStatistics();
+  double num = double(turns)*double(actor.attrs.size());
+  if ( num < 1 ) num = 1;
+  printout(INFO,"XMLAttributeBenchmark","+++ %ld numeric attributes, %ld turns.",long(actor.attrs.size()),turns);
+  printout(INFO,"XMLAttributeBenchmark","+++ Evaluator:          %9.3f usec/conversion",1e6*slow.count()/num);
+  printout(INFO,"XMLAttributeBenchmark","+++ Fast path:          %9.3f usec/conversion  [speedup: %.1f]",
+           1e6*quick.count()/num, quick.count() > 0 ? slow.count()/quick.count() : 0e0);
+  printout(INFO,"XMLAttributeBenchmark","+++ Fast path: %ld literals, %ld memoised, %ld evaluated.",
+           long(s.literals-stat.literals), long(s.memoised-stat.memoised), long(s.evaluated-stat.evaluated));
+  if ( slow_sum != fast_sum )  {
+    except("XMLAttributeBenchmark","+++ Conversion results differ: %g <> %g",slow_sum,fast_sum);
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_XMLAttributeBenchmark,xml_attribute_benchmark)
+
 /// Basic entry point to dump the geometry tree of the lcdd instance
 /**
  *  Factory: DD4hepGeometryTreeDump
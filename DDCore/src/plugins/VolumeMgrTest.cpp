@@ -87,7 +87,7 @@ VolIDTest::VolIDTest(LCDD& lcdd, DetElement sdet, size_t depth) : m_det(sdet) {
   m_iddesc = lcdd.sensitiveDetector(m_det.name()).readout().idSpec();
   //walk(m_det,VolIDs(),Chain(),0,depth);
   PlacedVolume pv  = sdet.placement();
-  VolIDs       ids = pv.volIDs();
+  VolIDs       ids = pv.physVolIDs();
   Chain        chain;
   chain.push_back(pv);
   checkVolume(sdet, pv, ids, chain);
@@ -255,7 +255,8 @@ void VolIDTest::walkVolume(DetElement detector, PlacedVolume pv, VolIDs ids, con
 
       place.access(); // Test validity
       child_chain.push_back(place);
-      child_ids.insert(child_ids.end(), place.volIDs().begin(), place.volIDs().end());
+      VolIDs place_ids = place.physVolIDs();
+      child_ids.insert(child_ids.end(), place_ids.begin(), place_ids.end());
       //bool is_sensitive = place.volume().isSensitive();
       //if ( is_sensitive || !child_ids.empty() )  {
       checkVolume(detector, place, child_ids, child_chain);
@@ -276,7 +277,7 @@ void VolIDTest::walk(DetElement detector, VolIDs ids, const Chain& chain, size_t
     //bool         is_sensitive = pv.volume().isSensitive() || (0 != det_vol_id);
 
     child_chain.push_back(pv);
-    child_ids.insert(child_ids.end(), pv.volIDs().begin(), pv.volIDs().end());
+    pv.packedVolIDs().unpack(child_ids);
     //if ( is_sensitive )  {
     checkVolume(detector, pv, child_ids, child_chain);
     //}
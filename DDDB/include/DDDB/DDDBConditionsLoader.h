@@ -26,14 +26,22 @@
 #include "DDCond/ConditionsDataLoader.h"
 #include "DD4hep/ConditionsListener.h"
 #include "DD4hep/Printout.h"
+#include "DD4hep/Mutex.h"
 #include "XML/UriReader.h"
 
+// C/C++ include files
+#include <map>
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
   /// Namespace for the geometry part of the AIDA detector description toolkit
   namespace DDDB  {
 
+    /// Forward declarations
+    class dddb;
+
     /// Implementation of a stack of conditions assembled before application
     /** 
      *  \author   M.Frank
@@ -60,8 +68,48 @@ namespace DD4hep {
         /// ConditionsListener overload: onRegister new condition
         virtual void onRegisterCondition(Conditions::Condition cond, void* param);
       };
+      /// Cache entry describing the conditions converted from one document
+      /**
+       *  Only the condition keys are kept. On access the conditions are
+       *  looked up in the manager's pool: if the pool was meanwhile cleaned,
+       *  the entry is dropped and the document is parsed again.
+       *
+       *  \author   M.Frank
+       *  \version  1.0
+       *  \ingroup  DD4HEP_CONDITIONS
+       */
+      class DocumentEntry  {
+      public:
+        /// IOV type of the converted conditions
+        const IOVType*        type = 0;
+        /// Validity of the converted conditions
+        IOV::Key              validity;
+        /// Keys of the converted conditions
+        std::vector<key_type> keys;
+        /// Last access of the entry (see DocumentLRU)
+        unsigned long         stamp = 0;
+      };
+      typedef std::multimap<std::string, DocumentEntry> DocumentCache;
+      /// Cached documents ordered by their last access: the first entry is evicted first
+      typedef std::map<unsigned long, DocumentCache::iterator> DocumentLRU;
+      typedef std::vector<std::pair<std::string, dddb*> > ParsedDocuments;
+
       XML::UriReader* m_resolver;
       KeyCollector    m_keys;
+      /// Cache of converted documents keyed by URL
+      DocumentCache   m_cache;
+      /// Least recently used order of the cached documents
+      DocumentLRU     m_cacheLRU;
+      /// Access counter of the document cache
+      unsigned long   m_cacheClock = 0;
+      /// Lock protecting the conversion step and the document cache
+      dd4hep_mutex_t  m_lock;
+      /// Property: Number of threads to parse documents in load_many (1: serial)
+      int             m_numThreads = 1;
+      /// Property: Enable the document cache
+      bool            m_useCache   = true;
+      /// Property: Maximal number of cached documents. The least recently used documents are evicted
+      int             m_cacheSize  = 10000;
 
       /// Load single conditions document
       void loadDocument(XML::UriContextReader& rdr, const Key& k);
@@ -69,6 +117,14 @@ namespace DD4hep {
       void loadDocument(XML::UriContextReader& rdr, 
                         const std::string& sys_id,
                         const std::string& obj_id);
+      /// Parse a set of conditions documents concurrently and convert them
+      void loadDocuments(long long int event_time, const std::vector<Key>& urls);
+      /// Convert parsed documents and register the conditions. Adopts the objects.
+      void convertDocuments(ParsedDocuments& documents);
+      /// Feed the conditions of an already converted document to a listener
+      bool loadCached(const std::string& url,
+                      long long int event_time,
+                      Conditions::ConditionsListener* listener);
 
     public:
       /// Default constructor
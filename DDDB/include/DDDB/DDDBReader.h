@@ -57,14 +57,24 @@ namespace DD4hep {
       virtual bool load(const std::string& system_id, std::string& buffer);
       /// Resolve a given URI to a string containing the data
       virtual bool load(const std::string& system_id, UserContext* ctxt, std::string& buffer);
+      /// Resolve a given URI to a read-only view of the data
+      virtual bool loadView(const std::string& system_id, const char*& data, size_t& length);
+      /// Resolve a given URI to a read-only view of the data
+      virtual bool loadView(const std::string& system_id, UserContext* ctxt, const char*& data, size_t& length);
       /// Inform reader about a locally (e.g. by XercesC) handled source load
       virtual void parserLoaded(const std::string& system_id);
       /// Inform reader about a locally (e.g. by XercesC) handled source load
       virtual void parserLoaded(const std::string& system_id, UserContext* ctxt);
       /// Read raw XML object from the database / file
       virtual int getObject(const std::string& system_id, UserContext* ctxt, std::string& data);
+      /// Access raw XML object from the database / file without copy. Default: not supported
+      virtual int getObjectView(const std::string& system_id, UserContext* ctxt, const char*& data, size_t& length);
 
-   protected:
+    protected:
+      /// Translate the system id to the object id of the database. False if not matching.
+      bool objectID(const std::string& system_id, std::string& object_id)  const;
+
+    protected:
       std::string       m_directory;
       std::string       m_match;
       DDDBReaderContext m_context;
@@ -27,6 +27,7 @@
 #include "DDDB/DDDBConversion.h"
 
 // C/C++ include files
+#include <atomic>
 
 using namespace std;
 using namespace DD4hep;
@@ -595,7 +596,8 @@ namespace DD4hep {
         Catalog*   catalog = _option<Catalog>();
         Document*  doc     = context->locals.xml_doc;
         string     path    = object_path(context,name);
-        static int num_param=0, num_vector=0, num_map=0, num_spec=0, num_align=0;
+        // Documents may be parsed concurrently (see DDDBConditionsLoader)
+        static atomic<int> num_param(0), num_vector(0), num_map(0), num_spec(0), num_align(0);
 
         Condition cond(path,"DDDB");
         cond->address  = doc->name+"@"+id;
@@ -663,7 +665,8 @@ namespace DD4hep {
         num_param += int(d.params.size());
         if ( (context->geo->conditions.size()%500) == 0 )  {
           printout(INFO,"Condition","++ Processed %d conditions....last:%s Number of Params: %d Vec:%d Map:%d Spec:%d Align:%d", 
-                   int(context->geo->conditions.size()), path.c_str(), num_param, num_vector, num_map, num_spec, num_align);
+                   int(context->geo->conditions.size()), path.c_str(), int(num_param), int(num_vector),
+                   int(num_map), int(num_spec), int(num_align));
         }
       }
     }
@@ -1819,6 +1822,25 @@ namespace DD4hep {
     long load_dddb_conditions_from_uri(lcdd_t& lcdd, int argc, char** argv) {
       return load_dddb_objects<dddb_conditions>(lcdd,argc,argv);
     }
+    /// Parse a conditions document into a local object. The DDDBHelper is not touched.
+    /** The caller takes ownership of the returned object. Since no shared
+     *  state is modified, independent documents may be parsed concurrently
+     *  provided each caller uses its own reader context.
+     */
+    dddb* parse_dddb_conditions_from_uri(lcdd_t& lcdd,
+                                         XML::UriReader* rdr,
+                                         const string& sys_id,
+                                         const string& obj_path)
+    {
+      Context ctxt(lcdd);
+      config_context(ctxt, rdr, sys_id, obj_path);
+      load_dddb_entity<dddb_conditions>(&ctxt,0,0,ctxt.locals.xml_doc->id);
+      checkParents( &ctxt );
+      fixCatalogs( &ctxt );
+      dddb* geo = ctxt.geo;
+      ctxt.geo = 0;
+      return geo;
+    }
     /// Plugin entry point.
     long load_dddb_from_handle(lcdd_t& lcdd, xml_h element) {
       DDDBHelper* helper = lcdd.extension<DDDBHelper>(false);
@@ -1046,15 +1046,20 @@ namespace DD4hep {
       except("DDDB","++ No DDDBHelper instance installed. Geometry conversion failed!");
       return 1;
     }
+    /// Convert locally parsed conditions. The dddb object is NOT adopted.
+    long dddb_conditions_2_dd4hep(LCDD& lcdd, dddb* geo) {
+      Context context(lcdd, geo);
+      context.helper              = lcdd.extension<DDDBHelper>(false);
+      context.print_conditions    = false;
+      context.conditions_only     = true;
+      CNV<dddb> cnv(lcdd,&context);
+      cnv(make_pair(string(),context.geo));
+      return 1;
+    }
     long dddb_conditions_2_dd4hep(LCDD& lcdd, int , char** ) {
       DDDBHelper* helper = lcdd.extension<DDDBHelper>(false);
       if ( helper )   {
-        Context context(lcdd, helper->detectorDescription());
-        context.helper              = helper;
-        context.print_conditions    = false;
-        context.conditions_only     = true;
-        CNV<dddb> cnv(lcdd,&context);
-        cnv(make_pair(string(),context.geo));
+        dddb_conditions_2_dd4hep(lcdd, helper->detectorDescription());
         helper->setDetectorDescription(0);
         return 1;
       }
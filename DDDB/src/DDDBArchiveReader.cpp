@@ -0,0 +1,308 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// DDDB is a detector description convention developed by the LHCb experiment.
+// For further information concerning the DTD, please see:
+// http://lhcb-comp.web.cern.ch/lhcb-comp/Frameworks/DetDesc/Documents/lhcbDtd.pdf
+//
+//==========================================================================
+
+// Framework includes
+#include "DDDB/DDDBReader.h"
+
+// C/C++ include files
+#include <map>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace of the DDDB conversion stuff
+  namespace DDDB  {
+
+    /// Class reading the DDDB database directly from a (uncompressed) tar archive
+    /**
+     *  The archive is memory mapped once. On opening an index of all
+     *  members is built, which maps the member name to its offset and size.
+     *  Data are handed to the XML parser as read-only views into the mapped
+     *  region. No copies are made and no file system access is necessary
+     *  on each document access.
+     *
+     *  The directory of the reader is interpreted as the path prefix of the
+     *  members inside the archive (e.g. "DDDB/DDDB").
+     *
+     *  Note: Compressed archives cannot be memory mapped. They must be
+     *  decompressed once beforehand (e.g. gunzip -k DDDB.tar.gz).
+     *
+     *  \author   M.Frank
+     *  \version  1.0
+     *  \ingroup DD4HEP_XML
+     */
+    class DDDBArchiveReader : public DDDBReader   {
+    public:
+      /// Archive member descriptor
+      struct Member  {
+        const char* data;
+        size_t      length;
+      };
+      typedef std::map<std::string, Member> Members;
+
+    protected:
+      /// Name of the archive file
+      std::string m_archive;
+      /// Start of the memory mapped region
+      char*       m_mapping = 0;
+      /// Size of the memory mapped region
+      size_t      m_size    = 0;
+      /// Archive index: member name -> data view
+      Members     m_members;
+
+      /// Build the member index
+      void buildIndex();
+      /// Locate an archive member
+      const Member* find(const std::string& system_id)  const;
+
+    public:
+      /// Standard constructor
+      DDDBArchiveReader(const std::string& archive);
+      /// Default destructor
+      virtual ~DDDBArchiveReader();
+      /// Access the member index
+      const Members& members() const  {  return m_members;  }
+      /// Read raw XML object from the database / file
+      virtual int getObject(const std::string& system_id, UserContext* ctxt, std::string& data);
+      /// Access raw XML object from the archive without copy
+      virtual int getObjectView(const std::string& system_id, UserContext* ctxt, const char*& data, size_t& length);
+      /// Resolve a given URI to a string containing the data
+      virtual bool load(const std::string& system_id, std::string& buffer);
+      /// Resolve a given URI to a string containing the data
+      virtual bool load(const std::string& system_id, UserContext* ctxt, std::string& buffer);
+      /// Resolve a given URI to a read-only view of the data
+      virtual bool loadView(const std::string& system_id, const char*& data, size_t& length);
+      /// Resolve a given URI to a read-only view of the data
+      virtual bool loadView(const std::string& system_id, UserContext* ctxt, const char*& data, size_t& length);
+    };
+  }    /* End namespace DDDB            */
+}      /* End namespace DD4hep          */
+
+
+//==========================================================================
+// Framework includes
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Path.h"
+#include "DD4hep/LCDD.h"
+
+// C/C++ include files
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstring>
+#include <cerrno>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::DDDB;
+
+namespace {
+  /// Block size of tar archives
+  const size_t TAR_BLOCK = 512;
+
+  /// Convert numeric tar header field (octal or GNU base-256 encoding)
+  size_t tar_number(const char* p, size_t len)  {
+    size_t val = 0;
+    if ( (unsigned char)p[0] & 0x80 )  {
+      for(size_t i=1; i<len; ++i)
+        val = (val<<8) | (unsigned char)p[i];
+      return val;
+    }
+    for(size_t i=0; i<len && p[i]; ++i)  {
+      if ( p[i] >= '0' && p[i] <= '7' )
+        val = (val<<3) + (p[i]-'0');
+    }
+    return val;
+  }
+
+  /// Bounded string copy of a tar header field
+  string tar_string(const char* p, size_t len)  {
+    return string(p, ::strnlen(p, len));
+  }
+
+  /// Normalize member names: remove leading "./" and "/"
+  string member_name(const string& name)  {
+    string n = Path(name).normalize().native();
+    while ( n.substr(0,2) == "./" ) n = n.substr(2);
+    while ( !n.empty() && n[0] == '/' ) n = n.substr(1);
+    return n;
+  }
+}
+
+/// Standard constructor
+DDDBArchiveReader::DDDBArchiveReader(const string& archive)
+  : DDDBReader(), m_archive(archive)
+{
+  int fid = ::open(m_archive.c_str(), O_RDONLY);
+  if ( fid == -1 )   {
+    except("DDDBArchiveReader","++ Failed to open archive %s [%s]",
+           m_archive.c_str(), ::strerror(errno));
+  }
+  struct stat buff;
+  if ( 0 != ::fstat(fid, &buff) )  {
+    ::close(fid);
+    except("DDDBArchiveReader","++ Failed to stat archive %s [%s]",
+           m_archive.c_str(), ::strerror(errno));
+  }
+  m_size = buff.st_size;
+  void* ptr = ::mmap(0, m_size, PROT_READ, MAP_PRIVATE, fid, 0);
+  ::close(fid);
+  if ( ptr == MAP_FAILED )  {
+    except("DDDBArchiveReader","++ Failed to map archive %s [%s]",
+           m_archive.c_str(), ::strerror(errno));
+  }
+  m_mapping = (char*)ptr;
+  buildIndex();
+}
+
+/// Default destructor
+DDDBArchiveReader::~DDDBArchiveReader()  {
+  if ( m_mapping )  {
+    ::munmap(m_mapping, m_size);
+    m_mapping = 0;
+  }
+}
+
+/// Build the member index
+void DDDBArchiveReader::buildIndex()   {
+  const char* ptr = m_mapping;
+  const char* end = m_mapping + m_size;
+  string      long_name;
+
+  m_members.clear();
+  while ( ptr + TAR_BLOCK <= end )  {
+    // Two consecutive empty blocks terminate the archive. One is enough for us.
+    if ( ptr[0] == 0 ) break;
+    size_t      len  = tar_number(ptr+124, 12);
+    char        type = ptr[156];
+    const char* data = ptr + TAR_BLOCK;
+    size_t      next = TAR_BLOCK + ((len+TAR_BLOCK-1)/TAR_BLOCK)*TAR_BLOCK;
+
+    if ( data + len > end )  {
+      except("DDDBArchiveReader","++ Archive %s is truncated.",m_archive.c_str());
+    }
+    if ( type == 'L' )   {   // GNU long name extension: name of the next member
+      long_name = tar_string(data, len);
+    }
+    else if ( type == 'x' )  {   // POSIX extended header: look for the path record
+      string rec(data, len);
+      size_t idx = rec.find(" path=");
+      if ( idx != string::npos )  {
+        size_t idq = rec.find('\n', idx);
+        long_name = rec.substr(idx+6, idq == string::npos ? string::npos : idq-idx-6);
+      }
+    }
+    else if ( type == '0' || type == 0 )   {
+      string name = long_name;
+      if ( name.empty() )  {
+        string prefix = ::strncmp(ptr+257,"ustar",5) == 0 ? tar_string(ptr+345,155) : string();
+        name = tar_string(ptr, 100);
+        if ( !prefix.empty() ) name = prefix + "/" + name;
+      }
+      Member m = { data, len };
+      m_members[member_name(name)] = m;
+      long_name.clear();
+    }
+    else  {
+      long_name.clear();
+    }
+    ptr += next;
+  }
+  printout(INFO,"DDDBArchiveReader","++ Indexed %ld members of archive %s [%ld bytes]",
+           long(m_members.size()), m_archive.c_str(), long(m_size));
+}
+
+/// Locate an archive member
+const DDDBArchiveReader::Member* DDDBArchiveReader::find(const string& system_id)  const  {
+  Members::const_iterator i = m_members.find(member_name(m_directory+"/"+system_id));
+  return i == m_members.end() ? 0 : &(*i).second;
+}
+
+/// Read raw XML object from the database / file
+int DDDBArchiveReader::getObject(const string& system_id, UserContext* /* ctxt */, string& buffer)  {
+  const Member* m = find(system_id);
+  if ( m )  {
+    buffer.assign(m->data, m->length);
+    return 1;
+  }
+  errno = ENOENT;
+  return 0;
+}
+
+/// Access raw XML object from the archive without copy
+int DDDBArchiveReader::getObjectView(const string& system_id, UserContext* /* ctxt */,
+                                     const char*& data, size_t& length)
+{
+  const Member* m = find(system_id);
+  if ( m )  {
+    data   = m->data;
+    length = m->length;
+    return 1;
+  }
+  printout(ERROR,"DDDBArchiveReader","++ Failed to resolve system id: %s [No such archive member]",
+           system_id.c_str());
+  return 0;
+}
+
+/// Resolve a given URI to a string containing the data
+bool DDDBArchiveReader::load(const string& system_id, string& buffer)   {
+  return XML::UriReader::load(system_id, buffer);
+}
+
+/// Resolve a given URI to a string containing the data
+bool DDDBArchiveReader::load(const string& system_id, UserContext* ctxt, string& buffer)  {
+  bool result = DDDBReader::load(system_id, ctxt, buffer);
+  if ( result )  {
+    DDDBReaderContext* c = (DDDBReaderContext*)ctxt;
+    c->valid_since = c->event_time;
+    c->valid_until = c->event_time;
+  }
+  return result;
+}
+
+/// Resolve a given URI to a read-only view of the data
+bool DDDBArchiveReader::loadView(const string& system_id, const char*& data, size_t& length)   {
+  return XML::UriReader::loadView(system_id, data, length);
+}
+
+/// Resolve a given URI to a read-only view of the data
+bool DDDBArchiveReader::loadView(const string& system_id, UserContext* ctxt,
+                                 const char*& data, size_t& length)
+{
+  bool result = DDDBReader::loadView(system_id, ctxt, data, length);
+  if ( result )  {
+    DDDBReaderContext* c = (DDDBReaderContext*)ctxt;
+    c->valid_since = c->event_time;
+    c->valid_until = c->event_time;
+  }
+  return result;
+}
+
+namespace {
+  void* create_dddb_archive_reader(const char* archive) {
+    if ( !archive || !archive[0] )  {
+      except("DDDBArchiveReader","++ No archive file name given!");
+    }
+    return new DD4hep::DDDB::DDDBArchiveReader(archive);
+  }
+}
+DECLARE_CONSTRUCTOR(DDDB_ArchiveReader,create_dddb_archive_reader)
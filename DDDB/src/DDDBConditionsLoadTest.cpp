@@ -0,0 +1,148 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// DDDB is a detector description convention developed by the LHCb experiment.
+// For further information concerning the DTD, please see:
+// http://lhcb-comp.web.cern.ch/lhcb-comp/Frameworks/DetDesc/Documents/lhcbDtd.pdf
+//
+//==========================================================================
+
+// Framework includes
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/objects/ConditionsInterna.h"
+
+#include "DDCond/ConditionsSlice.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DDCond/ConditionsDataLoader.h"
+#include "DDCond/ConditionsManager.h"
+
+#include "DDDB/DDDBHelper.h"
+#include "DDDB/DDDBReaderContext.h"
+
+// C/C++ include files
+#include <set>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Conditions;
+
+using Geometry::LCDD;
+
+/// Anonymous namespace for plugins
+namespace  {
+
+  /// Reload all DDDB conditions through the conditions loader
+  /**
+   *  All conditions of the "epoch" IOV type are removed from the manager
+   *  and then requested again with a conditions slice, which triggers
+   *  ConditionsDataLoader::load_many. This is done once with one and once
+   *  with several parser threads. Both passes must load the same conditions.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CONDITIONS
+   */
+  class ConditionsReloader  {
+  public:
+    typedef vector<pair<ConditionKey,string> > Items;
+    ConditionsManager manager;
+    const IOVType*    epoch = 0;
+    Items             items;
+
+    /// Initializing constructor
+    ConditionsReloader(ConditionsManager m) : manager(m)  {
+      epoch = manager.iovType("epoch");
+      if ( !epoch )  {
+        except("DDDBLoadTest","++ No IOV type 'epoch' present. Are the conditions loaded?");
+      }
+    }
+    /// Collect the keys and addresses of all loaded conditions
+    size_t collect()  {
+      ConditionsIOVPool* iov_pool = manager.iovPool(*epoch);
+      items.clear();
+      if ( iov_pool )  {
+        for(const auto& p : iov_pool->elements)  {
+          RangeConditions conds;
+          p.second->select_all(conds);
+          for(Condition c : conds)  {
+            Condition::Object* o = c.ptr();
+            if ( 0 == (o->flags&Condition::DERIVED) && !o->address.empty() )
+              items.push_back(make_pair(ConditionKey(o->name,o->hash),string(o->address)));
+          }
+        }
+      }
+      return items.size();
+    }
+    /// Clear the manager and reload all conditions with the given number of parser threads
+    set<Condition::key_type> reload(int num_threads, long long int time)  {
+      char text[32];
+      set<Condition::key_type> keys;
+      ::snprintf(text,sizeof(text),"%d",num_threads);
+      manager.clear();
+      manager.loader()->property("Threads") = text;
+      dd4hep_ptr<ConditionsSlice> slice(createSlice(manager,*epoch));
+      for(const auto& i : items)
+        slice->insert(i.first,ConditionsSlice::LoadInfo<string>(i.second));
+      IOV iov(epoch, IOV::Key(time,time));
+      ConditionsManager::Result res = manager.prepare(iov, *slice);
+      for(const auto& i : items)  {
+        if ( slice->pool->exists(i.first.hash) ) keys.insert(i.first.hash);
+      }
+      printout(INFO,"DDDBLoadTest","++ Threads:%2d Requested %ld conditions: loaded:%ld missing:%ld in pool:%ld",
+               num_threads, long(items.size()), long(res.loaded), long(res.missing), long(keys.size()));
+      slice->pool->clear();
+      return keys;
+    }
+  };
+
+  //========================================================================
+  /// Plugin function
+  /// Reload all conditions serially and with concurrent document parsing
+  long dddb_conditions_load_test(LCDD& lcdd, int argc, char** argv) {
+    int num_threads = 4;
+    for(int i=0; i<argc; ++i)  {
+      if ( ::strcmp(argv[i],"-threads")==0 )  {
+        num_threads = ::atol(argv[++i]);
+      }
+      else if ( ::strcmp(argv[i],"--help")==0 )      {
+        printout(INFO,"Plugin-Help","Usage: DDDB_ConditionsLoadTest --opt [--opt]        ");
+        printout(INFO,"Plugin-Help","  -threads <number>  Number of parser threads (default: 4)");
+        printout(INFO,"Plugin-Help","  -help              Print this help message    ");
+        ::exit(EINVAL);
+      }
+    }
+    DDDB::DDDBHelper* helper = lcdd.extension<DDDB::DDDBHelper>();
+    DDDB::DDDBReaderContext* ctx = (DDDB::DDDBReaderContext*)helper->xmlReader()->context();
+    ConditionsReloader reloader(ConditionsManager::from(lcdd));
+    if ( 0 == reloader.collect() )  {
+      except("DDDBLoadTest","++ No conditions present to be reloaded.");
+    }
+    set<Condition::key_type> serial   = reloader.reload(1, ctx->event_time);
+    set<Condition::key_type> parallel = reloader.reload(num_threads, ctx->event_time);
+    if ( serial.empty() || serial != parallel )  {
+      except("DDDBLoadTest","++ Loaded conditions differ: %ld serial, %ld with %d threads.",
+             long(serial.size()), long(parallel.size()), num_threads);
+    }
+    printout(INFO,"DDDBLoadTest","++ Reloaded %ld conditions identically with 1 and %d threads.",
+             long(serial.size()), num_threads);
+    return 1;
+  }
+} /* End anonymous namespace  */
+
+DECLARE_APPLY(DDDB_ConditionsLoadTest,dddb_conditions_load_test)
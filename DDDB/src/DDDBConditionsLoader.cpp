@@ -23,15 +23,20 @@
 #include "DDDB/DDDBConditionsLoader.h"
 #include "DDDB/DDDBReaderContext.h"
 #include "DDDB/DDDBHelper.h"
+#include "DDDB/DDDBConversion.h"
 
 // Other DD4hep includes
 #include "DD4hep/Printout.h"
+#include "DD4hep/Primitives.h"
 #include "DD4hep/Factories.h"
 #include "DD4hep/Operators.h"
 #include "DD4hep/objects/ConditionsInterna.h"
 #include "DDCond/ConditionsManagerObject.h"
+#include "DDCond/ConditionsIOVPool.h"
 
 // C/C++ include files
+#include <thread>
+#include <algorithm>
 
 // Forward declartions
 using namespace std;
@@ -153,6 +158,11 @@ namespace DD4hep {
     /// Plugin entry points.
     long load_dddb_conditions_from_uri(LCDD& lcdd, int argc, char** argv);
     long dddb_conditions_2_dd4hep(LCDD& lcdd, int argc, char** argv);
+    long dddb_conditions_2_dd4hep(LCDD& lcdd, dddb* geo);
+    dddb* parse_dddb_conditions_from_uri(LCDD& lcdd,
+                                         XML::UriReader* rdr,
+                                         const string& sys_id,
+                                         const string& obj_path);
 
     long load_dddb_from_uri(LCDD& lcdd, int argc, char** argv);
     long dddb_2_dd4hep(LCDD& lcdd, int argc, char** argv);
@@ -191,6 +201,9 @@ DDDBConditionsLoader::DDDBConditionsLoader(LCDD& lcdd, ConditionsManager mgr, co
   // but we do not have a better way as of now....
   m_mgr->callOnRegister(m_keys.call,true);
   m_resolver = helper->xmlReader();
+  declareProperty("Threads",        m_numThreads);
+  declareProperty("CacheDocuments", m_useCache);
+  declareProperty("CacheSize",      m_cacheSize);
 }
 
 /// Default Destructor
@@ -209,18 +222,153 @@ void DDDBConditionsLoader::loadDocument(XML::UriContextReader& rdr,
                                         const string& sys_id,
                                         const string& obj_id)
 {
-  const void* argv_conddb[] = {&rdr, sys_id.c_str(), obj_id.c_str(), 0};
-  long result = load_dddb_conditions_from_uri(m_lcdd, 3, (char**)argv_conddb);
-  if ( 0 == result )  {
+  ParsedDocuments docs;
+  dddb* geo = parse_dddb_conditions_from_uri(m_lcdd, &rdr, sys_id, obj_id);
+  if ( 0 == geo )  {
     except("DDDB","++ Failed to load conditions from URI:%s",sys_id.c_str());
   }
-  const void* argv_dddb[] = {"conditions_only", 0};
-  result = dddb_conditions_2_dd4hep(m_lcdd, 1, (char**)argv_dddb);
-  if ( 0 == result )  {
-    except("DDDBLoader","++ Failed to process conditions from URI:%s",sys_id.c_str());
+  docs.push_back(make_pair(sys_id,geo));
+  convertDocuments(docs);
+}
+
+/// Parse a set of conditions documents concurrently and convert them
+void DDDBConditionsLoader::loadDocuments(long long int event_time, const vector<Key>& urls)  {
+  size_t num_threads = m_numThreads > 1 ? size_t(m_numThreads) : 1;
+  num_threads = std::min(num_threads, urls.size());
+  ParsedDocuments docs(urls.size(), ParsedDocuments::value_type("",(dddb*)0));
+  vector<string>  errors(num_threads);
+
+  // Each worker parses a stride of the documents with its private reader context.
+  // The parsed objects are only kept locally. The shared expression evaluator
+  // evaluates expressions under a shared (reader) lock (see XmlTools::Evaluator)
+  // and the statistics counters of the converters are atomic. The dictionary of
+  // the evaluator must not be modified while documents are parsed.
+  auto worker = [&](size_t id)  {
+    DDDBReaderContext     local;
+    XML::UriContextReader local_reader(m_resolver, &local);
+    try  {
+      for(size_t i=id; i<urls.size(); i += num_threads)  {
+        const Key& k = urls[i];
+        local.event_time  = event_time;
+        local.valid_since = 0;
+        local.valid_until = 0;
+        docs[i] = make_pair(k.first,parse_dddb_conditions_from_uri(m_lcdd,&local_reader,k.first,k.second));
+      }
+    }
+    catch(const exception& e)  {
+      errors[id] = e.what();
+    }
+    catch(...)  {
+      errors[id] = "UNKNOWN exception";
+    }
+  };
+  if ( num_threads > 1 )  {
+    vector<thread> threads;
+    for(size_t i=0; i<num_threads; ++i)
+      threads.push_back(thread(worker,i));
+    for(auto& t : threads)
+      t.join();
+  }
+  else if ( num_threads == 1 )  {
+    worker(0);
+  }
+  for(const auto& e : errors)  {
+    if ( !e.empty() )  {
+      for(auto& d : docs) deletePtr(d.second);
+      except("DDDBLoader","++ Failed to load conditions: %s",e.c_str());
+    }
+  }
+  for(const auto& d : docs)  {
+    if ( 0 == d.second )  {
+      for(auto& dd : docs) deletePtr(dd.second);
+      except("DDDBLoader","++ Failed to load conditions from URI:%s",d.first.c_str());
+    }
+  }
+  convertDocuments(docs);
+}
+
+/// Convert parsed documents and register the conditions. Adopts the objects.
+void DDDBConditionsLoader::convertDocuments(ParsedDocuments& docs)  {
+  // Registration modifies the manager and triggers the listeners: one locked step.
+  dd4hep_lock_t lock(m_lock);
+  try  {
+    for(auto& d : docs)  {
+      dddb* geo = d.second;
+      long result = dddb_conditions_2_dd4hep(m_lcdd, geo);
+      if ( 0 == result )  {
+        except("DDDBLoader","++ Failed to process conditions from URI:%s",d.first.c_str());
+      }
+      if ( m_useCache && !geo->conditions.empty() )  {
+        DocumentEntry entry;
+        for(const auto& c : geo->conditions)  {
+          const IOV* iov = c.second->iov;
+          if ( iov )  {
+            entry.type     = iov->iovType;
+            entry.validity = iov->keyData;
+            entry.keys.push_back(c.second->hash);
+          }
+        }
+        if ( entry.type )  {
+          // Evict the least recently used documents only: frequently accessed documents stay
+          while ( !m_cacheLRU.empty() && m_cache.size() >= size_t(m_cacheSize) )  {
+            m_cache.erase(m_cacheLRU.begin()->second);
+            m_cacheLRU.erase(m_cacheLRU.begin());
+          }
+          entry.stamp = ++m_cacheClock;
+          m_cacheLRU.insert(make_pair(entry.stamp, m_cache.insert(make_pair(d.first,entry))));
+        }
+      }
+      deletePtr(d.second);
+    }
+  }
+  catch(...)  {
+    for(auto& d : docs) deletePtr(d.second);
+    throw;
   }
 }
 
+/// Feed the conditions of an already converted document to a listener
+bool DDDBConditionsLoader::loadCached(const string& url,
+                                      long long int event_time,
+                                      ConditionsListener* listener)
+{
+  if ( m_useCache )  {
+    dd4hep_lock_t lock(m_lock);
+    auto range = m_cache.equal_range(url);
+    for(auto i=range.first; i != range.second; ++i)  {
+      DocumentEntry& e = (*i).second;
+      if ( e.validity.first <= event_time && event_time <= e.validity.second )  {
+        Conditions::ConditionsIOVPool* iov_pool = m_mgr->iovPool(*e.type);
+        if ( iov_pool )  {
+          Conditions::ConditionsIOVPool::Elements::const_iterator p = iov_pool->elements.find(e.validity);
+          if ( p != iov_pool->elements.end() )  {
+            RangeConditions conds;
+            conds.reserve(e.keys.size());
+            for(key_type k : e.keys)  {
+              Condition c = (*p).second->exists(k);
+              if ( !c.isValid() ) break;
+              conds.push_back(c);
+            }
+            if ( conds.size() == e.keys.size() )  {
+              m_cacheLRU.erase(e.stamp);
+              e.stamp = ++m_cacheClock;
+              m_cacheLRU.insert(make_pair(e.stamp, i));
+              for(Condition c : conds)
+                listener->onRegisterCondition(c, listener);
+              return true;
+            }
+          }
+        }
+        // The pool was cleaned meanwhile: the document must be re-parsed.
+        m_cacheLRU.erase(e.stamp);
+        m_cache.erase(i);
+        return false;
+      }
+    }
+  }
+  return false;
+}
+
 /// Load  a condition set given a Detector Element and the conditions name according to their validity
 size_t DDDBConditionsLoader::load_range(key_type key,
                                         const iov_type& req_iov,
@@ -240,7 +388,8 @@ size_t DDDBConditionsLoader::load_range(key_type key,
       local.valid_since = 0;
       local.valid_until = 0;
       listener.iov.reset().invert();
-      loadDocument(local_reader, url_key);
+      if ( !loadCached(url_key.first, start, &listener) )
+        loadDocument(local_reader, url_key);
       start = listener.iov.keyData.second+1;
     }
     m_mgr->callOnRegister(make_pair(&listener,&listener), false);
@@ -264,7 +413,8 @@ size_t DDDBConditionsLoader::load_single(key_type key,
     local.valid_until = 0;
     local.event_time  = req_iov.keyData.first;
     m_mgr->callOnRegister(make_pair(&listener,&listener), true);  
-    loadDocument(local_reader, (*k).second);
+    if ( !loadCached((*k).second.first, local.event_time, &listener) )
+      loadDocument(local_reader, (*k).second);
     m_mgr->callOnRegister(make_pair(&listener,&listener), false);
     return conditions.size() - len;
   }
@@ -277,15 +427,9 @@ size_t DDDBConditionsLoader::load_many(const iov_type& req_iov,
                                        LoadedItems&    loaded,
                                        iov_type&       conditions_validity)
 {
-  DDDBReaderContext  local;
   size_t len = loaded.size();
   map<std::string,std::string>   urls;
-
-  local.event_time  = req_iov.keyData.first;
-  local.valid_since = 0;
-  local.valid_until = 0;
-
-  XML::UriContextReader local_reader(m_resolver, &local);
+  vector<Key>                    work_urls;
 
   // First collect all required URIs which need loading.
   // Since one file contains many conditions, we have
@@ -319,8 +463,14 @@ size_t DDDBConditionsLoader::load_many(const iov_type& req_iov,
   try  {
     m_mgr->callOnRegister(make_pair(&listener,&listener),true);
     listener.iov.reset().invert();
+    // Documents already converted are served from the cache. The others are
+    // parsed as one batch and registered in one locked step.
     for(const auto& url : urls )  {
-      loadDocument(local_reader, url.first, url.second);
+      if ( !loadCached(url.first, req_iov.keyData.first, &listener) )
+        work_urls.push_back(url);
+    }
+    if ( !work_urls.empty() )  {
+      loadDocuments(req_iov.keyData.first, work_urls);
     }
     conditions_validity = listener.iov;
   }
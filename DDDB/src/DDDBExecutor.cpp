@@ -55,6 +55,9 @@ static void usage_load_xml_dddb()   {
     "  -loader <plugin>      Plugin instance for XML entity resolution.      \n"
     "  -param  <file-name>   Preprocessing xml file                          \n"
     "  -input  <file-name>   Directory containing DDDB                       \n"
+    "                        With -tar: member path of the top document      \n"
+    "  -tar    <file-name>   Uncompressed tar archive containing DDDB.       \n"
+    "                        Implies the loader DDDB_ArchiveReader.          \n"
     "  -config <plugin>      Execute config plugin initializing the helper.  \n"
     "  -match  <string>      Match string for entity resolver e.g.'conddb:'  \n"
     "  -xml    <file-name>   Parse additional XML files using LCDD.          \n"
@@ -76,7 +79,7 @@ static long run_plugin(Geometry::LCDD& lcdd, const std::string& plugin, std::vec
 
 static long load_xml_dddb(Geometry::LCDD& lcdd, int argc, char** argv) {
   if ( argc > 0 )   {
-    string sys_id, params, match="conddb:", attr="", loader_name="DDDB_FileReader";
+    string sys_id, params, match="conddb:", attr="", archive, loader_name="DDDB_FileReader";
     std::vector<string> setup, xmlFiles, executors, config;
     std::map<std::string, std::vector<char*> > e_args, s_args, c_args;
     long result = 0, visualize = 0, dump = 0;
@@ -125,6 +128,11 @@ static long load_xml_dddb(Geometry::LCDD& lcdd, int argc, char** argv) {
           s_args[setup.back()] = std::vector<char*>();
           last = c;
           break;
+        case 'T':
+          archive = argv[++i];
+          loader_name = "DDDB_ArchiveReader";
+          last = 0;
+          break;
         case 'V':
           visualize = 1;
           last = 0;
@@ -162,10 +170,15 @@ static long load_xml_dddb(Geometry::LCDD& lcdd, int argc, char** argv) {
 
     DDDBHelper* helper = lcdd.extension<DDDBHelper>();
     if ( !loader_name.empty() )  {
-      DDDBReader* resolver = (DDDBReader*)DD4hep::PluginService::Create<void*>(loader_name,(const char*)0);
+      const char* loader_arg = archive.empty() ? 0 : archive.c_str();
+      DDDBReader* resolver = (DDDBReader*)DD4hep::PluginService::Create<void*>(loader_name,loader_arg);
       resolver->setMatch(match);
       resolver->setDirectory(path.parent_path().c_str());
       helper->setXmlReader(resolver);
+      if ( !archive.empty() && !sys_id.empty() )  {
+        // The input is the archive member: the top document is resolved by the reader
+        sys_id = match + "/" + path.filename();
+      }
     }
 
     /// Execute config plugins without arguments
@@ -43,15 +43,12 @@ bool DDDBReader::load(const string& system_id, string& buffer)   {
   return XML::UriReader::load(system_id, buffer);
 }
 
-/// Resolve a given URI to a string containing the data
-bool DDDBReader::load(const string& system_id,
-                          UserContext*  ctxt,
-                          string& buffer)
-{
+/// Translate the system id to the object id of the database. False if not matching.
+bool DDDBReader::objectID(const string& system_id, string& id)  const   {
   if ( system_id.substr(0,m_match.length()) == m_match )  {
     string mm = m_match + "//";
     const string& sys = system_id;
-    string id = sys.c_str() + (sys.substr(0,mm.length()) == mm ? 9 : 7);
+    id = sys.c_str() + (sys.substr(0,mm.length()) == mm ? 9 : 7);
     // Extract the COOL field name from the condition path
     // "conddb:/path/to/field@folder"
     string::size_type at_pos = id.find('@');
@@ -60,6 +57,18 @@ bool DDDBReader::load(const string& system_id,
       // always remove '@' from the path
       id = id.substr(0,slash_pos+1) +  id.substr(at_pos+1);
     }
+    return true;
+  }
+  return false;
+}
+
+/// Resolve a given URI to a string containing the data
+bool DDDBReader::load(const string& system_id,
+                          UserContext*  ctxt,
+                          string& buffer)
+{
+  string id;
+  if ( objectID(system_id, id) )  {
     // GET: 1458055061070516000 /lhcb.xml 0 0 SUCCESS
     int ret = getObject(id, ctxt, buffer);
     if ( ret == 1 ) return true;
@@ -69,6 +78,24 @@ bool DDDBReader::load(const string& system_id,
   return false;
 }
 
+/// Resolve a given URI to a read-only view of the data
+bool DDDBReader::loadView(const string& system_id, const char*& data, size_t& length)   {
+  return XML::UriReader::loadView(system_id, data, length);
+}
+
+/// Resolve a given URI to a read-only view of the data
+bool DDDBReader::loadView(const string& system_id,
+                          UserContext*  ctxt,
+                          const char*&  data,
+                          size_t&       length)
+{
+  string id;
+  if ( objectID(system_id, id) )  {
+    return 1 == getObjectView(id, ctxt, data, length);
+  }
+  return false;
+}
+
 /// Inform reader about a locally (e.g. by XercesC) handled source load
 void DDDBReader::parserLoaded(const std::string& system_id)  {
   return XML::UriReader::parserLoaded(system_id);
@@ -81,6 +108,13 @@ void DDDBReader::parserLoaded(const std::string& /* system_id */, UserContext* c
   c->valid_until = c->event_time;
 }
 
+/// Access raw XML object from the database / file without copy. Default: not supported
+int DDDBReader::getObjectView(const string& /* sys_id */, UserContext* /* ctxt */,
+                              const char*& /* data */, size_t& /* length */)
+{
+  return 0;
+}
+
 int DDDBReader::getObject(const string& sys_id, UserContext* /* ctxt */, string& /* out */)
 {
   except("DDDBReader","DDDBReader::getObject is a virtual method, "
@@ -0,0 +1,126 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// DDDB is a detector description convention developed by the LHCb experiment.
+// For further information concerning the DTD, please see:
+// http://lhcb-comp.web.cern.ch/lhcb-comp/Frameworks/DetDesc/Documents/lhcbDtd.pdf
+//
+//==========================================================================
+
+// Framework includes
+#include "DDDB/DDDBReader.h"
+#include "DDDB/DDDBHelper.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/LCDD.h"
+
+// ROOT include files
+#include "TTimeStamp.h"
+
+// C/C++ include files
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::DDDB;
+
+/// Anonymous namespace for plugins
+namespace {
+
+  /// Load the DDDB database with a given reader. Returns the elapsed time in seconds
+  double time_dddb_load(Geometry::LCDD& lcdd,
+                        const string& loader,
+                        const char* loader_arg,
+                        const string& directory,
+                        const string& sys_id)
+  {
+    DDDBHelper* helper = lcdd.extension<DDDBHelper>();
+    XML::UriReader* prev = helper->xmlReader();
+    TTimeStamp start;
+    /// Reader creation is part of the startup: e.g. mapping and indexing the archive
+    unique_ptr<DDDBReader> rdr((DDDBReader*)PluginService::Create<void*>(loader,loader_arg));
+    if ( !rdr.get() )  {
+      except("DDDB_ReaderBenchmark","++ Failed to create reader %s",loader.c_str());
+    }
+    rdr->setDirectory(directory);
+    helper->setXmlReader(rdr.get());
+    long long int init_time = makeTime(2016,4,1,12);
+    const void* args[] = {rdr.get(), sys_id.c_str(), "/", &init_time, 0};
+    long result = lcdd.apply("DDDB_Loader", 4, (char**)args);
+    TTimeStamp stop;
+    helper->setXmlReader(prev);
+    helper->setDetectorDescription(0);
+    if ( result != 1 )  {
+      except("DDDB_ReaderBenchmark","++ Failed to load %s with reader %s",sys_id.c_str(),loader.c_str());
+    }
+    return stop.AsDouble()-start.AsDouble();
+  }
+
+  /// Compare the startup time of the DDDB file reader and the DDDB archive reader
+  /**
+   *  Usage:
+   *   DDDB_ReaderBenchmark -directory <extracted DDDB directory e.g. /tmp/DDDB/DDDB>
+   *                        -archive   <uncompressed tar file e.g. /tmp/DDDB.tar>
+   *                        -prefix    <member prefix in the archive. Default: DDDB/DDDB>
+   *                        -input     <top document. Default: conddb:/lhcb.xml>
+   *                        -turns     <number of repetitions. Default: 3>
+   *
+   *  @author  M.Frank
+   *  @version 1.0
+   */
+  long dddb_reader_benchmark(Geometry::LCDD& lcdd, int argc, char** argv)   {
+    string directory, archive, prefix = "DDDB/DDDB", sys_id = "conddb:/lhcb.xml";
+    int    turns = 3;
+    for(int i=0; i<argc; ++i)  {
+      if      ( ::strncmp(argv[i],"-directory",4)==0 ) directory = argv[++i];
+      else if ( ::strncmp(argv[i],"-archive",4)==0 )   archive   = argv[++i];
+      else if ( ::strncmp(argv[i],"-prefix",4)==0 )    prefix    = argv[++i];
+      else if ( ::strncmp(argv[i],"-input",4)==0 )     sys_id    = argv[++i];
+      else if ( ::strncmp(argv[i],"-turns",4)==0 )     turns     = ::atol(argv[++i]);
+      else  {
+        cout <<
+          "Usage: -plugin DDDB_ReaderBenchmark -arg [-arg]                            \n"
+          "     -directory <string>  Directory of the extracted DDDB database.        \n"
+          "     -archive   <string>  Uncompressed tar archive of the DDDB database.   \n"
+          "     -prefix    <string>  Path of the database inside the archive.         \n"
+          "     -input     <string>  Top level document. Default: conddb:/lhcb.xml    \n"
+          "     -turns     <number>  Number of repetitions.                           \n"
+          "\tArguments given: " << arguments(argc,argv) << endl << flush;
+        ::exit(EINVAL);
+      }
+    }
+    if ( directory.empty() || archive.empty() )  {
+      except("DDDB_ReaderBenchmark","++ Both, the DDDB directory and the archive must be given.");
+    }
+    lcdd.apply("DDDB_InstallHelper", 0, 0);
+    double t_file = 0e0, t_archive = 0e0;
+    for(int i=0; i<turns; ++i)  {
+      double tf = time_dddb_load(lcdd, "DDDB_FileReader", 0, directory, sys_id);
+      double ta = time_dddb_load(lcdd, "DDDB_ArchiveReader", archive.c_str(), prefix, sys_id);
+      printout(INFO,"DDDB_ReaderBenchmark","++ Turn %2d: Directory reader: %8.3f sec  Archive reader: %8.3f sec",
+               i, tf, ta);
+      t_file += tf;
+      t_archive += ta;
+    }
+    if ( turns > 0 )  {
+      printout(ALWAYS,"DDDB_ReaderBenchmark","++ Mean startup time: Directory reader: %8.3f sec  "
+               "Archive reader: %8.3f sec  Ratio: %6.2f",
+               t_file/turns, t_archive/turns, t_archive > 0 ? t_file/t_archive : 0e0);
+    }
+    return 1;
+  }
+}
+DECLARE_APPLY(DDDB_ReaderBenchmark,dddb_reader_benchmark)
@@ -19,6 +19,7 @@
 #include "DD4hep/Plugins.h"
 #include "DD4hep/Printout.h"
 #include "DD4hep/Primitives.h"
+#include "DDG4/Geant4Dispatch.h"
 
 // C/C++ include files
 #include <string>
@@ -96,7 +97,7 @@ namespace {
 
   /// Factory to create Geant4 action objects
   DD4HEP_PLUGIN_FACTORY_ARGS_2(DS::Geant4Action*,_ns::CT*, std::string)
-  {    return new P(a0,a1);  }
+  {    return DS::Geant4NoOpCallbacks::mark(new P(a0,a1));  }
 
   /// Factory to create Geant4 equations of motion for magnetic fields
   DD4HEP_PLUGIN_FACTORY_ARGS_1(G4Mag_EqRhs*,G4MagneticField*)
@@ -19,6 +19,7 @@
 #include "DD4hep/ComponentProperties.h"
 #include "DDG4/Geant4Context.h"
 #include "DDG4/Geant4Callback.h"
+#include "DDG4/Geant4ActionProfiler.h"
 
 // Geant4 forward declarations
 class G4Run;
@@ -43,6 +44,7 @@ namespace DD4hep {
 
     // Forward declarations
     class Geant4UIMessenger;
+    class Geant4ActionLock;
 
     /// Cast operator
     template <typename TO, typename FROM> TO fast_cast(FROM from) {
@@ -105,6 +107,10 @@ namespace DD4hep {
       PropertyManager    m_properties;
       /// Reference count. Initial value: 1
       long               m_refCount = 1;
+      /// Default property: Reentrant. Shared actions call reentrant actions without locking
+      bool               m_reentrant = false;
+      /// Callbacks inherited unchanged from the empty base implementations (see Geant4NoOpCallbacks)
+      unsigned int       m_noOpCallbacks = 0;
 
     public:
       /// Functor to update the context of a Geant4Action object
@@ -131,6 +137,15 @@ namespace DD4hep {
 
     protected:
 
+      /// Execute a callback sequence. If enabled, the calls are profiled as one entry of this action
+      template <typename... ARGS>
+      void profiled(const char* cb, const CallbackSequence& seq, ARGS... args)  const  {
+        if ( !seq.empty() )  {
+          Geant4ActionProfiler::Timer timer(this, cb);
+          seq(args...);
+        }
+      }
+
       /// Functor to access elements by name
       struct FindByName  {
         std::string _n;
@@ -212,6 +227,32 @@ namespace DD4hep {
           for (typename _V::const_iterator i = m_v.begin(); i != m_v.end(); ++i)
             ((*i)->*pmf)(a0, a1);
         }
+        /// NON-CONST actions with optional profiling. The callback name must be a string literal
+        template <typename R, typename Q> void profiled(const char* cb, R (Q::*pmf)()) {
+          if (!Geant4ActionProfiler::enabled())
+            return (*this)(pmf);
+          for (typename _V::iterator i = m_v.begin(); i != m_v.end(); ++i)  {
+            Geant4ActionProfiler::Timer timer(*i, cb);
+            ((*i)->*pmf)();
+          }
+        }
+        template <typename R, typename Q, typename A0> void profiled(const char* cb, R (Q::*pmf)(A0), A0 a0) {
+          if (!Geant4ActionProfiler::enabled())
+            return (*this)(pmf, a0);
+          for (typename _V::iterator i = m_v.begin(); i != m_v.end(); ++i)  {
+            Geant4ActionProfiler::Timer timer(*i, cb);
+            ((*i)->*pmf)(a0);
+          }
+        }
+        template <typename R, typename Q, typename A0, typename A1>
+        void profiled(const char* cb, R (Q::*pmf)(A0, A1), A0 a0, A1 a1) {
+          if (!Geant4ActionProfiler::enabled())
+            return (*this)(pmf, a0, a1);
+          for (typename _V::iterator i = m_v.begin(); i != m_v.end(); ++i)  {
+            Geant4ActionProfiler::Timer timer(*i, cb);
+            ((*i)->*pmf)(a0, a1);
+          }
+        }
         /// CONST filters
         template <typename Q> bool filter(bool (Q::*pmf)() const) const {
           if (!m_v.empty())
@@ -279,6 +320,18 @@ namespace DD4hep {
       void setName(const std::string& new_name) {
         m_name = new_name;
       }
+      /// Concurrency contract: may the action be called concurrently by several threads?
+      bool isReentrant() const  {
+        return m_reentrant;
+      }
+      /// Mask of the callbacks not overloaded by the concrete action type. Set by the action factory
+      unsigned int noOpCallbacks() const  {
+        return m_noOpCallbacks;
+      }
+      /// Set the mask of the callbacks not overloaded by the concrete action type
+      void setNoOpCallbacks(unsigned int mask)  {
+        m_noOpCallbacks = mask;
+      }
       /// Access to the properties of the object
       PropertyManager& properties() {
         return m_properties;
@@ -0,0 +1,108 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4ACTIONPROFILER_H
+#define DD4HEP_DDG4_GEANT4ACTIONPROFILER_H
+
+// C/C++ include files
+#include <atomic>
+#include <string>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    // Forward declarations
+    class Geant4Action;
+
+    /// Opt-in profiling of the callbacks dispatched by the action sequences
+    /**
+     *  If enabled, the action sequences time every call to their actions.
+     *  For each action instance and callback type the number of calls,
+     *  the cumulative wall and CPU time and logarithmic histograms of
+     *  both are recorded. The wall time is measured using the time stamp
+     *  counter of the CPU, the CPU time using the thread CPU clock.
+     *  Data are accumulated in thread local stores without locking and
+     *  aggregated by action name across all worker threads when the summary
+     *  is printed. Optionally the individual calls are recorded
+     *  to be written as Chrome trace-event JSON file (chrome://tracing).
+     *
+     *  The profiler is controlled by the Geant4ProfilerAction run action.
+     *  If disabled the overhead is one check per action sequence callback.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ActionProfiler  {
+    public:
+      /// Number of logarithmic histogram bins (bin i: [2^i, 2^(i+1)) nanoseconds)
+      enum { NUM_BINS = 40 };
+
+    protected:
+      /// Global enable flag
+      static std::atomic<bool> s_enabled;
+
+      /// Start the measurement of one call
+      static void start(unsigned long long& ticks, long long& cpu);
+      /// Record the measurement of one call
+      static void record(const Geant4Action* action, const char* callback,
+                         unsigned long long ticks, long long cpu);
+
+    public:
+      /// Scoped measurement of one call
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Timer  {
+        const Geant4Action* action;
+        const char*         callback;
+        unsigned long long  ticks;
+        long long           cpu;
+      public:
+        /// Constructor. Starts the measurement if the profiler is enabled.
+        /** The callback name must be a string literal: it is used as key */
+        Timer(const Geant4Action* a, const char* cb)
+          : action(enabled() ? a : 0), callback(cb), ticks(0), cpu(0)
+        {
+          if ( action ) start(ticks, cpu);
+        }
+        /// Destructor. Records the measurement
+        ~Timer()  {
+          if ( action ) record(action, callback, ticks, cpu);
+        }
+      };
+
+      /// Check if the profiler is enabled
+      static bool enabled()  {
+        return s_enabled.load(std::memory_order_relaxed);
+      }
+      /// Enable the profiler
+      static void enable(bool measure_cpu, size_t max_trace_events);
+      /// Disable the profiler
+      static void disable();
+      /// Reset all counters. Only call while the worker threads are idle!
+      static void reset();
+      /// Print the sorted summary. Only call while the worker threads are idle!
+      static void summary(int print_level, size_t max_lines, bool histograms);
+      /// Write the recorded calls as Chrome trace-event JSON. Only call while the worker threads are idle!
+      static bool writeTrace(const std::string& file_name);
+    };
+
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+
+#endif // DD4HEP_DDG4_GEANT4ACTIONPROFILER_H
@@ -0,0 +1,182 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4CONCURRENCY_H
+#define DD4HEP_DDG4_GEANT4CONCURRENCY_H
+
+// Framework include files
+#include "DDG4/Geant4Action.h"
+
+// C/C++ include files
+#include <atomic>
+#include <mutex>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Lock protecting the callbacks of one action shared between worker threads
+    /**
+     *  Concurrency contract of shared actions:
+     *  - Actions declaring themselves reentrant (property "Reentrant", Geant4Action::isReentrant())
+     *    are called concurrently without any lock and without context swap.
+     *    Such actions may not use the context of the action: all event related
+     *    information must be taken from the callback arguments.
+     *  - All other actions are serialized with a lock private to the action instance.
+     *    Independent shared actions hence do not block each other.
+     *
+     *  One lock object exists per shared action instance. It is acquired by every
+     *  thread local wrapper and deleted together with the last wrapper.
+     *  The time spent by worker threads waiting for the lock is accumulated
+     *  and printed when the lock is deleted.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ActionLock  {
+    protected:
+      /// Protection mutex
+      std::mutex   m_mutex;
+      /// Name of the protected action
+      std::string  m_name;
+      /// Number of wrappers using this lock
+      long         m_refCount = 1;
+      /// Number of locked calls
+      long         m_calls = 0;
+      /// Number of calls, which had to wait for the lock
+      long         m_contended = 0;
+      /// Total time waited for the lock in nanoseconds
+      long long    m_waitTime = 0;
+      /// Protected action. The concurrency contract is queried at execution time
+      const Geant4Action* m_action;
+
+      /// Initializing constructor
+      Geant4ActionLock(const Geant4Action* action);
+      /// Default destructor. Prints the lock statistics
+      ~Geant4ActionLock();
+
+    public:
+      /// Scoped protection of one callback. Accumulates the lock wait time.
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Guard  {
+        Geant4ActionLock* lock;
+      public:
+        /// Constructor. Acquires the lock
+        Guard(Geant4ActionLock* l);
+        /// Destructor. Releases the lock
+        ~Guard()  {  lock->m_mutex.unlock();  }
+      };
+
+      /// Access the lock of a shared action. Creates the lock on first access.
+      static Geant4ActionLock* acquire(const Geant4Action* action);
+      /// Release a lock reference. The last release deletes the lock
+      static void release(Geant4ActionLock* lock);
+
+      /// Flag if the protected action is reentrant
+      bool reentrant() const  {  return m_action->isReentrant();  }
+      /// Execute a callback of a shared action according to its concurrency contract
+      template <typename CALL>
+      void execute(Geant4Action* action, Geant4Context* ctxt, CALL call)  {
+        if ( m_action->isReentrant() )  {
+          call();
+          return;
+        }
+        Guard protection_lock(this);  {
+          Geant4Action::ContextSwap swap(action, ctxt);
+          call();
+        }
+      }
+    };
+
+    /// Dense index of the calling thread for the use with Geant4PerThread
+    /**
+     *  The slot is returned when the thread exits and handed to the next new thread.
+     *  Thread local instances of Geant4PerThread are hence reused by later threads
+     *  and keep accumulating their data.
+     */
+    int geant4ThreadSlot();
+
+    /// Per thread accumulation of data with a merge after the processing
+    /**
+     *  Statistics gathering actions declared reentrant accumulate their data
+     *  in a thread local instance, which is accessed without any locking.
+     *  The thread local instances are merged once the worker threads are idle,
+     *  e.g. in the end-of-run callback of the master or in the destructor:
+     *
+     *  \code
+     *    struct Counters { long events = 0; double energy = 0; };
+     *    Geant4PerThread<Counters> m_counters;
+     *    ...
+     *    void end(const G4Event* evt)  {  ++m_counters.local().events;  }
+     *    ...
+     *    long events = 0;
+     *    m_counters.merge([&events](const Counters& c) { events += c.events; });
+     *  \endcode
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    template <typename T, int N=256> class Geant4PerThread  {
+      /// Thread local instances indexed by geant4ThreadSlot()
+      std::atomic<T*> m_slots[N];
+    public:
+      /// Default constructor
+      Geant4PerThread()  {
+        for(int i=0; i<N; ++i) m_slots[i] = 0;
+      }
+      /// Inhibit copy constructor
+      Geant4PerThread(const Geant4PerThread& copy) = delete;
+      /// Inhibit assignment operator
+      Geant4PerThread& operator=(const Geant4PerThread& copy) = delete;
+      /// Default destructor
+      ~Geant4PerThread()  {
+        clear();
+      }
+      /// Access the instance of the calling thread. Created on first access.
+      T& local()  {
+        int slot = geant4ThreadSlot();
+        if ( slot >= N )  {
+          except("Geant4PerThread","+++ Thread slot %d exceeds the maximum of %d threads.",slot,N);
+        }
+        T* p = m_slots[slot].load(std::memory_order_acquire);
+        if ( !p )  {
+          p = new T();
+          m_slots[slot].store(p, std::memory_order_release);
+        }
+        return *p;
+      }
+      /// Call a functor for all thread local instances. Only call with idle workers!
+      template <typename F> void merge(F func)  const  {
+        for(int i=0; i<N; ++i)  {
+          const T* p = m_slots[i].load(std::memory_order_acquire);
+          if ( p ) func(*p);
+        }
+      }
+      /// Delete all thread local instances. Only call with idle workers!
+      void clear()  {
+        for(int i=0; i<N; ++i)
+          delete m_slots[i].exchange(0);
+      }
+    };
+
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+
+#endif // DD4HEP_DDG4_GEANT4CONCURRENCY_H
@@ -17,6 +17,7 @@
 // Framework incloude files
 #include "DD4hep/Primitives.h"
 #include "DD4hep/ObjectExtensions.h"
+#include "DDG4/Geant4RandomStream.h"
 
 // Forward declarations
 class G4Run;
@@ -116,6 +117,9 @@ namespace DD4hep {
      *  Any random numbers used to process one event should be accessed
      *  from this location. The framework ensures that the same seeded
      *  sequence is used throughout the processing of one single event.
+     *  Components not using the Geant4 engine should use the counter
+     *  based random streams, which are independent of the thread
+     *  processing the event (see Geant4RandomStream).
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -126,10 +130,12 @@ namespace DD4hep {
       const G4Event* m_event;
       /// Reference to the main random number generator
       Geant4Random* m_random;
+      /// Key of the random streams of this event
+      unsigned long long m_streamKey;
 
     public:
       /// Intializing constructor
-      Geant4Event(const G4Event* run, Geant4Random* rndm);
+      Geant4Event(const G4Event* run, Geant4Random* rndm, unsigned long long stream_key=0);
       /// Default destructor
       virtual ~Geant4Event();
       /// Access the G4Event directly: Automatic type conversion
@@ -138,6 +144,10 @@ namespace DD4hep {
       const G4Event& event() const     {  return *m_event;   }
       /// Access the random number generator
       Geant4Random& random() const     {  return *m_random;  }
+      /// Access the counter based random stream of a named consumer
+      Geant4RandomStream randomStream(const std::string& consumer) const  {
+        return Geant4RandomStream(m_streamKey, Geant4RandomStream::streamID(consumer));
+      }
 
       /// Add an extension object to the detector element
       /** Note:
@@ -193,6 +203,8 @@ namespace DD4hep {
       Geant4Event& event()  const;
       /// Access the geant4 event by ptr. Must be checked by clients!
       Geant4Event* eventPtr()  const  { return m_event; }
+      /// Access the random stream of a named consumer for the current event
+      Geant4RandomStream randomStream(const std::string& consumer)  const;
       /// Access to the kernel object
       Geant4Kernel& kernel()  const   { return *m_kernel;   }
       /// Access to detector description
@@ -17,6 +17,10 @@
 #include "DD4hep/Printout.h"
 #include "DDG4/Geant4Mapping.h"
 
+// C/C++ include files
+#include <unordered_map>
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
@@ -33,6 +37,11 @@ namespace DD4hep {
     public:
       bool m_checkOverlaps;
       PrintLevel m_outputLevel;
+      /// Geant4 solids shared by all shapes with identical type and parameters
+      mutable std::unordered_map<std::string, G4VSolid*> m_sharedSolids;
+
+      /// Access the parameters of a primitive shape. Returns false for composite and unknown shapes
+      static bool shapeParameters(const TGeoShape* shape, std::vector<double>& params);
 
       /// Initializing Constructor
       Geant4Converter(LCDD& lcdd);
@@ -0,0 +1,162 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4DISPATCH_H
+#define DD4HEP_DDG4_GEANT4DISPATCH_H
+
+// Framework include files
+#include "DD4hep/Callback.h"
+
+// C/C++ include files
+#include <type_traits>
+#include <vector>
+
+// Forward declarations
+class G4Step;
+class G4Track;
+class G4SteppingManager;
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    // Forward declarations
+    class Geant4SteppingAction;
+    class Geant4TrackingAction;
+
+    /// Flat dispatch table of an action sequence
+    /**
+     *  A sequence compiles its actors and callbacks into a single array of
+     *  entries. Each entry is a plain function pointer with the pre-bound
+     *  object, so that the dispatch of one callback is a single loop without
+     *  iterating over several containers and without repacking the arguments
+     *  for every member function wrapper.
+     *
+     *  The table does not own the objects. It must be rebuilt whenever the
+     *  actors or the callbacks of the sequence change.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    template <typename... ARGS> class Geant4DispatchTable  {
+    public:
+      /// Signature of the entry functions
+      typedef void (*call_t)(void* object, const void* data, ARGS... args);
+      /// Definition of one table entry
+      struct Entry  {
+        call_t      call;
+        void*       object;
+        const void* data;
+      };
+
+    protected:
+      /// The table entries in the order of the calls
+      std::vector<Entry> m_entries;
+
+      /// Entry function for actors: call of the member function PMF
+      template <typename T, void (T::*PMF)(ARGS...)>
+      static void call_member(void* object, const void* /* data */, ARGS... args)  {
+        (static_cast<T*>(object)->*PMF)(args...);
+      }
+      /// Entry function for callbacks: the callback is the entry data
+      static void call_callback(void* /* object */, const void* data, ARGS... args)  {
+        const void* arguments[sizeof...(ARGS)] = { args... };
+        static_cast<const Callback*>(data)->execute(arguments);
+      }
+
+    public:
+      /// Number of entries
+      size_t size() const            {  return m_entries.size();   }
+      /// Check if the table is empty
+      bool empty() const             {  return m_entries.empty();  }
+      /// Remove all entries
+      void clear()                   {  m_entries.clear();         }
+      /// Add an actor. The member function PMF is bound at compile time
+      template <typename T, void (T::*PMF)(ARGS...)> void add(T* object)  {
+        Entry e = { call_member<T,PMF>, object, 0 };
+        m_entries.push_back(e);
+      }
+      /// Add all callbacks of a callback sequence. The sequence must not change while the table is used
+      void add(const CallbackSequence& seq)  {
+        for(const Callback& cb : seq.callbacks)  {
+          Entry e = { call_callback, 0, &cb };
+          m_entries.push_back(e);
+        }
+      }
+      /// Dispatch the call to all entries
+      void operator()(ARGS... args)  const  {
+        for(const Entry& e : m_entries)
+          e.call(e.object, e.data, args...);
+      }
+    };
+
+    /// Detection of callbacks, which are not overloaded by a concrete action type
+    /**
+     *  The action factory marks every action it creates with the callbacks
+     *  the concrete type inherits unchanged from the empty implementations
+     *  of the base classes. The action sequences leave such actors out of
+     *  their dispatch tables.
+     *
+     *  The check is done at compile time on the declaring class of the
+     *  member function. Actions created without the factory are not marked
+     *  and hence are always called.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4NoOpCallbacks  {
+    public:
+      /// Flags of the callbacks with empty base implementations
+      enum Callbacks  {
+        STEP        = 1<<0,
+        BEGIN_TRACK = 1<<1,
+        END_TRACK   = 1<<2
+      };
+
+    protected:
+      /// Result type if the declaring class cannot be determined
+      struct Unknown  {};
+      /// Declaring class of the stepping callback
+      template <typename C> static C* step_class(void (C::*)(const G4Step*, G4SteppingManager*));
+      /// Declaring class of the tracking callbacks
+      template <typename C> static C* track_class(void (C::*)(const G4Track*));
+
+      template <typename P> static auto step_owner(int) -> decltype(step_class(&P::operator()));
+      template <typename P> static Unknown step_owner(...);
+      template <typename P> static auto begin_owner(int) -> decltype(track_class(&P::begin));
+      template <typename P> static Unknown begin_owner(...);
+      template <typename P> static auto end_owner(int) -> decltype(track_class(&P::end));
+      template <typename P> static Unknown end_owner(...);
+
+    public:
+      /// Mask of the callbacks not overloaded by the concrete action type P
+      template <typename P> static unsigned int mask()  {
+        unsigned int m = 0;
+        if ( std::is_same<decltype(step_owner<P>(0)),  Geant4SteppingAction*>::value ) m |= STEP;
+        if ( std::is_same<decltype(begin_owner<P>(0)), Geant4TrackingAction*>::value ) m |= BEGIN_TRACK;
+        if ( std::is_same<decltype(end_owner<P>(0)),   Geant4TrackingAction*>::value ) m |= END_TRACK;
+        return m;
+      }
+      /// Mark a newly created action
+      template <typename P> static P* mark(P* action)  {
+        action->setNoOpCallbacks(mask<P>());
+        return action;
+      }
+    };
+
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+#endif // DD4HEP_DDG4_GEANT4DISPATCH_H
@@ -0,0 +1,141 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4FASTSIMSHOWERMODEL_H
+#define DD4HEP_DDG4_GEANT4FASTSIMSHOWERMODEL_H
+
+// Framework include files
+#include "DDG4/Geant4DetectorConstruction.h"
+
+// Geant4 include files
+#include "G4TouchableHandle.hh"
+#include "G4ThreeVector.hh"
+
+// C/C++ include files
+#include <vector>
+#include <set>
+
+// Forward declarations
+class G4Step;
+class G4FastStep;
+class G4FastTrack;
+class G4Navigator;
+class G4ParticleDefinition;
+class G4VFastSimulationModel;
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Helper to deposit energy spots through the sensitive detectors of the hit volumes
+    /**
+     *  The volume containing the spot is located with a private navigator.
+     *  If the volume is sensitive, a step with the deposited energy
+     *  is handed to the sensitive detector. The hits are hence created
+     *  by the same Geant4Sensitive actions used for full simulation.
+     *
+     *  One instance exists per worker thread.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FastSimHitMaker  {
+    protected:
+      /// Navigator to locate the spots
+      G4Navigator*      m_navigator = 0;
+      /// Touchable of the current spot
+      G4TouchableHandle m_touchable;
+      /// Step handed to the sensitive detectors
+      G4Step*           m_step = 0;
+      /// Flag if the navigator is initialized
+      bool              m_initialized = false;
+      /// Number of spots deposited in sensitive volumes
+      long              m_numHits = 0;
+      /// Number of spots outside sensitive volumes
+      long              m_numLost = 0;
+    public:
+      /// Default constructor
+      Geant4FastSimHitMaker();
+      /// Inhibit copy constructor
+      Geant4FastSimHitMaker(const Geant4FastSimHitMaker& copy) = delete;
+      /// Inhibit assignment operator
+      Geant4FastSimHitMaker& operator=(const Geant4FastSimHitMaker& copy) = delete;
+      /// Default destructor
+      ~Geant4FastSimHitMaker();
+      /// Deposit energy at a global position. Returns false if the volume is not sensitive.
+      bool deposit(const G4FastTrack& track, const G4ThreeVector& position, double energy, double time);
+      /// Number of spots deposited in sensitive volumes
+      long numHits()  const  {  return m_numHits;  }
+      /// Number of spots outside sensitive volumes
+      long numLost()  const  {  return m_numLost;  }
+    };
+
+    /// Base class of fast simulation models attached to a region
+    /**
+     *  The action creates a Geant4 fast simulation model for the region
+     *  given by the property "RegionName" during the construction of the
+     *  sensitive detectors, i.e. once per worker thread. The callbacks of the
+     *  Geant4 model are forwarded to this action:
+     *  - check():       Is the model applicable to a given particle type?
+     *                   Default: the particle is in the list "ApplicableParticles".
+     *  - trigger():     Should the model be triggered for this track?
+     *                   Default: the kinetic energy is inside [Emin, Emax].
+     *  - modelShower(): Create the shower. Energy is deposited using the hit maker.
+     *                   Pure virtual: every concrete model must implement it.
+     *
+     *  Note:
+     *  The physics list must contain the fast simulation process for the
+     *  applicable particles (see the physics constructor Geant4FastPhysics).
+     *  The action is shared by all worker threads. The callbacks may not modify
+     *  the state of the action.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FastSimShowerModel : public Geant4DetectorConstruction  {
+    protected:
+      /// Property: Region name to which this model is attached
+      std::string              m_regionName;
+      /// Property: Names of the particles to which this model is applicable
+      std::vector<std::string> m_applicableParticleNames;
+      /// Property: Enable/disable the model
+      bool                     m_enable;
+      /// Property: Minimal kinetic energy to trigger the model
+      double                   m_eMin;
+      /// Property: Maximal kinetic energy to trigger the model
+      double                   m_eMax;
+      /// Particle definitions of the applicable particles
+      std::set<const G4ParticleDefinition*> m_applicableParticles;
+      /// Geant4 models of all threads. The fast simulation managers do not own them
+      std::vector<G4VFastSimulationModel*>  m_models;
+
+    public:
+      /// Standard constructor
+      Geant4FastSimShowerModel(Geant4Context* context, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4FastSimShowerModel();
+      /// Sensitive detector construction callback. Creates the Geant4 model of this thread.
+      virtual void constructSensitives(Geant4DetectorConstructionContext* ctxt);
+      /// Geant4 callback: Is the model applicable to the particle type?
+      virtual bool check(const G4ParticleDefinition& particle)  const;
+      /// Geant4 callback: Should the model be triggered for this track?
+      virtual bool trigger(const G4FastTrack& track)  const;
+      /// Geant4 callback: Create the shower and deposit its energy
+      virtual void modelShower(const G4FastTrack& track, G4FastStep& step, Geant4FastSimHitMaker& hits)  const = 0;
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+#endif // DD4HEP_DDG4_GEANT4FASTSIMSHOWERMODEL_H
@@ -0,0 +1,100 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4FROZENSHOWERLIBRARY_H
+#define DD4HEP_DDG4_GEANT4FROZENSHOWERLIBRARY_H
+
+// C/C++ include files
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Library of pre-simulated electromagnetic showers
+    /**
+     *  Each shower is stored as a set of energy spots in the frame of the shower:
+     *  z is the distance along the direction of the incoming particle from the
+     *  shower start, x and y are transverse. The spot energy is stored as fraction
+     *  of the energy of the incoming particle.
+     *
+     *  File format (native byte order):
+     *  - Header:  magic "DDG4FSL", version, number of showers, number of spots
+     *  - Showers: energy, particle class, index of the first spot, number of spots
+     *  - Spots:   x, y, z, energy fraction as 32 bit floats
+     *
+     *  Showers are sorted by particle class (22: photons, 11: electrons and positrons)
+     *  and energy. A shower is sampled from the showers of the nearest recorded energy.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FrozenShowerLibrary  {
+    public:
+      /// Energy spot of a shower
+      struct Spot  {
+        float x, y, z, energy;
+      };
+      /// Shower entry
+      struct Shower  {
+        float        energy;
+        int          particle;
+        unsigned int first;
+        unsigned int count;
+      };
+      typedef std::vector<Shower> Showers;
+      typedef std::vector<Spot>   Spots;
+
+    protected:
+      /// Shower directory
+      Showers m_showers;
+      /// Energy spots of all showers
+      Spots   m_spots;
+      /// Flag if the showers are sorted
+      bool    m_sorted = true;
+
+      /// Sort the showers by particle class and energy
+      void sort();
+
+    public:
+      /// Default constructor
+      Geant4FrozenShowerLibrary() = default;
+      /// Default destructor
+      ~Geant4FrozenShowerLibrary() = default;
+      /// Particle class used as library key for a PDG code. Returns 0 if not supported.
+      static int particleClass(int pdg);
+      /// Load a library file. Throws an exception on failure
+      void load(const std::string& file_name);
+      /// Save the library to file. Throws an exception on failure
+      void save(const std::string& file_name);
+      /// Add a shower
+      void add(int pdg, double energy, const Spots& spots);
+      /// Select a shower of the nearest recorded energy. Returns 0 if none is present.
+      const Shower* sample(int pdg, double energy, double rndm)  const;
+      /// Access the first spot of a shower
+      const Spot* spots(const Shower& s)  const  {  return &m_spots[s.first];  }
+      /// Number of showers
+      size_t numShowers()  const  {  return m_showers.size();  }
+      /// Number of spots
+      size_t numSpots()  const    {  return m_spots.size();    }
+      /// Memory used by the library in bytes
+      size_t bytes()  const  {
+        return m_showers.size()*sizeof(Shower) + m_spots.size()*sizeof(Spot);
+      }
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+#endif // DD4HEP_DDG4_GEANT4FROZENSHOWERLIBRARY_H
@@ -68,8 +68,10 @@ namespace DD4hep {
      * multi-threaded purposes. The wrapper ensures the locking
      * of the basic actions to avoid race conditions.
      *
-     * Shared action should be 'fast'. The global lock otherwise
-     * inhibits the efficient use of the multiple threads.
+     * Non-reentrant actions are protected by a lock private to the
+     * shared action instance (see Geant4ActionLock). Reentrant actions
+     * are called without locking. Shared actions should be 'fast':
+     * the lock otherwise inhibits the efficient use of the multiple threads.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -79,6 +81,8 @@ namespace DD4hep {
     protected:
       /// Reference to the shared action
       Geant4GeneratorAction* m_action = 0;
+      /// Lock protecting the shared action
+      Geant4ActionLock* m_lock = 0;
     public:
       /// Default constructor
       Geant4SharedGeneratorAction() = default;
@@ -0,0 +1,88 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4GEOMETRYCACHE_H
+#define DD4HEP_DDG4_GEANT4GEOMETRYCACHE_H
+
+// Framework include files
+#include "DDG4/Geant4Converter.h"
+
+// C/C++ include files
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Cache of the converted Geant4 geometry
+    /**
+     *  The converted geometry is written to a GDML file together with a
+     *  small text file holding the relations between the DD4hep placements
+     *  and the Geant4 placements. Both file names contain a checksum of the
+     *  geometry: volumes, shapes, materials and placements. A changed
+     *  geometry hence never picks up a stale cache.
+     *
+     *  When restoring, the GDML file replaces the conversion of the solids,
+     *  materials, logical volumes and placements. The maps of the
+     *  Geant4GeometryInfo are rebuilt from the relation file. Regions,
+     *  limits, visualisation attributes and the properties (fields),
+     *  which are not part of GDML, are converted as usual.
+     *
+     *  Geometries with parameterised placements cannot be cached.
+     *  Requires Geant4 with GDML support (GEANT4_HAS_GDML).
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4GeometryCache  {
+    public:
+      typedef Geometry::DetElement DetElement;
+      /// Key of a placement: (ordinal of the mother volume, index of the daughter)
+      typedef std::pair<int,int> NodeKey;
+
+    protected:
+      /// Reference to the geometry converter
+      Geant4Converter&                m_converter;
+      /// Prefix of the cache file names
+      std::string                     m_prefix;
+      /// All volumes in deterministic order (depth first traversal, daughters in order)
+      std::vector<const TGeoVolume*>  m_volumes;
+      /// Geometry checksum
+      unsigned long long              m_checksum;
+
+      /// Enumerate the volumes below the top element and compute the checksum
+      void scan(DetElement top);
+
+    public:
+      /// Initializing constructor
+      Geant4GeometryCache(Geant4Converter& converter, const std::string& prefix);
+      /// Default destructor
+      virtual ~Geant4GeometryCache();
+      /// Access the geometry checksum
+      unsigned long long checksum()  const  {  return m_checksum;  }
+      /// Name of the cached GDML file
+      std::string gdmlFile()  const;
+      /// Name of the file with the placement relations
+      std::string mappingFile()  const;
+      /// Restore the converted geometry from the cache. Returns false if no valid cache exists
+      bool restore(DetElement top);
+      /// Save the geometry converted before. Returns false if the geometry cannot be cached
+      bool save(DetElement top);
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+
+#endif // DD4HEP_DDG4_GEANT4GEOMETRYCACHE_H
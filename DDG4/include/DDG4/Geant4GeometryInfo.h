@@ -23,6 +23,7 @@
 // C/C++ include files
 #include <map>
 #include <vector>
+#include <unordered_map>
 
 // Forward declarations (TGeo)
 class TGeoElement;
@@ -68,22 +69,26 @@ namespace DD4hep {
       using Geometry::LimitSet;
       using Geometry::SensitiveDetector;
 
+      typedef Geometry::GeoHandlerTypes::PointerHash PointerHash;
       typedef std::vector<const G4VPhysicalVolume*> Geant4PlacementPath;
-      typedef std::map<Atom, G4Element*> ElementMap;
-      typedef std::map<Material, G4Material*> MaterialMap;
-      typedef std::map<LimitSet, G4UserLimits*> LimitMap;
-      typedef std::map<PlacedVolume, G4VPhysicalVolume*> PlacementMap;
-      typedef std::map<Region, G4Region*> RegionMap;
-      typedef std::map<Volume, G4LogicalVolume*> VolumeMap;
-      typedef std::map<PlacedVolume, Geant4AssemblyVolume*>  AssemblyMap;
+      typedef std::unordered_map<Atom, G4Element*, PointerHash> ElementMap;
+      typedef std::unordered_map<Material, G4Material*, PointerHash> MaterialMap;
+      typedef std::unordered_map<LimitSet, G4UserLimits*, PointerHash> LimitMap;
+      typedef std::unordered_map<PlacedVolume, G4VPhysicalVolume*, PointerHash> PlacementMap;
+      typedef std::unordered_map<Region, G4Region*, PointerHash> RegionMap;
+      typedef std::unordered_map<Volume, G4LogicalVolume*, PointerHash> VolumeMap;
+      typedef std::unordered_map<PlacedVolume, Geant4AssemblyVolume*, PointerHash>  AssemblyMap;
 
       typedef std::vector<const TGeoNode*> VolumeChain;
       typedef std::pair<VolumeChain,const G4VPhysicalVolume*> ImprintEntry;
       typedef std::vector<ImprintEntry> Imprints;
-      typedef std::map<Volume,Imprints>   VolumeImprintMap;
-      typedef std::map<const TGeoShape*, G4VSolid*> SolidMap;
-      typedef std::map<VisAttr, G4VisAttributes*> VisMap;
+      typedef std::unordered_map<Volume,Imprints, PointerHash>   VolumeImprintMap;
+      typedef std::unordered_map<const TGeoShape*, G4VSolid*, PointerHash> SolidMap;
+      typedef std::unordered_map<VisAttr, G4VisAttributes*, PointerHash> VisMap;
       typedef std::map<Geant4PlacementPath, VolumeID> Geant4PathMap;
+      /// Volume ID fields derived from replica numbers: (path depth, (bit offset, bit mask))
+      typedef std::vector<std::pair<int,std::pair<int,VolumeID> > > ReplicaFields;
+      typedef std::map<Geant4PlacementPath, ReplicaFields> Geant4ReplicaMap;
 
       typedef Geometry::GeoHandlerTypes::SensitiveVolumes SensitiveVolumes;
       typedef Geometry::GeoHandlerTypes::RegionVolumes RegionVolumes;
@@ -111,6 +116,7 @@ namespace DD4hep {
       Geant4GeometryMaps::VisMap g4Vis;
       Geant4GeometryMaps::LimitMap g4Limits;
       Geant4GeometryMaps::Geant4PathMap g4Paths;
+      Geant4GeometryMaps::Geant4ReplicaMap g4Replicas;
       Geant4GeometryMaps::SensitiveVolumes sensitives;
       Geant4GeometryMaps::RegionVolumes regions;
       Geant4GeometryMaps::LimitVolumes limits;
@@ -35,6 +35,11 @@ namespace DD4hep {
      * the corresponding errors. The interaction to be modified is identified by the
      * interaction's unique mask.
      *
+     * If the property UseRandomStream is set, the smearing values are drawn from
+     * the counter based random stream of the action and the interaction
+     * (see Geant4RandomStream) rather than the Geant4 engine: the result is then
+     * independent of the thread processing the event.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -51,6 +56,8 @@ namespace DD4hep {
       ROOT::Math::PxPyPzEVector m_sigma;
       /// Property: Unique identifier of the interaction created
       int m_mask;
+      /// Property: Use the counter based random stream instead of the Geant4 engine
+      bool m_useRandomStream;
 
       /// Action routine to smear one single interaction according to the properties
       void smear(Interaction* interaction)  const;
@@ -83,6 +83,8 @@ namespace DD4hep {
       //bool        m_multiThreaded;
       /// Master property: Number of execution threads in multi threaded mode.
       int         m_numThreads;
+      /// Master property: Seed of the counter based random streams
+      long        m_streamSeed;
       /// Flag: Master instance (id<0) or worker (id >= 0)
       unsigned long      m_id, m_ident;
       /// Parent reference
@@ -111,6 +113,9 @@ namespace DD4hep {
       //bool isMultiThreaded() const { return m_multiThreaded; }
       bool isMultiThreaded() const { return m_numThreads > 0; }
 
+      /// Seed of the counter based random streams (see Geant4RandomStream)
+      unsigned long randomStreamSeed() const  { return (unsigned long)m_master->m_streamSeed; }
+
       /// Access thread identifier
       static unsigned long int thread_self();
 
@@ -0,0 +1,115 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4PILEUPOVERLAY_H
+#define DD4HEP_DDG4_GEANT4PILEUPOVERLAY_H
+
+// Framework include files
+#include "DDG4/Geant4GeneratorAction.h"
+
+// ROOT include files
+#include "Math/Vector4D.h"
+
+// C/C++ include files
+#include <vector>
+#include <map>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Forward declarations
+    class Geant4PrimaryInteraction;
+
+    /// Generator action overlaying pile-up interactions read from background files
+    /**
+     *  For every input stream and every bunch crossing in the range
+     *  [FirstCrossing, LastCrossing] a poisson distributed number of
+     *  background events with the mean MeanPileup is added to the primary
+     *  event. Each event becomes an interaction of its own with a unique mask
+     *  starting at Mask. The vertex of each interaction is smeared with the
+     *  gaussian given by Offset and Sigma; the time is in addition shifted
+     *  by the crossing number times BunchSpacing.
+     *
+     *  The events are read and parsed by one background thread per input
+     *  stream into a bounded buffer of Prefetch events, so that the event
+     *  loop only waits for the input if the buffer runs dry.
+     *  Exhausted inputs are reopened if Rewind is set.
+     *
+     *  The interactions are merged with the other interactions by the
+     *  Geant4InteractionMerger. Vertex smearing actions for all interactions
+     *  (Mask=-1) must be placed before the overlay. In multi-threaded mode
+     *  the overlay should be a single shared action, so that all worker
+     *  threads consume the same input streams.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4PileupOverlay: public Geant4GeneratorAction {
+    public:
+      /// Interaction definition
+      typedef Geant4PrimaryInteraction Interaction;
+      /// Prefetching input stream. Implementation private
+      class Stream;
+
+    protected:
+      /// Property: Input specifications "<reader type>|<file name>"
+      std::vector<std::string>           m_inputs;
+      /// Property: Named parameters to configure the file readers
+      std::map<std::string, std::string> m_parameters;
+      /// Property: Mean number of events per crossing for each input (or one value for all)
+      std::vector<double>                m_mean;
+      /// Property: First bunch crossing relative to the signal
+      int                                m_firstCrossing;
+      /// Property: Last bunch crossing relative to the signal
+      int                                m_lastCrossing;
+      /// Property: Time between two bunch crossings
+      double                             m_bunchSpacing;
+      /// Property: The constant smearing offset
+      ROOT::Math::PxPyPzEVector          m_offset;
+      /// Property: The gaussian sigmas to the offset
+      ROOT::Math::PxPyPzEVector          m_sigma;
+      /// Property: Mask of the first overlaid interaction
+      int                                m_mask;
+      /// Property: Number of events buffered per input stream
+      int                                m_prefetch;
+      /// Property: Reopen exhausted inputs
+      bool                               m_rewind;
+      /// Property: Use the counter based random stream instead of the Geant4 engine
+      bool                               m_useRandomStream;
+
+      /// The prefetching input streams
+      std::vector<Stream*>               m_streams;
+      /// Statistics: number of events and overlaid interactions
+      long                               m_numEvents, m_numInteractions;
+
+      /// Start the background threads of the input streams
+      void startStreams();
+
+    public:
+      /// Inhibit default constructor
+      Geant4PileupOverlay() = delete;
+      /// Inhibit copy constructor
+      Geant4PileupOverlay(const Geant4PileupOverlay& copy) = delete;
+      /// Standard constructor
+      Geant4PileupOverlay(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4PileupOverlay();
+      /// Callback to generate primary particles
+      virtual void operator()(G4Event* event);
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+#endif /* DD4HEP_DDG4_GEANT4PILEUPOVERLAY_H  */
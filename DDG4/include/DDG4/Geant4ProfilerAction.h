@@ -0,0 +1,65 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4PROFILERACTION_H
+#define DD4HEP_DDG4_GEANT4PROFILERACTION_H
+
+// Framework include files
+#include "DDG4/Geant4RunAction.h"
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Run action to enable the profiling of the action sequences
+    /**
+     *  Adding this action to the run action sequence of the master enables
+     *  the Geant4ActionProfiler at the beginning of the run.
+     *  At the end of the run the profile aggregated over all worker threads
+     *  is printed sorted by the total wall time spent in each action callback.
+     *  If a trace file is given, the individual calls are written as
+     *  Chrome trace-event JSON. All counters are reset thereafter.
+     *
+     *  Instances attached to worker threads are ignored.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ProfilerAction : public Geant4RunAction   {
+    protected:
+      /// Property: Measure the CPU time of each call in addition to the wall time
+      bool        m_measureCPU;
+      /// Property: Print the time histograms of each action callback
+      bool        m_histograms;
+      /// Property: Maximal number of lines in the summary
+      int         m_maxLines;
+      /// Property: Maximal number of calls recorded for the trace file
+      int         m_maxTraceEvents;
+      /// Property: Name of the Chrome trace-event output file. Empty: no trace
+      std::string m_traceFile;
+
+    public:
+      /// Standard constructor
+      Geant4ProfilerAction(Geant4Context* context, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4ProfilerAction();
+      /// Begin-of-run callback
+      virtual void begin(const G4Run* run);
+      /// End-of-run callback
+      virtual void end(const G4Run* run);
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+#endif // DD4HEP_DDG4_GEANT4PROFILERACTION_H
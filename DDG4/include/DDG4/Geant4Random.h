@@ -155,6 +155,8 @@ namespace DD4hep {
       double gauss(double mean=0, double sigma=1);
       /// Create landau distributed random numbers
       double landau(double mean=0, double sigma=1);
+      /// Create poisson distributed random numbers
+      int    poisson(double mean);
       /// Create tuple of randum number around a circle with radius r
       void   circle(double &x, double &y, double r);
       /// Create tuple of randum number on a sphere with radius r
@@ -0,0 +1,115 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4RANDOMSTREAM_H
+#define DD4HEP_DDG4_GEANT4RANDOMSTREAM_H
+
+// C/C++ include files
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Counter based random number stream (Philox4x32-10)
+    /**
+     *  The random numbers are a pure function of the key and the counter:
+     *  - the key is derived from the master seed, the run and the event number,
+     *  - the counter contains the identifier of the stream, derived from
+     *    the name of the consumer, and the index of the draw.
+     *
+     *  Each event and each named consumer hence obtains an independent and
+     *  reproducible sequence, which does not depend on the thread processing
+     *  the event nor on the order of the events. A stream is a small value
+     *  object owned by the consumer: there is no shared mutable state and
+     *  no locking.
+     *
+     *  Streams for the current event are obtained from the Geant4Context:
+     *  \code
+     *    Geant4RandomStream rnd = context()->randomStream(name());
+     *    double x = rnd.gauss(0e0, sigma);
+     *  \endcode
+     *  Requesting the stream of the same consumer twice within one event
+     *  restarts the same sequence.
+     *
+     *  See: J.K.Salmon et al., Parallel random numbers: as easy as 1, 2, 3, SC11.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4RandomStream  {
+    protected:
+      /// Philox key
+      uint32_t m_key[2];
+      /// Philox counter: draw index (0,1) and stream identifier (2,3)
+      uint32_t m_counter[4];
+      /// Output of the last block
+      uint32_t m_block[4];
+      /// Number of words of the last block already used
+      int      m_used;
+      /// Second gaussian number of the Box-Muller transformation
+      double   m_gauss;
+      /// Flag if m_gauss is valid
+      bool     m_haveGauss;
+
+      /// Generate the next block
+      void nextBlock()  {
+        philox(m_counter, m_key, m_block);
+        if ( ++m_counter[0] == 0 ) ++m_counter[1];
+        m_used = 0;
+      }
+
+    public:
+      /// Initializing constructor
+      Geant4RandomStream(uint64_t key, uint64_t stream_id);
+      /// Philox4x32-10 block function
+      static void philox(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4]);
+      /// Key of the streams of one event
+      static uint64_t eventKey(uint64_t seed, int run, int event);
+      /// Stream identifier of a named consumer
+      static uint64_t streamID(const std::string& consumer);
+
+      /// Next 32 random bits
+      uint32_t uint32()  {
+        if ( m_used == 4 ) nextBlock();
+        return m_block[m_used++];
+      }
+      /// Next 64 random bits
+      uint64_t uint64()  {
+        uint64_t hi = uint32();
+        return (hi << 32) | uint32();
+      }
+      /// Flat random number in the open interval (0,1) with 53 bit resolution
+      double rndm()  {
+        return (double(uint64() >> 11) + 0.5) * (1e0/9007199254740992e0);
+      }
+      /// Flat random number in the interval (a,b)
+      double flat(double a, double b)  {
+        return a + (b-a)*rndm();
+      }
+      /// Gaussian random number
+      double gauss(double mean=0e0, double sigma=1e0);
+      /// Exponential random number
+      double exp(double tau);
+      /// Poisson distributed random number
+      int poisson(double mean);
+      /// Fill an array with flat random numbers in the open interval (0,1)
+      void rndmArray(size_t n, double* array);
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+#endif // DD4HEP_DDG4_GEANT4RANDOMSTREAM_H
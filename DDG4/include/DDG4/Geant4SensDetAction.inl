@@ -21,6 +21,10 @@
 #include "DDG4/Geant4ReadoutVolumeFilter.h"
 #include "DDG4/Geant4Data.h"
 
+// Geant4 include files
+#include "G4Step.hh"
+#include "G4Track.hh"
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
@@ -112,6 +116,15 @@ namespace DD4hep {
     // Forward declarations
     typedef Geant4HitData::Contribution HitContribution;
 
+    /// Scale the deposit of a contribution with the statistical weight of the track
+    /** Tracks surviving a Russian roulette carry the weight of the killed tracks.
+     *  The weight is only known by the G4Track: it is not stored with the MC particles.
+     */
+    inline HitContribution& weighted(HitContribution& contrib, const G4Step* step)  {
+      contrib.deposit *= step->GetTrack()->GetWeight();
+      return contrib;
+    }
+
 
   }    // End namespace Simulation
 }      // End namespace DD4hep
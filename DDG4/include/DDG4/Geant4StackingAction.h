@@ -17,6 +17,12 @@
 // Framework include files
 #include "DDG4/Geant4Action.h"
 
+// Geant4 include files
+#include "G4ClassificationOfNewTrack.hh"
+
+// Forward declarations
+class G4Track;
+
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
 
@@ -28,6 +34,28 @@ namespace DD4hep {
     class Geant4SharedStackingAction;
     class Geant4StackingActionSequence;
 
+    /// Result of the classification of a new track by a stacking action
+    /**
+     *  Actions, which do not want to influence the stacking of a track
+     *  return an undefined classification (default constructor).
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4TrackClassification  {
+    public:
+      /// Flag if the classification is defined
+      bool                       defined = false;
+      /// Stack the track should be pushed to
+      G4ClassificationOfNewTrack value   = fUrgent;
+    public:
+      /// Default constructor: undefined classification
+      Geant4TrackClassification() = default;
+      /// Initializing constructor
+      Geant4TrackClassification(G4ClassificationOfNewTrack val) : defined(true), value(val)  {}
+    };
+
     /// Concrete implementation of the Geant4 stacking action base class
     /**
      *  \author  M.Frank
@@ -37,6 +65,7 @@ namespace DD4hep {
     class Geant4StackingAction: public Geant4Action {
     public:
       typedef Geant4SharedStackingAction shared_type;
+      typedef Geant4TrackClassification  TrackClassification;
     public:
       /// Standard constructor
       Geant4StackingAction(Geant4Context* ctxt, const std::string& name);
@@ -48,6 +77,10 @@ namespace DD4hep {
       /// Preparation callback
       virtual void prepare() {
       }
+      /// Classify a new track. The default leaves the decision to other actions
+      virtual TrackClassification classifyNewTrack(const G4Track* /* track */) {
+        return TrackClassification();
+      }
     };
 
     /// Implementation of the Geant4 shared stacking action
@@ -56,8 +89,10 @@ namespace DD4hep {
      * multi-threaded purposes. The wrapper ensures the locking
      * of the basic actions to avoid race conditions.
      *
-     * Shared action should be 'fast'. The global lock otherwise
-     * inhibits the efficient use of the multiple threads.
+     * Non-reentrant actions are protected by a lock private to the
+     * shared action instance (see Geant4ActionLock). Reentrant actions
+     * are called without locking. Shared actions should be 'fast':
+     * the lock otherwise inhibits the efficient use of the multiple threads.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -67,6 +102,8 @@ namespace DD4hep {
     protected:
       /// Reference to the shared action
       Geant4StackingAction* m_action;
+      /// Lock protecting the shared action
+      Geant4ActionLock* m_lock = 0;
     public:
       /// Standard constructor
       Geant4SharedStackingAction(Geant4Context* context, const std::string& nam);
@@ -80,6 +117,8 @@ namespace DD4hep {
       virtual void newStage();
       /// Preparation callback
       virtual void prepare();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(const G4Track* track);
     };
 
     /// Concrete implementation of the Geant4 stacking action sequence
@@ -88,6 +127,11 @@ namespace DD4hep {
      * to all registered Geant4StackingAction members and all
      * registered callbacks.
      *
+     * New tracks are classified by asking all members: a request to kill
+     * the track is always honoured, otherwise the first defined
+     * classification is used. If no member defines a classification,
+     * the Geant4 default (urgent stack) applies.
+     *
      * Note Multi-Threading issue:
      * Neither callbacks not the action list is protected against multiple 
      * threads calling the Geant4 callbacks!
@@ -130,6 +174,8 @@ namespace DD4hep {
       virtual void newStage();
       /// Preparation callback
       virtual void prepare();
+      /// Classify a new track
+      virtual Geant4TrackClassification classifyNewTrack(const G4Track* track);
     };
 
   }    // End namespace Simulation
@@ -15,6 +15,7 @@
 
 // Framework include files
 #include "DDG4/Geant4Action.h"
+#include "DDG4/Geant4Dispatch.h"
 
 // Forward declarations
 class G4SteppingManager;
@@ -59,8 +60,10 @@ namespace DD4hep {
      * multi-threaded purposes. The wrapper ensures the locking
      * of the basic actions to avoid race conditions.
      *
-     * Shared action should be 'fast'. The global lock otherwise
-     * inhibits the efficient use of the multiple threads.
+     * Non-reentrant actions are protected by a lock private to the
+     * shared action instance (see Geant4ActionLock). Reentrant actions
+     * are called without locking. Shared actions should be 'fast':
+     * the lock otherwise inhibits the efficient use of the multiple threads.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -70,6 +73,8 @@ namespace DD4hep {
     protected:
       /// Reference to the shared action
       Geant4SteppingAction* m_action = 0;
+      /// Lock protecting the shared action
+      Geant4ActionLock* m_lock = 0;
     public:
       /// Default constructor
       Geant4SharedSteppingAction() = default;
@@ -98,16 +103,29 @@ namespace DD4hep {
      * threads calling the Geant4 callbacks!
      * These must be protected in the user actions themselves.
      *
+     * Unless the action profiler is enabled, the actors and callbacks are
+     * compiled into a flat dispatch table before the first step. Actors
+     * which do not overload the stepping callback are not called.
+     * The property "Compile" allows to disable the table.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4SteppingActionSequence: public Geant4Action {
+    public:
+      typedef Geant4DispatchTable<const G4Step*, G4SteppingManager*> DispatchTable;
     protected:
       /// Callback sequence for user stepping action calls
       CallbackSequence m_calls;
       /// The list of action objects to be called
       Actors<Geant4SteppingAction> m_actors;
+      /// Flat dispatch table of the actors and callbacks
+      DispatchTable    m_dispatch;
+      /// Property: Flag to use the flat dispatch table
+      bool             m_compile = true;
+      /// Flag if the dispatch table is up to date
+      bool             m_compiled = false;
 
     public:
       /// Inhibit copy constructor
@@ -126,9 +144,12 @@ namespace DD4hep {
       template <typename Q, typename T>
       void call(Q* p, void (T::*f)(const G4Step*, G4SteppingManager*)) {
         m_calls.add(p, f);
+        m_compiled = false;
       }
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adopt(Geant4SteppingAction* action);
+      /// Compile the actors and callbacks into the flat dispatch table
+      void compile();
       /// User stepping callback
       virtual void operator()(const G4Step* step, G4SteppingManager* mgr);
     };
@@ -25,6 +25,7 @@
 #include "DDG4/Geant4StackingAction.h"
 #include "DDG4/Geant4ActionPhase.h"
 #include "DDG4/Geant4SensDetAction.h"
+#include "DDG4/Geant4Concurrency.h"
 
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
@@ -133,13 +134,19 @@ namespace DD4hep {
         virtual void end(const G4Track*);
       };
 
-      /// Example stepping action doing nothing, but print
+      /// Example stepping action doing nothing, but print and count steps
       /**
+       *  The action does not use its context and is reentrant: if shared,
+       *  it is called without locking. The steps are counted per thread.
+       *
        *  \author  M.Frank
        *  \version 1.0
        *  \ingroup DD4HEP_SIMULATION
        */
       class Geant4TestStepAction: public Geant4SteppingAction, public Geant4TestBase {
+      protected:
+        /// Number of steps seen by each thread
+        Geant4PerThread<long> m_steps;
       public:
         /// Standard constructor with initializing arguments
         Geant4TestStepAction(Geant4Context* c, const std::string& n);
@@ -16,6 +16,7 @@
 
 // Framework include files
 #include "DDG4/Geant4Action.h"
+#include "DDG4/Geant4Dispatch.h"
 #include "G4VUserTrackInformation.hh"
 
 class G4TrackingManager;
@@ -69,8 +70,10 @@ namespace DD4hep {
      * multi-threaded purposes. The wrapper ensures the locking
      * of the basic actions to avoid race conditions.
      *
-     * Shared action should be 'fast'. The global lock otherwise
-     * inhibits the efficient use of the multiple threads.
+     * Non-reentrant actions are protected by a lock private to the
+     * shared action instance (see Geant4ActionLock). Reentrant actions
+     * are called without locking. Shared actions should be 'fast':
+     * the lock otherwise inhibits the efficient use of the multiple threads.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -80,6 +83,8 @@ namespace DD4hep {
     protected:
       /// Reference to the shared action
       Geant4TrackingAction* m_action = 0;
+      /// Lock protecting the shared action
+      Geant4ActionLock* m_lock = 0;
 
     public:
       /// Default constructor
@@ -111,11 +116,18 @@ namespace DD4hep {
      * threads calling the Geant4 callbacks!
      * These must be protected in the user actions themselves.
      *
+     * Unless the action profiler is enabled, the actors and callbacks are
+     * compiled into flat dispatch tables before the first track. Actors
+     * which do not overload the begin or end callback are not called
+     * for this callback. The property "Compile" allows to disable the tables.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4TrackingActionSequence: public Geant4Action {
+    public:
+      typedef Geant4DispatchTable<const G4Track*> DispatchTable;
     protected:
       /// Callback sequence for pre tracking action
       CallbackSequence             m_front;
@@ -127,6 +139,14 @@ namespace DD4hep {
       CallbackSequence             m_final;
       /// The list of action objects to be called
       Actors<Geant4TrackingAction> m_actors;
+      /// Flat dispatch table of the pre tracking actors and callbacks
+      DispatchTable                m_beginDispatch;
+      /// Flat dispatch table of the post tracking actors and callbacks
+      DispatchTable                m_endDispatch;
+      /// Property: Flag to use the flat dispatch tables
+      bool                         m_compile = true;
+      /// Flag if the dispatch tables are up to date
+      bool                         m_compiled = false;
     public:
       /// Default constructor
       Geant4TrackingActionSequence() = default;
@@ -147,27 +167,33 @@ namespace DD4hep {
       void callUpFront(Q* p, void (T::*f)(const G4Track*),
                        CallbackSequence::Location where=CallbackSequence::END) {
         m_front.add(p, f, where);
+        m_compiled = false;
       }
       /// Register Pre-track action callback
       template <typename Q, typename T>
       void callAtBegin(Q* p, void (T::*f)(const G4Track*),
                        CallbackSequence::Location where=CallbackSequence::END) {
         m_begin.add(p, f, where);
+        m_compiled = false;
       }
       /// Register Post-track action callback
       template <typename Q, typename T>
       void callAtEnd(Q* p, void (T::*f)(const G4Track*),
                      CallbackSequence::Location where=CallbackSequence::END) {
         m_end.add(p, f, where);
+        m_compiled = false;
       }
       /// Register Post-track action callback
       template <typename Q, typename T>
       void callAtFinal(Q* p, void (T::*f)(const G4Track*),
                        CallbackSequence::Location where=CallbackSequence::END) {
         m_final.add(p, f, where);
+        m_compiled = false;
       }
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adopt(Geant4TrackingAction* action);
+      /// Compile the actors and callbacks into the flat dispatch tables
+      void compile();
       /// Pre-tracking action callback
       virtual void begin(const G4Track* track);
       /// Post-tracking action callback
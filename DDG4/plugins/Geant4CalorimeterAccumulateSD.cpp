@@ -0,0 +1,252 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4SensDetAction.inl"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+// C/C++ include files
+#include <unordered_map>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+
+using namespace std;
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation   {
+
+    /// Geant4 sensitive detector accumulating the calorimeter deposits of one event before creating hits.
+    /**
+     *  Geant4SensitiveAction<CalorimeterAccumulate>
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+
+    /** \addtogroup Geant4SDActionPlugin
+     *
+     * @{
+     * \package Geant4CalorimeterAccumulateAction
+     *
+     * \brief Sensitive detector meant for high granularity calorimeters
+
+      Steps are recorded in a compact buffer (cell ID, deposit, time, track).
+      At the end of the event the buffer is sorted by cell and track and
+      reduced: one hit is created per cell and all deposits of one track
+      are collapsed into a single MC contribution. The time of a collapsed
+      contribution is the time of the earliest deposit, the position is
+      the energy weighted mean. The hits are equivalent to the hits of the
+      Geant4CalorimeterAction, but carry far fewer contributions.
+
+      The buffer keeps its capacity between events. Each worker thread
+      owns its own sensitive actions and hence its own buffer.
+
+      \param double TimeWindow
+        - If positive, deposits later than TimeWindow are ignored
+
+     *
+     * @}
+     */
+    struct CalorimeterAccumulate {
+      typedef Geant4HitCollection          HitCollection;
+      typedef Geant4Calorimeter::Hit       Hit;
+      typedef Geant4HitData::Contribution  Contribution;
+      typedef Geometry::Position           Position;
+
+      /// Compact record of one energy deposit
+      struct Deposit  {
+        VolumeID cell;
+        double   deposit;
+        float    time;
+        int      trackID;
+        int      pdgID;
+        float    x, y, z;
+      };
+      /// Ordering of the deposits: cell, track, time
+      static bool deposit_less(const Deposit& a, const Deposit& b)  {
+        if ( a.cell    != b.cell    ) return a.cell    < b.cell;
+        if ( a.trackID != b.trackID ) return a.trackID < b.trackID;
+        return a.time < b.time;
+      }
+
+      /// Deposits of the current event
+      vector<Deposit>                      deposits;
+      /// Global position of the cells hit in the current event
+      unordered_map<VolumeID, Position>    cells;
+      /// Last cell seen. Consecutive steps mostly hit the same cell.
+      VolumeID                             last_cell = 0;
+      /// Property: Time window for the deposits. Disabled if not positive
+      double                               time_window = 0e0;
+      Geant4Sensitive*                     sensitive = 0;
+
+      /// Statistics counters
+      long   num_events = 0, num_steps = 0, num_late = 0;
+      long   num_hits = 0, num_contributions = 0;
+      size_t max_buffer = 0;
+      double reduce_time = 0e0, energy = 0e0;
+
+      /// Record the deposit of a step
+      void add(VolumeID cell, const Contribution& c)   {
+        Deposit d;
+        d.cell    = cell;
+        d.deposit = c.deposit;
+        d.time    = float(c.time);
+        d.trackID = c.trackID;
+        d.pdgID   = c.pdgID;
+        d.x       = c.x;
+        d.y       = c.y;
+        d.z       = c.z;
+        deposits.push_back(d);
+        ++num_steps;
+      }
+
+      /// Reduce the deposits of the event to hits
+      void reduce(HitCollection* coll)   {
+        auto start = chrono::steady_clock::now();
+        max_buffer = max(max_buffer, deposits.capacity()*sizeof(Deposit));
+        sort(deposits.begin(), deposits.end(), deposit_less);
+        for(size_t i = 0, n = deposits.size(); i < n; )  {
+          VolumeID cell = deposits[i].cell;
+          Hit* hit = coll->findByKey<Hit>(cell);
+          if ( !hit )  {
+            hit = new Hit(cells[cell]);
+            hit->cellID = cell;
+            coll->add(cell, hit);
+            ++num_hits;
+          }
+          // Segment of one cell: collapse the deposits of each track
+          while ( i < n && deposits[i].cell == cell )  {
+            const Deposit& first = deposits[i];
+            double dep = 0e0, x = 0e0, y = 0e0, z = 0e0;
+            for( ; i < n && deposits[i].cell == cell && deposits[i].trackID == first.trackID; ++i )  {
+              const Deposit& d = deposits[i];
+              dep += d.deposit;
+              x   += d.x*d.deposit;
+              y   += d.y*d.deposit;
+              z   += d.z*d.deposit;
+            }
+            double pos[3] = { first.x, first.y, first.z };
+            if ( dep != 0e0 )  {
+              pos[0] = x/dep; pos[1] = y/dep; pos[2] = z/dep;
+            }
+            hit->truth.push_back(Contribution(first.trackID, first.pdgID, dep, first.time, pos));
+            hit->energyDeposit += dep;
+            energy += dep;
+            ++num_contributions;
+          }
+        }
+        clear();
+        ++num_events;
+        reduce_time += chrono::duration<double>(chrono::steady_clock::now()-start).count();
+      }
+
+      /// Clear the buffer. The capacity is kept for the next event
+      void clear()  {
+        deposits.clear();
+        cells.clear();
+        last_cell = 0;
+      }
+
+      /// Print the accumulation statistics
+      void printStatistics()  const  {
+        if ( num_events > 0 )  {
+          sensitive->info("+++ Events:%ld Steps:%ld Late deposits:%ld Hits:%ld Contributions:%ld",
+                          num_events, num_steps, num_late, num_hits, num_contributions);
+          sensitive->info("+++ Contributions: %.3f MB instead of %.3f MB with one per step. "
+                          "Max. step buffer: %.3f MB Reduction: %.3f ms/event",
+                          double(num_contributions*sizeof(Contribution))/1048576e0,
+                          double(num_steps*sizeof(Contribution))/1048576e0,
+                          double(max_buffer)/1048576e0, 1e3*reduce_time/double(num_events));
+          sensitive->info("+++ Total energy deposit: %.3f MeV %.3f MeV/event",
+                          energy/CLHEP::MeV, energy/CLHEP::MeV/double(num_events));
+        }
+      }
+    };
+
+    /// Initialization overload for specialization
+    template <> void Geant4SensitiveAction<CalorimeterAccumulate>::initialize() {
+      declareProperty("TimeWindow", m_userData.time_window);
+      m_userData.sensitive = this;
+    }
+
+    /// Finalization overload for specialization
+    template <> void Geant4SensitiveAction<CalorimeterAccumulate>::finalize() {
+      m_userData.printStatistics();
+    }
+
+    /// Define collections created by this sensitivie action object
+    template <> void Geant4SensitiveAction<CalorimeterAccumulate>::defineCollections() {
+      m_collectionID = declareReadoutFilteredCollection<Geant4Calorimeter::Hit>();
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the begining of each event.
+    template <> void Geant4SensitiveAction<CalorimeterAccumulate>::begin(G4HCofThisEvent* /* hce */)   {
+      m_userData.clear();
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the end of each event.
+    template <> void Geant4SensitiveAction<CalorimeterAccumulate>::end(G4HCofThisEvent* /* hce */)   {
+      m_userData.reduce(collection(m_collectionID));
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked if the event was aborted.
+    template <> void Geant4SensitiveAction<CalorimeterAccumulate>::clear(G4HCofThisEvent* /* hce */) {
+      m_userData.clear();
+    }
+
+    /// Method for generating hit(s) using the information of G4Step object.
+    template <> G4bool
+    Geant4SensitiveAction<CalorimeterAccumulate>::process(G4Step* step, G4TouchableHistory* /* history */) {
+      HitContribution contrib = Geant4Calorimeter::Hit::extractContribution(step);
+      weighted(contrib, step);
+      if ( m_userData.time_window > 0e0 && contrib.time > m_userData.time_window )  {
+        ++m_userData.num_late;
+        return true;
+      }
+      VolumeID cell = 0;
+      try {
+        cell = cellID(step);
+      } catch(std::runtime_error &e) {
+        error("+++ Failed to compute the cell ID: %s",e.what());
+        return true;
+      }
+      if ( 0 == cell )  {
+        except("+++ Invalid CELL ID for hit!");
+      }
+      if ( cell != m_userData.last_cell )  {
+        auto i = m_userData.cells.find(cell);
+        if ( i == m_userData.cells.end() )  {
+          StepHandler h(step);
+          DDSegmentation::Vector3D pos = m_segmentation.position(cell);
+          m_userData.cells.insert(make_pair(cell, h.localToGlobal(pos)));
+        }
+        m_userData.last_cell = cell;
+      }
+      m_userData.add(cell, contrib);
+      mark(step);
+      return true;
+    }
+
+    typedef Geant4SensitiveAction<CalorimeterAccumulate>  Geant4CalorimeterAccumulateAction;
+  }
+}
+
+using namespace DD4hep::Simulation;
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4SENSITIVE(Geant4CalorimeterAccumulateAction)
@@ -36,6 +36,8 @@ namespace DD4hep {
       bool m_dumpHierarchy;
       /// Property: G4 GDML dump file name (default: empty. If non empty, dump)
       std::string m_dumpGDML;
+      /// Property: Prefix of the geometry cache files (default: empty. If non empty, use cache)
+      std::string m_geometryCache;
 
     public:
       /// Initializing constructor for DDG4
@@ -55,6 +57,7 @@ namespace DD4hep {
 #include "DD4hep/LCDD.h"
 
 #include "DDG4/Geant4HierarchyDump.h"
+#include "DDG4/Geant4GeometryCache.h"
 #include "DDG4/Geant4Converter.h"
 #include "DDG4/Geant4Kernel.h"
 #include "DDG4/Factories.h"
@@ -76,6 +79,7 @@ Geant4DetectorGeometryConstruction::Geant4DetectorGeometryConstruction(Geant4Con
 {
   declareProperty("DumpHierarchy", m_dumpHierarchy=false);
   declareProperty("DumpGDML",      m_dumpGDML="");
+  declareProperty("GeometryCache", m_geometryCache="");
   InstanceCount::increment(this);
 }
 
@@ -89,7 +93,18 @@ void Geant4DetectorGeometryConstruction::constructGeo(Geant4DetectorConstruction
   Geant4Mapping& g4map = Geant4Mapping::instance();
   Geometry::DetElement world = ctxt->lcdd.world();
   Geant4Converter conv(ctxt->lcdd, outputLevel());
-  ctxt->geometry = conv.create(world).detach();
+  if ( m_geometryCache.empty() )  {
+    conv.create(world);
+  }
+  else  {
+    // Convert only if no cache for this geometry exists and store the result
+    Geant4GeometryCache cache(conv, m_geometryCache);
+    if ( !cache.restore(world) )  {
+      conv.create(world);
+      cache.save(world);
+    }
+  }
+  ctxt->geometry = conv.detach();
   g4map.attach(ctxt->geometry);
   G4VPhysicalVolume* w = ctxt->geometry->world();
   // Create Geant4 volume manager only if not yet available
@@ -100,7 +115,7 @@ void Geant4DetectorGeometryConstruction::constructGeo(Geant4DetectorConstruction
   }
 #ifdef GEANT4_HAS_GDML
   const char* gdml_dmp = ::getenv("DUMP_GDML");
-  if ( !m_dumpGDML.empty() ||  ) {
+  if ( !m_dumpGDML.empty() || gdml_dmp ) {
     G4GDMLParser parser;
     if ( !m_dumpGDML.empty() )
       parser.Write(m_dumpGDML.c_str(), w);
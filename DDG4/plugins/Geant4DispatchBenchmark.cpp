@@ -0,0 +1,143 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4SteppingAction.h"
+#include "DDG4/Geant4TrackingAction.h"
+
+// C/C++ include files
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+
+  /// Stepping action counting the steps
+  class StepCounter : public Geant4SteppingAction  {
+  public:
+    long steps = 0, calls = 0;
+    StepCounter(Geant4Context* c, const string& n) : Geant4SteppingAction(c,n) {}
+    virtual ~StepCounter() {}
+    virtual void operator()(const G4Step*, G4SteppingManager*)  {  ++steps;  }
+    void call(const G4Step*, G4SteppingManager*)                {  ++calls;  }
+  };
+
+  /// Stepping action inheriting the empty stepping callback
+  class StepNoOp : public Geant4SteppingAction  {
+  public:
+    StepNoOp(Geant4Context* c, const string& n) : Geant4SteppingAction(c,n) {}
+    virtual ~StepNoOp() {}
+  };
+
+  /// Tracking action overloading only the pre tracking callback
+  class TrackBegin : public Geant4TrackingAction  {
+  public:
+    TrackBegin(Geant4Context* c, const string& n) : Geant4TrackingAction(c,n) {}
+    virtual ~TrackBegin() {}
+    virtual void begin(const G4Track*)  {}
+  };
+
+  /// Time the dispatch of the stepping callback in nanoseconds per step
+  double time_steps(Geant4SteppingActionSequence* seq, long num_steps)  {
+    auto start = chrono::steady_clock::now();
+    for(long i=0; i<num_steps; ++i)
+      (*seq)(0, 0);
+    return 1e9*chrono::duration<double>(chrono::steady_clock::now()-start).count()/double(num_steps);
+  }
+
+  /// Plugin function: Benchmark of the dispatch of the stepping action sequence
+  /**
+   *  Factory: DD4hep_Geant4DispatchBenchmark
+   *
+   *  Measures the overhead per step of the stepping action sequence with
+   *  the sequential dispatch and with the flat dispatch table. Both must
+   *  call the actors and callbacks the same number of times.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   */
+  long dispatch_benchmark(Geometry::LCDD& /* lcdd */, int argc, char** argv)  {
+    long num_steps = 10000000;
+    int  num_actors = 4, num_noops = 4, num_calls = 2;
+    for(int i=0; i<argc && argv[i]; ++i)  {
+      if ( 0 == ::strncmp("-steps",argv[i],4) )
+        num_steps = ::atol(argv[++i]);
+      else if ( 0 == ::strncmp("-actors",argv[i],4) )
+        num_actors = ::atol(argv[++i]);
+      else if ( 0 == ::strncmp("-noops",argv[i],4) )
+        num_noops = ::atol(argv[++i]);
+      else if ( 0 == ::strncmp("-callbacks",argv[i],4) )
+        num_calls = ::atol(argv[++i]);
+      else  {
+        printout(ALWAYS,"DispatchBenchmark",
+                 "Usage: -plugin DD4hep_Geant4DispatchBenchmark -steps <number> "
+                 "-actors <number> -noops <number> -callbacks <number>");
+        ::exit(EINVAL);
+      }
+    }
+    bool ok = true;
+    if ( Geant4NoOpCallbacks::mask<StepCounter>() != 0 ||
+         Geant4NoOpCallbacks::mask<StepNoOp>() != Geant4NoOpCallbacks::STEP ||
+         Geant4NoOpCallbacks::mask<TrackBegin>() != Geant4NoOpCallbacks::END_TRACK )  {
+      printout(ERROR,"DispatchBenchmark","+++ Wrong detection of the empty callbacks.");
+      ok = false;
+    }
+    Geant4SteppingActionSequence* seq = new Geant4SteppingActionSequence(0, "StepSequence");
+    vector<StepCounter*> counters;
+    for(int i=0; i<num_actors; ++i)  {
+      StepCounter* a = Geant4NoOpCallbacks::mark(new StepCounter(0, "Counter"));
+      seq->adopt(a);
+      counters.push_back(a);
+      a->release();
+    }
+    for(int i=0; i<num_noops; ++i)  {
+      StepNoOp* a = Geant4NoOpCallbacks::mark(new StepNoOp(0, "NoOp"));
+      seq->adopt(a);
+      a->release();
+    }
+    for(int i=0; i<num_calls && !counters.empty(); ++i)
+      seq->call(counters[i%counters.size()], &StepCounter::call);
+
+    long before = 0, after = 0;
+    seq->property("Compile").set(false);
+    double t_seq = time_steps(seq, num_steps);
+    for(const StepCounter* a : counters) before += a->steps + a->calls;
+    seq->property("Compile").set(true);
+    double t_flat = time_steps(seq, num_steps);
+    for(const StepCounter* a : counters) after += a->steps + a->calls;
+    after -= before;
+    if ( before != after || before != num_steps*(num_actors+num_calls) )  {
+      printout(ERROR,"DispatchBenchmark","+++ Inconsistent number of calls: %ld <> %ld",before,after);
+      ok = false;
+    }
+    printout(INFO,"DispatchBenchmark","+++ %d actors, %d empty actors, %d callbacks:",
+             num_actors, num_noops, num_calls);
+    printout(INFO,"DispatchBenchmark","+++ Sequential dispatch: %8.2f ns/step", t_seq);
+    printout(INFO,"DispatchBenchmark","+++ Flat dispatch table: %8.2f ns/step", t_flat);
+    seq->release();
+    printout(ok ? INFO : ERROR,"DispatchBenchmark","+++ %ld steps dispatched: Test %s",
+             num_steps, ok ? "PASSED" : "FAILED");
+    return ok ? 1 : 0;
+  }
+}
+
+DECLARE_APPLY(DD4hep_Geant4DispatchBenchmark,dispatch_benchmark)
@@ -0,0 +1,827 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4InputAction.h"
+
+// C/C++ include files
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Base class of event readers working on memory mapped ASCII files
+    /**
+     *  The input file is memory mapped once. On opening an index of the
+     *  start offsets of all events is built. Hence the readers support
+     *  direct access: moving to an arbitrary event is a constant time
+     *  operation and events may be read in any order.
+     *
+     *  Numbers are decoded directly from the mapped region with a small
+     *  hand-written tokenizer, avoiding the overhead of the iostream layer.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4EventReaderMapped : public Geant4EventReader  {
+    public:
+      /// Minimal tokenizer working on a region of the mapped file
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Cursor  {
+      public:
+        const char* ptr;
+        const char* end;
+        bool        good;
+      public:
+        /// Initializing constructor
+        Cursor(const char* b, const char* e) : ptr(b), end(e), good(true) {}
+        /// Skip blanks (including line ends)
+        void skipSpace()  {
+          while ( ptr < end && (*ptr==' ' || *ptr=='\t' || *ptr=='\r' || *ptr=='\n') ) ++ptr;
+        }
+        /// Check if all data were consumed
+        bool atEnd()  {  skipSpace(); return ptr >= end;  }
+        /// Access the next token without converting it
+        bool token(const char*& tok, size_t& len);
+        /// Skip the next token
+        bool skip()  {  const char* t; size_t l; return token(t,l);  }
+        /// Decode the next token as an integer
+        bool get(int& value);
+        /// Decode the next token as a floating point number
+        bool get(double& value);
+        /// Decode the next token as a single precision floating point number
+        bool get(float& value);
+      };
+
+    protected:
+      /// Start of the memory mapped region
+      char*               m_mapping = 0;
+      /// Size of the memory mapped region
+      size_t              m_size    = 0;
+      /// Event index: start offsets of all events. The last entry marks the end of the last event
+      std::vector<size_t> m_offsets;
+
+      /// Access the mapped region of a given event
+      Cursor eventData(int event_number)  const;
+
+    public:
+      /// Initializing constructor
+      explicit Geant4EventReaderMapped(const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4EventReaderMapped();
+      /// Number of events in the input file
+      size_t numEvents()  const  {  return m_offsets.empty() ? 0 : m_offsets.size()-1; }
+      /// Move to the indicated event number (constant time)
+      virtual EventReaderStatus moveToEvent(int event_number)  override;
+    };
+
+    /// Memory mapped reader of HEPEvt files (short and long format)
+    /**
+     *  Produces the same particles and vertices as Geant4EventReaderHepEvt.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4EventReaderHepEvtMapped : public Geant4EventReaderMapped  {
+    protected:
+      int m_format;
+      /// Build the event index
+      void buildIndex();
+    public:
+      /// Initializing constructor
+      explicit Geant4EventReaderHepEvtMapped(const std::string& nam, int format);
+      /// Default destructor
+      virtual ~Geant4EventReaderHepEvtMapped() {}
+      /// Read an event and fill a vector of MCParticles.
+      virtual EventReaderStatus readParticles(int event_number,
+                                              Vertices& vertices,
+                                              std::vector<Particle*>& particles)  override;
+    };
+
+    /// Memory mapped reader of HepMC 2 ASCII files
+    /**
+     *  Produces the same particles and vertices as Geant4EventReaderHepMC.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4EventReaderHepMCMapped : public Geant4EventReaderMapped  {
+    protected:
+      /// HepMC IO type as given by the header of the event listing
+      int m_ioType = 0;
+      /// Build the event index
+      void buildIndex();
+    public:
+      /// Initializing constructor
+      explicit Geant4EventReaderHepMCMapped(const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4EventReaderHepMCMapped() {}
+      /// Read an event and fill a vector of MCParticles.
+      virtual EventReaderStatus readParticles(int event_number,
+                                              Vertices& vertices,
+                                              std::vector<Particle*>& particles)  override;
+    };
+  }     /* End namespace Simulation   */
+}       /* End namespace DD4hep       */
+
+//====================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------
+//
+//====================================================================
+
+// Framework include files
+#include "DDG4/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4Primary.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "CLHEP/Units/PhysicalConstants.h"
+
+// C/C++ include files
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <map>
+
+using namespace std;
+using namespace CLHEP;
+using namespace DD4hep::Simulation;
+typedef DD4hep::ReferenceBitMask<int> PropertyMask;
+
+#define HEPEvtShort 1
+#define HEPEvtLong  2
+
+// Local declarations in anaonymous namespace
+namespace {
+  class Geant4EventReaderHepEvtShortMapped : public Geant4EventReaderHepEvtMapped  {
+  public:
+    /// Initializing constructor
+    explicit Geant4EventReaderHepEvtShortMapped(const string& nam) : Geant4EventReaderHepEvtMapped(nam,HEPEvtShort) {}
+    /// Default destructor
+    virtual ~Geant4EventReaderHepEvtShortMapped() {}
+  };
+  class Geant4EventReaderHepEvtLongMapped : public Geant4EventReaderHepEvtMapped  {
+  public:
+    /// Initializing constructor
+    explicit Geant4EventReaderHepEvtLongMapped(const string& nam) : Geant4EventReaderHepEvtMapped(nam,HEPEvtLong) {}
+    /// Default destructor
+    virtual ~Geant4EventReaderHepEvtLongMapped() {}
+  };
+
+  /// Exact powers of ten as double
+  const double s_pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                             1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                             1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  /// Number of tokens per particle entry in HEPEvt files
+  inline int hepevt_tokens(int format)  {  return format == HEPEvtShort ? 8 : 15;  }
+
+  /// Access the next line [ptr,eol) of a memory region
+  inline const char* line_end(const char* ptr, const char* end)  {
+    const char* p = (const char*)::memchr(ptr, '\n', end-ptr);
+    return p ? p : end;
+  }
+
+  /// Compare a token with a string constant
+  inline bool token_is(const char* tok, size_t len, const char* value)  {
+    return ::strlen(value) == len && ::strncmp(tok, value, len) == 0;
+  }
+}
+
+// Factory entry
+DECLARE_GEANT4_EVENT_READER(Geant4EventReaderHepEvtShortMapped)
+// Factory entry
+DECLARE_GEANT4_EVENT_READER(Geant4EventReaderHepEvtLongMapped)
+// Factory entry
+DECLARE_GEANT4_EVENT_READER(Geant4EventReaderHepMCMapped)
+
+/// Access the next token without converting it
+bool Geant4EventReaderMapped::Cursor::token(const char*& tok, size_t& len)   {
+  skipSpace();
+  tok = ptr;
+  while ( ptr < end && !(*ptr==' ' || *ptr=='\t' || *ptr=='\r' || *ptr=='\n') ) ++ptr;
+  len = ptr - tok;
+  if ( len == 0 ) good = false;
+  return len > 0;
+}
+
+/// Decode the next token as an integer
+bool Geant4EventReaderMapped::Cursor::get(int& value)   {
+  const char* tok = 0;
+  size_t len = 0;
+  if ( token(tok, len) )  {
+    const char* p = tok, *e = tok+len;
+    bool neg = false;
+    long val = 0;
+    if ( *p == '-' || *p == '+' ) neg = (*p++ == '-');
+    if ( p < e )  {
+      for( ; p < e && *p >= '0' && *p <= '9'; ++p) val = val*10 + (*p-'0');
+      if ( p == e )  {
+        value = int(neg ? -val : val);
+        return true;
+      }
+    }
+  }
+  good = false;
+  return false;
+}
+
+/// Decode the next token as a floating point number
+/**
+ *  Numbers with at most 15 significant digits and a decimal exponent
+ *  within the range of exactly representable powers of ten are converted
+ *  with a single correctly rounded multiplication or division.
+ *  Up to 19 significant digits (as written by HepMC) are converted in
+ *  extended precision if the result can be rounded unambiguously.
+ *  All other numbers are handed to strtod. The result is therefore
+ *  identical to the one of the standard library.
+ */
+bool Geant4EventReaderMapped::Cursor::get(double& value)   {
+  const char* tok = 0;
+  size_t len = 0;
+  if ( !token(tok, len) )  {
+    return false;
+  }
+  const char* p = tok, *e = tok+len;
+  bool neg = false;
+  if ( *p == '-' || *p == '+' ) neg = (*p++ == '-');
+
+  unsigned long long mant = 0;
+  int  digits = 0, exp10 = 0, ndig = 0, zeros = 0;
+  for( ; p < e && *p >= '0' && *p <= '9'; ++p, ++ndig)  {
+    if ( mant == 0 && *p == '0' ) continue;
+    if ( ++digits <= 19 ) mant = mant*10 + (*p-'0');
+    else ++exp10;
+  }
+  if ( p < e && *p == '.' )  {
+    // Trailing zeros of the fraction do not count as significant digits
+    for( ++p; p < e && *p >= '0' && *p <= '9'; ++p, ++ndig)  {
+      if ( *p == '0' )  {
+        if ( mant == 0 ) --exp10;
+        else ++zeros;
+        continue;
+      }
+      for( ; zeros > 0 && digits < 19; --zeros, ++digits, --exp10) mant *= 10;
+      if ( zeros > 0 || ++digits > 19 )  {
+        digits = 20;         // Too many digits: use strtod
+        zeros  = 0;
+        continue;
+      }
+      mant = mant*10 + (*p-'0');
+      --exp10;
+    }
+  }
+  bool fast = ndig > 0;
+  if ( p < e && (*p == 'e' || *p == 'E') )  {
+    bool eneg = false;
+    int  ev = 0;
+    ++p;
+    if ( p < e && (*p == '-' || *p == '+') ) eneg = (*p++ == '-');
+    if ( p == e ) fast = false;
+    for( ; p < e && *p >= '0' && *p <= '9'; ++p)
+      ev = ev < 10000 ? ev*10 + (*p-'0') : ev;
+    exp10 += eneg ? -ev : ev;
+  }
+  if ( fast && p == e && mant == 0 )  {
+    value = neg ? -0e0 : 0e0;
+    return true;
+  }
+  else if ( fast && p == e && exp10 >= -22 && exp10 <= 22 )  {
+    if ( digits <= 15 )  {
+      double v = double(mant);
+      v = exp10 < 0 ? v / s_pow10[-exp10] : v * s_pow10[exp10];
+      value = neg ? -v : v;
+      return true;
+    }
+    else if ( digits <= 19 && std::numeric_limits<long double>::digits >= 64 )  {
+      long double v = (long double)mant;
+      v = exp10 < 0 ? v / (long double)s_pow10[-exp10] : v * (long double)s_pow10[exp10];
+      // Only a single rounding to the 64 bit mantissa happened. Rounding to double is
+      // exact unless the result is too close to the half-way point between two doubles.
+      int e2 = 0;
+      unsigned long long bits = (unsigned long long)::ldexpl(::frexpl(v,&e2),64);
+      unsigned int low = (unsigned int)(bits & 0x7FF);
+      if ( low < 0x3FF || low > 0x401 )  {
+        value = double(neg ? -v : v);
+        return true;
+      }
+    }
+  }
+  // Slow path: tokens are not null terminated in the mapped region
+  char buff[128];
+  if ( len < sizeof(buff) )  {
+    char* stop = 0;
+    ::memcpy(buff, tok, len);
+    buff[len] = 0;
+    value = ::strtod(buff, &stop);
+    if ( stop == buff+len ) return true;
+  }
+  good = false;
+  return false;
+}
+
+/// Decode the next token as a single precision floating point number
+/**
+ *  The token is rounded once to float like 'istream >> float' does.
+ *  Converting via double would round twice and may differ in the last bit.
+ */
+bool Geant4EventReaderMapped::Cursor::get(float& value)   {
+  const char* tok = 0;
+  size_t len = 0;
+  char buff[128];
+  if ( !token(tok, len) )  {
+    return false;
+  }
+  if ( len < sizeof(buff) )  {
+    char* stop = 0;
+    ::memcpy(buff, tok, len);
+    buff[len] = 0;
+    value = ::strtof(buff, &stop);
+    if ( stop == buff+len ) return true;
+  }
+  good = false;
+  return false;
+}
+
+/// Initializing constructor
+Geant4EventReaderMapped::Geant4EventReaderMapped(const string& nam)
+  : Geant4EventReader(nam)
+{
+  int fid = ::open(nam.c_str(), O_RDONLY);
+  if ( fid == -1 )   {
+    except("Geant4EventReaderMapped","+++ Failed to open input file: %s Error:%s.",
+           nam.c_str(), ::strerror(errno));
+  }
+  struct stat buff;
+  if ( 0 != ::fstat(fid, &buff) )  {
+    ::close(fid);
+    except("Geant4EventReaderMapped","+++ Failed to stat input file: %s Error:%s.",
+           nam.c_str(), ::strerror(errno));
+  }
+  m_size = buff.st_size;
+  if ( m_size > 0 )  {
+    void* ptr = ::mmap(0, m_size, PROT_READ, MAP_PRIVATE, fid, 0);
+    if ( ptr == MAP_FAILED )  {
+      ::close(fid);
+      except("Geant4EventReaderMapped","+++ Failed to map input file: %s Error:%s.",
+             nam.c_str(), ::strerror(errno));
+    }
+    ::madvise(ptr, m_size, MADV_SEQUENTIAL);
+    m_mapping = (char*)ptr;
+  }
+  ::close(fid);
+  m_directAccess = true;
+}
+
+/// Default destructor
+Geant4EventReaderMapped::~Geant4EventReaderMapped()    {
+  if ( m_mapping )  {
+    ::munmap(m_mapping, m_size);
+    m_mapping = 0;
+  }
+}
+
+/// Access the mapped region of a given event
+Geant4EventReaderMapped::Cursor Geant4EventReaderMapped::eventData(int event_number)  const  {
+  return Cursor(m_mapping + m_offsets[event_number], m_mapping + m_offsets[event_number+1]);
+}
+
+/// Move to the indicated event number (constant time)
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderMapped::moveToEvent(int event_number) {
+  if ( event_number < 0 || size_t(event_number) >= numEvents() )  {
+    printout(ERROR,"EventReaderMapped::moveToEvent","+++ Event %d out of range. File %s has %ld events.",
+             event_number, m_name.c_str(), long(numEvents()));
+    return EVENT_READER_IO_ERROR;
+  }
+  m_currEvent = event_number;
+  printout(DEBUG,"EventReaderMapped::moveToEvent","Current event number: %d",m_currEvent);
+  return EVENT_READER_OK;
+}
+
+/// Initializing constructor
+Geant4EventReaderHepEvtMapped::Geant4EventReaderHepEvtMapped(const string& nam, int format)
+  : Geant4EventReaderMapped(nam), m_format(format)
+{
+  buildIndex();
+}
+
+/// Build the event index
+void Geant4EventReaderHepEvtMapped::buildIndex()   {
+  Cursor cur(m_mapping, m_mapping+m_size);
+  int ntok = hepevt_tokens(m_format);
+
+  size_t last = 0;
+  m_offsets.clear();
+  while ( !cur.atEnd() )  {
+    size_t start = cur.ptr - m_mapping;
+    int    nhep  = 0;
+    if ( !cur.get(nhep) || nhep < 0 || nhep > 1000000 )  {
+      cur.good = false;
+      break;
+    }
+    for(long i=0, n=long(nhep)*ntok; i<n && cur.skip(); ++i);
+    if ( !cur.good ) break;
+    m_offsets.push_back(start);
+    last = cur.ptr - m_mapping;
+  }
+  if ( !cur.good )  {
+    printout(WARNING,"EventReaderHepEvtMapped","+++ Incomplete or corrupted event after %ld events in %s",
+             long(m_offsets.size()), m_name.c_str());
+  }
+  m_offsets.push_back(last);
+  printout(INFO,"EventReaderHepEvtMapped","+++ Indexed %ld events in file %s",
+           long(numEvents()), m_name.c_str());
+}
+
+/// Read an event and fill a vector of MCParticles.
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepEvtMapped::readParticles(int /* event_number */,
+                                             Vertices& vertices,
+                                             vector<Particle*>& particles)   {
+  if ( m_currEvent < 0 || size_t(m_currEvent) >= numEvents() )   {
+    return EVENT_READER_IO_ERROR;
+  }
+  Cursor cur = eventData(m_currEvent);
+  int NHEP = 0;
+  if ( !cur.get(NHEP) )  {
+    return EVENT_READER_IO_ERROR;
+  }
+  //fg: for now we create exactly one event vertex here ( as before )
+  Geant4Vertex* vtx = new Geant4Vertex ;
+  vertices.push_back( vtx );
+  vtx->x = 0;
+  vtx->y = 0;
+  vtx->z = 0;
+  vtx->time = 0;
+
+  int ISTHEP(0), IDHEP(0), JMOHEP1(0), JMOHEP2(0), JDAHEP1(0), JDAHEP2(0);
+  double PHEP1(0), PHEP2(0), PHEP3(0), PHEP4(0), PHEP5(0);
+  double VHEP1(0), VHEP2(0), VHEP3(0), VHEP4(0);
+  vector<int> daughter1, daughter2;
+
+  particles.reserve(particles.size()+NHEP);
+  daughter1.reserve(NHEP);
+  daughter2.reserve(NHEP);
+  for( int IHEP=0; IHEP<NHEP; IHEP++ )    {
+    if ( m_format == HEPEvtShort )  {
+      cur.get(ISTHEP); cur.get(IDHEP); cur.get(JDAHEP1); cur.get(JDAHEP2);
+      cur.get(PHEP1);  cur.get(PHEP2); cur.get(PHEP3);   cur.get(PHEP5);
+    }
+    else  {
+      cur.get(ISTHEP);  cur.get(IDHEP);
+      cur.get(JMOHEP1); cur.get(JMOHEP2);
+      cur.get(JDAHEP1); cur.get(JDAHEP2);
+      cur.get(PHEP1);   cur.get(PHEP2);  cur.get(PHEP3);
+      cur.get(PHEP4);   cur.get(PHEP5);
+      cur.get(VHEP1);   cur.get(VHEP2);  cur.get(VHEP3);
+      cur.get(VHEP4);
+    }
+    if ( !cur.good )  {
+      printout(ERROR,"EventReaderHepEvtMapped","+++ Failed to decode particle %d of event %d",
+               IHEP, m_currEvent);
+      return EVENT_READER_IO_ERROR;
+    }
+    Particle* p = new Particle(IHEP);
+    PropertyMask status(p->status);
+    p->pdgID = IDHEP;
+    p->pex = p->psx = PHEP1*GeV;
+    p->pey = p->psy = PHEP2*GeV;
+    p->pez = p->psz = PHEP3*GeV;
+    p->mass = PHEP5*GeV;
+    p->vsx = VHEP1*mm;
+    p->vsy = VHEP2*mm;
+    p->vsz = VHEP3*mm;
+    p->vex = 0.0;
+    p->vey = 0.0;
+    p->vez = 0.0;
+    p->time       = VHEP4*ns;
+    p->properTime = VHEP4*ns;
+    p->status = 0;
+    if ( ISTHEP == 0 )      status.set(G4PARTICLE_GEN_EMPTY);
+    else if ( ISTHEP == 1 ) status.set(G4PARTICLE_GEN_STABLE);
+    else if ( ISTHEP == 2 ) status.set(G4PARTICLE_GEN_DECAYED);
+    else                    status.set(G4PARTICLE_GEN_DOCUMENTATION);
+    daughter1.push_back(JDAHEP1);
+    daughter2.push_back(JDAHEP2);
+    particles.push_back(p);
+  }
+  //
+  //  Same parent/daughter logic as Geant4EventReaderHepEvt:
+  //  all daughters listed get this particle as a parent.
+  for( int IHEP=0; IHEP<NHEP; IHEP++ )    {
+    Particle* mcp = particles[IHEP];
+    int fd = daughter1[IHEP] - 1;
+    int ld = daughter2[IHEP] - 1;
+    if ( fd >= NHEP || ld >= NHEP )  {
+      printout(WARNING,"EventReaderHepEvtMapped","+++ Invalid daughter range [%d,%d] of particle %d",
+               fd+1, ld+1, IHEP);
+      continue;
+    }
+    if( (fd > -1) && (ld > -1) )  {
+      if(ld >= fd)   {
+        for(int id=fd;id<ld+1;id++)
+          particles[id]->parents.insert(mcp->id);
+      }
+      else  {
+        particles[fd]->parents.insert(mcp->id);
+        particles[ld]->parents.insert(mcp->id);
+      }
+    }
+    else if(fd > -1)
+      particles[fd]->parents.insert(mcp->id);
+    else if(ld > -1)
+      particles[ld]->parents.insert(mcp->id);
+  }
+  for(size_t i=0; i<particles.size(); ++i )   {
+    Geant4ParticleHandle p(particles[i]);
+    if ( p->parents.size() == 0 )  {
+      PropertyMask status(p->status);
+      if ( status.isSet(G4PARTICLE_GEN_EMPTY) || status.isSet(G4PARTICLE_GEN_DOCUMENTATION) )
+        vtx->in.insert(p->id);  // Beam particles and primary quarks etc.
+      else
+        vtx->out.insert(p->id); // Stuff, to be given to Geant4 together with daughters
+    }
+  }
+  ++m_currEvent;
+  return EVENT_READER_OK;
+}
+
+/// Known HepMC IO types (see Geant4EventReaderHepMC)
+namespace  {
+  enum hepmc_known_io { gen=1, ascii, extascii, ascii_pdt, extascii_pdt };
+}
+
+/// Initializing constructor
+Geant4EventReaderHepMCMapped::Geant4EventReaderHepMCMapped(const string& nam)
+  : Geant4EventReaderMapped(nam)
+{
+  buildIndex();
+}
+
+/// Build the event index
+/**
+ *  Each event starts with a line beginning with 'E'. Events end either
+ *  at the start of the next event or at the end of the event listing.
+ *  The IO type is taken from the start of the event listing.
+ */
+void Geant4EventReaderHepMCMapped::buildIndex()   {
+  const char* ptr = m_mapping;
+  const char* end = m_mapping + m_size;
+  bool in_event = false;
+
+  m_offsets.clear();
+  while ( ptr < end )  {
+    const char* eol = line_end(ptr, end);
+    if ( *ptr == 'E' )  {
+      m_offsets.push_back(ptr - m_mapping);
+      in_event = true;
+    }
+    else if ( *ptr == 'H' && eol-ptr > 7 && ::strncmp(ptr,"HepMC::",7) == 0 )  {
+      Cursor cur(ptr, eol);
+      const char* tok = 0;
+      size_t len = 0;
+      cur.token(tok, len);
+      if      ( token_is(tok,len,"HepMC::IO_GenEvent-START_EVENT_LISTING") )       m_ioType = gen;
+      else if ( token_is(tok,len,"HepMC::IO_Ascii-START_EVENT_LISTING") )          m_ioType = ascii;
+      else if ( token_is(tok,len,"HepMC::IO_ExtendedAscii-START_EVENT_LISTING") )  m_ioType = extascii;
+      else if ( token_is(tok,len,"HepMC::IO_Ascii-START_PARTICLE_DATA") )          m_ioType = ascii_pdt;
+      else if ( token_is(tok,len,"HepMC::IO_ExtendedAscii-START_PARTICLE_DATA") )  m_ioType = extascii_pdt;
+      if ( in_event )  {
+        // End of the event listing: close the last event
+        m_offsets.push_back(ptr - m_mapping);
+        in_event = false;
+        break;
+      }
+    }
+    ptr = eol < end ? eol+1 : end;
+  }
+  if ( in_event )  {
+    m_offsets.push_back(m_size);
+  }
+  printout(INFO,"EventReaderHepMCMapped","+++ Indexed %ld events in file %s [IO type:%d]",
+           long(numEvents()), m_name.c_str(), m_ioType);
+}
+
+/// Read an event and fill a vector of MCParticles.
+/**
+ *  Decodes the same information as Geant4EventReaderHepMC: vertices (V)
+ *  with their particles (P) and the units (U). Other records are ignored.
+ */
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepMCMapped::readParticles(int /* event_number */,
+                                            Vertices& vertices,
+                                            vector<Particle*>& output)   {
+  typedef map<int,Geant4Vertex*>   VertexMap;
+  typedef map<int,Geant4Particle*> ParticleMap;
+  if ( m_currEvent < 0 || size_t(m_currEvent) >= numEvents() )   {
+    return EVENT_READER_IO_ERROR;
+  }
+  //fg: for now we create exactly one event vertex here ( as before )
+  Geant4Vertex* primary_vertex = new Geant4Vertex ;
+  vertices.push_back( primary_vertex );
+  primary_vertex->x = 0;
+  primary_vertex->y = 0;
+  primary_vertex->z = 0;
+
+  Cursor      evt = eventData(m_currEvent);
+  const char* ptr = evt.ptr;
+  double      mom_unit = MeV, pos_unit = mm;
+  VertexMap   verts;
+  ParticleMap parts;
+  Geant4Vertex* v = 0;
+  int num_orphans_in = 0, num_particles_out = 0;
+  bool ok = true;
+
+  for( ; ok && ptr < evt.end; )  {
+    const char* eol = line_end(ptr, evt.end);
+    Cursor cur(ptr+1, eol);
+    switch( *ptr )  {
+    case 'U':
+      if ( m_ioType == gen )  {
+        const char *mom = 0, *pos = 0;
+        size_t lm = 0, lp = 0;
+        if ( cur.token(mom,lm) && cur.token(pos,lp) )  {
+          if      ( token_is(mom,lm,"KEV") ) mom_unit = keV;
+          else if ( token_is(mom,lm,"MEV") ) mom_unit = MeV;
+          else if ( token_is(mom,lm,"GEV") ) mom_unit = GeV;
+          else if ( token_is(mom,lm,"TEV") ) mom_unit = TeV;
+          if      ( token_is(pos,lp,"MM") )  pos_unit = mm;
+          else if ( token_is(pos,lp,"CM") )  pos_unit = cm;
+          else if ( token_is(pos,lp,"M") )   pos_unit = m;
+        }
+        ok = cur.good;
+      }
+      break;
+    case 'V':  {
+      int id = 0, dummy = 0, weights_size = 0;
+      v = new Geant4Vertex();
+      cur.get(id); cur.get(dummy);
+      cur.get(v->x); cur.get(v->y); cur.get(v->z); cur.get(v->time);
+      cur.get(num_orphans_in); cur.get(num_particles_out); cur.get(weights_size);
+      for(int i=0; i<weights_size && cur.good; ++i) cur.skip();
+      v->x *= pos_unit;
+      v->y *= pos_unit;
+      v->z *= pos_unit;
+      if ( !cur.good || !verts.insert(make_pair(id,v)).second )  {
+        delete v;
+        v = 0;
+        ok = false;
+      }
+      break;
+    }
+    case 'P':  {
+      if ( !v )  {
+        printout(ERROR,"EventReaderHepMCMapped","+++ Found unexpected particle line.");
+        ok = false;
+        break;
+      }
+      Geant4Particle* p = new Geant4Particle();
+      PropertyMask status(p->status);
+      // Same types as Geant4EventReaderHepMC: the energy is read in single precision
+      float ene = 0., theta = 0., phi = 0.;
+      int stat = 0, size = 0;
+      cur.get(p->id); cur.get(p->pdgID);
+      cur.get(p->psx); cur.get(p->psy); cur.get(p->psz); cur.get(ene);
+      p->id = parts.size();
+      p->psx *= mom_unit;
+      p->psy *= mom_unit;
+      p->psz *= mom_unit;
+      ene *= mom_unit;
+      if ( m_ioType != ascii )  {
+        cur.get(p->mass);
+        p->mass *= mom_unit;
+      }
+      else   {
+        p->mass = std::sqrt(fabs(ene*ene - (p->psx*p->psx + p->psy*p->psy + p->psz*p->psz)));
+      }
+      // Reuse here the secondaries to store the end-vertex ID
+      cur.get(stat); cur.get(theta); cur.get(phi); cur.get(p->secondaries); cur.get(size);
+      status.clear();
+      if ( stat == 0 )        status.set(G4PARTICLE_GEN_EMPTY);
+      else if ( stat == 0x1 ) status.set(G4PARTICLE_GEN_STABLE);
+      else if ( stat == 0x2 ) status.set(G4PARTICLE_GEN_DECAYED);
+      else if ( stat == 0x3 ) status.set(G4PARTICLE_GEN_DOCUMENTATION);
+      else if ( stat == 0x4 ) status.set(G4PARTICLE_GEN_DOCUMENTATION);
+      else if ( stat == 0xB ) status.set(G4PARTICLE_GEN_DOCUMENTATION);
+      for (int i = 0; i < size && cur.good; ++i )  {
+        cur.get(p->colorFlow[0]); cur.get(p->colorFlow[1]);
+      }
+      if ( !cur.good )  {
+        delete p;
+        ok = false;
+        break;
+      }
+      parts.insert(make_pair(p->id,p));
+      p->pex = p->psx;
+      p->pey = p->psy;
+      p->pez = p->psz;
+      if ( --num_orphans_in >= 0 )   {
+        v->in.insert(p->id);
+        p->vex = v->x;
+        p->vey = v->y;
+        p->vez = v->z;
+      }
+      else  {
+        v->out.insert(p->id);
+        p->vsx = v->x;
+        p->vsy = v->y;
+        p->vsz = v->z;
+      }
+      break;
+    }
+    default:            // E, C, N, F, H and comments carry nothing we use
+      break;
+    }
+    if ( ok ) ptr = eol < evt.end ? eol+1 : evt.end;
+  }
+  if ( !ok )  {
+    printout(ERROR,"EventReaderHepMCMapped","+++ Failed to decode event %d [line:%.40s]",
+             m_currEvent, string(ptr, line_end(ptr, evt.end)).c_str());
+    releaseObjects(verts);
+    releaseObjects(parts);
+    return EVENT_READER_IO_ERROR;
+  }
+  //
+  //  Fix particle relationships: identical to HepMC::fix_particles
+  for(ParticleMap::iterator i=parts.begin(); i != parts.end(); ++i)  {
+    Geant4ParticleHandle p((*i).second);
+    int end_vtx_id = p->secondaries;
+    p->secondaries = 0;
+    VertexMap::iterator iv = verts.find(end_vtx_id);
+    if ( iv != verts.end() )   {
+      Geant4Vertex* ev = (*iv).second;
+      p->vex = ev->x;
+      p->vey = ev->y;
+      p->vez = ev->z;
+      ev->in.insert(p->id);
+      p->daughters.insert(ev->out.begin(), ev->out.end());
+    }
+  }
+  for(VertexMap::iterator j=verts.begin(); j != verts.end(); ++j)  {
+    Geant4Vertex* vv = (*j).second;
+    for (set<int>::const_iterator ip=vv->out.begin(); ip!=vv->out.end();++ip)   {
+      ParticleMap::iterator ipp = parts.find(*ip);
+      if ( ipp != parts.end() ) (*ipp).second->parents.insert(vv->in.begin(), vv->in.end());
+    }
+  }
+  /// Particles originating from the beam (=no parents) must be
+  /// be stripped off their parents and the status set to G4PARTICLE_GEN_DECAYED!
+  vector<Geant4Particle*> beam;
+  for(ParticleMap::iterator i=parts.begin(); i != parts.end(); ++i)  {
+    Geant4ParticleHandle p((*i).second);
+    if ( p->parents.size() == 0 )  {
+      for(set<int>::const_iterator id=p->daughters.begin(); id!=p->daughters.end();++id)  {
+        ParticleMap::iterator ipp = parts.find(*id);
+        if ( ipp != parts.end() ) beam.push_back((*ipp).second);
+      }
+    }
+  }
+  for(vector<Geant4Particle*>::iterator ipp=beam.begin(); ipp!=beam.end();++ipp)  {
+    (*ipp)->parents.clear();
+    (*ipp)->status = G4PARTICLE_GEN_DECAYED;
+  }
+  releaseObjects(verts);
+
+  output.reserve(output.size()+parts.size());
+  for(ParticleMap::iterator i=parts.begin(); i != parts.end(); ++i)  {
+    Geant4ParticleHandle p((*i).second);
+    output.push_back(p);
+    if ( p->parents.size() == 0 )  {
+      PropertyMask status(p->status);
+      if ( status.isSet(G4PARTICLE_GEN_EMPTY) || status.isSet(G4PARTICLE_GEN_DOCUMENTATION) )
+        primary_vertex->in.insert(p->id);  // Beam particles and primary quarks etc.
+      else
+        primary_vertex->out.insert(p->id); // Stuff, to be given to Geant4 together with daughters
+    }
+  }
+  ++m_currEvent;
+  return EVENT_READER_OK;
+}
@@ -75,6 +75,9 @@ DECLARE_GEANT4ACTION(Geant4UserParticleHandler)
 #include "DDG4/Geant4ParticlePrint.h"
 DECLARE_GEANT4ACTION(Geant4ParticlePrint)
 
+#include "DDG4/Geant4ProfilerAction.h"
+DECLARE_GEANT4ACTION(Geant4ProfilerAction)
+
 //=============================
 #include "DDG4/Geant4TrackingPreAction.h"
 DECLARE_GEANT4ACTION(Geant4TrackingPreAction)
@@ -122,6 +125,10 @@ DECLARE_GEANT4ACTION(Geant4PrimaryHandler)
 #include "DDG4/Geant4InputAction.h"
 DECLARE_GEANT4ACTION(Geant4InputAction)
 
+//=============================
+#include "DDG4/Geant4PileupOverlay.h"
+DECLARE_GEANT4ACTION(Geant4PileupOverlay)
+
 //=============================
 #include "DDG4/Geant4GeneratorWrapper.h"
 DECLARE_GEANT4ACTION(Geant4GeneratorWrapper)
@@ -0,0 +1,355 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4RunAction.h"
+#include "DDG4/Geant4EventAction.h"
+#include "DDG4/Geant4SteppingAction.h"
+#include "DDG4/Geant4PhysicsConstructor.h"
+#include "DDG4/Geant4FastSimShowerModel.h"
+#include "DDG4/Geant4FrozenShowerLibrary.h"
+
+// C/C++ include files
+#include <map>
+#include <tuple>
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Physics constructor adding the fast simulation process to particles
+    /**
+     *  Property:
+     *  - EnabledParticles: Names of the particles for which fast simulation
+     *                      models may be triggered. Default: e-, e+, gamma.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FastPhysics : public Geant4PhysicsConstructor    {
+    protected:
+      /// Property: Particles for which fast simulation is enabled
+      std::vector<std::string> m_enabledParticles;
+    public:
+      /// Standard constructor
+      Geant4FastPhysics(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4FastPhysics();
+      /// Callback to construct processes (uses the G4 particle table)
+      virtual void constructProcess(Constructor& ctor);
+    };
+
+    /// Fast simulation of electromagnetic showers using a library of frozen showers
+    /**
+     *  Low energy electrons, positrons and photons entering the region are
+     *  replaced by a shower of the library with the nearest energy.
+     *  The energy spots of the shower are rotated into the direction of the
+     *  particle, scaled with its kinetic energy and deposited through the
+     *  sensitive detectors of the volumes containing the spots.
+     *
+     *  Properties (in addition to the base class):
+     *  - Library:        Name of the shower library file.
+     *  - RandomRotation: Rotate the shower randomly around its axis. Default: true.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FrozenShowerModel : public Geant4FastSimShowerModel  {
+    protected:
+      /// Property: Name of the shower library file
+      std::string               m_libraryName;
+      /// Property: Rotate the shower randomly around its axis
+      bool                      m_randomRotation;
+      /// The shower library shared by all threads
+      Geant4FrozenShowerLibrary m_library;
+    public:
+      /// Standard constructor
+      Geant4FrozenShowerModel(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4FrozenShowerModel();
+      /// Sensitive detector construction callback. Loads the library once.
+      virtual void constructSensitives(Geant4DetectorConstructionContext* ctxt);
+      /// Geant4 callback: Should the model be triggered for this track?
+      virtual bool trigger(const G4FastTrack& track)  const;
+      /// Geant4 callback: Create the shower and deposit its energy
+      virtual void modelShower(const G4FastTrack& track, G4FastStep& step, Geant4FastSimHitMaker& hits)  const;
+    };
+
+    /// Stepping action to record a library of frozen showers
+    /**
+     *  Each event is expected to contain one primary electron, positron or photon.
+     *  All energy deposits of the event are stored as spots in the frame of the
+     *  shower starting at the first step of the primary. Deposits are merged in
+     *  cubic cells of the size "SpotSize". The library is written at the end of the run.
+     *
+     *  Properties:
+     *  - Library:    Name of the output file.
+     *  - SpotSize:   Size of the cells merging energy deposits. Default: 1 mm.
+     *  - RegionName: If set only deposits in volumes of this region are recorded.
+     *
+     *  The recorder collects the showers of one thread. Use it in single threaded mode.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FrozenShowerRecorder : public Geant4SteppingAction  {
+    protected:
+      typedef std::map<std::tuple<int,int,int>,double> Cells;
+      /// Property: Name of the output library
+      std::string               m_libraryName;
+      /// Property: Cell size to merge energy deposits
+      double                    m_spotSize;
+      /// Property: Region of the recorded deposits
+      std::string               m_regionName;
+      /// The library of recorded showers
+      Geant4FrozenShowerLibrary m_library;
+      /// Energy deposits of the current event in the frame of the shower
+      Cells                     m_cells;
+      /// Shower frame of the current event
+      G4ThreeVector             m_origin, m_u, m_v, m_w;
+      /// Energy and PDG code of the primary particle of the current event
+      double                    m_energy;
+      int                       m_pdg;
+      /// Flag if the shower start was seen in the current event
+      bool                      m_started;
+    public:
+      /// Standard constructor
+      Geant4FrozenShowerRecorder(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4FrozenShowerRecorder();
+      /// Begin-of-event callback
+      void beginEvent(const G4Event* event);
+      /// End-of-event callback
+      void endEvent(const G4Event* event);
+      /// End-of-run callback
+      void endRun(const G4Run* run);
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager* mgr);
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+
+// Geant4 include files
+#include "G4FastSimulationManagerProcess.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ProcessManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Region.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+// C/C++ include files
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+  /// Protection of the library loading executed by all worker threads
+  mutex library_load_mutex;
+}
+
+/// Standard constructor
+Geant4FastPhysics::Geant4FastPhysics(Geant4Context* ctxt, const string& nam)
+  : Geant4PhysicsConstructor(ctxt, nam)
+{
+  m_enabledParticles.push_back("e-");
+  m_enabledParticles.push_back("e+");
+  m_enabledParticles.push_back("gamma");
+  declareProperty("EnabledParticles", m_enabledParticles);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FastPhysics::~Geant4FastPhysics()   {
+  InstanceCount::decrement(this);
+}
+
+/// Callback to construct processes (uses the G4 particle table)
+void Geant4FastPhysics::constructProcess(Constructor& ctor)   {
+  G4ParticleTable::G4PTblDicIterator* iter = ctor.particleIterator();
+  while( (*iter)() )  {
+    G4ParticleDefinition* def = iter->value();
+    const string& nam = def->GetParticleName();
+    if ( find(m_enabledParticles.begin(), m_enabledParticles.end(), nam) != m_enabledParticles.end() )  {
+      G4ProcessManager* mgr = def->GetProcessManager();
+      mgr->AddDiscreteProcess(new G4FastSimulationManagerProcess("fastSimProcess_massGeom"));
+      info("+++ Enabled fast simulation for particle %s",nam.c_str());
+    }
+  }
+}
+
+/// Standard constructor
+Geant4FrozenShowerModel::Geant4FrozenShowerModel(Geant4Context* ctxt, const string& nam)
+  : Geant4FastSimShowerModel(ctxt, nam)
+{
+  m_applicableParticleNames.push_back("e-");
+  m_applicableParticleNames.push_back("e+");
+  m_applicableParticleNames.push_back("gamma");
+  declareProperty("Library",        m_libraryName);
+  declareProperty("RandomRotation", m_randomRotation = true);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FrozenShowerModel::~Geant4FrozenShowerModel()   {
+  InstanceCount::decrement(this);
+}
+
+/// Sensitive detector construction callback. Loads the library once.
+void Geant4FrozenShowerModel::constructSensitives(Geant4DetectorConstructionContext* ctxt)   {
+  {
+    lock_guard<mutex> protection_lock(library_load_mutex);
+    if ( 0 == m_library.numShowers() )  {
+      m_library.load(m_libraryName);
+    }
+  }
+  this->Geant4FastSimShowerModel::constructSensitives(ctxt);
+}
+
+/// Geant4 callback: Should the model be triggered for this track?
+bool Geant4FrozenShowerModel::trigger(const G4FastTrack& track)  const   {
+  if ( this->Geant4FastSimShowerModel::trigger(track) )  {
+    const G4Track* trk = track.GetPrimaryTrack();
+    return 0 != m_library.sample(trk->GetDefinition()->GetPDGEncoding(), trk->GetKineticEnergy(), 0e0);
+  }
+  return false;
+}
+
+/// Geant4 callback: Create the shower and deposit its energy
+void Geant4FrozenShowerModel::modelShower(const G4FastTrack& track, G4FastStep& step, Geant4FastSimHitMaker& hits)  const   {
+  const G4Track* trk  = track.GetPrimaryTrack();
+  double         ekin = trk->GetKineticEnergy();
+  const Geant4FrozenShowerLibrary::Shower* shower =
+    m_library.sample(trk->GetDefinition()->GetPDGEncoding(), ekin, G4UniformRand());
+  if ( shower )  {
+    const Geant4FrozenShowerLibrary::Spot* spots = m_library.spots(*shower);
+    G4ThreeVector pos = trk->GetPosition();
+    G4ThreeVector w   = trk->GetMomentumDirection();
+    G4ThreeVector u   = w.orthogonal().unit();
+    G4ThreeVector v   = w.cross(u);
+    double        time = trk->GetGlobalTime();
+    if ( m_randomRotation )  {
+      double phi = CLHEP::twopi*G4UniformRand();
+      G4ThreeVector r = cos(phi)*u + sin(phi)*v;
+      v = w.cross(r);
+      u = r;
+    }
+    for(unsigned int i=0; i<shower->count; ++i)  {
+      const Geant4FrozenShowerLibrary::Spot& s = spots[i];
+      hits.deposit(track, pos + s.x*u + s.y*v + s.z*w, s.energy*ekin, time);
+    }
+  }
+  step.KillPrimaryTrack();
+  step.ProposePrimaryTrackPathLength(0e0);
+  step.ProposeTotalEnergyDeposited(ekin);
+}
+
+/// Standard constructor
+Geant4FrozenShowerRecorder::Geant4FrozenShowerRecorder(Geant4Context* ctxt, const string& nam)
+  : Geant4SteppingAction(ctxt, nam), m_energy(0), m_pdg(0), m_started(false)
+{
+  declareProperty("Library",    m_libraryName);
+  declareProperty("SpotSize",   m_spotSize = 1e0*CLHEP::mm);
+  declareProperty("RegionName", m_regionName);
+  eventAction().callAtBegin(this, &Geant4FrozenShowerRecorder::beginEvent);
+  eventAction().callAtEnd(this,   &Geant4FrozenShowerRecorder::endEvent);
+  runAction().callAtEnd(this,     &Geant4FrozenShowerRecorder::endRun);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FrozenShowerRecorder::~Geant4FrozenShowerRecorder()   {
+  InstanceCount::decrement(this);
+}
+
+/// Begin-of-event callback
+void Geant4FrozenShowerRecorder::beginEvent(const G4Event* )   {
+  m_cells.clear();
+  m_started = false;
+}
+
+/// End-of-event callback
+void Geant4FrozenShowerRecorder::endEvent(const G4Event* )   {
+  if ( m_started && m_energy > 0e0 && !m_cells.empty() )  {
+    Geant4FrozenShowerLibrary::Spots spots;
+    spots.reserve(m_cells.size());
+    for(const auto& c : m_cells)  {
+      Geant4FrozenShowerLibrary::Spot s;
+      s.x = float((get<0>(c.first)+0.5)*m_spotSize);
+      s.y = float((get<1>(c.first)+0.5)*m_spotSize);
+      s.z = float((get<2>(c.first)+0.5)*m_spotSize);
+      s.energy = float(c.second/m_energy);
+      spots.push_back(s);
+    }
+    m_library.add(m_pdg, m_energy, spots);
+  }
+}
+
+/// End-of-run callback
+void Geant4FrozenShowerRecorder::endRun(const G4Run* )   {
+  if ( m_library.numShowers() > 0 )  {
+    m_library.save(m_libraryName);
+  }
+}
+
+/// User stepping callback
+void Geant4FrozenShowerRecorder::operator()(const G4Step* step, G4SteppingManager* )   {
+  const G4Track*     trk = step->GetTrack();
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  if ( !m_started )  {
+    int pdg = trk->GetDefinition()->GetPDGEncoding();
+    if ( trk->GetParentID() != 0 || 0 == Geant4FrozenShowerLibrary::particleClass(pdg) )
+      return;
+    m_origin  = pre->GetPosition();
+    m_w       = pre->GetMomentumDirection();
+    m_u       = m_w.orthogonal().unit();
+    m_v       = m_w.cross(m_u);
+    m_energy  = pre->GetKineticEnergy();
+    m_pdg     = pdg;
+    m_started = true;
+  }
+  double edep = step->GetTotalEnergyDeposit();
+  if ( edep > 0e0 )  {
+    if ( !m_regionName.empty() )  {
+      const G4VPhysicalVolume* pv = pre->GetPhysicalVolume();
+      if ( !pv || pv->GetLogicalVolume()->GetRegion()->GetName() != m_regionName )
+        return;
+    }
+    G4ThreeVector d = 0.5*(pre->GetPosition() + step->GetPostStepPoint()->GetPosition()) - m_origin;
+    Cells::key_type key(int(floor(d.dot(m_u)/m_spotSize)),
+                        int(floor(d.dot(m_v)/m_spotSize)),
+                        int(floor(d.dot(m_w)/m_spotSize)));
+    m_cells[key] += edep;
+  }
+}
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION(Geant4FastPhysics)
+DECLARE_GEANT4ACTION(Geant4FrozenShowerModel)
+DECLARE_GEANT4ACTION(Geant4FrozenShowerRecorder)
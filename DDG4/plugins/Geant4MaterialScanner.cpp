@@ -16,9 +16,17 @@
 #include "DD4hep/Objects.h"
 #include "DDG4/Defs.h"
 #include "DDG4/Geant4SteppingAction.h"
+#include "DDG4/Geant4ParticleGenerator.h"
+
+// C/C++ include files
+#include <unordered_map>
+#include <memory>
 
 // Forward declarations
+class G4Material;
+class G4VTouchable;
 class G4LogicalVolume;
+class G4VPhysicalVolume;
 
 /// Namespace for the AIDA detector description toolkit
 namespace DD4hep {
@@ -28,12 +36,25 @@ namespace DD4hep {
 
     /// Class to perform directional material scans using Geantinos.
     /**
+     *  By default the material table of every track is printed.
+     *
+     *  If the property Output is set, the scanner runs in batch mode: the
+     *  radiation and interaction lengths of every track are accumulated per
+     *  subdetector (top level detector element) and per material without
+     *  storing the steps. At the end the results of all threads are merged
+     *  and written to one binary summary file (see Summary::write for the
+     *  format). Together with the Geant4MaterialScanGenerator the rays of
+     *  an eta/phi or x/y scan pattern are distributed over the worker threads.
      *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4MaterialScanner : public Geant4SteppingAction  {
+    public:
+      /// Material budget summary of the batch mode
+      class Summary;
+
     protected:
       /// Structure to hold the information of one simulation step.
       class StepInfo {
@@ -52,13 +73,37 @@ namespace DD4hep {
         /// Assignment operator
         StepInfo& operator=(const StepInfo& c);
       };
-      typedef std::vector<StepInfo*> Steps;
+      /// Step buffer. Cleared, but never released between tracks
+      typedef std::vector<StepInfo> Steps;
+
+      /// Property: Output file of the batch mode
+      std::string m_output;
 
       double m_sumX0     = 0E0;
       double m_sumLambda = 0E0;
       double m_sumPath   = 0E0;
       Steps  m_steps;
 
+      /// Batch mode: start position and direction of the current track
+      Position  m_start, m_direction;
+      /// Batch mode: X0 and lambda of the current track per subdetector (interleaved)
+      std::vector<double> m_budget;
+      /// Batch mode: results of this instance (i.e. of this thread)
+      Summary* m_results = 0;
+      /// Batch mode: summary shared by all instances with the same output
+      std::shared_ptr<Summary> m_summary;
+      /// Batch mode: subdetector index of the top level Geant4 placements
+      std::unordered_map<const G4VPhysicalVolume*, size_t> m_subdetectors;
+      /// Batch mode: material index of the Geant4 materials
+      std::unordered_map<const G4Material*, size_t> m_materials;
+
+      /// Batch mode: access the subdetector index of a step
+      size_t subdetector(const G4VTouchable* touchable);
+      /// Batch mode: access the material index of a step
+      size_t material(const G4Material* material);
+      /// Print the material table of the current track
+      void printSteps(const G4Track* track);
+
     public:
       /// Standard constructor
       Geant4MaterialScanner(Geant4Context* context, const std::string& name);
@@ -73,6 +118,53 @@ namespace DD4hep {
       /// Registered callback on Begin-event
       void beginEvent(const G4Event* event);
     };
+
+    /// Generator of geantino rays following a regular scan pattern
+    /**
+     *  Every event contains one ray. The ray is determined by the event
+     *  number, hence the pattern is distributed over all worker threads.
+     *  Each pattern contains NumEta*NumPhi or NumX*NumY rays through the
+     *  bin centers; further events repeat the pattern.
+     *
+     *  Pattern "EtaPhi": rays from Position in the direction given by the
+     *                    pseudo-rapidity and the azimuthal angle.
+     *  Pattern "XY":     parallel rays in the Direction starting at (x, y, z)
+     *                    with z taken from Position.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4MaterialScanGenerator : public Geant4ParticleGenerator  {
+    protected:
+      /// Property: Scan pattern "EtaPhi" or "XY"
+      std::string m_pattern;
+      /// Property: Pseudo-rapidity range and number of bins
+      double m_etaMin, m_etaMax;
+      int    m_numEta;
+      /// Property: Azimuthal angle range and number of bins
+      double m_phiMin, m_phiMax;
+      int    m_numPhi;
+      /// Property: x range and number of bins
+      double m_xMin, m_xMax;
+      int    m_numX;
+      /// Property: y range and number of bins
+      double m_yMin, m_yMax;
+      int    m_numY;
+
+      /// Access the bin centers of the current ray
+      void ray(double& u, double& v)  const;
+      /// Particle modification: the vertex of the x/y pattern
+      virtual void getVertexPosition(ROOT::Math::XYZVector& position) const;
+      /// Particle modification: the direction of the eta/phi pattern
+      virtual void getParticleDirection(int num, ROOT::Math::XYZVector& direction, double& momentum) const;
+
+    public:
+      /// Standard constructor
+      Geant4MaterialScanGenerator(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4MaterialScanGenerator();
+    };
   }
 }
 
@@ -88,19 +180,191 @@ namespace DD4hep {
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/Printout.h"
+#include "DD4hep/LCDD.h"
 #include "DDG4/Geant4TouchableHandler.h"
 #include "DDG4/Geant4StepHandler.h"
 #include "DDG4/Geant4EventAction.h"
 #include "DDG4/Geant4TrackingAction.h"
+#include "DDG4/Geant4Mapping.h"
 #include "CLHEP/Units/SystemOfUnits.h"
 #include "G4LogicalVolume.hh"
+#include "G4VTouchable.hh"
 #include "G4Material.hh"
+#include "G4Event.hh"
+
+// C/C++ include files
+#include <algorithm>
+#include <fstream>
+#include <cstdint>
+#include <cctype>
+#include <cmath>
+#include <mutex>
+#include <map>
 
 using namespace std;
 using namespace DD4hep::Simulation;
 
 #include "DDG4/Factories.h"
 DECLARE_GEANT4ACTION(Geant4MaterialScanner)
+DECLARE_GEANT4ACTION(Geant4MaterialScanGenerator)
+
+/// Material budget summary of the batch mode
+/**
+ *  Lengths are given in cm.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_SIMULATION
+ */
+class Geant4MaterialScanner::Summary  {
+public:
+  /// Integrated budget of one material
+  struct Material  {
+    string name;
+    double radLength, intLength, density;
+    double path, x0, lambda;
+  };
+  /// Budget of one ray
+  struct Ray  {
+    int64_t        event;
+    int32_t        track;
+    double         start[3], direction[3];
+    double         path, x0, lambda;
+    /// X0 and lambda per subdetector (interleaved)
+    vector<double> budget;
+  };
+
+  /// Output file name (empty for the per-thread results)
+  string                 output;
+  vector<string>         subdetectors;
+  vector<Material>       materials;
+  vector<Ray>            rays;
+  map<string,size_t>     subdetectorIndex, materialIndex;
+  /// Protection of the shared summary
+  mutex                  lock;
+
+  /// Initializing constructor
+  Summary(const string& out) : output(out) {}
+  /// Default destructor. The shared summary is written when the last scanner releases it
+  ~Summary()  {
+    if ( !output.empty() )  {
+      try  {
+        write();
+      }
+      catch(const exception& e)  {
+        DD4hep::printout(DD4hep::ERROR, "MaterialScan", "+++ Failed to write %s: %s", output.c_str(), e.what());
+      }
+    }
+  }
+  /// Access the summary shared by all scanners with the same output
+  static shared_ptr<Summary> instance(const string& out)  {
+    static mutex                             s_lock;
+    static map<string, weak_ptr<Summary> >   s_summaries;
+    lock_guard<mutex> protect(s_lock);
+    weak_ptr<Summary>& w = s_summaries[out];
+    shared_ptr<Summary> s = w.lock();
+    if ( !s )  {
+      s = make_shared<Summary>(out);
+      w = s;
+    }
+    return s;
+  }
+  /// Access a subdetector index by name
+  size_t subdetector(const string& nam)  {
+    map<string,size_t>::const_iterator i = subdetectorIndex.find(nam);
+    if ( i != subdetectorIndex.end() ) return (*i).second;
+    subdetectors.push_back(nam);
+    return subdetectorIndex[nam] = subdetectors.size()-1;
+  }
+  /// Access a material index by name
+  size_t material(const Material& mat)  {
+    map<string,size_t>::const_iterator i = materialIndex.find(mat.name);
+    if ( i != materialIndex.end() ) return (*i).second;
+    materials.push_back(mat);
+    materials.back().path = materials.back().x0 = materials.back().lambda = 0e0;
+    return materialIndex[mat.name] = materials.size()-1;
+  }
+  /// Merge the results of one thread
+  void merge(const Summary& s)  {
+    lock_guard<mutex> protect(lock);
+    vector<size_t> sub;
+    for(const string& n : s.subdetectors)
+      sub.push_back(subdetector(n));
+    for(const Material& m : s.materials)  {
+      Material& mat = materials[material(m)];
+      mat.path   += m.path;
+      mat.x0     += m.x0;
+      mat.lambda += m.lambda;
+    }
+    for(const Ray& r : s.rays)  {
+      rays.push_back(r);
+      vector<double>& b = rays.back().budget;
+      b.assign(2*subdetectors.size(), 0e0);
+      for(size_t i=0; 2*i<r.budget.size(); ++i)  {
+        b[2*sub[i]]   = r.budget[2*i];
+        b[2*sub[i]+1] = r.budget[2*i+1];
+      }
+    }
+  }
+  /// Write the binary summary file
+  /**
+   *  All numbers are written in native byte order:
+   *  - char[16] "DD4hepMatScan", int32 version (=1)
+   *  - int32 number of subdetectors; per subdetector: int32 length, name
+   *  - int32 number of materials; per material: int32 length, name,
+   *    double radiation length, interaction length, density [g/cm3],
+   *    total path, total X0, total lambda
+   *  - int64 number of rays; per ray ordered by event and track:
+   *    int64 event, int32 track, double start[3], direction[3], path, X0, lambda,
+   *    double X0 and lambda for each subdetector
+   */
+  void write()  {
+    ofstream out(output.c_str(), ios::binary|ios::trunc);
+    auto put_int = [&out](int32_t v)      { out.write((const char*)&v, sizeof(v)); };
+    auto put_dbl = [&out](double v)       { out.write((const char*)&v, sizeof(v)); };
+    auto put_str = [&](const string& s)   { put_int(int32_t(s.length())); out.write(s.c_str(), s.length()); };
+    char magic[16] = "DD4hepMatScan";
+    int64_t num_rays = rays.size();
+    size_t  num_sub  = subdetectors.size();
+
+    sort(rays.begin(), rays.end(), [](const Ray& a, const Ray& b)
+         { return a.event < b.event || (a.event == b.event && a.track < b.track); });
+    out.write(magic, sizeof(magic));
+    put_int(1);
+    put_int(int32_t(num_sub));
+    for(const string& s : subdetectors) put_str(s);
+    put_int(int32_t(materials.size()));
+    for(const Material& m : materials)  {
+      put_str(m.name);
+      put_dbl(m.radLength);  put_dbl(m.intLength);  put_dbl(m.density);
+      put_dbl(m.path);       put_dbl(m.x0);         put_dbl(m.lambda);
+    }
+    out.write((const char*)&num_rays, sizeof(num_rays));
+    for(Ray& r : rays)  {
+      r.budget.resize(2*num_sub, 0e0);
+      out.write((const char*)&r.event, sizeof(r.event));
+      put_int(r.track);
+      for(int i=0; i<3; ++i) put_dbl(r.start[i]);
+      for(int i=0; i<3; ++i) put_dbl(r.direction[i]);
+      put_dbl(r.path);  put_dbl(r.x0);  put_dbl(r.lambda);
+      out.write((const char*)&r.budget[0], r.budget.size()*sizeof(double));
+    }
+    out.close();
+    if ( !out.good() )  {
+      throw runtime_error("I/O error while writing the material scan summary.");
+    }
+    vector<double> sum(2*num_sub, 0e0);
+    for(const Ray& r : rays)
+      for(size_t i=0; i<2*num_sub; ++i) sum[i] += r.budget[i];
+    DD4hep::printout(DD4hep::INFO, "MaterialScan", "+++ Average material budget of %ld rays:", long(num_rays));
+    for(size_t i=0; i<num_sub && num_rays>0; ++i)  {
+      DD4hep::printout(DD4hep::INFO, "MaterialScan", "+++   %-24s  X0:%10.4f  Lambda:%10.4f",
+                       subdetectors[i].c_str(), sum[2*i]/double(num_rays), sum[2*i+1]/double(num_rays));
+    }
+    DD4hep::printout(DD4hep::INFO, "MaterialScan", "+++ Material scan summary of %ld rays written to %s",
+                     long(num_rays), output.c_str());
+  }
+};
 
 /// Initializing constructor
 Geant4MaterialScanner::StepInfo::StepInfo(const Position& prePos, const Position& postPos, const G4LogicalVolume* vol)
@@ -126,7 +390,9 @@ Geant4MaterialScanner::StepInfo& Geant4MaterialScanner::StepInfo::operator=(cons
 Geant4MaterialScanner::Geant4MaterialScanner(Geant4Context* ctxt, const string& nam)
   : Geant4SteppingAction(ctxt,nam)
 {
+  declareProperty("Output", m_output);
   m_needsControl = true;
+  m_steps.reserve(1024);
   eventAction().callAtBegin(this,&Geant4MaterialScanner::beginEvent);
   trackingAction().callAtEnd(this,&Geant4MaterialScanner::end);
   trackingAction().callAtBegin(this,&Geant4MaterialScanner::begin);
@@ -135,9 +401,46 @@ Geant4MaterialScanner::Geant4MaterialScanner(Geant4Context* ctxt, const string&
 
 /// Default destructor
 Geant4MaterialScanner::~Geant4MaterialScanner() {
+  if ( m_summary )  {
+    m_summary->merge(*m_results);
+    m_summary.reset();
+  }
+  deletePtr(m_results);
   InstanceCount::decrement(this);
 }
 
+/// Batch mode: access the subdetector index of a step
+size_t Geant4MaterialScanner::subdetector(const G4VTouchable* touchable)  {
+  int depth = touchable->GetHistoryDepth();
+  const G4VPhysicalVolume* pv = touchable->GetVolume(depth > 0 ? depth-1 : 0);
+  unordered_map<const G4VPhysicalVolume*, size_t>::const_iterator i = m_subdetectors.find(pv);
+  if ( i != m_subdetectors.end() ) return (*i).second;
+
+  // Top level placements are named after their detector element
+  string nam = depth > 0 ? pv->GetName() : string("world");
+  const Geant4GeometryMaps::PlacementMap& places = Geant4Mapping::instance().data().g4Placements;
+  for(const auto& c : context()->lcdd().world().children())  {
+    Geant4GeometryMaps::PlacementMap::const_iterator ip = places.find(c.second.placement());
+    if ( depth > 0 && ip != places.end() && (*ip).second == pv )  {
+      nam = c.first;
+      break;
+    }
+  }
+  return m_subdetectors[pv] = m_results->subdetector(nam);
+}
+
+/// Batch mode: access the material index of a step
+size_t Geant4MaterialScanner::material(const G4Material* mat)  {
+  unordered_map<const G4Material*, size_t>::const_iterator i = m_materials.find(mat);
+  if ( i != m_materials.end() ) return (*i).second;
+  Summary::Material m;
+  m.name      = mat->GetName();
+  m.radLength = mat->GetRadlen()/CLHEP::cm;
+  m.intLength = mat->GetNuclearInterLength()/CLHEP::cm;
+  m.density   = mat->GetDensity()/(CLHEP::gram/CLHEP::cm3);
+  return m_materials[mat] = m_results->material(m);
+}
+
 /// User stepping callback
 void Geant4MaterialScanner::operator()(const G4Step* step, G4SteppingManager*) {
   Geant4StepHandler h(step);
@@ -148,12 +451,34 @@ void Geant4MaterialScanner::operator()(const G4Step* step, G4SteppingManager*) {
   string postPath = post_handler.path();
 #endif
   G4LogicalVolume* logVol = h.logvol(h.pre);
-  m_steps.push_back(new StepInfo(h.prePos(), h.postPos(), logVol));
+  if ( m_output.empty() )  {
+    m_steps.push_back(StepInfo(h.prePos(), h.postPos(), logVol));
+    return;
+  }
+  if ( !m_summary )  {
+    m_results = new Summary("");
+    m_summary = Summary::instance(m_output);
+  }
+  const G4Material* mat = logVol->GetMaterial();
+  size_t sub = subdetector(h.preTouchable());
+  Summary::Material& m = m_results->materials[material(mat)];
+  double length  = (h.postPos() - h.prePos()).R()/CLHEP::cm;
+  double nx0     = length / m.radLength;
+  double nLambda = length / m.intLength;
+
+  if ( m_budget.size() <= 2*sub ) m_budget.resize(2*sub+2, 0e0);
+  m_budget[2*sub]   += nx0;
+  m_budget[2*sub+1] += nLambda;
+  m.path      += length;
+  m.x0        += nx0;
+  m.lambda    += nLambda;
+  m_sumPath   += length;
+  m_sumX0     += nx0;
+  m_sumLambda += nLambda;
 }
 
 /// Registered callback on Begin-event
 void Geant4MaterialScanner::beginEvent(const G4Event* /* event */)   {
-  for_each(m_steps.begin(),m_steps.end(),DestroyObject<StepInfo*>());
   m_steps.clear();
   m_sumX0 = 0;
   m_sumLambda = 0;
@@ -163,8 +488,12 @@ void Geant4MaterialScanner::beginEvent(const G4Event* /* event */)   {
 /// Begin-of-tracking callback
 void Geant4MaterialScanner::begin(const G4Track* track) {
   printP2("Starting tracking action for track ID=%d",track->GetTrackID());
-  for_each(m_steps.begin(),m_steps.end(),DestroyObject<StepInfo*>());
   m_steps.clear();
+  m_budget.assign(m_budget.size(), 0e0);
+  m_start = Position(track->GetPosition().x(), track->GetPosition().y(), track->GetPosition().z());
+  m_direction = Position(track->GetMomentumDirection().x(),
+                         track->GetMomentumDirection().y(),
+                         track->GetMomentumDirection().z());
   m_sumX0 = 0;
   m_sumLambda = 0;
   m_sumPath = 0;
@@ -172,13 +501,35 @@ void Geant4MaterialScanner::begin(const G4Track* track) {
 
 /// End-of-tracking callback
 void Geant4MaterialScanner::end(const G4Track* track) {
+  if ( !m_output.empty() )  {
+    if ( m_results && m_sumPath > 0e0 )  {
+      Summary::Ray r;
+      r.event  = context()->event().event().GetEventID();
+      r.track  = track->GetTrackID();
+      r.start[0] = m_start.X()/CLHEP::cm;
+      r.start[1] = m_start.Y()/CLHEP::cm;
+      r.start[2] = m_start.Z()/CLHEP::cm;
+      m_direction.GetCoordinates(r.direction);
+      r.path   = m_sumPath;
+      r.x0     = m_sumX0;
+      r.lambda = m_sumLambda;
+      r.budget = m_budget;
+      m_results->rays.push_back(r);
+    }
+    return;
+  }
+  printSteps(track);
+}
+
+/// Print the material table of the current track
+void Geant4MaterialScanner::printSteps(const G4Track* track) {
   using namespace CLHEP;
   if ( !m_steps.empty() )  {
     const char* line = " +--------------------------------------------------------------------------------------------------------------------------------------------------\n";
     const char* fmt1 = " | %5d %-20s %3.0f %8.3f %8.4f %11.4f  %11.4f %10.3f %8.2f %11.6f %11.6f  (%7.2f,%7.2f,%7.2f)\n";
     const char* fmt2 = " | %5d %-20s %3.0f %8.3f %8.4f %11.6g  %11.6g %10.3f %8.2f %11.6f %11.6f  (%7.2f,%7.2f,%7.2f)\n";
-    const Position& pre = m_steps[0]->pre;
-    const Position& post = m_steps[m_steps.size()-1]->post;
+    const Position& pre = m_steps[0].pre;
+    const Position& post = m_steps[m_steps.size()-1].post;
 
     ::printf("%s + Material scan between: x_0 = (%7.2f,%7.2f,%7.2f) [cm] and x_1 = (%7.2f,%7.2f,%7.2f) [cm]  TrackID:%d: \n%s",
              line,pre.X()/cm,pre.Y()/cm,pre.Z()/cm,post.X()/cm,post.Y()/cm,post.Z()/cm,track->GetTrackID(),line);
@@ -188,10 +539,10 @@ void Geant4MaterialScanner::end(const G4Track* track) {
     ::printf("%s",line);
     int count = 1;
     for(Steps::const_iterator i=m_steps.begin(); i!=m_steps.end(); ++i, ++count)  {
-      const G4LogicalVolume* logVol = (*i)->volume;
+      const G4LogicalVolume* logVol = (*i).volume;
       G4Material* material = logVol->GetMaterial();
-      const Position& prePos  = (*i)->pre;
-      const Position& postPos = (*i)->post;
+      const Position& prePos  = (*i).pre;
+      const Position& postPos = (*i).post;
       Position direction = postPos - prePos;
       double length  = direction.R()/cm;
       double intLen  = material->GetNuclearInterLength()/cm;
@@ -216,7 +567,68 @@ void Geant4MaterialScanner::end(const G4Track* track) {
                postPos.X()/cm,postPos.Y()/cm,postPos.Z()/cm);
       //cout << *m << endl;
     }
-    for_each(m_steps.begin(),m_steps.end(),DestroyObject<StepInfo*>());
     m_steps.clear();
   }
 }
+
+/// Standard constructor
+Geant4MaterialScanGenerator::Geant4MaterialScanGenerator(Geant4Context* ctxt, const string& nam)
+  : Geant4ParticleGenerator(ctxt, nam)
+{
+  InstanceCount::increment(this);
+  m_particleName = "geantino";
+  m_energy       = 20 * CLHEP::GeV;
+  declareProperty("Pattern", m_pattern = "EtaPhi");
+  declareProperty("EtaMin",  m_etaMin = -5.0);
+  declareProperty("EtaMax",  m_etaMax =  5.0);
+  declareProperty("NumEta",  m_numEta = 100);
+  declareProperty("PhiMin",  m_phiMin = 0.0);
+  declareProperty("PhiMax",  m_phiMax = 2.0*M_PI);
+  declareProperty("NumPhi",  m_numPhi = 1);
+  declareProperty("XMin",    m_xMin = -1.0*CLHEP::m);
+  declareProperty("XMax",    m_xMax =  1.0*CLHEP::m);
+  declareProperty("NumX",    m_numX = 100);
+  declareProperty("YMin",    m_yMin = -1.0*CLHEP::m);
+  declareProperty("YMax",    m_yMax =  1.0*CLHEP::m);
+  declareProperty("NumY",    m_numY = 100);
+}
+
+/// Default destructor
+Geant4MaterialScanGenerator::~Geant4MaterialScanGenerator() {
+  InstanceCount::decrement(this);
+}
+
+/// Access the bin centers of the current ray
+void Geant4MaterialScanGenerator::ray(double& u, double& v)  const  {
+  bool   xy    = ::toupper(m_pattern[0]) == 'X';
+  int    nu    = std::max(xy ? m_numX : m_numEta, 1);
+  int    nv    = std::max(xy ? m_numY : m_numPhi, 1);
+  long   num   = context()->event().event().GetEventID() % (long(nu)*long(nv));
+  double u_min = xy ? m_xMin : m_etaMin, u_max = xy ? m_xMax : m_etaMax;
+  double v_min = xy ? m_yMin : m_phiMin, v_max = xy ? m_yMax : m_phiMax;
+  u = u_min + (double(num/nv) + 0.5)*(u_max-u_min)/double(nu);
+  v = v_min + (double(num%nv) + 0.5)*(v_max-v_min)/double(nv);
+}
+
+/// Particle modification: the vertex of the x/y pattern
+void Geant4MaterialScanGenerator::getVertexPosition(ROOT::Math::XYZVector& position) const   {
+  if ( ::toupper(m_pattern[0]) == 'X' )  {
+    double x, y;
+    ray(x, y);
+    position.SetXYZ(x, y, m_position.Z());
+  }
+}
+
+/// Particle modification: the direction of the eta/phi pattern
+void Geant4MaterialScanGenerator::getParticleDirection(int, ROOT::Math::XYZVector& direction, double&) const   {
+  if ( ::toupper(m_pattern[0]) == 'E' )  {
+    double eta, phi;
+    ray(eta, phi);
+    double z = std::sinh(eta);
+    double r = std::sqrt(1.0+z*z);
+    direction.SetXYZ(std::cos(phi)/r, std::sin(phi)/r, z/r);
+  }
+  else if ( ::toupper(m_pattern[0]) != 'X' )  {
+    except("Unknown scan pattern: %s. Use EtaPhi or XY.", m_pattern.c_str());
+  }
+}
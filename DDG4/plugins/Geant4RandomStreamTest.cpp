@@ -0,0 +1,146 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4RandomStream.h"
+
+// C/C++ include files
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+
+  /// Known answer tests of the Philox4x32-10 block function (Random123 distribution)
+  bool check_known_answers()  {
+    static const uint32_t ctr[3][4] = {
+      { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+      { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+      { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } };
+    static const uint32_t key[3][2] = {
+      { 0x00000000, 0x00000000 },
+      { 0xffffffff, 0xffffffff },
+      { 0xa4093822, 0x299f31d0 } };
+    static const uint32_t res[3][4] = {
+      { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+      { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+      { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+    bool ok = true;
+    for(int i=0; i<3; ++i)  {
+      uint32_t out[4];
+      Geant4RandomStream::philox(ctr[i], key[i], out);
+      if ( ::memcmp(out, res[i], sizeof(out)) != 0 )  {
+        printout(ERROR,"RandomStreamTest","+++ Known answer test %d FAILED: %08x %08x %08x %08x",
+                 i, out[0], out[1], out[2], out[3]);
+        ok = false;
+      }
+    }
+    return ok;
+  }
+
+  /// Simulate the random draws of all events. Events are picked dynamically by the threads
+  vector<uint64_t> process(int num_threads, int num_events, int num_draws)  {
+    static const char* consumers[] = { "Gun", "VertexSmear/1", "Generator", "Digitizer" };
+    vector<uint64_t> result(num_events, 0);
+    vector<thread>   threads;
+    atomic<int>      next_event(0);
+    auto worker = [&]()  {
+      for(int evt = next_event++; evt < num_events; evt = next_event++)  {
+        uint64_t key  = Geant4RandomStream::eventKey(12345, 1, evt);
+        uint64_t hash = 0;
+        for(const char* c : consumers)  {
+          Geant4RandomStream rnd(key, Geant4RandomStream::streamID(c));
+          for(int i=0; i<num_draws; ++i)  {
+            double r = (i%2) ? rnd.gauss(0e0, 1e0) : rnd.rndm();
+            uint64_t bits;
+            ::memcpy(&bits, &r, sizeof(bits));
+            hash = (hash ^ bits) * 0x100000001B3ULL;
+          }
+        }
+        result[evt] = hash;
+      }
+    };
+    for(int i=0; i<num_threads; ++i)
+      threads.push_back(thread(worker));
+    for(auto& t : threads)
+      t.join();
+    return result;
+  }
+
+  /// Plugin function: Test of the counter based random streams
+  /**
+   *  Factory: DD4hep_Geant4RandomStreamTest
+   *
+   *  The random numbers of all events must be identical independent of
+   *  the number of threads processing the events.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   */
+  long random_stream_test(Geometry::LCDD& /* lcdd */, int argc, char** argv)  {
+    int num_events = 1000, num_draws = 100;
+    vector<int> num_threads;
+    for(int i=0; i<argc && argv[i]; ++i)  {
+      if ( 0 == ::strncmp("-events",argv[i],4) )
+        num_events = ::atol(argv[++i]);
+      else if ( 0 == ::strncmp("-draws",argv[i],4) )
+        num_draws = ::atol(argv[++i]);
+      else if ( 0 == ::strncmp("-threads",argv[i],4) )  {
+        while( i+1 < argc && argv[i+1] && argv[i+1][0] != '-' )
+          num_threads.push_back(::atol(argv[++i]));
+      }
+      else  {
+        printout(ALWAYS,"RandomStreamTest",
+                 "Usage: -plugin DD4hep_Geant4RandomStreamTest -events <number> -draws <number> -threads <n1> [<n2> ...]");
+        ::exit(EINVAL);
+      }
+    }
+    if ( num_threads.empty() )  {
+      num_threads = { 1, 4, 16 };
+    }
+    bool ok = check_known_answers();
+    vector<uint64_t> reference = process(num_threads[0], num_events, num_draws);
+    for(size_t i=1; i<num_threads.size(); ++i)  {
+      vector<uint64_t> res = process(num_threads[i], num_events, num_draws);
+      for(int evt=0; evt<num_events; ++evt)  {
+        if ( res[evt] != reference[evt] )  {
+          printout(ERROR,"RandomStreamTest","+++ Event %d differs with %d threads: %016llX <> %016llX",
+                   evt, num_threads[i], (unsigned long long)res[evt], (unsigned long long)reference[evt]);
+          ok = false;
+          break;
+        }
+      }
+    }
+    for(int evt=1; evt<num_events; ++evt)  {
+      if ( reference[evt] == reference[evt-1] )  {
+        printout(ERROR,"RandomStreamTest","+++ Events %d and %d have identical streams.",evt-1,evt);
+        ok = false;
+      }
+    }
+    printout(ok ? INFO : ERROR,"RandomStreamTest","+++ %d events with %d draws per stream: Test %s",
+             num_events, num_draws, ok ? "PASSED" : "FAILED");
+    return ok ? 1 : 0;
+  }
+}
+
+DECLARE_APPLY(DD4hep_Geant4RandomStreamTest,random_stream_test)
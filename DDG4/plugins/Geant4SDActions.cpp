@@ -60,8 +60,9 @@ namespace DD4hep {
       //   direction *= new_len/hit_len;
       // }
 
-      Hit* hit = new Hit(h.trkID(), h.trkPdgID(), h.deposit(), h.track->GetGlobalTime());
+      Hit* hit = new Hit(h.trkID(), h.trkPdgID(), h.deposit()*h.track->GetWeight(), h.track->GetGlobalTime());
       HitContribution contrib = Hit::extractContribution(step);
+      weighted(contrib, step);
       hit->cellID        = cellID(step);
       hit->energyDeposit = contrib.deposit;
       hit->position      = position;
@@ -108,6 +109,7 @@ namespace DD4hep {
       HitContribution contrib = Hit::extractContribution(step);
       HitCollection*  coll    = collection(m_collectionID);
       VolumeID cell = 0;
+      weighted(contrib, step);
 
       try {
         cell = cellID(step);
@@ -196,6 +198,7 @@ namespace DD4hep {
         HitCollection*  coll    = collection(m_collectionID);
         HitContribution contrib = Hit::extractContribution(step);
         Position        pos     = h.prePos();
+        weighted(contrib, step);
         Hit* hit = coll->find<Hit>(PositionCompare<Hit,Position>(pos));
         if ( !hit ) {
           hit = new Hit(pos);
@@ -248,6 +251,7 @@ namespace DD4hep {
       HitContribution contrib = Hit::extractContribution(step,true);
       HitCollection*  coll    = collection(m_collectionID);
       VolumeID cell = 0;
+      weighted(contrib, step);
       try {
         cell = cellID(step);
       } catch(std::runtime_error &e) {
@@ -347,6 +351,7 @@ namespace DD4hep {
       /// Update energy and track information during hit info accumulation
       void update(G4Step* step) {
         post.storePoint(step,step->GetPostStepPoint());
+        post.truth.deposit *= step->GetTrack()->GetWeight();
         pre.truth.deposit += post.truth.deposit;
         mean_pos.SetX(mean_pos.x()+post.position.x()*post.truth.deposit);
         mean_pos.SetY(mean_pos.y()+post.position.y()*post.truth.deposit);
@@ -0,0 +1,426 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4StackingAction.h"
+
+// C/C++ include files
+#include <map>
+#include <vector>
+
+// Forward declarations
+class G4Region;
+class G4ParticleDefinition;
+
+/// Namespace for the AIDA detector description toolkit
+namespace DD4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace Simulation {
+
+    /// Base class of the stacking policies: book keeping of the rule counters
+    /**
+     *  Every rule of a policy owns a counter of the tracks it affected.
+     *  The counters are printed when the action is deleted.
+     *  Only secondaries are subject to the stacking policies: primary
+     *  particles are always passed unchanged to the Geant4ParticleHandler.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4StackingPolicy : public Geant4StackingAction  {
+    public:
+      /// Counter of the tracks affected by one rule
+      struct Counter  {
+        /// Number of killed tracks
+        long   killed = 0;
+        /// Number of tracks which survived with increased weight
+        long   weighted = 0;
+        /// Number of tracks pushed to the waiting stack
+        long   waiting = 0;
+        /// Kinetic energy of the killed tracks
+        double energy = 0e0;
+      };
+      typedef std::map<std::string, Counter> Counters;
+    protected:
+      /// Counters by rule name
+      Counters m_counters;
+      /// Flag if the names of the rules are resolved
+      bool     m_resolved = false;
+
+      /// Access the counter of a rule
+      Counter* counter(const std::string& rule)  {  return &m_counters[rule];  }
+      /// Resolve region and particle names. Called before the first event
+      virtual void resolve() = 0;
+      /// Resolve a region name. Throws an exception if the region does not exist
+      G4Region* region(const std::string& nam)  const;
+      /// Resolve a particle name. Throws an exception if the particle does not exist
+      G4ParticleDefinition* particle(const std::string& nam)  const;
+      /// Kill a track and update the rule counter
+      TrackClassification kill(Counter* c, const G4Track* track)  const;
+
+    public:
+      /// Standard constructor
+      Geant4StackingPolicy(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor. Prints the counters
+      virtual ~Geant4StackingPolicy();
+      /// Preparation callback: resolves the names of the rules
+      virtual void prepare();
+    };
+
+    /// Stacking action killing secondaries below kinetic energy thresholds
+    /**
+     *  Properties:
+     *  - RegionThresholds:   Map region name -> minimal kinetic energy.
+     *                        Secondaries created in the region with lower energy are killed.
+     *  - ParticleThresholds: Map particle name -> minimal kinetic energy.
+     *                        Secondaries of the given type with lower energy are killed.
+     *  - NeutronTimeCut:     Neutrons created later than this global time are killed.
+     *                        Default: 0 (disabled).
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4TrackKillPolicy : public Geant4StackingPolicy  {
+    protected:
+      typedef std::pair<double, Counter*> Rule;
+      /// Property: Kinetic energy thresholds by region name
+      std::map<std::string, double> m_regionThresholds;
+      /// Property: Kinetic energy thresholds by particle name
+      std::map<std::string, double> m_particleThresholds;
+      /// Property: Time cut for neutrons
+      double                        m_neutronTimeCut;
+      /// Resolved region rules
+      std::map<const G4Region*, Rule>             m_regions;
+      /// Resolved particle rules
+      std::map<const G4ParticleDefinition*, Rule> m_particles;
+      /// Counter of the neutron time cut
+      Counter*                                    m_neutronCounter = 0;
+
+      /// Resolve region and particle names
+      virtual void resolve();
+    public:
+      /// Standard constructor
+      Geant4TrackKillPolicy(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4TrackKillPolicy();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(const G4Track* track);
+    };
+
+    /// Stacking action applying Russian roulette to low energy secondaries
+    /**
+     *  Secondaries below the energy threshold of their particle type created in
+     *  one of the selected regions (typically calorimeters) survive with the
+     *  probability p. The weight of the surviving tracks is multiplied by 1/p.
+     *  The weight is carried by the G4Track and is hence available to the
+     *  sensitive detectors through the step points. Killed tracks never reach
+     *  the tracking action and do not leave records in the Geant4ParticleHandler.
+     *
+     *  Properties:
+     *  - Regions:             Names of the regions where the roulette is played.
+     *  - Thresholds:          Map particle name -> kinetic energy threshold.
+     *                         Default: gamma: 5 MeV, neutron: 10 MeV.
+     *  - SurvivalProbability: Survival probability p. Default: 0.1
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4RussianRoulette : public Geant4StackingPolicy  {
+    protected:
+      typedef std::pair<double, Counter*> Rule;
+      /// Property: Names of the regions where the roulette is applied
+      std::vector<std::string>      m_regionNames;
+      /// Property: Kinetic energy thresholds by particle name
+      std::map<std::string, double> m_thresholds;
+      /// Property: Survival probability
+      double                        m_probability;
+      /// Resolved regions
+      std::vector<const G4Region*>  m_regions;
+      /// Resolved particle rules
+      std::map<const G4ParticleDefinition*, Rule> m_particles;
+
+      /// Resolve region and particle names
+      virtual void resolve();
+    public:
+      /// Standard constructor
+      Geant4RussianRoulette(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4RussianRoulette();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(const G4Track* track);
+    };
+
+    /// Stacking action prioritising the tracking of secondaries
+    /**
+     *  Secondaries pushed to the waiting stack are only tracked once the
+     *  urgent stack is empty. Tracking e.g. neutrons and soft particles last
+     *  allows to abort uninteresting events early and improves the locality
+     *  of the tracking.
+     *
+     *  Properties:
+     *  - WaitingParticles: Names of particles pushed to the waiting stack.
+     *  - WaitingThreshold: Secondaries with lower kinetic energy are pushed
+     *                      to the waiting stack. Default: 0 (disabled).
+     *  - UrgentParticles:  Names of particles always pushed to the urgent stack.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4StackPriority : public Geant4StackingPolicy  {
+    protected:
+      /// Property: Names of the particles tracked last
+      std::vector<std::string> m_waitingNames;
+      /// Property: Names of the particles always tracked first
+      std::vector<std::string> m_urgentNames;
+      /// Property: Kinetic energy threshold for the waiting stack
+      double                   m_waitingThreshold;
+      /// Resolved particle rules: stack and counter
+      std::map<const G4ParticleDefinition*, std::pair<G4ClassificationOfNewTrack, Counter*> > m_particles;
+      /// Counter of the energy rule
+      Counter*                 m_energyCounter = 0;
+
+      /// Resolve particle names
+      virtual void resolve();
+    public:
+      /// Standard constructor
+      Geant4StackPriority(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4StackPriority();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(const G4Track* track);
+    };
+  }    // End namespace Simulation
+}      // End namespace DD4hep
+
+// Geant4 include files
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4Track.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+  /// Region in which a new track was created. May be 0 for primaries
+  inline const G4Region* track_region(const G4Track* track)  {
+    const G4VPhysicalVolume* pv = track->GetVolume();
+    return pv ? pv->GetLogicalVolume()->GetRegion() : 0;
+  }
+}
+
+/// Standard constructor
+Geant4StackingPolicy::Geant4StackingPolicy(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingAction(ctxt, nam)
+{
+  InstanceCount::increment(this);
+}
+
+/// Default destructor. Prints the counters
+Geant4StackingPolicy::~Geant4StackingPolicy()   {
+  for(const auto& c : m_counters)  {
+    const Counter& cnt = c.second;
+    info("+++ Rule %-32s Killed:%9ld [%12.3f MeV] Weighted:%9ld Waiting:%9ld",
+         c.first.c_str(), cnt.killed, cnt.energy/MeV, cnt.weighted, cnt.waiting);
+  }
+  InstanceCount::decrement(this);
+}
+
+/// Preparation callback: resolves the names of the rules
+void Geant4StackingPolicy::prepare()   {
+  if ( !m_resolved )  {
+    resolve();
+    m_resolved = true;
+  }
+}
+
+/// Resolve a region name. Throws an exception if the region does not exist
+G4Region* Geant4StackingPolicy::region(const string& nam)  const   {
+  G4Region* r = G4RegionStore::GetInstance()->GetRegion(nam, false);
+  if ( !r )  {
+    except("+++ Failed to resolve stacking rule: Unknown region: '%s'",nam.c_str());
+  }
+  return r;
+}
+
+/// Resolve a particle name. Throws an exception if the particle does not exist
+G4ParticleDefinition* Geant4StackingPolicy::particle(const string& nam)  const   {
+  G4ParticleDefinition* p = G4ParticleTable::GetParticleTable()->FindParticle(nam);
+  if ( !p )  {
+    except("+++ Failed to resolve stacking rule: Unknown particle: '%s'",nam.c_str());
+  }
+  return p;
+}
+
+/// Kill a track and update the rule counter
+Geant4TrackClassification Geant4StackingPolicy::kill(Counter* c, const G4Track* track)  const   {
+  ++c->killed;
+  c->energy += track->GetKineticEnergy();
+  return TrackClassification(fKill);
+}
+
+/// Standard constructor
+Geant4TrackKillPolicy::Geant4TrackKillPolicy(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingPolicy(ctxt, nam)
+{
+  declareProperty("RegionThresholds",   m_regionThresholds);
+  declareProperty("ParticleThresholds", m_particleThresholds);
+  declareProperty("NeutronTimeCut",     m_neutronTimeCut = 0e0);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4TrackKillPolicy::~Geant4TrackKillPolicy()   {
+  InstanceCount::decrement(this);
+}
+
+/// Resolve region and particle names
+void Geant4TrackKillPolicy::resolve()   {
+  for(const auto& r : m_regionThresholds)
+    m_regions[region(r.first)] = Rule(r.second, counter("kill-region:"+r.first));
+  for(const auto& p : m_particleThresholds)
+    m_particles[particle(p.first)] = Rule(p.second, counter("kill-particle:"+p.first));
+  if ( m_neutronTimeCut > 0e0 )
+    m_neutronCounter = counter("kill-neutron-time");
+}
+
+/// Classify a new track
+Geant4TrackClassification Geant4TrackKillPolicy::classifyNewTrack(const G4Track* track)   {
+  if ( track->GetParentID() > 0 )  {
+    double ekin = track->GetKineticEnergy();
+    if ( !m_particles.empty() )  {
+      auto i = m_particles.find(track->GetDefinition());
+      if ( i != m_particles.end() && ekin < i->second.first )
+        return kill(i->second.second, track);
+    }
+    if ( !m_regions.empty() )  {
+      auto i = m_regions.find(track_region(track));
+      if ( i != m_regions.end() && ekin < i->second.first )
+        return kill(i->second.second, track);
+    }
+    if ( m_neutronCounter && track->GetDefinition()->GetPDGEncoding() == 2112 &&
+         track->GetGlobalTime() > m_neutronTimeCut )
+      return kill(m_neutronCounter, track);
+  }
+  return TrackClassification();
+}
+
+/// Standard constructor
+Geant4RussianRoulette::Geant4RussianRoulette(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingPolicy(ctxt, nam)
+{
+  m_thresholds["gamma"]   = 5*MeV;
+  m_thresholds["neutron"] = 10*MeV;
+  declareProperty("Regions",             m_regionNames);
+  declareProperty("Thresholds",          m_thresholds);
+  declareProperty("SurvivalProbability", m_probability = 0.1);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4RussianRoulette::~Geant4RussianRoulette()   {
+  InstanceCount::decrement(this);
+}
+
+/// Resolve region and particle names
+void Geant4RussianRoulette::resolve()   {
+  if ( m_probability <= 0e0 || m_probability > 1e0 )  {
+    except("+++ Invalid survival probability %g. Must be in the range (0,1].",m_probability);
+  }
+  if ( m_regionNames.empty() )  {
+    warning("+++ No regions given: Russian roulette is disabled.");
+  }
+  for(const auto& r : m_regionNames)
+    m_regions.push_back(region(r));
+  for(const auto& p : m_thresholds)
+    m_particles[particle(p.first)] = Rule(p.second, counter("roulette:"+p.first));
+}
+
+/// Classify a new track
+Geant4TrackClassification Geant4RussianRoulette::classifyNewTrack(const G4Track* track)   {
+  if ( !m_regions.empty() && track->GetParentID() > 0 )  {
+    auto i = m_particles.find(track->GetDefinition());
+    if ( i != m_particles.end() && track->GetKineticEnergy() < i->second.first )  {
+      const G4Region* r = track_region(track);
+      if ( r && find(m_regions.begin(), m_regions.end(), r) != m_regions.end() )  {
+        if ( G4UniformRand() >= m_probability )
+          return kill(i->second.second, track);
+        // Survivors carry the weight of the killed tracks
+        const_cast<G4Track*>(track)->SetWeight(track->GetWeight()/m_probability);
+        ++i->second.second->weighted;
+      }
+    }
+  }
+  return TrackClassification();
+}
+
+/// Standard constructor
+Geant4StackPriority::Geant4StackPriority(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingPolicy(ctxt, nam)
+{
+  declareProperty("WaitingParticles", m_waitingNames);
+  declareProperty("UrgentParticles",  m_urgentNames);
+  declareProperty("WaitingThreshold", m_waitingThreshold = 0e0);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4StackPriority::~Geant4StackPriority()   {
+  InstanceCount::decrement(this);
+}
+
+/// Resolve particle names
+void Geant4StackPriority::resolve()   {
+  for(const auto& p : m_waitingNames)
+    m_particles[particle(p)] = make_pair(fWaiting, counter("waiting-particle:"+p));
+  for(const auto& p : m_urgentNames)
+    m_particles[particle(p)] = make_pair(fUrgent, (Counter*)0);
+  if ( m_waitingThreshold > 0e0 )
+    m_energyCounter = counter("waiting-energy");
+}
+
+/// Classify a new track
+Geant4TrackClassification Geant4StackPriority::classifyNewTrack(const G4Track* track)   {
+  if ( track->GetParentID() > 0 )  {
+    auto i = m_particles.find(track->GetDefinition());
+    if ( i != m_particles.end() )  {
+      if ( i->second.second ) ++i->second.second->waiting;
+      return TrackClassification(i->second.first);
+    }
+    else if ( m_energyCounter && track->GetKineticEnergy() < m_waitingThreshold )  {
+      ++m_energyCounter->waiting;
+      return TrackClassification(fWaiting);
+    }
+  }
+  return TrackClassification();
+}
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION(Geant4TrackKillPolicy)
+DECLARE_GEANT4ACTION(Geant4RussianRoulette)
+DECLARE_GEANT4ACTION(Geant4StackPriority)
@@ -337,6 +337,8 @@ namespace DD4hep {
         kernel.steppingAction().adopt(_action<StepAction::handled_type>(action.get()));
       else if ( seqType.second == "PhysicsList" )
         kernel.physicsList().adopt(_action<PhysicsList::handled_type>(action.get()));
+      else if ( seqType.second == "DetectorConstruction" )
+        kernel.detectorConstruction().adopt(_action<DetectorConstruction::handled_type>(action.get()));
       else if ( sdSeq.get() )
         sdSeq->adopt(_action<Sensitive::handled_type>(action.get()));
       else   {
@@ -627,6 +627,22 @@ class Geant4:
     self.kernel().generatorAction().add(gun)
     return gun
 
+  """
+     Configure the pile-up overlay from background files.
+     The returned action is a shared generator module to be passed to buildInputStage.
+
+     \author  M.Frank
+  """
+  def setupPileup(self, name, inputs, mean, first_crossing=0, last_crossing=0, **args):
+    overlay = GeneratorAction(self.kernel(),"Geant4PileupOverlay/"+name,True)
+    for i in args.items():
+      setattr(overlay,i[0],i[1])
+    overlay.Inputs        = inputs
+    overlay.MeanPileup    = mean if isinstance(mean,(list,tuple)) else [mean]
+    overlay.FirstCrossing = first_crossing
+    overlay.LastCrossing  = last_crossing
+    return overlay
+
   """
      Configure ROOT output for the simulated events
 
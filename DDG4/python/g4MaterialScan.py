@@ -18,15 +18,60 @@ def printOpts(opts):
   for name,value in o.items():
     print '%s > %-18s %s  [%s]'%(prefix,name+':',str(value),str(value.__class__),)
 
+def setupScan(geant4, opts):
+  kernel = geant4.kernel()
+  if opts.output:
+    # Batch mode: one ray of the scan pattern per event
+    gen = DDG4.GeneratorAction(kernel,'Geant4MaterialScanGenerator/ScanGun')
+    gen.Position = opts.position
+    gen.Direction = opts.direction
+    if opts.xy:
+      gen.Pattern = 'XY'
+      gen.XMin, gen.XMax, gen.NumX = opts.xy[0]*SystemOfUnits.cm, opts.xy[1]*SystemOfUnits.cm, int(opts.xy[2])
+      gen.YMin, gen.YMax, gen.NumY = opts.xy[3]*SystemOfUnits.cm, opts.xy[4]*SystemOfUnits.cm, int(opts.xy[5])
+    else:
+      gen.Pattern = 'EtaPhi'
+      gen.EtaMin, gen.EtaMax, gen.NumEta = opts.eta[0], opts.eta[1], int(opts.eta[2])
+      gen.PhiMin, gen.PhiMax, gen.NumPhi = opts.phi[0], opts.phi[1], int(opts.phi[2])
+    geant4.buildInputStage([gen],have_mctruth=False)
+  else:
+    gun = geant4.setupGun("Gun",
+                          Standalone=True,
+                          particle='geantino',
+                          energy=20*SystemOfUnits.GeV,
+                          position=opts.position,
+                          direction=opts.direction,
+                          multiplicity=1,
+                          isotrop=False )
+  scan = DDG4.SteppingAction(kernel,'Geant4MaterialScanner/MaterialScan')
+  scan.Output = opts.output
+  kernel.steppingAction().adopt(scan)
+  return 1
+
+def numberOfRays(opts):
+  if not opts.output:
+    return 1
+  elif opts.xy:
+    return int(opts.xy[2])*int(opts.xy[5])
+  return int(opts.eta[2])*int(opts.phi[2])
+
 def materialScan(opts):
   kernel = DDG4.Kernel()
+  kernel.NumberOfThreads = opts.threads
   install_dir = os.environ['DD4hepINSTALL']
   kernel.loadGeometry(opts.compact)
   DDG4.Core.setPrintFormat("%-32s %6s %s")
   geant4 = DDG4.Geant4(kernel)
   # Configure UI
   geant4.setupCshUI(ui=None)
-  for i in geant4.lcdd.detectors():
+  if opts.threads > 0:
+    # The workers build the generation and the scan, the master only the geometry.
+    # Sensitive detectors are not required to scan the material.
+    geant4.addUserInitialization(worker=setupScan, worker_args=(geant4,opts))
+    geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  else:
+    setupScan(geant4, opts)
+  for i in (geant4.lcdd.detectors() if opts.threads == 0 else []):
     o = DDG4.DetElement(i.second.ptr())
     sd = geant4.lcdd.sensitiveDetector(o.name())
     if sd.isValid():
@@ -38,17 +83,6 @@ def materialScan(opts):
         print '+++  %-32s type:%-12s  --> Unknown Sensitive type: %s'%(o.name(), typ, sdtyp,)
         sys.exit(errno.EINVAL)
 
-  gun = geant4.setupGun("Gun",
-                        Standalone=True,
-                        particle='geantino',
-                        energy=20*SystemOfUnits.GeV,
-                        position=opts.position,
-                        direction=opts.direction,
-                        multiplicity=1,
-                        isotrop=False )
-  scan = DDG4.SteppingAction(kernel,'Geant4MaterialScanner/MaterialScan')
-  kernel.steppingAction().adopt(scan)
-
   # Now build the physics list:
   phys = geant4.setupPhysics('QGSP_BERT')
   """
@@ -62,9 +96,12 @@ def materialScan(opts):
   phys.adopt(ph) 
   """
 
+  kernel.NumEvents = numberOfRays(opts)
+  if opts.threads > 0:
+    geant4.run()
+    return 0
   kernel.configure()
   kernel.initialize()
-  kernel.NumEvents = 1
   kernel.run()
   kernel.terminate()
   return 0
@@ -88,6 +125,27 @@ parser.add_option('-d', '--direction',
                   help='Direction of the material scan. [give tuple "x,y,z" as string]',
 		  metavar='<tuple>')
 
+parser.add_option('-o', '--output',
+		  dest='output', default='',
+                  help='Batch mode: scan the pattern given by --eta/--phi or --xy and write the summary to this file.',
+		  metavar='<FILE>')
+parser.add_option('--eta',
+		  dest='eta', default='-5.0,5.0,100',
+                  help='Batch mode: pseudo-rapidity range and number of rays. [give tuple "min,max,n" as string]',
+		  metavar='<tuple>')
+parser.add_option('--phi',
+		  dest='phi', default='0.0,6.283185307,1',
+                  help='Batch mode: azimuthal range and number of rays. [give tuple "min,max,n" as string]',
+		  metavar='<tuple>')
+parser.add_option('--xy',
+		  dest='xy', default=None,
+                  help='Batch mode: parallel rays along the direction from a grid in x and y [cm]. [give tuple "xmin,xmax,nx,ymin,ymax,ny" as string]',
+		  metavar='<tuple>')
+parser.add_option('-t', '--threads',
+		  dest='threads', default=0, type='int',
+                  help='Number of Geant4 worker threads. 0 runs the scan sequentially.',
+		  metavar='<int>')
+
 (opts, args) = parser.parse_args()
 
 if opts.compact is None:
@@ -96,6 +154,9 @@ if opts.compact is None:
 
 opts.position=eval('('+opts.position+')')
 opts.direction=eval('('+opts.direction+')')
+opts.eta=eval('('+opts.eta+')')
+opts.phi=eval('('+opts.phi+')')
+if opts.xy: opts.xy=eval('('+opts.xy+')')
 printOpts(opts)
 
 try:
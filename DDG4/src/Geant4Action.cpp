@@ -64,6 +64,7 @@ Geant4Action::Geant4Action(Geant4Context* ctxt, const string& nam)
   declareProperty("name", m_name);
   declareProperty("OutputLevel", m_outputLevel);
   declareProperty("Control", m_needsControl);
+  declareProperty("Reentrant", m_reentrant);
 }
 
 /// Default destructor
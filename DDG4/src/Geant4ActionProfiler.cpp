@@ -0,0 +1,312 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4Action.h"
+#include "DDG4/Geant4ActionProfiler.h"
+
+// C/C++ include files
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <map>
+#include <ctime>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+std::atomic<bool> Geant4ActionProfiler::s_enabled(false);
+
+namespace {
+
+  typedef unsigned long long ticks_t;
+  typedef chrono::steady_clock steady_t;
+
+  /// Read the time stamp counter. Falls back to the steady clock in nanoseconds
+  inline ticks_t read_ticks()  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(steady_t::now().time_since_epoch()).count();
+#endif
+  }
+
+  /// CPU time of the calling thread in nanoseconds
+  inline long long thread_cpu_time()  {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec*1000000000LL + ts.tv_nsec;
+  }
+
+  /// Logarithmic histogram bin of a value
+  inline int log_bin(unsigned long long value)  {
+    int bin = 63 - __builtin_clzll(value|1);
+    return bin < Geant4ActionProfiler::NUM_BINS ? bin : Geant4ActionProfiler::NUM_BINS-1;
+  }
+
+  /// Counters of one action callback
+  struct Counter  {
+    std::string action;
+    const char* callback = 0;
+    long        calls = 0;
+    ticks_t     wall = 0;
+    long long   cpu = 0;
+    long        wallHist[Geant4ActionProfiler::NUM_BINS] = {0};
+    long        cpuHist[Geant4ActionProfiler::NUM_BINS] = {0};
+    /// Accumulate counters
+    Counter& operator+=(const Counter& c)  {
+      calls += c.calls;
+      wall  += c.wall;
+      cpu   += c.cpu;
+      for(int i=0; i<Geant4ActionProfiler::NUM_BINS; ++i)  {
+        wallHist[i] += c.wallHist[i];
+        cpuHist[i]  += c.cpuHist[i];
+      }
+      return *this;
+    }
+  };
+
+  /// Key of one action callback: action instance and callback name
+  typedef pair<const Geant4Action*,const char*> Key;
+
+  /// Hash function for the counter keys
+  struct KeyHash  {
+    size_t operator()(const Key& k) const  {
+      return hash<const void*>()(k.first) ^ (hash<const void*>()(k.second) << 1);
+    }
+  };
+
+  /// Single call recorded for the trace output
+  struct TraceEntry  {
+    const Counter* counter;
+    ticks_t        start;
+    ticks_t        duration;
+  };
+
+  /// Data store of one thread. Only written by the owning thread.
+  struct ThreadData  {
+    int                                   id;
+    unordered_map<Key,Counter,KeyHash>    counters;
+    vector<TraceEntry>                    trace;
+  };
+
+  /// Global profiler state
+  struct Profiler  {
+    mutex                          lock;
+    vector<unique_ptr<ThreadData> > threads;
+    atomic<size_t>                 numTrace;
+    size_t                         maxTrace = 0;
+    bool                           measureCPU = true;
+    ticks_t                        tick0 = 0;
+    steady_t::time_point           time0;
+    Profiler() : numTrace(0)  {}
+    /// Nanoseconds per tick from the calibration at enable time
+    double nsPerTick()  const  {
+      double ns = chrono::duration_cast<chrono::nanoseconds>(steady_t::now()-time0).count();
+      ticks_t ticks = read_ticks() - tick0;
+      return ticks > 0 ? ns/double(ticks) : 1e0;
+    }
+  };
+
+  Profiler& profiler()  {
+    static Profiler p;
+    return p;
+  }
+
+  /// Access the data store of the calling thread. Data stores are never deleted.
+  ThreadData& thread_data()  {
+    static thread_local ThreadData* data = 0;
+    if ( !data )  {
+      Profiler& p = profiler();
+      lock_guard<mutex> protection_lock(p.lock);
+      data = new ThreadData();
+      data->id = int(p.threads.size());
+      p.threads.push_back(unique_ptr<ThreadData>(data));
+    }
+    return *data;
+  }
+
+  /// Upper edge of the histogram bin containing the requested fraction of all entries
+  double percentile(const long* hist, long calls, double fraction)  {
+    long sum = 0, limit = long(fraction*double(calls));
+    for(int i=0; i<Geant4ActionProfiler::NUM_BINS; ++i)  {
+      sum += hist[i];
+      if ( sum > limit ) return double(1ULL<<(i+1));
+    }
+    return double(1ULL<<Geant4ActionProfiler::NUM_BINS);
+  }
+
+  /// Escape a string for the use in JSON
+  string json_escape(const string& s)  {
+    string r;
+    r.reserve(s.length());
+    for(char c : s)  {
+      if ( c == '"' || c == '\\' ) r += '\\';
+      r += c;
+    }
+    return r;
+  }
+}
+
+/// Enable the profiler
+void Geant4ActionProfiler::enable(bool measure_cpu, size_t max_trace_events)   {
+  Profiler& p = profiler();
+  p.measureCPU = measure_cpu;
+  p.maxTrace   = max_trace_events;
+  p.numTrace   = 0;
+  p.time0      = steady_t::now();
+  p.tick0      = read_ticks();
+  s_enabled    = true;
+}
+
+/// Disable the profiler
+void Geant4ActionProfiler::disable()   {
+  s_enabled = false;
+}
+
+/// Reset all counters. Only call while the worker threads are idle!
+void Geant4ActionProfiler::reset()   {
+  Profiler& p = profiler();
+  lock_guard<mutex> protection_lock(p.lock);
+  for(auto& d : p.threads)  {
+    d->trace.clear();
+    d->counters.clear();
+  }
+  p.numTrace = 0;
+}
+
+/// Start the measurement of one call
+void Geant4ActionProfiler::start(unsigned long long& ticks, long long& cpu)   {
+  cpu   = profiler().measureCPU ? thread_cpu_time() : 0;
+  ticks = read_ticks();
+}
+
+/// Record the measurement of one call
+void Geant4ActionProfiler::record(const Geant4Action* action, const char* callback,
+                                  unsigned long long ticks, long long cpu)
+{
+  ticks_t    wall = read_ticks() - ticks;
+  Profiler&  p    = profiler();
+  ThreadData& d   = thread_data();
+  Counter&   c    = d.counters[Key(action,callback)];
+  if ( 0 == c.callback )  {
+    c.action   = action->name();
+    c.callback = callback;
+  }
+  ++c.calls;
+  c.wall += wall;
+  ++c.wallHist[log_bin(wall)];
+  if ( p.measureCPU )  {
+    cpu = thread_cpu_time() - cpu;
+    c.cpu += cpu;
+    ++c.cpuHist[log_bin(cpu)];
+  }
+  if ( p.maxTrace > 0 && p.numTrace.fetch_add(1, memory_order_relaxed) < p.maxTrace )  {
+    TraceEntry e = { &c, ticks, wall };
+    d.trace.push_back(e);
+  }
+}
+
+/// Print the sorted summary. Only call while the worker threads are idle!
+void Geant4ActionProfiler::summary(int print_level, size_t max_lines, bool histograms)   {
+  Profiler& p = profiler();
+  map<pair<string,string>,Counter> merged;
+  ticks_t total_wall = 0;
+  double  ns = p.nsPerTick();
+  {
+    lock_guard<mutex> protection_lock(p.lock);
+    for(const auto& d : p.threads)  {
+      for(const auto& i : d->counters)  {
+        const Counter& c = i.second;
+        Counter& m = merged[make_pair(c.action,string(c.callback))];
+        m += c;
+        total_wall += c.wall;
+      }
+    }
+  }
+  vector<pair<const pair<string,string>*,const Counter*> > sorted;
+  for(const auto& i : merged)
+    sorted.push_back(make_pair(&i.first,&i.second));
+  sort(sorted.begin(), sorted.end(),
+       [](const pair<const pair<string,string>*,const Counter*>& a,
+          const pair<const pair<string,string>*,const Counter*>& b)
+       { return a.second->wall > b.second->wall;  });
+
+  PrintLevel lvl = PrintLevel(print_level);
+  printout(lvl,"Geant4Profiler","+++ Action profile of %ld threads. Sum of measured calls: %.3f sec "
+           "[Clock: %.3f GHz]", long(p.threads.size()), double(total_wall)*ns/1e9, 1e0/ns);
+  printout(lvl,"Geant4Profiler","+++ %-32s %-24s %11s %12s %7s %11s %11s %11s %12s",
+           "Action","Callback","Calls","Wall [ms]","[%]","Mean [us]","p50 [us]","p99 [us]","CPU [ms]");
+  for(size_t i=0; i<sorted.size() && i<max_lines; ++i)  {
+    const Counter& c = *sorted[i].second;
+    double wall_ms = double(c.wall)*ns/1e6;
+    printout(lvl,"Geant4Profiler","+++ %-32s %-24s %11ld %12.3f %7.2f %11.3f %11.3f %11.3f %12.3f",
+             sorted[i].first->first.c_str(), sorted[i].first->second.c_str(),
+             c.calls, wall_ms, total_wall ? 100e0*double(c.wall)/double(total_wall) : 0e0,
+             c.calls ? 1e3*wall_ms/double(c.calls) : 0e0,
+             percentile(c.wallHist,c.calls,0.50)*ns/1e3,
+             percentile(c.wallHist,c.calls,0.99)*ns/1e3,
+             double(c.cpu)/1e6);
+    if ( histograms )  {
+      for(int j=0; j<NUM_BINS; ++j)  {
+        if ( c.wallHist[j] || c.cpuHist[j] )  {
+          printout(lvl,"Geant4Profiler","+++      [%11.3f,%11.3f) us  Wall:%11ld  CPU [%11.3f,%11.3f) us:%11ld",
+                   double(1ULL<<j)*ns/1e3, double(1ULL<<(j+1))*ns/1e3, c.wallHist[j],
+                   double(1ULL<<j)/1e3, double(1ULL<<(j+1))/1e3, c.cpuHist[j]);
+        }
+      }
+    }
+  }
+  if ( sorted.size() > max_lines )  {
+    printout(lvl,"Geant4Profiler","+++ ... %ld further entries suppressed.",long(sorted.size()-max_lines));
+  }
+}
+
+/// Write the recorded calls as Chrome trace-event JSON. Only call while the worker threads are idle!
+bool Geant4ActionProfiler::writeTrace(const string& file_name)   {
+  Profiler& p = profiler();
+  ofstream out(file_name.c_str());
+  if ( !out.good() )  {
+    printout(ERROR,"Geant4Profiler","+++ Failed to open trace file %s",file_name.c_str());
+    return false;
+  }
+  double ns = p.nsPerTick();
+  size_t num = 0;
+  bool   first = true;
+  lock_guard<mutex> protection_lock(p.lock);
+  out << "{\"traceEvents\":[\n";
+  for(const auto& d : p.threads)  {
+    for(const auto& e : d->trace)  {
+      double ts  = double(e.start-p.tick0)*ns/1e3;
+      double dur = double(e.duration)*ns/1e3;
+      if ( !first ) out << ",\n";
+      first = false;
+      out << "{\"name\":\"" << json_escape(e.counter->action) << "\",\"cat\":\""
+          << json_escape(e.counter->callback) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << d->id
+          << ",\"ts\":" << fixed << ts << ",\"dur\":" << dur << "}";
+      ++num;
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  printout(INFO,"Geant4Profiler","+++ Wrote %ld trace events to %s",long(num),file_name.c_str());
+  return out.good();
+}
@@ -0,0 +1,129 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4Concurrency.h"
+
+// C/C++ include files
+#include <chrono>
+#include <vector>
+#include <map>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+  /// Registry of the locks of all shared actions
+  mutex registry_mutex;
+  map<const Geant4Action*,Geant4ActionLock*>& lock_registry()  {
+    static map<const Geant4Action*,Geant4ActionLock*> s_locks;
+    return s_locks;
+  }
+  /// Allocator of dense thread slots. Slots of finished threads are reused.
+  class ThreadSlots  {
+    mutex       m_lock;
+    vector<int> m_free;
+    int         m_next = 0;
+  public:
+    int allocate()  {
+      lock_guard<mutex> protection_lock(m_lock);
+      if ( m_free.empty() ) return m_next++;
+      int slot = m_free.back();
+      m_free.pop_back();
+      return slot;
+    }
+    void release(int slot)  {
+      lock_guard<mutex> protection_lock(m_lock);
+      m_free.push_back(slot);
+    }
+    static ThreadSlots& instance()  {
+      static ThreadSlots s_slots;
+      return s_slots;
+    }
+  };
+  /// Thread local slot holder: returns the slot when the thread exits
+  struct ThreadSlot  {
+    int index;
+    ThreadSlot() : index(ThreadSlots::instance().allocate()) {}
+    ~ThreadSlot()  {  ThreadSlots::instance().release(index);  }
+  };
+}
+
+/// Dense index of the calling thread for the use with Geant4PerThread
+int DD4hep::Simulation::geant4ThreadSlot()   {
+  static thread_local ThreadSlot slot;
+  return slot.index;
+}
+
+/// Initializing constructor
+Geant4ActionLock::Geant4ActionLock(const Geant4Action* action)
+  : m_name(action->name()), m_action(action)
+{
+  InstanceCount::increment(this);
+}
+
+/// Default destructor. Prints the lock statistics
+Geant4ActionLock::~Geant4ActionLock()   {
+  if ( m_action->isReentrant() )  {
+    printout(DEBUG,"Geant4ActionLock","+++ %-32s Reentrant shared action: no locking.",m_name.c_str());
+  }
+  else if ( m_calls > 0 )  {
+    printout(m_contended > 0 ? INFO : DEBUG,"Geant4ActionLock",
+             "+++ %-32s Calls:%10ld Contended:%10ld [%5.1f %%] Lock wait: %10.3f ms [%8.3f us/call]",
+             m_name.c_str(), m_calls, m_contended, 100e0*double(m_contended)/double(m_calls),
+             double(m_waitTime)/1e6, double(m_waitTime)/1e3/double(m_calls));
+  }
+  InstanceCount::decrement(this);
+}
+
+/// Constructor. Acquires the lock
+Geant4ActionLock::Guard::Guard(Geant4ActionLock* l) : lock(l)   {
+  if ( !lock->m_mutex.try_lock() )  {
+    typedef chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    lock->m_mutex.lock();
+    lock->m_waitTime += chrono::duration_cast<chrono::nanoseconds>(clock::now()-start).count();
+    ++lock->m_contended;
+  }
+  ++lock->m_calls;
+}
+
+/// Access the lock of a shared action. Creates the lock on first access.
+Geant4ActionLock* Geant4ActionLock::acquire(const Geant4Action* action)   {
+  lock_guard<mutex> protection_lock(registry_mutex);
+  Geant4ActionLock*& lock = lock_registry()[action];
+  if ( lock )  {
+    ++lock->m_refCount;
+    return lock;
+  }
+  lock = new Geant4ActionLock(action);
+  return lock;
+}
+
+/// Release a lock reference. The last release deletes the lock
+void Geant4ActionLock::release(Geant4ActionLock* lock)   {
+  if ( lock )  {
+    lock_guard<mutex> protection_lock(registry_mutex);
+    if ( --lock->m_refCount > 0 ) return;
+    auto& registry = lock_registry();
+    for(auto i=registry.begin(); i != registry.end(); ++i)  {
+      if ( i->second == lock )  {
+        registry.erase(i);
+        break;
+      }
+    }
+    delete lock;
+  }
+}
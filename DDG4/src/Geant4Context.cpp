@@ -38,8 +38,8 @@ Geant4Run::~Geant4Run()   {
 }
 
 /// Intializing constructor
-Geant4Event::Geant4Event(const G4Event* evt, Geant4Random* rnd)
-  : ObjectExtensions(typeid(Geant4Event)), m_event(evt), m_random(rnd)
+Geant4Event::Geant4Event(const G4Event* evt, Geant4Random* rnd, unsigned long long stream_key)
+  : ObjectExtensions(typeid(Geant4Event)), m_event(evt), m_random(rnd), m_streamKey(stream_key)
 {
   InstanceCount::increment(this);
 }
@@ -85,6 +85,11 @@ Geant4Event& Geant4Context::event()  const   {
   return *m_event;
 }
 
+/// Access the random stream of a named consumer for the current event
+Geant4RandomStream Geant4Context::randomStream(const std::string& consumer)  const   {
+  return event().randomStream(consumer);
+}
+
 /// Access to detector description
 Geometry::LCDD& Geant4Context::lcdd() const {
   return m_kernel->lcdd();
@@ -81,6 +81,10 @@
 #include "G4Transform3D.hh"
 #include "G4ThreeVector.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
+#include "G4PVDivision.hh"
+#include "G4PVParameterised.hh"
+#include "G4VPVParameterisation.hh"
 #include "G4ElectroMagneticField.hh"
 #include "G4FieldManager.hh"
 #include "G4ReflectionFactory.hh"
@@ -90,6 +94,8 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <chrono>
+#include <cmath>
 
 using namespace DD4hep::Simulation;
 //using namespace DD4hep::Simulation::Geant4GeometryMaps;
@@ -232,6 +238,100 @@ namespace {
     }
   };
 
+  /// Geant4 parameterisation of DD4hep parameterised placements: translations along a line
+  class Geant4PlacementParameterisation : public G4VPVParameterisation  {
+    G4ThreeVector     m_start;
+    G4ThreeVector     m_delta;
+    G4RotationMatrix* m_rotation;
+  public:
+    /// Initializing constructor. Positions in Geant4 units, the rotation is the frame rotation
+    Geant4PlacementParameterisation(const G4ThreeVector& start, const G4ThreeVector& delta, G4RotationMatrix* rot)
+      : G4VPVParameterisation(), m_start(start), m_delta(delta), m_rotation(rot)  {}
+    /// Default destructor
+    virtual ~Geant4PlacementParameterisation()  {
+      if ( m_rotation ) delete m_rotation;
+    }
+    /// G4VPVParameterisation overload: Position the copy with the given copy number
+    virtual void ComputeTransformation(const G4int copy_no, G4VPhysicalVolume* pv) const  {
+      pv->SetTranslation(m_start + double(copy_no)*m_delta);
+      pv->SetRotation(m_rotation);
+    }
+  };
+
+  /// Access the axis range of a divided TGeo shape in TGeo units. Returns the Geant4 axis
+  EAxis replicaAxis(const TGeoShape* sh, int axis, double& lo, double& hi)  {
+    switch(axis)  {
+    case Volume::X_axis:    sh->GetAxisRange(1, lo, hi);  return kXAxis;
+    case Volume::Y_axis:    sh->GetAxisRange(2, lo, hi);  return kYAxis;
+    case Volume::Rho_axis:  sh->GetAxisRange(1, lo, hi);  return kRho;
+    case Volume::Phi_axis:
+      sh->GetAxisRange(2, lo, hi);
+      lo *= DEGREE_2_RAD;
+      hi *= DEGREE_2_RAD;
+      return kPhi;
+    case Volume::Z_axis:
+    default:
+      sh->GetAxisRange(3, lo, hi);
+      return kZAxis;
+    }
+  }
+
+  /// Create the single Geant4 placement representing all copies of a replicated placement
+  G4VPhysicalVolume* placeReplica(const TGeoNode* node, const G4Transform3D& transform,
+                                  G4LogicalVolume* g4vol, G4LogicalVolume* g4mot, bool check)
+  {
+    PlacedVolume pv(node);
+    const PlacedVolume::Parameterisation* par = pv.params();
+    if ( par->type == PlacedVolume::Parameterisation::DIVISION )  {
+      double lo = 0e0, hi = 0e0;
+      EAxis  axis   = replicaAxis(node->GetMotherVolume()->GetShape(), par->axis, lo, hi);
+      double unit   = axis == kPhi ? CLHEP::radian : CM_2_MM;
+      double eps    = 1e-9*(hi-lo);
+      bool   filled = std::fabs(par->offset-lo) < eps && std::fabs(par->offset+par->count*par->width-hi) < eps;
+      // Replicas must fill the mother completely. Otherwise use divisions.
+      if ( axis != kRho && filled )  {
+        // Cartesian replicas are always centered: the offset is only used for phi replicas
+        double offset = axis == kPhi ? par->offset : 0e0;
+        return new G4PVReplica(node->GetName(), g4vol, g4mot, axis, par->count, par->width*unit, offset*unit);
+      }
+      // Offsets of divisions are relative to the start of the mother along the axis
+      return new G4PVDivision(node->GetName(), g4vol, g4mot, axis, par->count,
+                              par->width*unit, (par->offset-lo)*unit);
+    }
+    G4ThreeVector delta(par->delta.X()*CM_2_MM, par->delta.Y()*CM_2_MM, par->delta.Z()*CM_2_MM);
+    G4RotationMatrix  rot = transform.getRotation();
+    G4RotationMatrix* frame = rot.isIdentity() ? 0 : new G4RotationMatrix(rot.inverse());
+    // The axis is only a hint for the voxelisation of the mother volume
+    EAxis axis = kUndefined;
+    if      ( delta.y() == 0e0 && delta.z() == 0e0 ) axis = kXAxis;
+    else if ( delta.x() == 0e0 && delta.z() == 0e0 ) axis = kYAxis;
+    else if ( delta.x() == 0e0 && delta.y() == 0e0 ) axis = kZAxis;
+    return new G4PVParameterised(node->GetName(), g4vol, g4mot, axis, par->count,
+                                 new Geant4PlacementParameterisation(transform.getTranslation(), delta, frame),
+                                 check);
+  }
+
+  /// Timer of the geometry conversion printing the time spent in every conversion phase
+  class ConversionTimer  {
+    typedef chrono::steady_clock clock_type;
+    clock_type::time_point m_start, m_last;
+    PrintLevel m_level;
+  public:
+    /// Initializing constructor
+    ConversionTimer(PrintLevel lvl) : m_start(clock_type::now()), m_last(m_start), m_level(lvl) {}
+    /// Print the time elapsed since the end of the previous phase
+    void operator()(const char* phase, size_t count)  {
+      clock_type::time_point now = clock_type::now();
+      printout(m_level, "Geant4Converter", "++ Handled %7ld %-20s in %8.3f seconds.",
+               long(count), phase, chrono::duration<double>(now-m_last).count());
+      m_last = now;
+    }
+    /// Total time elapsed since construction
+    double total()  const  {
+      return chrono::duration<double>(clock_type::now()-m_start).count();
+    }
+  };
+
 #if 0  // warning: unused function 'handleName' [-Wunused-function]
   void handleName(const TGeoNode* n) {
     TGeoVolume* v = n->GetVolume();
@@ -374,10 +474,85 @@ void* Geant4Converter::handleMaterial(const string& name, Material medium) const
   return mat;
 }
 
+/// Access the parameters of a primitive shape. Returns false for composite and unknown shapes
+bool Geant4Converter::shapeParameters(const TGeoShape* shape, vector<double>& p)  {
+  const TClass* cl = shape->IsA();
+  p.clear();
+  if (cl == TGeoBBox::Class()) {
+    const TGeoBBox* s = (const TGeoBBox*) shape;
+    p = { s->GetDX(), s->GetDY(), s->GetDZ() };
+  }
+  else if (cl == TGeoTube::Class()) {
+    const TGeoTube* s = (const TGeoTube*) shape;
+    p = { s->GetRmin(), s->GetRmax(), s->GetDz() };
+  }
+  else if (cl == TGeoTubeSeg::Class()) {
+    const TGeoTubeSeg* s = (const TGeoTubeSeg*) shape;
+    p = { s->GetRmin(), s->GetRmax(), s->GetDz(), s->GetPhi1(), s->GetPhi2() };
+  }
+  else if (cl == TGeoEltu::Class()) {
+    const TGeoEltu* s = (const TGeoEltu*) shape;
+    p = { s->GetA(), s->GetB(), s->GetDz() };
+  }
+  else if (cl == TGeoTrd1::Class()) {
+    const TGeoTrd1* s = (const TGeoTrd1*) shape;
+    p = { s->GetDx1(), s->GetDx2(), s->GetDy(), s->GetDz() };
+  }
+  else if (cl == TGeoTrd2::Class()) {
+    const TGeoTrd2* s = (const TGeoTrd2*) shape;
+    p = { s->GetDx1(), s->GetDx2(), s->GetDy1(), s->GetDy2(), s->GetDz() };
+  }
+  else if (cl == TGeoHype::Class()) {
+    const TGeoHype* s = (const TGeoHype*) shape;
+    p = { s->GetRmin(), s->GetRmax(), s->GetStIn(), s->GetStOut(), s->GetDz() };
+  }
+  else if (cl == TGeoPgon::Class() || cl == TGeoPcon::Class()) {
+    const TGeoPcon* s = (const TGeoPcon*) shape;
+    p = { s->GetPhi1(), s->GetDphi(), double(s->GetNz()) };
+    if (cl == TGeoPgon::Class()) p.push_back(((const TGeoPgon*)s)->GetNedges());
+    for (Int_t i = 0; i < s->GetNz(); ++i) {
+      p.push_back(s->GetRmin(i));
+      p.push_back(s->GetRmax(i));
+      p.push_back(s->GetZ(i));
+    }
+  }
+  else if (cl == TGeoCone::Class()) {
+    const TGeoCone* s = (const TGeoCone*) shape;
+    p = { s->GetRmin1(), s->GetRmax1(), s->GetRmin2(), s->GetRmax2(), s->GetDz() };
+  }
+  else if (cl == TGeoConeSeg::Class()) {
+    const TGeoConeSeg* s = (const TGeoConeSeg*) shape;
+    p = { s->GetRmin1(), s->GetRmax1(), s->GetRmin2(), s->GetRmax2(), s->GetDz(), s->GetPhi1(), s->GetPhi2() };
+  }
+  else if (cl == TGeoParaboloid::Class()) {
+    const TGeoParaboloid* s = (const TGeoParaboloid*) shape;
+    p = { s->GetDz(), s->GetRlo(), s->GetRhi() };
+  }
+  else if (cl == TGeoSphere::Class()) {
+    const TGeoSphere* s = (const TGeoSphere*) shape;
+    p = { s->GetRmin(), s->GetRmax(), s->GetPhi1(), s->GetPhi2(), s->GetTheta1(), s->GetTheta2() };
+  }
+  else if (cl == TGeoTorus::Class()) {
+    const TGeoTorus* s = (const TGeoTorus*) shape;
+    p = { s->GetRmin(), s->GetRmax(), s->GetR(), s->GetPhi1(), s->GetDphi() };
+  }
+  else if (cl == TGeoTrap::Class()) {
+    const TGeoTrap* s = (const TGeoTrap*) shape;
+    p = { s->GetDz(), s->GetTheta(), s->GetPhi(), s->GetH1(), s->GetBl1(), s->GetTl1(), s->GetAlpha1(),
+          s->GetH2(), s->GetBl2(), s->GetTl2(), s->GetAlpha2() };
+  }
+  else  {
+    return false;
+  }
+  return true;
+}
+
 /// Dump solid in GDML format to output stream
 void* Geant4Converter::handleSolid(const string& name, const TGeoShape* shape) const {
   G4VSolid* solid = 0;
   if (shape) {
+    string key;
+    vector<double> params;
     if (0 != (solid = data().g4Solids[shape])) {
       return solid;
     }
@@ -387,7 +562,18 @@ void* Geant4Converter::handleSolid(const string& name, const TGeoShape* shape) c
       data().g4Solids[shape] = solid;
       return solid;
     }
-    else if (shape->IsA() == TGeoBBox::Class()) {
+    else if (shapeParameters(shape, params)) {
+      // Primitive shapes with identical parameters share the same Geant4 solid
+      key = shape->IsA()->GetName();
+      key.append((const char*)&params[0], params.size()*sizeof(double));
+      unordered_map<string, G4VSolid*>::const_iterator i = m_sharedSolids.find(key);
+      if (i != m_sharedSolids.end()) {
+        data().g4Solids[shape] = (*i).second;
+        return (*i).second;
+      }
+    }
+
+    if (shape->IsA() == TGeoBBox::Class()) {
       const TGeoBBox* s = (const TGeoBBox*) shape;
       solid = new G4Box(name, s->GetDX() * CM_2_MM, s->GetDY() * CM_2_MM, s->GetDZ() * CM_2_MM);
     }
@@ -551,6 +737,9 @@ void* Geant4Converter::handleSolid(const string& name, const TGeoShape* shape) c
       string err = "Failed to handle unknown solid shape:" + name + " of type " + string(shape->IsA()->GetName());
       throw runtime_error(err);
     }
+    if (!key.empty()) {
+      m_sharedSolids[key] = solid;
+    }
     data().g4Solids[shape] = solid;
   }
   return solid;
@@ -752,6 +941,22 @@ void* Geant4Converter::handlePlacement(const string& name, const TGeoNode* node)
       }
       G4LogicalVolume* g4vol = info.g4Volumes[vol];
       G4LogicalVolume* g4mot = info.g4Volumes[mot_vol];
+      PlacedVolume     pv(node);
+      if ( pv.data() && pv.isReplicated() )  {
+        //
+        // Replicated placement: all copies are represented by one single
+        // Geant4 placement, which is created from the first copy.
+        //
+        const TGeoNode* node0 = mot_vol->GetNode(0);
+        const TGeoMatrix* tr0 = node0->GetMatrix();
+        MyTransform3D tr_0(tr0->GetTranslation(),tr0->IsRotation() ? tr0->GetRotationMatrix() : s_identity_rot);
+        g4 = placeReplica(node0, tr_0, info.g4Volumes[node0->GetVolume()], g4mot, m_checkOverlaps);
+        for(Int_t i=0, n=mot_vol->GetNdaughters(); i<n; ++i)
+          info.g4Placements[mot_vol->GetNode(i)] = g4;
+        printout(m_outputLevel, "Geant4Converter", "+++ Replica: %s: %d copies of %s in mother %s",
+                 g4->GetName().c_str(), pv.params()->count, vol->GetName(), mot_vol->GetName());
+        return g4;
+      }
       g4 = new G4PVPlacement(transform,   // no rotation
                              g4vol,     // its logical volume
                              name,      // its name
@@ -762,7 +967,7 @@ void* Geant4Converter::handlePlacement(const string& name, const TGeoNode* node)
     }
     info.g4Placements[node] = g4;
   }
-  else {
+  else if ( !PlacedVolume(node).isReplicated() ) {
     printout(ERROR, "Geant4Converter", "++ Attempt to DOUBLE-place physical volume: %s No:%d", name.c_str(), node->GetNumber());
   }
   return g4;
@@ -928,7 +1133,7 @@ void Geant4Converter::printSensitive(SensitiveDetector sens_det, const set<const
   printout(INFO, "Geant4Converter", str.str().c_str());
 
   for (ConstVolumeSet::iterator i = volset.begin(); i != volset.end(); ++i) {
-    map<Volume, G4LogicalVolume*>::iterator v = info.g4Volumes.find(*i);
+    Geant4GeometryMaps::VolumeMap::iterator v = info.g4Volumes.find(*i);
     G4LogicalVolume* vol = (*v).second;
     str.str("");
     str << "                                   | " << "Volume:" << setw(24) << left << vol->GetName() << " "
@@ -1008,9 +1213,15 @@ template <typename O, typename C, typename F> void handleRMap(const O* o, const
 
 /// Create geometry conversion
 Geant4Converter& Geant4Converter::create(DetElement top) {
+  ConversionTimer timer(m_outputLevel);
   Geant4GeometryInfo& geo = this->init();
   m_data->clear();
+  m_sharedSolids.clear();
   collect(top, geo);
+  size_t num_nodes = 0;
+  for (Data::const_iterator i = m_data->begin(); i != m_data->end(); ++i)
+    num_nodes += (*i).second.size();
+  timer("collected nodes", num_nodes);
   m_checkOverlaps = false;
   // We do not have to handle defines etc.
   // All positions and the like are not really named.
@@ -1020,27 +1231,37 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   //setPrintLevel(VERBOSE);
 
   handle(this, geo.volumes, &Geant4Converter::collectVolume);
+  timer("volume settings", geo.volumes.size());
   handle(this, geo.solids,  &Geant4Converter::handleSolid);
-  printout(m_outputLevel, "Geant4Converter", "++ Handled %ld solids.", geo.solids.size());
+  timer("solids", geo.solids.size());
+  set<const G4VSolid*> unique_solids;
+  for (Geant4GeometryMaps::SolidMap::const_iterator i = geo.g4Solids.begin(); i != geo.g4Solids.end(); ++i)
+    if ((*i).second) unique_solids.insert((*i).second);
+  printout(m_outputLevel, "Geant4Converter", "++ Created %ld Geant4 solids for %ld shapes.",
+           long(unique_solids.size()), long(geo.solids.size()));
   handleRefs(this, geo.vis, &Geant4Converter::handleVis);
-  printout(m_outputLevel, "Geant4Converter", "++ Handled %ld visualization attributes.", geo.vis.size());
+  timer("vis attributes", geo.vis.size());
   handleMap(this, geo.limits, &Geant4Converter::handleLimitSet);
-  printout(m_outputLevel, "Geant4Converter", "++ Handled %ld limit sets.", geo.limits.size());
+  timer("limit sets", geo.limits.size());
   handleMap(this, geo.regions, &Geant4Converter::handleRegion);
-  printout(m_outputLevel, "Geant4Converter", "++ Handled %ld regions.", geo.regions.size());
+  timer("regions", geo.regions.size());
   handle(this, geo.volumes, &Geant4Converter::handleVolume);
-  printout(m_outputLevel, "Geant4Converter", "++ Handled %ld volumes.", geo.volumes.size());
+  timer("volumes", geo.volumes.size());
   handleRMap(this, *m_data, &Geant4Converter::handleAssembly);
+  timer("assemblies", geo.g4AssemblyVolumes.size());
   // Now place all this stuff appropriately
   handleRMap(this, *m_data, &Geant4Converter::handlePlacement);
+  timer("placements", geo.g4Placements.size());
   //==================== Fields
   handleProperties(m_lcdd.properties());
+  timer("properties", m_lcdd.properties().size());
 
   //handleMap(this, geo.sensitives, &Geant4Converter::printSensitive);
   //handleRMap(this, *m_data, &Geant4Converter::printPlacement);
 
   geo.setWorld(top.placement().ptr());
   geo.valid = true;
-  printout(INFO, "Geant4Converter", "+++  Successfully converted geometry to Geant4.");
+  printout(INFO, "Geant4Converter", "+++  Successfully converted geometry to Geant4 in %.3f seconds.",
+           timer.total());
   return *this;
 }
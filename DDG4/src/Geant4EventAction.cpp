@@ -15,6 +15,7 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4EventAction.h"
+#include "DDG4/Geant4Concurrency.h"
 // Geant4 headers
 #include "G4Threading.hh"
 #include "G4AutoLock.hh"
@@ -57,6 +58,7 @@ Geant4SharedEventAction::Geant4SharedEventAction(Geant4Context* ctxt, const stri
 
 /// Default destructor
 Geant4SharedEventAction::~Geant4SharedEventAction()   {
+  Geant4ActionLock::release(m_lock);
   releasePtr(m_action);
   InstanceCount::decrement(this);
 }
@@ -72,6 +74,8 @@ void Geant4SharedEventAction::use(Geant4EventAction* action)   {
     action->addRef();
     m_properties.adopt(action->properties());
     m_action = action;
+    Geant4ActionLock::release(m_lock);
+    m_lock = Geant4ActionLock::acquire(action);
     return;
   }
   throw runtime_error("Geant4SharedEventAction: Attempt to use invalid actor!");
@@ -80,20 +84,14 @@ void Geant4SharedEventAction::use(Geant4EventAction* action)   {
 /// Begin-of-event callback
 void Geant4SharedEventAction::begin(const G4Event* event)   {
   if ( m_action )  {
-    G4AutoLock protection_lock(&event_action_mutex);    {
-      ContextSwap swap(m_action,context());
-      m_action->begin(event);
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->begin(event); });
   }
 }
 
 /// End-of-event callback
 void Geant4SharedEventAction::end(const G4Event* event)   {
   if ( m_action )  {
-    G4AutoLock protection_lock(&event_action_mutex);  {
-      ContextSwap swap(m_action,context());
-      m_action->end(event);
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->end(event); });
   }
 }
 
@@ -143,13 +141,13 @@ void Geant4EventActionSequence::adopt(Geant4EventAction* action) {
 
 /// Pre-track action callback
 void Geant4EventActionSequence::begin(const G4Event* event)   {
-  m_actors(&Geant4EventAction::begin, event);
-  m_begin(event);
+  m_actors.profiled("begin-event", &Geant4EventAction::begin, event);
+  profiled("begin-event:callbacks", m_begin, event);
 }
 
 /// Post-track action callback
 void Geant4EventActionSequence::end(const G4Event* event)   {
-  m_end(event);
-  m_actors(&Geant4EventAction::end, event);
-  m_final(event);
+  profiled("end-event:callbacks", m_end, event);
+  m_actors.profiled("end-event", &Geant4EventAction::end, event);
+  profiled("end-event:final", m_final, event);
 }
@@ -32,6 +32,8 @@
 
 // Geant4 include files
 #include "G4Version.hh"
+#include "G4Run.hh"
+#include "G4Event.hh"
 #include "G4UserRunAction.hh"
 #include "G4UserEventAction.hh"
 #include "G4UserTrackingAction.hh"
@@ -111,7 +113,11 @@ namespace DD4hep {
         }
       }
       void createClientContext(const G4Event* evt)   {
-        Geant4Event* e = new Geant4Event(evt,Geant4Random::instance());
+        Geant4Run* r = m_activeContext->runPtr();
+        int run_id = r ? r->run().GetRunID() : 0;
+        unsigned long long key =
+          Geant4RandomStream::eventKey(kernel().randomStreamSeed(), run_id, evt->GetEventID());
+        Geant4Event* e = new Geant4Event(evt,Geant4Random::instance(),key);
         m_activeContext->setEvent(e);
       }
       void destroyClientContext(const G4Event*)   {
@@ -240,6 +246,11 @@ namespace DD4hep {
       virtual void PrepareNewEvent() {
         m_sequence->prepare();
       }
+      /// Classification callback of new tracks
+      virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) {
+        Geant4TrackClassification c = m_sequence->classifyNewTrack(track);
+        return c.defined ? c.value : G4UserStackingAction::ClassifyNewTrack(track);
+      }
     };
 
 
@@ -0,0 +1,188 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4FastSimShowerModel.h"
+
+// Geant4 include files
+#include "G4VFastSimulationModel.hh"
+#include "G4TransportationManager.hh"
+#include "G4VSensitiveDetector.hh"
+#include "G4TouchableHistory.hh"
+#include "G4ParticleTable.hh"
+#include "G4RegionStore.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Navigator.hh"
+#include "G4Step.hh"
+
+// C/C++ include files
+#include <mutex>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+
+  /// Protection of the model setup executed by all worker threads
+  mutex model_setup_mutex;
+
+  /// Geant4 fast simulation model forwarding the callbacks to a Geant4FastSimShowerModel
+  /**
+   *  One instance is created per worker thread. It owns the hit maker of the thread.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_SIMULATION
+   */
+  class Geant4FastSimModelWrapper : public G4VFastSimulationModel  {
+    const Geant4FastSimShowerModel* m_action;
+    Geant4FastSimHitMaker           m_hits;
+  public:
+    /// Initializing constructor. Attaches the model to the region
+    Geant4FastSimModelWrapper(const Geant4FastSimShowerModel* action, G4Region* region)
+      : G4VFastSimulationModel(action->name(), region), m_action(action) {}
+    /// Default destructor
+    virtual ~Geant4FastSimModelWrapper()  {}
+    /// Is the model applicable to the particle type?
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle)  override  {
+      return m_action->check(particle);
+    }
+    /// Should the model be triggered for this track?
+    virtual G4bool ModelTrigger(const G4FastTrack& track)  override  {
+      return m_action->trigger(track);
+    }
+    /// Create the shower
+    virtual void DoIt(const G4FastTrack& track, G4FastStep& step)  override  {
+      m_action->modelShower(track, step, m_hits);
+    }
+  };
+}
+
+/// Default constructor
+Geant4FastSimHitMaker::Geant4FastSimHitMaker()   {
+  m_navigator = new G4Navigator();
+  m_touchable = new G4TouchableHistory();
+  m_step      = new G4Step();
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FastSimHitMaker::~Geant4FastSimHitMaker()   {
+  // The step refers to the touchable: delete it first, then drop the last reference
+  deletePtr(m_step);
+  deletePtr(m_navigator);
+  m_touchable = 0;
+  InstanceCount::decrement(this);
+}
+
+/// Deposit energy at a global position. Returns false if the volume is not sensitive.
+bool Geant4FastSimHitMaker::deposit(const G4FastTrack& track, const G4ThreeVector& position,
+                                    double energy, double time)
+{
+  if ( !m_initialized )  {
+    G4Navigator* nav = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+    m_navigator->SetWorldVolume(nav->GetWorldVolume());
+    m_navigator->LocateGlobalPointAndUpdateTouchableHandle(position,G4ThreeVector(),m_touchable,false);
+    m_initialized = true;
+  }
+  else  {
+    m_navigator->LocateGlobalPointAndUpdateTouchableHandle(position,G4ThreeVector(),m_touchable);
+  }
+  G4VPhysicalVolume* pv = m_touchable->GetVolume();
+  G4VSensitiveDetector* sd = pv ? pv->GetLogicalVolume()->GetSensitiveDetector() : 0;
+  if ( !sd )  {
+    ++m_numLost;
+    return false;
+  }
+  G4Track*     trk  = const_cast<G4Track*>(track.GetPrimaryTrack());
+  G4StepPoint* pre  = m_step->GetPreStepPoint();
+  G4StepPoint* post = m_step->GetPostStepPoint();
+  m_step->SetTrack(trk);
+  m_step->SetStepLength(0e0);
+  m_step->SetTotalEnergyDeposit(energy);
+  pre->SetPosition(position);
+  pre->SetGlobalTime(time);
+  pre->SetLocalTime(trk->GetLocalTime());
+  pre->SetProperTime(trk->GetProperTime());
+  pre->SetMomentumDirection(trk->GetMomentumDirection());
+  pre->SetKineticEnergy(trk->GetKineticEnergy());
+  pre->SetMass(trk->GetDynamicParticle()->GetMass());
+  pre->SetCharge(trk->GetDynamicParticle()->GetCharge());
+  pre->SetWeight(trk->GetWeight());
+  pre->SetTouchableHandle(m_touchable);
+  pre->SetMaterial(pv->GetLogicalVolume()->GetMaterial());
+  pre->SetMaterialCutsCouple(pv->GetLogicalVolume()->GetMaterialCutsCouple());
+  pre->SetSensitiveDetector(sd);
+  *post = *pre;
+  ++m_numHits;
+  return sd->Hit(m_step);
+}
+
+/// Standard constructor
+Geant4FastSimShowerModel::Geant4FastSimShowerModel(Geant4Context* ctxt, const string& nam)
+  : Geant4DetectorConstruction(ctxt, nam)
+{
+  declareProperty("RegionName",          m_regionName);
+  declareProperty("ApplicableParticles", m_applicableParticleNames);
+  declareProperty("Enable",              m_enable = true);
+  declareProperty("Emin",                m_eMin = 0e0);
+  declareProperty("Emax",                m_eMax = 1e100);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FastSimShowerModel::~Geant4FastSimShowerModel()   {
+  for(auto& m : m_models) deletePtr(m);
+  m_models.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Sensitive detector construction callback. Creates the Geant4 model of this thread.
+void Geant4FastSimShowerModel::constructSensitives(Geant4DetectorConstructionContext* )   {
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion(m_regionName, false);
+  if ( !region )  {
+    except("+++ Failed to attach fast simulation model: Unknown region: '%s'",m_regionName.c_str());
+  }
+  lock_guard<mutex> protection_lock(model_setup_mutex);
+  if ( m_applicableParticles.empty() )  {
+    G4ParticleTable* table = G4ParticleTable::GetParticleTable();
+    for(const auto& n : m_applicableParticleNames)  {
+      const G4ParticleDefinition* def = table->FindParticle(n);
+      if ( !def )  {
+        except("+++ Failed to attach fast simulation model: Unknown particle: '%s'",n.c_str());
+      }
+      m_applicableParticles.insert(def);
+    }
+  }
+  // The model registers itself to the fast simulation manager of the region
+  m_models.push_back(new Geant4FastSimModelWrapper(this, region));
+  info("+++ Attached fast simulation model to region %s [%s]",
+       m_regionName.c_str(), m_enable ? "Enabled" : "Disabled");
+}
+
+/// Geant4 callback: Is the model applicable to the particle type?
+bool Geant4FastSimShowerModel::check(const G4ParticleDefinition& particle)  const   {
+  return m_applicableParticles.find(&particle) != m_applicableParticles.end();
+}
+
+/// Geant4 callback: Should the model be triggered for this track?
+bool Geant4FastSimShowerModel::trigger(const G4FastTrack& track)  const   {
+  if ( m_enable )  {
+    double ekin = track.GetPrimaryTrack()->GetKineticEnergy();
+    return ekin >= m_eMin && ekin <= m_eMax;
+  }
+  return false;
+}
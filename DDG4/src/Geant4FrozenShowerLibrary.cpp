@@ -0,0 +1,160 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4FrozenShowerLibrary.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+
+  /// Library file header
+  struct FileHeader  {
+    char     magic[8];
+    uint32_t version;
+    uint32_t numShowers;
+    uint64_t numSpots;
+  };
+  const char     LIBRARY_MAGIC[8] = "DDG4FSL";
+  const uint32_t LIBRARY_VERSION  = 1;
+
+  /// Order of the showers: particle class, then energy
+  bool shower_less(const Geant4FrozenShowerLibrary::Shower& a, const Geant4FrozenShowerLibrary::Shower& b)  {
+    return a.particle < b.particle || (a.particle == b.particle && a.energy < b.energy);
+  }
+}
+
+/// Particle class used as library key for a PDG code. Returns 0 if not supported.
+int Geant4FrozenShowerLibrary::particleClass(int pdg)   {
+  switch(pdg)  {
+  case 22:             return 22;
+  case 11:  case -11:  return 11;
+  default:             return 0;
+  }
+}
+
+/// Sort the showers by particle class and energy
+void Geant4FrozenShowerLibrary::sort()   {
+  if ( !m_sorted )  {
+    std::stable_sort(m_showers.begin(), m_showers.end(), shower_less);
+    m_sorted = true;
+  }
+}
+
+/// Add a shower
+void Geant4FrozenShowerLibrary::add(int pdg, double energy, const Spots& spots)   {
+  Shower s;
+  s.energy   = float(energy);
+  s.particle = particleClass(pdg);
+  s.first    = (unsigned int)m_spots.size();
+  s.count    = (unsigned int)spots.size();
+  if ( 0 == s.particle )  {
+    except("Geant4FrozenShowerLibrary","+++ Showers of particles with PDG code %d are not supported.",pdg);
+  }
+  m_spots.insert(m_spots.end(), spots.begin(), spots.end());
+  m_sorted = m_sorted && (m_showers.empty() || !shower_less(s, m_showers.back()));
+  m_showers.push_back(s);
+}
+
+/// Load a library file. Throws an exception on failure
+void Geant4FrozenShowerLibrary::load(const string& file_name)   {
+  FileHeader hdr;
+  FILE* f = ::fopen(file_name.c_str(),"rb");
+  if ( !f )  {
+    except("Geant4FrozenShowerLibrary","+++ Failed to open shower library %s: %s",
+           file_name.c_str(), ::strerror(errno));
+  }
+  bool ok = ::fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+    ::memcmp(hdr.magic, LIBRARY_MAGIC, sizeof(hdr.magic)) == 0 &&
+    hdr.version == LIBRARY_VERSION;
+  if ( ok )  {
+    m_showers.resize(hdr.numShowers);
+    m_spots.resize(hdr.numSpots);
+    ok = (hdr.numShowers == 0 || ::fread(&m_showers[0], sizeof(Shower), hdr.numShowers, f) == hdr.numShowers) &&
+      (hdr.numSpots == 0 || ::fread(&m_spots[0], sizeof(Spot), hdr.numSpots, f) == hdr.numSpots);
+  }
+  ::fclose(f);
+  for(size_t i=0; ok && i<m_showers.size(); ++i)
+    ok = uint64_t(m_showers[i].first) + m_showers[i].count <= hdr.numSpots;
+  if ( !ok )  {
+    m_showers.clear();
+    m_spots.clear();
+    except("Geant4FrozenShowerLibrary","+++ The file %s is no valid shower library.",file_name.c_str());
+  }
+  m_sorted = false;
+  sort();
+  printout(INFO,"Geant4FrozenShowerLibrary","+++ Loaded %ld showers with %ld spots [%.3f MB] from %s",
+           long(m_showers.size()), long(m_spots.size()), double(bytes())/1048576e0, file_name.c_str());
+}
+
+/// Save the library to file. Throws an exception on failure
+void Geant4FrozenShowerLibrary::save(const string& file_name)   {
+  FileHeader hdr;
+  sort();
+  ::memcpy(hdr.magic, LIBRARY_MAGIC, sizeof(hdr.magic));
+  hdr.version    = LIBRARY_VERSION;
+  hdr.numShowers = uint32_t(m_showers.size());
+  hdr.numSpots   = uint64_t(m_spots.size());
+  FILE* f = ::fopen(file_name.c_str(),"wb");
+  if ( !f )  {
+    except("Geant4FrozenShowerLibrary","+++ Failed to create shower library %s: %s",
+           file_name.c_str(), ::strerror(errno));
+  }
+  bool ok = ::fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+    (m_showers.empty() || ::fwrite(&m_showers[0], sizeof(Shower), m_showers.size(), f) == m_showers.size()) &&
+    (m_spots.empty()   || ::fwrite(&m_spots[0], sizeof(Spot), m_spots.size(), f) == m_spots.size());
+  ok = (::fclose(f) == 0) && ok;
+  if ( !ok )  {
+    except("Geant4FrozenShowerLibrary","+++ Failed to write shower library %s: %s",
+           file_name.c_str(), ::strerror(errno));
+  }
+  printout(INFO,"Geant4FrozenShowerLibrary","+++ Saved %ld showers with %ld spots [%.3f MB] to %s",
+           long(m_showers.size()), long(m_spots.size()), double(bytes())/1048576e0, file_name.c_str());
+}
+
+/// Select a shower of the nearest recorded energy. Returns 0 if none is present.
+const Geant4FrozenShowerLibrary::Shower*
+Geant4FrozenShowerLibrary::sample(int pdg, double energy, double rndm)  const   {
+  Shower key;
+  key.particle = particleClass(pdg);
+  key.energy   = float(energy);
+  // Range of showers of this particle class
+  Shower lo = key, hi = key;
+  lo.energy = -1e30f;
+  hi.energy =  1e30f;
+  Showers::const_iterator first = lower_bound(m_showers.begin(), m_showers.end(), lo, shower_less);
+  Showers::const_iterator last  = upper_bound(first, m_showers.end(), hi, shower_less);
+  if ( first == last )  {
+    return 0;
+  }
+  // Nearest recorded energy
+  Showers::const_iterator i = lower_bound(first, last, key, shower_less);
+  if ( i == last || (i != first && energy-(i-1)->energy < i->energy-energy) )
+    --i;
+  Shower e = *i;
+  Showers::const_iterator b = lower_bound(first, last, e, shower_less);
+  Showers::const_iterator t = upper_bound(b, last, e, shower_less);
+  size_t n = size_t(t-b), idx = size_t(rndm*double(n));
+  return &*(b + (idx < n ? idx : n-1));
+}
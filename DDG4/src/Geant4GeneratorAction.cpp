@@ -15,6 +15,7 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4GeneratorAction.h"
+#include "DDG4/Geant4Concurrency.h"
 // Geant4 headers
 #include "G4Threading.hh"
 #include "G4AutoLock.hh"
@@ -48,6 +49,7 @@ Geant4SharedGeneratorAction::Geant4SharedGeneratorAction(Geant4Context* ctxt, co
 
 /// Default destructor
 Geant4SharedGeneratorAction::~Geant4SharedGeneratorAction()   {
+  Geant4ActionLock::release(m_lock);
   releasePtr(m_action);
   InstanceCount::decrement(this);
 }
@@ -62,6 +64,8 @@ void Geant4SharedGeneratorAction::use(Geant4GeneratorAction* action)   {
   if (action) {
     action->addRef();
     m_action = action;
+    Geant4ActionLock::release(m_lock);
+    m_lock = Geant4ActionLock::acquire(action);
     return;
   }
   throw runtime_error("Geant4SharedGeneratorAction: Attempt to use invalid actor!");
@@ -70,10 +74,7 @@ void Geant4SharedGeneratorAction::use(Geant4GeneratorAction* action)   {
 /// User generator callback
 void Geant4SharedGeneratorAction::operator()(G4Event* event)  {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);    {
-      ContextSwap swap(m_action,context());
-      (*m_action)(event);
-    }
+    m_lock->execute(m_action, context(), [&]() { (*m_action)(event); });
   }
 }
 
@@ -121,6 +122,6 @@ void Geant4GeneratorActionSequence::adopt(Geant4GeneratorAction* action) {
 
 /// Generator callback
 void Geant4GeneratorActionSequence::operator()(G4Event* event) {
-  m_actors(&Geant4GeneratorAction::operator(), event);
-  m_calls(event);
+  m_actors.profiled("generate", &Geant4GeneratorAction::operator(), event);
+  profiled("generate:callbacks", m_calls, event);
 }
@@ -0,0 +1,527 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/LCDD.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Volumes.h"
+#include "DDG4/Geant4GeometryCache.h"
+
+// ROOT include files
+#include "TClass.h"
+#include "TGeoNode.h"
+#include "TGeoBBox.h"
+#include "TGeoMatrix.h"
+#include "TGeoMedium.h"
+#include "TGeoElement.h"
+#include "TGeoMaterial.h"
+#include "TGeoBoolNode.h"
+#include "TGeoScaledShape.h"
+#include "TGeoCompositeShape.h"
+
+// Geant4 include files
+#include "G4Region.hh"
+#include "G4Material.hh"
+#include "G4UserLimits.hh"
+#include "G4BooleanSolid.hh"
+#include "G4DisplacedSolid.hh"
+#include "G4VisAttributes.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#ifdef GEANT4_HAS_GDML
+#include "G4GDMLParser.hh"
+#endif
+
+// C/C++ include files
+#include <unordered_map>
+#include <unordered_set>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::Simulation;
+
+namespace {
+
+  /// Identifier of the relation file format
+  const char* s_cacheTag = "DD4hep-Geant4-cache-v1";
+
+  /// FNV-1a hash accumulating the geometry checksum
+  class Checksum  {
+  public:
+    unsigned long long value = 14695981039346656037ULL;
+    /// Add raw data
+    Checksum& add(const void* ptr, size_t len)  {
+      const unsigned char* c = (const unsigned char*)ptr;
+      for(size_t i=0; i<len; ++i)  {
+        value ^= c[i];
+        value *= 1099511628211ULL;
+      }
+      return *this;
+    }
+    Checksum& add(double value)         {  return add(&value, sizeof(value));                  }
+    Checksum& add(long value)           {  return add(&value, sizeof(value));                  }
+    Checksum& add(const char* value)    {  return add(value, value ? ::strlen(value)+1 : 0);   }
+  };
+
+  /// Helper to enumerate the geometry in deterministic order and to compute its checksum
+  /**
+   *  Shared shapes and media are hashed once at their first occurrence.
+   *  The names of shapes are not used: they may contain pointer values.
+   */
+  class Scanner  {
+  public:
+    Checksum                                   sum;
+    vector<const TGeoVolume*>&                 volumes;
+    unordered_map<const TGeoVolume*, long>     volumeIndex;
+    unordered_map<const TGeoShape*, long>      shapeIndex;
+    unordered_map<const TGeoMedium*, long>     mediumIndex;
+
+    Scanner(vector<const TGeoVolume*>& v) : volumes(v)  {
+      volumes.clear();
+      sum.add(s_cacheTag);
+    }
+    void addMatrix(const TGeoMatrix* m)  {
+      const Double_t* t = m->GetTranslation();
+      const Double_t* r = m->GetRotationMatrix();
+      const Double_t* s = m->GetScale();
+      for(int i=0; i<3; ++i) sum.add(t[i]);
+      for(int i=0; i<9; ++i) sum.add(r[i]);
+      for(int i=0; i<3; ++i) sum.add(s[i]);
+    }
+    void addShape(const TGeoShape* shape)  {
+      auto ins = shapeIndex.insert(make_pair(shape, long(shapeIndex.size())));
+      sum.add((*ins.first).second);
+      if ( !ins.second ) return;
+
+      vector<double> params;
+      const TClass* cl = shape->IsA();
+      sum.add(cl->GetName());
+      if ( Geant4Converter::shapeParameters(shape, params) )  {
+        const Double_t* o = ((const TGeoBBox*)shape)->GetOrigin();
+        for(double p : params) sum.add(p);
+        for(int i=0; i<3; ++i) sum.add(o[i]);
+      }
+      else if ( cl == TGeoCompositeShape::Class() )  {
+        const TGeoBoolNode* b = ((const TGeoCompositeShape*)shape)->GetBoolNode();
+        sum.add(long(b->GetBooleanOperator()));
+        addShape(b->GetLeftShape());
+        addMatrix(b->GetLeftMatrix());
+        addShape(b->GetRightShape());
+        addMatrix(b->GetRightMatrix());
+      }
+      else if ( cl == TGeoScaledShape::Class() )  {
+        const TGeoScaledShape* s = (const TGeoScaledShape*)shape;
+        const Double_t* scale = s->GetScale()->GetScale();
+        for(int i=0; i<3; ++i) sum.add(scale[i]);
+        addShape(s->GetShape());
+      }
+    }
+    void addMedium(const TGeoMedium* medium)  {
+      if ( !medium )  {
+        sum.add(-1L);
+        return;
+      }
+      auto ins = mediumIndex.insert(make_pair(medium, long(mediumIndex.size())));
+      sum.add((*ins.first).second);
+      if ( !ins.second ) return;
+
+      TGeoMaterial* m = medium->GetMaterial();
+      sum.add(medium->GetName()).add(m->GetName()).add(m->GetDensity()).add(long(m->GetState()));
+      sum.add(m->GetTemperature()).add(m->GetPressure()).add(m->GetA()).add(m->GetZ());
+      if ( m->IsMixture() )  {
+        const TGeoMixture* mix = (const TGeoMixture*)m;
+        for(Int_t i=0, n=mix->GetNelements(); i<n; ++i)  {
+          TGeoElement* e = mix->GetElement(i);
+          sum.add(e->GetName()).add(e->GetTitle()).add(long(e->Z())).add(e->A()).add(mix->GetWmixt()[i]);
+          for(Int_t j=0, niso=e->GetNisotopes(); j<niso; ++j)  {
+            TGeoIsotope* iso = e->GetIsotope(j);
+            sum.add(iso->GetName()).add(long(iso->GetZ())).add(long(iso->GetN())).add(iso->GetA());
+            sum.add(e->GetRelativeAbundance(j));
+          }
+        }
+      }
+    }
+    long addVolume(const TGeoVolume* vol)  {
+      auto ins = volumeIndex.insert(make_pair(vol, long(volumes.size())));
+      if ( !ins.second ) return (*ins.first).second;
+
+      long ordinal = long(volumes.size());
+      volumes.push_back(vol);
+      sum.add(ordinal).add(vol->GetName()).add(vol->IsA()->GetName());
+      addShape(vol->GetShape());
+      addMedium(vol->GetMedium());
+      sum.add(long(vol->GetNdaughters()));
+      for(Int_t i=0, n=vol->GetNdaughters(); i<n; ++i)  {
+        const TGeoNode* node = vol->GetNode(i);
+        long daughter = addVolume(node->GetVolume());
+        Geometry::PlacedVolume pv(node);
+        sum.add(daughter).add(node->GetName()).add(long(node->GetNumber()));
+        addMatrix(node->GetMatrix());
+        if ( pv.data() && pv.params() )  {
+          const Geometry::PlacedVolume::Parameterisation* p = pv.params();
+          sum.add(long(p->type)).add(long(p->axis)).add(long(p->count)).add(p->offset).add(p->width);
+          sum.add(p->start.X()).add(p->start.Y()).add(p->start.Z());
+          sum.add(p->delta.X()).add(p->delta.Y()).add(p->delta.Z());
+        }
+      }
+      return ordinal;
+    }
+  };
+
+#ifdef GEANT4_HAS_GDML
+  /// Relation of a DD4hep placement to the Geant4 placement: daughter of a logical volume
+  struct Relation  {
+    Geant4GeometryCache::NodeKey node;
+    Geant4GeometryCache::NodeKey g4;
+    vector<Geant4GeometryCache::NodeKey> chain;
+  };
+
+  /// Register the solids of a restored (boolean) solid
+  void restoreSolid(Geant4GeometryInfo& info, const TGeoShape* shape, G4VSolid* solid)  {
+    info.g4Solids[shape] = solid;
+    if ( shape->IsA() == TGeoCompositeShape::Class() )  {
+      G4BooleanSolid* b = dynamic_cast<G4BooleanSolid*>(solid);
+      if ( b )  {
+        const TGeoBoolNode* boolean = ((const TGeoCompositeShape*)shape)->GetBoolNode();
+        G4VSolid* right = b->GetConstituentSolid(1);
+        G4DisplacedSolid* moved = dynamic_cast<G4DisplacedSolid*>(right);
+        restoreSolid(info, boolean->GetLeftShape(),  b->GetConstituentSolid(0));
+        restoreSolid(info, boolean->GetRightShape(), moved ? moved->GetConstituentMovedSolid() : right);
+      }
+    }
+  }
+#endif
+}
+
+/// Initializing constructor
+Geant4GeometryCache::Geant4GeometryCache(Geant4Converter& converter, const string& prefix)
+  : m_converter(converter), m_prefix(prefix), m_checksum(0)
+{
+}
+
+/// Default destructor
+Geant4GeometryCache::~Geant4GeometryCache()   {
+}
+
+/// Enumerate the volumes below the top element and compute the checksum
+void Geant4GeometryCache::scan(DetElement top)   {
+  const TGeoNode* top_node = top.placement().ptr();
+  Scanner scanner(m_volumes);
+  scanner.sum.add(top_node->GetName());
+  scanner.addVolume(top_node->GetVolume());
+  m_checksum = scanner.sum.value;
+}
+
+/// Name of the cached GDML file
+string Geant4GeometryCache::gdmlFile()  const   {
+  char text[32];
+  ::snprintf(text, sizeof(text), "_%016llx.gdml", m_checksum);
+  return m_prefix + text;
+}
+
+/// Name of the file with the placement relations
+string Geant4GeometryCache::mappingFile()  const   {
+  char text[32];
+  ::snprintf(text, sizeof(text), "_%016llx.map", m_checksum);
+  return m_prefix + text;
+}
+
+/// Save the geometry converted before. Returns false if the geometry cannot be cached
+bool Geant4GeometryCache::save(DetElement top)   {
+#ifndef GEANT4_HAS_GDML
+  if ( top.isValid() )  {
+    printout(WARNING, "Geant4GeometryCache", "+++ No GDML support: The geometry cannot be cached.");
+  }
+  return false;
+#else
+  Geant4GeometryInfo& info = m_converter.data();
+  if ( !info.valid )  {
+    except("Geant4GeometryCache", "+++ The geometry must be converted before it can be cached.");
+  }
+  scan(top);
+  size_t num_volumes = m_volumes.size();
+  unordered_map<const TGeoNode*, NodeKey> node_keys;
+  for(size_t i=0; i<num_volumes; ++i)  {
+    const TGeoVolume* vol = m_volumes[i];
+    for(Int_t j=0, n=vol->GetNdaughters(); j<n; ++j)  {
+      const TGeoNode* node = vol->GetNode(j);
+      Geometry::PlacedVolume pv(node);
+      if ( pv.data() && pv.params() && pv.params()->type == Geometry::PlacedVolume::Parameterisation::PARAMETERISED )  {
+        printout(WARNING, "Geant4GeometryCache", "+++ Parameterised placement %s: The geometry cannot be cached.",
+                 node->GetName());
+        return false;
+      }
+      node_keys[node] = NodeKey(i, j);
+    }
+  }
+  // Locate every Geant4 placement as daughter of a converted logical volume
+  vector<G4LogicalVolume*> lvs(num_volumes, 0);
+  unordered_map<const G4VPhysicalVolume*, NodeKey> locations;
+  for(size_t i=0; i<num_volumes; ++i)  {
+    Geant4GeometryMaps::VolumeMap::const_iterator iv = info.g4Volumes.find(m_volumes[i]);
+    if ( iv != info.g4Volumes.end() && (*iv).second )  {
+      G4LogicalVolume* lv = lvs[i] = (*iv).second;
+      for(int k=0, n=lv->GetNoDaughters(); k<n; ++k)
+        locations[lv->GetDaughter(k)] = NodeKey(i, k);
+    }
+  }
+  stringstream out;
+  out << s_cacheTag << " " << hex << m_checksum << dec << " " << num_volumes << endl;
+  long num_placements = 0;
+  for(const auto& n : node_keys)  {
+    Geant4GeometryMaps::PlacementMap::const_iterator ip = info.g4Placements.find(n.first);
+    if ( ip == info.g4Placements.end() ) continue;  // Daughters of assemblies are imprinted
+    auto il = locations.find((*ip).second);
+    if ( il == locations.end() )  {
+      printout(WARNING, "Geant4GeometryCache", "+++ Placement %s has no converted mother volume: "
+               "The geometry cannot be cached.", n.first->GetName());
+      return false;
+    }
+    out << "P " << n.second.first << " " << n.second.second << " "
+        << (*il).second.first << " " << (*il).second.second << endl;
+    ++num_placements;
+  }
+  unordered_map<const TGeoVolume*, size_t> volume_keys;
+  for(size_t i=0; i<num_volumes; ++i) volume_keys[m_volumes[i]] = i;
+  for(const auto& vi : info.g4VolumeImprints)  {
+    for(const auto& imp : vi.second)  {
+      auto il = locations.find(imp.second);
+      if ( il == locations.end() || volume_keys.find(vi.first) == volume_keys.end() )  {
+        printout(WARNING, "Geant4GeometryCache", "+++ Unresolved imprint of the assembly %s: "
+                 "The geometry cannot be cached.", vi.first.name());
+        return false;
+      }
+      out << "I " << volume_keys[vi.first] << " " << (*il).second.first << " " << (*il).second.second
+          << " " << imp.first.size();
+      for(const TGeoNode* n : imp.first)  {
+        auto ik = node_keys.find(n);
+        if ( ik == node_keys.end() )  {
+          printout(WARNING, "Geant4GeometryCache", "+++ Unresolved imprint of the assembly %s: "
+                   "The geometry cannot be cached.", vi.first.name());
+          return false;
+        }
+        out << " " << (*ik).second.first << " " << (*ik).second.second;
+      }
+      out << endl;
+      ++num_placements;
+    }
+  }
+  // The logical volumes are tagged with their ordinal for the duration of the GDML dump
+  string gdml = gdmlFile(), mapping = mappingFile();
+  vector<G4String> names(num_volumes);
+  for(size_t i=0; i<num_volumes; ++i)  {
+    if ( lvs[i] )  {
+      stringstream tag;
+      names[i] = lvs[i]->GetName();
+      tag << names[i] << "#" << i;
+      lvs[i]->SetName(tag.str());
+    }
+  }
+  try  {
+    G4GDMLParser parser;
+    ::remove(gdml.c_str());
+    parser.Write(gdml, info.world(), true);
+  }
+  catch(...)  {
+    for(size_t i=0; i<num_volumes; ++i)
+      if ( lvs[i] ) lvs[i]->SetName(names[i]);
+    throw;
+  }
+  for(size_t i=0; i<num_volumes; ++i)
+    if ( lvs[i] ) lvs[i]->SetName(names[i]);
+
+  // The relation file is written last: it marks the cache as complete
+  ofstream file(mapping.c_str());
+  file << out.str();
+  file.close();
+  if ( !file.good() )  {
+    printout(WARNING, "Geant4GeometryCache", "+++ Failed to write the cache file %s.", mapping.c_str());
+    ::remove(mapping.c_str());
+    return false;
+  }
+  printout(INFO, "Geant4GeometryCache", "+++ Saved converted geometry to %s [%ld volumes, %ld placements].",
+           gdml.c_str(), long(num_volumes), num_placements);
+  return true;
+#endif
+}
+
+/// Restore the converted geometry from the cache. Returns false if no valid cache exists
+bool Geant4GeometryCache::restore(DetElement top)   {
+#ifndef GEANT4_HAS_GDML
+  if ( top.isValid() )  {
+    printout(WARNING, "Geant4GeometryCache", "+++ No GDML support: The geometry cannot be restored from a cache.");
+  }
+  return false;
+#else
+  auto start = chrono::steady_clock::now();
+  scan(top);
+  string gdml = gdmlFile(), mapping = mappingFile();
+  ifstream in(mapping.c_str());
+  if ( !in.good() || !ifstream(gdml.c_str()).good() )  {
+    printout(INFO, "Geant4GeometryCache", "+++ No cached geometry %s present.", gdml.c_str());
+    return false;
+  }
+  // Read and check the relations before anything is created
+  string tag, type;
+  unsigned long long checksum = 0;
+  size_t num_volumes = 0;
+  vector<Relation> placements, imprints;
+  in >> tag >> hex >> checksum >> dec >> num_volumes;
+  bool ok = in.good() && tag == s_cacheTag && checksum == m_checksum && num_volumes == m_volumes.size();
+  while ( ok && (in >> type) )  {
+    Relation r;
+    if ( type == "P" )  {
+      in >> r.node.first >> r.node.second >> r.g4.first >> r.g4.second;
+      placements.push_back(r);
+    }
+    else if ( type == "I" )  {
+      size_t len = 0;
+      in >> r.node.first >> r.g4.first >> r.g4.second >> len;
+      for(size_t i=0; in.good() && i<len; ++i)  {
+        NodeKey k;
+        in >> k.first >> k.second;
+        r.chain.push_back(k);
+      }
+      imprints.push_back(r);
+    }
+    else  {
+      ok = false;
+      break;
+    }
+    ok = !in.fail() && r.g4.first >= 0 && size_t(r.g4.first) < num_volumes;
+  }
+  auto valid_node = [this](const NodeKey& k)  {
+    return k.first >= 0 && size_t(k.first) < m_volumes.size() &&
+      k.second >= 0 && k.second < m_volumes[k.first]->GetNdaughters();
+  };
+  for(const Relation& r : placements)
+    ok = ok && valid_node(r.node);
+  for(const Relation& r : imprints)  {
+    ok = ok && r.node.first >= 0 && size_t(r.node.first) < num_volumes;
+    for(const NodeKey& k : r.chain) ok = ok && valid_node(k);
+  }
+  if ( !ok )  {
+    printout(WARNING, "Geant4GeometryCache", "+++ Invalid cache file %s. The geometry is converted.",
+             mapping.c_str());
+    return false;
+  }
+
+  // Everything not contained in GDML is converted as usual
+  Geant4GeometryInfo& info = m_converter.init();
+  m_converter.collect(top, info);
+  for(const Geometry::Volume& v : info.volumes)
+    m_converter.collectVolume(v.name(), v.ptr());
+  for(const auto& l : info.limits)
+    m_converter.handleLimitSet(l.first, l.second);
+  for(const auto& r : info.regions)
+    m_converter.handleRegion(r.first, r.second);
+
+  G4GDMLParser parser;
+  parser.Read(gdml, false);
+  G4VPhysicalVolume* world = parser.GetWorldVolume();
+  if ( !world )  {
+    except("Geant4GeometryCache", "+++ No world volume in the cached geometry %s. Remove the cache files.",
+           gdml.c_str());
+  }
+  // Locate the tagged logical volumes in the restored hierarchy
+  vector<G4LogicalVolume*> lvs(num_volumes, 0);
+  vector<G4LogicalVolume*> todo(1, world->GetLogicalVolume());
+  unordered_set<G4LogicalVolume*> seen(todo.begin(), todo.end());
+  while ( !todo.empty() )  {
+    G4LogicalVolume* lv = todo.back();
+    const G4String& nam = lv->GetName();
+    size_t idx = nam.rfind('#');
+    todo.pop_back();
+    if ( idx != string::npos )  {
+      size_t ordinal = ::strtoul(nam.c_str()+idx+1, 0, 10);
+      if ( ordinal < num_volumes ) lvs[ordinal] = lv;
+    }
+    for(int k=0, n=lv->GetNoDaughters(); k<n; ++k)  {
+      G4LogicalVolume* d = lv->GetDaughter(k)->GetLogicalVolume();
+      if ( seen.insert(d).second ) todo.push_back(d);
+    }
+  }
+  auto g4placement = [&lvs,&gdml](const NodeKey& k)  {
+    G4LogicalVolume* lv = lvs[k.first];
+    if ( !lv || k.second < 0 || k.second >= int(lv->GetNoDaughters()) )  {
+      except("Geant4GeometryCache", "+++ Inconsistent cached geometry %s. Remove the cache files.",
+             gdml.c_str());
+    }
+    return lv->GetDaughter(k.second);
+  };
+  // Restore the volumes together with the settings not contained in GDML
+  for(size_t i=0; i<num_volumes; ++i)  {
+    G4LogicalVolume* lv = lvs[i];
+    if ( !lv ) continue;
+    Geometry::Volume vol(m_volumes[i]);
+    Geometry::Material mat(vol->GetMedium());
+    G4Material* g4mat = lv->GetMaterial();
+    lv->SetName(vol->GetName());
+    info.g4Volumes[vol] = lv;
+    info.g4Materials[mat] = g4mat;
+    restoreSolid(info, vol->GetShape(), lv->GetSolid());
+    if ( mat->GetMaterial()->IsMixture() )  {
+      TGeoMixture* mix = (TGeoMixture*)mat->GetMaterial();
+      if ( size_t(mix->GetNelements()) == g4mat->GetNumberOfElements() )  {
+        for(Int_t j=0, n=mix->GetNelements(); j<n; ++j)
+          info.g4Elements[mix->GetElement(j)] = (G4Element*)g4mat->GetElement(j);
+      }
+    }
+    Geometry::VisAttr vis = vol.visAttributes();
+    if ( vis.isValid() )  {
+      lv->SetVisAttributes((G4VisAttributes*)m_converter.handleVis(vis.name(), vis));
+    }
+    Geometry::LimitSet lim = vol.limitSet();
+    if ( lim.isValid() )  {
+      lv->SetUserLimits(info.g4Limits[lim]);
+    }
+    Geometry::Region reg = vol.region();
+    if ( reg.isValid() )  {
+      G4Region* region = info.g4Regions[reg];
+      lv->SetRegion(region);
+      region->AddRootLogicalVolume(lv);
+    }
+  }
+  // Restore the placements
+  const TGeoNode* top_node = top.placement().ptr();
+  world->SetName(top_node->GetName());
+  info.g4Placements[top_node] = world;
+  for(const Relation& r : placements)  {
+    const TGeoVolume* mother = m_volumes[r.node.first];
+    const TGeoNode* node = mother->GetNode(r.node.second);
+    G4VPhysicalVolume* pv = g4placement(r.g4);
+    Geometry::PlacedVolume plc(node);
+    // All copies of a replicated placement share the Geant4 placement named after the first copy
+    pv->SetName((plc.data() && plc.isReplicated()) ? mother->GetNode(0)->GetName() : node->GetName());
+    info.g4Placements[node] = pv;
+  }
+  for(const Relation& r : imprints)  {
+    Geant4GeometryMaps::VolumeChain chain;
+    for(const NodeKey& k : r.chain) chain.push_back(m_volumes[k.first]->GetNode(k.second));
+    info.g4VolumeImprints[m_volumes[r.node.first]].push_back(make_pair(chain, g4placement(r.g4)));
+  }
+  m_converter.handleProperties(m_converter.lcdd().properties());
+  info.setWorld(top_node);
+  info.valid = true;
+  printout(INFO, "Geant4GeometryCache", "+++ Restored converted geometry from %s in %.3f seconds "
+           "[%ld volumes, %ld placements].", gdml.c_str(),
+           chrono::duration<double>(chrono::steady_clock::now()-start).count(),
+           long(num_volumes), long(placements.size()+imprints.size()));
+  return true;
+#endif
+}
@@ -243,7 +243,11 @@ int DD4hep::Simulation::mergeInteractions(const Geant4Action* caller,
   }
   output->setNextPID(particle_offset);
   Geant4PrimaryInteraction::ParticleMap::iterator ip, ipend;
-  caller->debug("+++ Merging MC input record from %d interactions:",(int)inter.size());
+  size_t num_vertices = 0;
+  for(const auto& v : output->vertices)
+    num_vertices += v.second.size();
+  caller->debug("+++ Merging MC input record from %d interactions: %d particles %d vertices",
+                (int)inter.size(),(int)output->particles.size(),(int)num_vertices);
   for( ip=output->particles.begin(), ipend=output->particles.end(); ip != ipend; ++ip )
     Geant4ParticleHandle((*ip).second).dump1(DEBUG,caller->name(),"Merged particles");
   return 1;
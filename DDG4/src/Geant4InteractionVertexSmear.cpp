@@ -22,6 +22,7 @@
 
 // C/C++ include files
 #include <cmath>
+#include <cstdio>
 
 using namespace DD4hep::Simulation;
 
@@ -33,6 +34,7 @@ Geant4InteractionVertexSmear::Geant4InteractionVertexSmear(Geant4Context* ctxt,
   declareProperty("Offset", m_offset);
   declareProperty("Sigma",  m_sigma);
   declareProperty("Mask",   m_mask = 1);
+  declareProperty("UseRandomStream", m_useRandomStream = false);
   m_needsControl = true;
 }
 
@@ -44,12 +46,24 @@ Geant4InteractionVertexSmear::~Geant4InteractionVertexSmear() {
 
 /// Action to smear one single interaction according to the properties
 void Geant4InteractionVertexSmear::smear(Interaction* inter)  const  {
-  Geant4Random& rndm = context()->event().random();
   if ( inter )  {
-    double dx = rndm.gauss(m_offset.x(),m_sigma.x());
-    double dy = rndm.gauss(m_offset.y(),m_sigma.y());
-    double dz = rndm.gauss(m_offset.z(),m_sigma.z());
-    double dt = rndm.gauss(m_offset.t(),m_sigma.t());
+    double dx, dy, dz, dt;
+    if ( m_useRandomStream )  {
+      char text[32];
+      ::snprintf(text,sizeof(text),"/%d",inter->mask);
+      Geant4RandomStream rndm = context()->randomStream(name()+text);
+      dx = rndm.gauss(m_offset.x(),m_sigma.x());
+      dy = rndm.gauss(m_offset.y(),m_sigma.y());
+      dz = rndm.gauss(m_offset.z(),m_sigma.z());
+      dt = rndm.gauss(m_offset.t(),m_sigma.t());
+    }
+    else  {
+      Geant4Random& rndm = context()->event().random();
+      dx = rndm.gauss(m_offset.x(),m_sigma.x());
+      dy = rndm.gauss(m_offset.y(),m_sigma.y());
+      dz = rndm.gauss(m_offset.z(),m_sigma.z());
+      dt = rndm.gauss(m_offset.t(),m_sigma.t());
+    }
     print("+++ Smearing primary vertex for interaction type %d (%d Vertices, %d particles) "
           "by (%+.2e mm, %+.2e mm, %+.2e mm, %+.2e ns)",
           m_mask,int(inter->vertices.size()),int(inter->particles.size()),dx,dy,dz,dt);
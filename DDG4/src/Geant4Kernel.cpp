@@ -76,7 +76,7 @@ Geant4ActionPhase& Geant4Kernel::PhaseSelector::operator[](const std::string& na
 /// Standard constructor
 Geant4Kernel::Geant4Kernel(LCDD& lcdd_ref)
   : Geant4ActionContainer(), m_runManager(0), m_control(0), m_trackMgr(0), m_lcdd(&lcdd_ref), 
-    m_numThreads(0), m_id(Geant4Kernel::thread_self()), m_master(this), m_shared(0),
+    m_numThreads(0), m_streamSeed(0), m_id(Geant4Kernel::thread_self()), m_master(this), m_shared(0),
     m_threadContext(0), phase(this)
 {
   m_lcdd->addExtension < Geant4Kernel > (this);
@@ -86,6 +86,7 @@ Geant4Kernel::Geant4Kernel(LCDD& lcdd_ref)
   declareProperty("NumEvents",      m_numEvent = 10);
   declareProperty("OutputLevels",   m_clientLevels);
   declareProperty("NumberOfThreads",m_numThreads);
+  declareProperty("RandomStreamSeed",m_streamSeed);
   m_controlName = "/ddg4/";
   m_control = new G4UIdirectory(m_controlName.c_str());
   m_control->SetGuidance("Control for named Geant4 actions");
@@ -97,7 +98,7 @@ Geant4Kernel::Geant4Kernel(LCDD& lcdd_ref)
 /// Standard constructor
 Geant4Kernel::Geant4Kernel(Geant4Kernel* m, unsigned long ident)
   : Geant4ActionContainer(), m_runManager(0), m_control(0), m_trackMgr(0), m_lcdd(0),
-    m_numThreads(1), m_id(ident), m_master(m), m_shared(0),
+    m_numThreads(1), m_streamSeed(0), m_id(ident), m_master(m), m_shared(0),
     m_threadContext(0), phase(this)
 {
   char text[64];
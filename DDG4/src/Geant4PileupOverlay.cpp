@@ -0,0 +1,285 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Plugins.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4Random.h"
+#include "DDG4/Geant4Context.h"
+#include "DDG4/Geant4Primary.h"
+#include "DDG4/Geant4InputAction.h"
+#include "DDG4/Geant4InputHandling.h"
+#include "DDG4/Geant4RandomStream.h"
+#include "DDG4/Geant4PileupOverlay.h"
+
+// C/C++ include files
+#include <condition_variable>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <memory>
+
+using namespace std;
+using namespace DD4hep::Simulation;
+
+/// Prefetching input stream of the pile-up overlay
+/**
+ *  The event reader is owned and used exclusively by the background thread.
+ *  The events are handed to the event loop through a bounded buffer.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_SIMULATION
+ */
+class Geant4PileupOverlay::Stream  {
+public:
+  typedef Geant4EventReader::Vertices  Vertices;
+  typedef Geant4EventReader::Particles Particles;
+  /// One pre-parsed background event
+  struct Event  {
+    Vertices  vertices;
+    Particles particles;
+    ~Event()  {
+      for(Geant4Vertex* v : vertices) v->release();
+      for(Geant4Particle* p : particles) p->release();
+    }
+  };
+
+  /// Input specification "<reader type>|<file name>"
+  string                   input;
+  /// Reader parameters
+  map<string,string>       parameters;
+  /// Buffer of pre-parsed events
+  deque<Event*>            buffer;
+  /// Maximal number of buffered events
+  size_t                   capacity;
+  /// Flag to reopen the input when exhausted
+  bool                     rewind;
+  /// Protection of the buffer
+  mutex                    lock;
+  /// Signalled when an event was added or the input ended
+  condition_variable       filled;
+  /// Signalled when an event was removed or the stream is stopped
+  condition_variable       drained;
+  /// Flags set by the event loop and by the reader thread
+  bool                     stop = false, finished = false;
+  /// Reason why the input ended
+  string                   reason;
+  /// The reader thread
+  thread                   reader;
+  /// Statistics
+  long                     numRead = 0, numRewinds = 0, numWaits = 0;
+  double                   waitTime = 0e0;
+
+  /// Initializing constructor
+  Stream(const string& inp, const map<string,string>& params, size_t cap, bool rew)
+    : input(inp), parameters(params), capacity(cap), rewind(rew)
+  {
+  }
+  /// Default destructor. Stops the reader thread
+  ~Stream()  {
+    {
+      lock_guard<mutex> protect(lock);
+      stop = true;
+    }
+    drained.notify_all();
+    if ( reader.joinable() ) reader.join();
+    for(Event* e : buffer) delete e;
+  }
+  /// Start the reader thread
+  void start()  {
+    reader = thread([this]() { this->run(); });
+  }
+  /// Create the event reader
+  Geant4EventReader* open()  {
+    TypeName tn = TypeName::split(input,"|");
+    Geant4EventReader* rdr = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
+    if ( 0 == rdr )  {
+      throw runtime_error("Failed to create file reader of type "+tn.first+" for "+tn.second);
+    }
+    map<string,string> params = parameters;
+    rdr->setParameters(params);
+    rdr->checkParameters(params);
+    return rdr;
+  }
+  /// Mark the input as ended
+  void finish(const string& why)  {
+    {
+      lock_guard<mutex> protect(lock);
+      finished = true;
+      reason   = why;
+    }
+    filled.notify_all();
+  }
+  /// Reader thread: read and parse events until the buffer is full
+  void run()  {
+    unique_ptr<Geant4EventReader> rdr;
+    try  {
+      rdr.reset(open());
+      for(int evt = 0; ; )  {
+        unique_ptr<Event> e(new Event());
+        int sc = rdr->moveToEvent(evt);
+        if ( sc == Geant4EventReader::EVENT_READER_OK )
+          sc = rdr->readParticles(evt, e->vertices, e->particles);
+        if ( sc != Geant4EventReader::EVENT_READER_OK )  {
+          if ( rewind && evt > 0 )  {
+            rdr.reset(open());
+            evt = 0;
+            ++numRewinds;
+            continue;
+          }
+          finish(evt > 0 ? "End of input" : "No events in input");
+          return;
+        }
+        ++evt;
+        unique_lock<mutex> protect(lock);
+        drained.wait(protect, [this]() { return stop || buffer.size() < capacity; });
+        if ( stop ) return;
+        buffer.push_back(e.release());
+        ++numRead;
+        protect.unlock();
+        filled.notify_one();
+      }
+    }
+    catch(const exception& e)  {
+      finish(e.what());
+    }
+  }
+  /// Access the next event. Waits for the reader if the buffer is empty. Null if the input ended
+  Event* next()  {
+    unique_lock<mutex> protect(lock);
+    if ( buffer.empty() && !finished )  {
+      auto start = chrono::steady_clock::now();
+      filled.wait(protect, [this]() { return finished || !buffer.empty(); });
+      waitTime += chrono::duration<double>(chrono::steady_clock::now()-start).count();
+      ++numWaits;
+    }
+    if ( buffer.empty() ) return 0;
+    Event* e = buffer.front();
+    buffer.pop_front();
+    protect.unlock();
+    drained.notify_one();
+    return e;
+  }
+};
+
+/// Standard constructor
+Geant4PileupOverlay::Geant4PileupOverlay(Geant4Context* ctxt, const string& nam)
+  : Geant4GeneratorAction(ctxt, nam), m_numEvents(0), m_numInteractions(0)
+{
+  InstanceCount::increment(this);
+  declareProperty("Inputs",          m_inputs);
+  declareProperty("Parameters",      m_parameters);
+  declareProperty("MeanPileup",      m_mean);
+  declareProperty("FirstCrossing",   m_firstCrossing = 0);
+  declareProperty("LastCrossing",    m_lastCrossing = 0);
+  declareProperty("BunchSpacing",    m_bunchSpacing = 25e0);
+  declareProperty("Offset",          m_offset);
+  declareProperty("Sigma",           m_sigma);
+  declareProperty("Mask",            m_mask = 1000);
+  declareProperty("Prefetch",        m_prefetch = 256);
+  declareProperty("Rewind",          m_rewind = true);
+  declareProperty("UseRandomStream", m_useRandomStream = false);
+  m_needsControl = true;
+}
+
+/// Default destructor
+Geant4PileupOverlay::~Geant4PileupOverlay() {
+  for(size_t i=0; i<m_streams.size(); ++i)  {
+    Stream* s = m_streams[i];
+    info("+++ Input %-32s Events read:%7ld Rewinds:%3ld Waits:%6ld (%.3f s)",
+         s->input.c_str(), s->numRead, s->numRewinds, s->numWaits, s->waitTime);
+    delete s;
+  }
+  if ( m_numEvents > 0 )  {
+    info("+++ Overlaid %ld interactions to %ld events (%.1f per event).",
+         m_numInteractions, m_numEvents, double(m_numInteractions)/double(m_numEvents));
+  }
+  InstanceCount::decrement(this);
+}
+
+/// Start the background threads of the input streams
+void Geant4PileupOverlay::startStreams()  {
+  if ( m_inputs.empty() )  {
+    except("+++ No pile-up input declared!");
+  }
+  if ( m_mean.size() != 1 && m_mean.size() != m_inputs.size() )  {
+    except("+++ MeanPileup requires one value or one value per input: %ld values for %ld inputs.",
+           long(m_mean.size()), long(m_inputs.size()));
+  }
+  if ( m_lastCrossing < m_firstCrossing )  {
+    except("+++ Invalid bunch crossing range [%d,%d].", m_firstCrossing, m_lastCrossing);
+  }
+  size_t capacity = m_prefetch > 0 ? size_t(m_prefetch) : 1;
+  for(const string& inp : m_inputs)  {
+    Stream* s = new Stream(inp, m_parameters, capacity, m_rewind);
+    m_streams.push_back(s);
+    s->start();
+    info("+++ Prefetching pile-up input %s [buffer: %ld events]", inp.c_str(), long(capacity));
+  }
+}
+
+/// Callback to generate primary particles
+void Geant4PileupOverlay::operator()(G4Event*) {
+  if ( m_streams.empty() ) startStreams();
+
+  Geant4Event&        evt    = context()->event();
+  Geant4PrimaryEvent* prim   = evt.extension<Geant4PrimaryEvent>();
+  Geant4Random&       engine = evt.random();
+  Geant4RandomStream  stream = context()->randomStream(name());
+  auto gauss = [&](double mean, double sigma)  {
+    return m_useRandomStream ? stream.gauss(mean, sigma) : engine.gauss(mean, sigma);
+  };
+  auto poisson = [&](double mean)  {
+    return m_useRandomStream ? stream.poisson(mean) : engine.poisson(mean);
+  };
+
+  int mask = m_mask, num_interactions = 0;
+  long num_particles = 0, num_vertices = 0;
+  for(size_t i=0; i<m_streams.size(); ++i)  {
+    Stream* s    = m_streams[i];
+    double  mean = m_mean.size() == 1 ? m_mean[0] : m_mean[i];
+    for(int crossing = m_firstCrossing; crossing <= m_lastCrossing; ++crossing)  {
+      for(int n = poisson(mean); n > 0; --n)  {
+        unique_ptr<Stream::Event> e(s->next());
+        if ( !e.get() )  {
+          abortRun("Pile-up input exhausted: "+s->reason,
+                   "Cannot read pile-up event from %s: %s",s->input.c_str(),s->reason.c_str());
+          return;
+        }
+        Interaction* inter = new Interaction();
+        prim->add(mask, inter);
+        inter->vertices[mask].swap(e->vertices);
+        for(Geant4Particle* p : e->particles)
+          inter->particles.insert(make_pair(p->id, p));
+        num_particles += long(inter->particles.size());
+        num_vertices  += long(inter->vertices[mask].size());
+        e->particles.clear();
+        double dx = gauss(m_offset.x(), m_sigma.x());
+        double dy = gauss(m_offset.y(), m_sigma.y());
+        double dz = gauss(m_offset.z(), m_sigma.z());
+        double dt = gauss(m_offset.t(), m_sigma.t()) + crossing*m_bunchSpacing;
+        smearInteraction(this, inter, dx, dy, dz, dt);
+        ++num_interactions;
+        ++mask;
+      }
+    }
+  }
+  ++m_numEvents;
+  m_numInteractions += num_interactions;
+  print("+++ Overlaid %d pile-up interactions with %ld particles and %ld vertices. Masks: [%d,%d].",
+        num_interactions, num_particles, num_vertices, m_mask, mask-1);
+}
@@ -0,0 +1,61 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4Kernel.h"
+#include "DDG4/Geant4ProfilerAction.h"
+#include "DDG4/Geant4ActionProfiler.h"
+
+using namespace std;
+using namespace DD4hep::Simulation;
+
+/// Standard constructor
+Geant4ProfilerAction::Geant4ProfilerAction(Geant4Context* ctxt, const string& nam)
+  : Geant4RunAction(ctxt, nam)
+{
+  InstanceCount::increment(this);
+  declareProperty("MeasureCPU",     m_measureCPU = true);
+  declareProperty("Histograms",     m_histograms = false);
+  declareProperty("MaxLines",       m_maxLines = 50);
+  declareProperty("MaxTraceEvents", m_maxTraceEvents = 1000000);
+  declareProperty("TraceFile",      m_traceFile);
+}
+
+/// Default destructor
+Geant4ProfilerAction::~Geant4ProfilerAction()  {
+  InstanceCount::decrement(this);
+}
+
+/// Begin-of-run callback
+void Geant4ProfilerAction::begin(const G4Run*)  {
+  if ( context()->kernel().isMaster() )  {
+    size_t max_trace = m_traceFile.empty() || m_maxTraceEvents < 0 ? 0 : size_t(m_maxTraceEvents);
+    Geant4ActionProfiler::reset();
+    Geant4ActionProfiler::enable(m_measureCPU, max_trace);
+    info("+++ Action profiling enabled. CPU time:%s Trace:%s",
+         m_measureCPU ? "YES" : "NO", max_trace ? m_traceFile.c_str() : "NO");
+  }
+}
+
+/// End-of-run callback
+void Geant4ProfilerAction::end(const G4Run*)  {
+  if ( context()->kernel().isMaster() && Geant4ActionProfiler::enabled() )  {
+    Geant4ActionProfiler::disable();
+    Geant4ActionProfiler::summary(outputLevel(), m_maxLines > 0 ? size_t(m_maxLines) : 0, m_histograms);
+    if ( !m_traceFile.empty() )  {
+      Geant4ActionProfiler::writeTrace(m_traceFile);
+    }
+    Geant4ActionProfiler::reset();
+  }
+}
@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4RandomStream.h"
+
+// C/C++ include files
+#include <cmath>
+
+using namespace DD4hep::Simulation;
+
+namespace {
+  /// SplitMix64 finalizer used to derive the event keys
+  inline uint64_t mix64(uint64_t z)  {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+}
+
+/// Initializing constructor
+Geant4RandomStream::Geant4RandomStream(uint64_t key, uint64_t stream_id)
+  : m_used(4), m_gauss(0e0), m_haveGauss(false)
+{
+  m_key[0]     = uint32_t(key);
+  m_key[1]     = uint32_t(key >> 32);
+  m_counter[0] = 0;
+  m_counter[1] = 0;
+  m_counter[2] = uint32_t(stream_id);
+  m_counter[3] = uint32_t(stream_id >> 32);
+  m_block[0] = m_block[1] = m_block[2] = m_block[3] = 0;
+}
+
+/// Philox4x32-10 block function
+void Geant4RandomStream::philox(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4])  {
+  const uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+  const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+  uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  for(int round = 0; round < 10; ++round)  {
+    uint64_t p0 = M0 * c0, p1 = M1 * c2;
+    uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+    uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+    c1 = uint32_t(p1);
+    c3 = uint32_t(p0);
+    c0 = n0;
+    c2 = n2;
+    k0 += W0;
+    k1 += W1;
+  }
+  result[0] = c0;
+  result[1] = c1;
+  result[2] = c2;
+  result[3] = c3;
+}
+
+/// Key of the streams of one event
+uint64_t Geant4RandomStream::eventKey(uint64_t seed, int run, int event)  {
+  uint64_t k = mix64(seed);
+  k = mix64(k ^ uint64_t(uint32_t(run)));
+  return mix64(k ^ uint64_t(uint32_t(event)));
+}
+
+/// Stream identifier of a named consumer (64 bit FNV-1a hash)
+uint64_t Geant4RandomStream::streamID(const std::string& consumer)  {
+  uint64_t h = 0xCBF29CE484222325ULL;
+  for(unsigned char c : consumer)  {
+    h ^= c;
+    h *= 0x100000001B3ULL;
+  }
+  return h;
+}
+
+/// Gaussian random number (Box-Muller transformation)
+double Geant4RandomStream::gauss(double mean, double sigma)  {
+  if ( m_haveGauss )  {
+    m_haveGauss = false;
+    return mean + sigma*m_gauss;
+  }
+  double r   = std::sqrt(-2e0*std::log(rndm()));
+  double phi = 2e0*M_PI*rndm();
+  m_gauss     = r*std::sin(phi);
+  m_haveGauss = true;
+  return mean + sigma*r*std::cos(phi);
+}
+
+/// Exponential random number
+double Geant4RandomStream::exp(double tau)  {
+  return -tau*std::log(rndm());
+}
+
+/// Poisson distributed random number
+/** Small means: multiplication of flat numbers.
+ *  Large means: transformed rejection with squeeze (W.Hoermann, PTRS, 1993).
+ */
+int Geant4RandomStream::poisson(double mean)  {
+  if ( mean <= 0e0 )  {
+    return 0;
+  }
+  else if ( mean < 10e0 )  {
+    double limit = std::exp(-mean), prod = rndm();
+    int    k = 0;
+    while ( prod > limit )  {
+      prod *= rndm();
+      ++k;
+    }
+    return k;
+  }
+  const double slam = std::sqrt(mean), loglam = std::log(mean);
+  const double b    = 0.931 + 2.53*slam;
+  const double a    = -0.059 + 0.02483*b;
+  const double inva = 1.1239 + 1.1328/(b-3.4);
+  const double vr   = 0.9277 - 3.6224/(b-2);
+  for(;;)  {
+    double u  = rndm() - 0.5, v = rndm();
+    double us = 0.5 - std::fabs(u);
+    double k  = std::floor((2*a/us + b)*u + mean + 0.43);
+    if ( us >= 0.07 && v <= vr )
+      return int(k);
+    if ( k < 0 || (us < 0.013 && v > us) )
+      continue;
+    if ( std::log(v) + std::log(inva) - std::log(a/(us*us)+b) <= -mean + k*loglam - std::lgamma(k+1) )
+      return int(k);
+  }
+}
+
+/// Fill an array with flat random numbers in the open interval (0,1)
+void Geant4RandomStream::rndmArray(size_t n, double* array)  {
+  for(size_t i = 0; i < n; ++i)
+    array[i] = rndm();
+}
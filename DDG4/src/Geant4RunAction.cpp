@@ -15,6 +15,7 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4RunAction.h"
+#include "DDG4/Geant4Concurrency.h"
 // Geant4 headers
 #include "G4Threading.hh"
 #include "G4AutoLock.hh"
@@ -57,6 +58,7 @@ Geant4SharedRunAction::Geant4SharedRunAction(Geant4Context* ctxt, const string&
 
 /// Default destructor
 Geant4SharedRunAction::~Geant4SharedRunAction()   {
+  Geant4ActionLock::release(m_lock);
   releasePtr(m_action);
   InstanceCount::decrement(this);
 }
@@ -72,6 +74,8 @@ void Geant4SharedRunAction::use(Geant4RunAction* action)   {
     action->addRef();
     m_properties.adopt(action->properties());
     m_action = action;
+    Geant4ActionLock::release(m_lock);
+    m_lock = Geant4ActionLock::acquire(action);
     return;
   }
   throw runtime_error("Geant4SharedRunAction: Attempt to use invalid actor!");
@@ -80,20 +84,14 @@ void Geant4SharedRunAction::use(Geant4RunAction* action)   {
 /// Begin-of-run callback
 void Geant4SharedRunAction::begin(const G4Run* run)   {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);    {
-      ContextSwap swap(m_action,context());
-      m_action->begin(run);
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->begin(run); });
   }
 }
 
 /// End-of-run callback
 void Geant4SharedRunAction::end(const G4Run* run)   {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);  {
-      ContextSwap swap(m_action,context());
-      m_action->end(run);
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->end(run); });
   }
 }
 
@@ -143,7 +141,7 @@ void Geant4RunActionSequence::adopt(Geant4RunAction* action) {
 /// Pre-track action callback
 void Geant4RunActionSequence::begin(const G4Run* run) {
   G4AutoLock protection_lock(&sequence_mutex);
-  m_actors(&Geant4RunAction::begin, run);
+  m_actors.profiled("begin-run", &Geant4RunAction::begin, run);
   m_begin(run);
 }
 
@@ -151,5 +149,5 @@ void Geant4RunActionSequence::begin(const G4Run* run) {
 void Geant4RunActionSequence::end(const G4Run* run) {
   G4AutoLock protection_lock(&sequence_mutex);
   m_end(run);
-  m_actors(&Geant4RunAction::end, run);
+  m_actors.profiled("end-run", &Geant4RunAction::end, run);
 }
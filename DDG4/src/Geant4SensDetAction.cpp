@@ -354,10 +354,11 @@ bool Geant4SensDetActionSequence::process(G4Step* step, G4TouchableHistory* hist
   bool result = false;
   for (vector<Geant4Sensitive*>::iterator i = m_actors->begin(); i != m_actors->end(); ++i) {
     Geant4Sensitive* s = *i;
+    Geant4ActionProfiler::Timer timer(s, "process-hits");
     if (s->accept(step))
       result |= s->process(step, hist);
   }
-  m_process(step, hist);
+  profiled("process-hits:callbacks", m_process, step, hist);
   return result;
 }
 
@@ -373,14 +374,14 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
     int id = m_detector->GetCollectionID(count);
     m_hce->AddHitsCollection(id, c);
   }
-  m_actors(&Geant4Sensitive::begin, m_hce);
-  m_begin (m_hce);
+  m_actors.profiled("begin-sd", &Geant4Sensitive::begin, m_hce);
+  profiled("begin-sd:callbacks", m_begin, m_hce);
 }
 
 /// G4VSensitiveDetector interface: Method invoked at the end of each event.
 void Geant4SensDetActionSequence::end(G4HCofThisEvent* hce) {
-  m_end(hce);
-  m_actors(&Geant4Sensitive::end, hce);
+  profiled("end-sd:callbacks", m_end, hce);
+  m_actors.profiled("end-sd", &Geant4Sensitive::end, hce);
   // G4HCofThisEvent must be availible until end-event. m_hce = 0;
 }
 
@@ -391,8 +392,8 @@ void Geant4SensDetActionSequence::end(G4HCofThisEvent* hce) {
  *  will be deleted automatically.
  */
 void Geant4SensDetActionSequence::clear() {
-  m_clear (m_hce);
-  m_actors(&Geant4Sensitive::clear, m_hce);
+  profiled("clear-sd:callbacks", m_clear, m_hce);
+  m_actors.profiled("clear-sd", &Geant4Sensitive::clear, m_hce);
 }
 
 /// Default destructor
@@ -15,18 +15,13 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4StackingAction.h"
-// Geant4 headers
-#include "G4Threading.hh"
-#include "G4AutoLock.hh"
+#include "DDG4/Geant4Concurrency.h"
 
 // C/C++ include files
 #include <stdexcept>
 
 using namespace std;
 using namespace DD4hep::Simulation;
-namespace {
-  G4Mutex action_mutex=G4MUTEX_INITIALIZER;
-}
 
 /// Standard constructor
 Geant4StackingAction::Geant4StackingAction(Geant4Context* ctxt, const string& nam)
@@ -48,6 +43,7 @@ Geant4SharedStackingAction::Geant4SharedStackingAction(Geant4Context* ctxt, cons
 
 /// Default destructor
 Geant4SharedStackingAction::~Geant4SharedStackingAction()   {
+  Geant4ActionLock::release(m_lock);
   releasePtr(m_action);
   InstanceCount::decrement(this);
 }
@@ -63,6 +59,8 @@ void Geant4SharedStackingAction::use(Geant4StackingAction* action)   {
     action->addRef();
     m_properties.adopt(action->properties());
     m_action = action;
+    Geant4ActionLock::release(m_lock);
+    m_lock = Geant4ActionLock::acquire(action);
     return;
   }
   throw runtime_error("Geant4SharedStackingAction: Attempt to use invalid actor!");
@@ -71,23 +69,26 @@ void Geant4SharedStackingAction::use(Geant4StackingAction* action)   {
 /// Begin-of-stacking callback
 void Geant4SharedStackingAction::newStage()  {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);    {
-      ContextSwap swap(m_action,context());
-      m_action->newStage();
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->newStage(); });
   }
 }
 
 /// End-of-stacking callback
 void Geant4SharedStackingAction::prepare()  {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);  {
-      ContextSwap swap(m_action,context());
-      m_action->prepare();
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->prepare(); });
   }
 }
 
+/// Classify a new track
+Geant4TrackClassification Geant4SharedStackingAction::classifyNewTrack(const G4Track* track)  {
+  TrackClassification result;
+  if ( m_action )  {
+    m_lock->execute(m_action, context(), [&]() { result = m_action->classifyNewTrack(track); });
+  }
+  return result;
+}
+
 /// Standard constructor
 Geant4StackingActionSequence::Geant4StackingActionSequence(Geant4Context* ctxt, const string& nam)
   : Geant4Action(ctxt, nam) {
@@ -132,12 +133,30 @@ Geant4StackingAction* Geant4StackingActionSequence::get(const string& nam) const
 
 /// Pre-track action callback
 void Geant4StackingActionSequence::newStage() {
-  m_actors(&Geant4StackingAction::newStage);
+  m_actors.profiled("new-stage", &Geant4StackingAction::newStage);
   m_newStage();
 }
 
 /// Post-track action callback
 void Geant4StackingActionSequence::prepare() {
-  m_actors(&Geant4StackingAction::prepare);
+  m_actors.profiled("prepare", &Geant4StackingAction::prepare);
   m_prepare();
 }
+
+/// Classify a new track
+Geant4TrackClassification Geant4StackingActionSequence::classifyNewTrack(const G4Track* track) {
+  Geant4TrackClassification result;
+  for(Geant4StackingAction* a : m_actors)  {
+    Geant4TrackClassification c;  {
+      Geant4ActionProfiler::Timer timer(a, "classify-track");
+      c = a->classifyNewTrack(track);
+    }
+    if ( !c.defined )
+      continue;
+    else if ( c.value == fKill )
+      return c;
+    else if ( !result.defined )
+      result = c;
+  }
+  return result;
+}
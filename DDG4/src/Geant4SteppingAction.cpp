@@ -15,6 +15,7 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4SteppingAction.h"
+#include "DDG4/Geant4Concurrency.h"
 // Geant4 headers
 #include "G4Threading.hh"
 #include "G4AutoLock.hh"
@@ -51,6 +52,7 @@ Geant4SharedSteppingAction::Geant4SharedSteppingAction(Geant4Context* ctxt, cons
 
 /// Default destructor
 Geant4SharedSteppingAction::~Geant4SharedSteppingAction()   {
+  Geant4ActionLock::release(m_lock);
   releasePtr(m_action);
   InstanceCount::decrement(this);
 }
@@ -61,6 +63,8 @@ void Geant4SharedSteppingAction::use(Geant4SteppingAction* action)   {
     action->addRef();
     m_properties.adopt(action->properties());
     m_action = action;
+    Geant4ActionLock::release(m_lock);
+    m_lock = Geant4ActionLock::acquire(action);
     return;
   }
   throw runtime_error("Geant4SharedSteppingAction: Attempt to use invalid actor!");
@@ -74,10 +78,7 @@ void Geant4SharedSteppingAction::configureFiber(Geant4Context* thread_context)
 /// User stepping callback
 void Geant4SharedSteppingAction::operator()(const G4Step* s, G4SteppingManager* m) {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);    {
-      ContextSwap swap(m_action,context());
-      (*m_action)(s,m);
-    }
+    m_lock->execute(m_action, context(), [&]() { (*m_action)(s,m); });
   }
 }
 
@@ -85,6 +86,7 @@ void Geant4SharedSteppingAction::operator()(const G4Step* s, G4SteppingManager*
 Geant4SteppingActionSequence::Geant4SteppingActionSequence(Geant4Context* ctxt, const string& nam)
 : Geant4Action(ctxt, nam) {
   m_needsControl = true;
+  declareProperty("Compile", m_compile);
   InstanceCount::increment(this);
 }
 
@@ -112,10 +114,31 @@ Geant4SteppingAction* Geant4SteppingActionSequence::get(const string& nam) const
   return m_actors.get(FindByName(TypeName::split(nam).second));
 }
 
+/// Compile the actors and callbacks into the flat dispatch table
+void Geant4SteppingActionSequence::compile()   {
+  size_t skipped = 0;
+  m_dispatch.clear();
+  for(Geant4SteppingAction* a : m_actors)  {
+    if ( a->noOpCallbacks() & Geant4NoOpCallbacks::STEP )
+      ++skipped;
+    else
+      m_dispatch.add<Geant4SteppingAction,&Geant4SteppingAction::operator()>(a);
+  }
+  m_dispatch.add(m_calls);
+  m_compiled = true;
+  printM1("+++ Dispatch table: %ld entries. %ld actors without stepping callback skipped.",
+          long(m_dispatch.size()), long(skipped));
+}
+
 /// Pre-track action callback
 void Geant4SteppingActionSequence::operator()(const G4Step* step, G4SteppingManager* mgr) {
-  m_actors(&Geant4SteppingAction::operator(), step, mgr);
-  m_calls(step, mgr);
+  if ( m_compile && !Geant4ActionProfiler::enabled() )  {
+    if ( !m_compiled ) compile();
+    m_dispatch(step, mgr);
+    return;
+  }
+  m_actors.profiled("step", &Geant4SteppingAction::operator(), step, mgr);
+  profiled("step:callbacks", m_calls, step, mgr);
 }
 
 /// Add an actor responding to all callbacks. Sequence takes ownership.
@@ -124,6 +147,7 @@ void Geant4SteppingActionSequence::adopt(Geant4SteppingAction* action) {
     G4AutoLock protection_lock(&action_mutex);
     action->addRef();
     m_actors.add(action);
+    m_compiled = false;
     return;
   }
   throw runtime_error("Geant4SteppingActionSequence: Attempt to add invalid actor!");
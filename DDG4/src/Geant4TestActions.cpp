@@ -174,15 +174,20 @@ void Geant4TestTrackAction::end(const G4Track* trk) {
 /// Standard constructor with initializing arguments
 Geant4TestStepAction::Geant4TestStepAction(Geant4Context* c, const std::string& n)
   : Geant4SteppingAction(c, n), Geant4TestBase(this, "Geant4TestStepAction") {
+  m_reentrant = true;
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4TestStepAction::~Geant4TestStepAction() {
+  long steps = 0, threads = 0;
+  m_steps.merge([&steps,&threads](long n) { steps += n; ++threads; });
+  PRINT("%s> %ld steps counted by %ld threads", m_type.c_str(), steps, threads);
   InstanceCount::decrement(this);
 }
 /// User stepping callback
 void Geant4TestStepAction::operator()(const G4Step*, G4SteppingManager*) {
+  ++m_steps.local();
   PRINT("%s> calling operator()", m_type.c_str());
 }
 
@@ -15,6 +15,7 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4TrackingAction.h"
+#include "DDG4/Geant4Concurrency.h"
 #include "DDG4/Geant4MonteCarloTruth.h"
 #include "DDG4/Geant4TrackInformation.h"
 
@@ -41,6 +42,7 @@ namespace {
 Geant4TrackingActionSequence::Geant4TrackingActionSequence(Geant4Context* ctxt, const string& nam)
   : Geant4Action(ctxt, nam) {
   m_needsControl = true;
+  declareProperty("Compile", m_compile);
   InstanceCount::increment(this);
 }
 
@@ -77,23 +79,59 @@ void Geant4TrackingActionSequence::adopt(Geant4TrackingAction* action) {
     G4AutoLock protection_lock(&action_mutex);
     action->addRef();
     m_actors.add(action);
+    m_compiled = false;
     return;
   }
   throw runtime_error("Geant4TrackingActionSequence: Attempt to add invalid actor!");
 }
 
+/// Compile the actors and callbacks into the flat dispatch tables
+void Geant4TrackingActionSequence::compile()   {
+  size_t skipped = 0;
+  m_beginDispatch.clear();
+  m_endDispatch.clear();
+  m_beginDispatch.add(m_front);
+  m_endDispatch.add(m_end);
+  for(Geant4TrackingAction* a : m_actors)  {
+    unsigned int noops = a->noOpCallbacks();
+    if ( noops & Geant4NoOpCallbacks::BEGIN_TRACK )
+      ++skipped;
+    else
+      m_beginDispatch.add<Geant4TrackingAction,&Geant4TrackingAction::begin>(a);
+    if ( noops & Geant4NoOpCallbacks::END_TRACK )
+      ++skipped;
+    else
+      m_endDispatch.add<Geant4TrackingAction,&Geant4TrackingAction::end>(a);
+  }
+  m_beginDispatch.add(m_begin);
+  m_endDispatch.add(m_final);
+  m_compiled = true;
+  printM1("+++ Dispatch tables: %ld begin and %ld end entries. %ld empty actor callbacks skipped.",
+          long(m_beginDispatch.size()), long(m_endDispatch.size()), long(skipped));
+}
+
 /// Pre-track action callback
 void Geant4TrackingActionSequence::begin(const G4Track* track) {
-  m_front(track);
-  m_actors(&Geant4TrackingAction::begin, track);
-  m_begin(track);
+  if ( m_compile && !Geant4ActionProfiler::enabled() )  {
+    if ( !m_compiled ) compile();
+    m_beginDispatch(track);
+    return;
+  }
+  profiled("begin-track:front", m_front, track);
+  m_actors.profiled("begin-track", &Geant4TrackingAction::begin, track);
+  profiled("begin-track:callbacks", m_begin, track);
 }
 
 /// Post-track action callback
 void Geant4TrackingActionSequence::end(const G4Track* track) {
-  m_end(track);
-  m_actors(&Geant4TrackingAction::end, track);
-  m_final(track);
+  if ( m_compile && !Geant4ActionProfiler::enabled() )  {
+    if ( !m_compiled ) compile();
+    m_endDispatch(track);
+    return;
+  }
+  profiled("end-track:callbacks", m_end, track);
+  m_actors.profiled("end-track", &Geant4TrackingAction::end, track);
+  profiled("end-track:final", m_final, track);
 }
 
 /// Standard constructor
@@ -130,6 +168,7 @@ Geant4SharedTrackingAction::Geant4SharedTrackingAction(Geant4Context* ctxt, cons
 
 /// Default destructor
 Geant4SharedTrackingAction::~Geant4SharedTrackingAction()   {
+  Geant4ActionLock::release(m_lock);
   releasePtr(m_action);
   InstanceCount::decrement(this);
 }
@@ -145,6 +184,8 @@ void Geant4SharedTrackingAction::use(Geant4TrackingAction* action)   {
     action->addRef();
     m_properties.adopt(action->properties());
     m_action = action;
+    Geant4ActionLock::release(m_lock);
+    m_lock = Geant4ActionLock::acquire(action);
     return;
   }
   throw runtime_error("Geant4SharedTrackingAction: Attempt to use invalid actor!");
@@ -153,19 +194,13 @@ void Geant4SharedTrackingAction::use(Geant4TrackingAction* action)   {
 /// Begin-of-track callback
 void Geant4SharedTrackingAction::begin(const G4Track* track)   {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);    {
-      ContextSwap swap(m_action,context());
-      m_action->begin(track);
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->begin(track); });
   }
 }
 
 /// End-of-track callback
 void Geant4SharedTrackingAction::end(const G4Track* track)   {
   if ( m_action )  {
-    G4AutoLock protection_lock(&action_mutex);  {
-      ContextSwap swap(m_action,context());
-      m_action->end(track);
-    }
+    m_lock->execute(m_action, context(), [&]() { m_action->end(track); });
   }
 }
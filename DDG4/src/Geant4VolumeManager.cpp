@@ -80,10 +80,9 @@ namespace {
     void scanPhysicalVolume(const TGeoNode* node, PlacedVolume::VolIDs ids, SensitiveDetector& sd, Chain& chain) {
       PlacedVolume pv = Ref_t(node);
       Volume vol = pv.volume();
-      PlacedVolume::VolIDs pv_ids = pv.volIDs();
 
       chain.push_back(node);
-      ids.PlacedVolume::VolIDs::Base::insert(ids.end(), pv_ids.begin(), pv_ids.end());
+      pv.packedVolIDs().unpack(ids);
       if (vol.isSensitive()) {
         sd = vol.sensitiveDetector();
         if (sd.readout().isValid()) {
@@ -100,6 +99,9 @@ namespace {
         PlacedVolume placement(daughter);
         if ( placement.data() ) {
           scanPhysicalVolume(daughter, ids, sd, chain);
+          // All copies of a replicated placement share one Geant4 placement:
+          // The volume ID field of the copy is derived from the replica number.
+          if ( placement.isReplicated() ) break;
         }
       }
       chain.pop_back();
@@ -110,6 +112,7 @@ namespace {
       const TGeoNode* node;
       Volume vol;
       Geant4PlacementPath path;
+      ReplicaFields replicas;
       Readout ro = sd.readout();
       IDDescriptor iddesc = ro.idSpec();
       VolumeID code = iddesc.encode(ids);
@@ -127,6 +130,11 @@ namespace {
           node = *(k);
           PlacementMap::const_iterator g4pit = m_geo.g4Placements.find(node);
           if (g4pit != m_geo.g4Placements.end()) {
+            const PlacedVolume::Parameterisation* par = PlacedVolume(node).params();
+            if ( par && !par->field.empty() )  {
+              IDDescriptor::Field f = iddesc.field(par->field);
+              replicas.push_back(make_pair(int(path.size()),make_pair(int(f->offset()),VolumeID(f->mask()))));
+            }
             path.push_back((*g4pit).second);
             printout(print_chain, "Geant4VolumeManager", "+++     Chain: Node OK: %s [%s]",
                      node->GetName(), (*g4pit).second->GetName().c_str());
@@ -159,6 +167,7 @@ namespace {
                    (void*)code, placementPath(path).c_str());
           if (m_geo.g4Paths.find(path) == m_geo.g4Paths.end()) {
             m_geo.g4Paths[path] = code;
+            if ( !replicas.empty() ) m_geo.g4Replicas[path] = replicas;
             m_entries.insert(make_pair(code,path));
             return;
           }
@@ -235,10 +244,30 @@ VolumeID Geant4VolumeManager::volumeID(const PlacementPath& path) const {
   return NonExisting;
 }
 
+namespace {
+  /// Add the volume ID fields derived from the replica numbers of the touchable
+  VolumeID replicaVolumeID(const Geant4GeometryInfo* info, const Geant4PlacementPath& path,
+                           const G4VTouchable* touchable, VolumeID vid)
+  {
+    if ( !info->g4Replicas.empty() && vid != Geant4VolumeManager::InvalidPath &&
+         vid != Geant4VolumeManager::Insensitive && vid != Geant4VolumeManager::NonExisting )  {
+      Geant4ReplicaMap::const_iterator i = info->g4Replicas.find(path);
+      if ( i != info->g4Replicas.end() )  {
+        for(const auto& r : (*i).second )  {
+          VolumeID copy = touchable->GetReplicaNumber(r.first);
+          vid |= (copy << r.second.first) & r.second.second;
+        }
+      }
+    }
+    return vid;
+  }
+}
+
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const {
   Geant4TouchableHandler handler(touchable);
-  return volumeID(handler.placementPath());
+  PlacementPath path = handler.placementPath();
+  return replicaVolumeID(ptr(), path, touchable, volumeID(path));
 }
 
 /// Accessfully decoded volume fields  by placement path
@@ -279,6 +308,13 @@ void Geant4VolumeManager::volumeDescriptor(const PlacementPath& path, VolIDDescr
 
 /// Access fully decoded volume fields by Geant4 touchable object
 void Geant4VolumeManager::volumeDescriptor(const G4VTouchable* touchable, VolIDDescriptor& vol_desc) const {
-  volumeDescriptor(placementPath(touchable), vol_desc);
+  PlacementPath path = placementPath(touchable);
+  volumeDescriptor(path, vol_desc);
+  VolumeID vid = replicaVolumeID(ptr(), path, touchable, vol_desc.first);
+  if ( vid != vol_desc.first )  {
+    vol_desc.first = vid;
+    for(auto& f : vol_desc.second )
+      f.second = f.first->value(vid);
+  }
 }
 
@@ -4,11 +4,20 @@
 
 #include "TGeoVolume.h"
 #include "TGeoManager.h"
+#include "TGeoNavigator.h"
 #include "TGeoNode.h"
 #include "TVirtualGeoTrack.h"
 
 #define MINSTEP 1.e-5
 
+namespace {
+  /// Navigator of the calling thread. In multi-threaded mode it is created on demand
+  TGeoNavigator* thread_navigator( TGeoManager* mgr ) {
+    TGeoNavigator* nav = mgr->GetCurrentNavigator() ;
+    return nav ? nav : mgr->AddNavigator() ;
+  }
+}
+
 namespace DD4hep {
   namespace DDRec {
 
@@ -47,31 +56,37 @@ namespace DD4hep {
 	for(unsigned int i=0; i<3; i++)
 	  direction[i]=direction[i]/totDist;
 	
-	_tgeoMgr->AddTrack(0, 12 ) ; // electron neutrino
+	// Every thread steps with its own navigator. The track bookkeeping
+	// of the geometry manager is shared: it is skipped in multi-threaded mode.
+	TGeoNavigator* nav = thread_navigator( _tgeoMgr ) ;
+	bool useTracks = !_tgeoMgr->IsMultiThread() ;
+
+	if( useTracks )
+	  _tgeoMgr->AddTrack(0, 12 ) ; // electron neutrino
 
-	TGeoNode *node1 = _tgeoMgr->InitTrack(startpoint, direction);
+	TGeoNode *node1 = nav->InitTrack(startpoint, direction);
 
 	//check if there is a node at startpoint
 	if(!node1)
 	  throw std::runtime_error("No geometry node found at given location. Either there is no node placed here or position is outside of top volume.");
 	
-	while ( !_tgeoMgr->IsOutside() )  {
+	while ( !nav->IsOutside() )  {
 	  
 	  // TGeoNode *node2;
 	  // TVirtualGeoTrack *track; 
 	  
 	  // step to (and over) the next Boundary
-	  TGeoNode * node2 = _tgeoMgr->FindNextBoundaryAndStep( 500, 1) ;
+	  TGeoNode * node2 = nav->FindNextBoundaryAndStep( 500, 1) ;
 	  
-	  if( !node2 || _tgeoMgr->IsOutside() )
+	  if( !node2 || nav->IsOutside() )
 	    break;
 	  
-	  const double *position    =  _tgeoMgr->GetCurrentPoint();
-	  const double *previouspos =  _tgeoMgr->GetLastPoint();
+	  const double *position    =  nav->GetCurrentPoint();
+	  const double *previouspos =  nav->GetLastPoint();
 	  
-	  double length = _tgeoMgr->GetStep();
+	  double length = nav->GetStep();
 
-	  TVirtualGeoTrack *track = _tgeoMgr->GetLastTrack();
+	  TVirtualGeoTrack *track = useTracks ? _tgeoMgr->GetLastTrack() : 0 ;
 
 	  //protection against infinitive loop in root which should not happen, but well it does...
 	  //work around until solution within root can be found when the step gets very small e.g. 1e-10
@@ -80,15 +95,15 @@ namespace DD4hep {
 #if 1   //fg: is this still needed ?
 	  if( length < MINSTEP ) {
 	    
-	    _tgeoMgr->SetCurrentPoint( position[0] + MINSTEP * direction[0], 
-				       position[1] + MINSTEP * direction[1], 
-				       position[2] + MINSTEP * direction[2] );
+	    nav->SetCurrentPoint( position[0] + MINSTEP * direction[0], 
+				  position[1] + MINSTEP * direction[1], 
+				  position[2] + MINSTEP * direction[2] );
 	    
-	    length = _tgeoMgr->GetStep();
-	    node2  = _tgeoMgr->FindNextBoundaryAndStep(500, 1) ;
+	    length = nav->GetStep();
+	    node2  = nav->FindNextBoundaryAndStep(500, 1) ;
 	    
-	    position    = _tgeoMgr->GetCurrentPoint();
-	    previouspos = _tgeoMgr->GetLastPoint();
+	    position    = nav->GetCurrentPoint();
+	    previouspos = nav->GetLastPoint();
 	  }
 #endif 	  
 	  //	printf( " --  step length :  %1.8e %1.8e   %1.8e   %1.8e   %1.8e   %1.8e   %1.8e   - %s \n" , length ,
@@ -109,7 +124,7 @@ namespace DD4hep {
 			   pow(endpoint[1]-previouspos[1],2) +
 			   pow(endpoint[2]-previouspos[2],2)   );
 	    
-	    track->AddPoint( endpoint[0], endpoint[1], endpoint[2], 0. );
+	    if( track ) track->AddPoint( endpoint[0], endpoint[1], endpoint[2], 0. );
 	    
 	    
 	    if( length > epsilon ) 
@@ -118,7 +133,7 @@ namespace DD4hep {
 	    break;
 	  }
 	  
-	  track->AddPoint( position[0], position[1], position[2], 0.);
+	  if( track ) track->AddPoint( position[0], position[1], position[2], 0.);
 	  
 	  if( length > epsilon ) 
 	    _mV.push_back( std::make_pair( Material( node1->GetMedium() ), length  )  ) ; 
@@ -133,9 +148,11 @@ namespace DD4hep {
 	}
 
 
-	_tgeoMgr->ClearTracks();
+	if( useTracks ) {
+	  _tgeoMgr->ClearTracks();
 
-	_tgeoMgr->CleanGarbage();
+	  _tgeoMgr->CleanGarbage();
+	}
 	
 	//---------------------------------------	
 	
@@ -151,7 +168,7 @@ namespace DD4hep {
 
       if( pos != _pos ) {
 	
-	TGeoNode *node=_tgeoMgr->FindNode( pos[0], pos[1], pos[2] ) ;
+	TGeoNode *node=thread_navigator( _tgeoMgr )->FindNode( pos[0], pos[1], pos[2] ) ;
 	
 	if( ! node ) {
 	  std::stringstream err ;
@@ -0,0 +1,153 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/objects/ConditionsArena.h"
+#include <exception>
+#include <iostream>
+#include <cstring>
+#include <set>
+#include <vector>
+
+using namespace std ;
+using namespace DD4hep ;
+using namespace DD4hep::Conditions ;
+
+// this should be the first line in your test
+static DDTest test( "ConditionsArena" ) ;
+
+//=============================================================================
+
+/// Allocate n chunks of a given size and fill them with a pattern
+static vector<void*> allocate( size_t n, size_t len ){
+  vector<void*> chunks ;
+  for( size_t i=0 ; i<n ; ++i ){
+    void* p = ConditionsArena::allocate( len ) ;
+    ::memset( p, int(i&0xFF), len ) ;
+    chunks.push_back( p ) ;
+  }
+  return chunks ;
+}
+
+/// Release chunks obtained by allocate()
+static void deallocate( vector<void*>& chunks ){
+  for( void* p : chunks ) ConditionsArena::deallocate( p ) ;
+  chunks.clear() ;
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test conditions arena and interned strings" );
+
+    // allocations spanning several blocks of the smallest size
+    ConditionsArena* arena = new ConditionsArena( 0 ) ;
+    vector<void*> chunks ;
+    {
+      ConditionsArena::Scope scope( arena ) ;
+      chunks = allocate( 100, 200 ) ;
+    }
+    ConditionsArena::Statistics stat = arena->statistics() ;
+    test( stat.chunks , size_t(100) , " number of allocated chunks " ) ;
+    test( stat.blocks > 1 , " chunks are carved from several blocks " ) ;
+    test( stat.bytes , stat.blocks*4*size_t(ConditionsArena::CHUNK_MAX) , " minimal block size " ) ;
+    test( set<void*>( chunks.begin(), chunks.end() ).size() , size_t(100) , " chunks are distinct " ) ;
+    bool intact = true ;
+    for( size_t i=0 ; i<chunks.size() ; ++i )
+      intact = intact && ((unsigned char*)chunks[i])[0] == (i&0xFF) && ((unsigned char*)chunks[i])[199] == (i&0xFF) ;
+    test( intact , " chunks do not overlap " ) ;
+    test( reinterpret_cast<size_t>( chunks[0] )%sizeof(double) , size_t(0) , " chunks are aligned " ) ;
+
+    // freed chunks are recycled without new blocks
+    set<void*> freed( chunks.begin(), chunks.end() ) ;
+    deallocate( chunks ) ;
+    test( arena->statistics().chunks , size_t(0) , " all chunks released " ) ;
+    {
+      ConditionsArena::Scope scope( arena ) ;
+      chunks = allocate( 100, 200 ) ;
+    }
+    test( arena->statistics().blocks , stat.blocks , " released chunks are recycled " ) ;
+    test( freed.count( chunks[0] ) == 1 , " recycled chunk is reused " ) ;
+    deallocate( chunks ) ;
+
+    // big chunks and allocations without scope are taken from the heap
+    {
+      ConditionsArena::Scope scope( arena ) ;
+      chunks = allocate( 2, 2*ConditionsArena::CHUNK_MAX ) ;
+    }
+    test( arena->statistics().chunks , size_t(0) , " big chunks are not taken from the arena " ) ;
+    deallocate( chunks ) ;
+    chunks = allocate( 2, 200 ) ;
+    test( arena->statistics().chunks , size_t(0) , " no arena without active scope " ) ;
+    deallocate( chunks ) ;
+
+    // nested scopes: the innermost scope wins, leaving a scope restores the previous arena
+    ConditionsArena* inner = new ConditionsArena() ;
+    test( ConditionsArena::current() == 0 , " no active arena " ) ;
+    {
+      ConditionsArena::Scope outer_scope( arena ) ;
+      test( ConditionsArena::current() == arena , " outer scope active " ) ;
+      {
+        ConditionsArena::Scope inner_scope( inner ) ;
+        test( ConditionsArena::current() == inner , " inner scope active " ) ;
+        chunks = allocate( 3, 64 ) ;
+        {
+          ConditionsArena::Scope heap_scope( 0 ) ;
+          test( ConditionsArena::current() == 0 , " NULL scope switches to the heap " ) ;
+        }
+        test( ConditionsArena::current() == inner , " inner scope restored " ) ;
+      }
+      test( ConditionsArena::current() == arena , " outer scope restored " ) ;
+    }
+    test( ConditionsArena::current() == 0 , " no active arena after the outer scope " ) ;
+    test( inner->statistics().chunks , size_t(3) , " inner arena serves the inner scope " ) ;
+    test( arena->statistics().chunks , size_t(0) , " outer arena untouched by the inner scope " ) ;
+    deallocate( chunks ) ;
+    inner->release() ;
+
+    // interning: identical strings in one arena share one copy
+    {
+      ConditionsArena::Scope scope( arena ) ;
+      InternedString a( "conditions.xml#alignment" ) ;
+      InternedString b( string( "conditions.xml#alignment" ) ) ;
+      InternedString c( "conditions.xml#temperature" ) ;
+      InternedString d( a ) ;
+      test( &a.str() == &b.str() , " identical strings are interned once " ) ;
+      test( &a.str() == &d.str() , " copies share the interned string " ) ;
+      test( &a.str() != &c.str() , " different strings are not shared " ) ;
+      test( arena->statistics().strings , size_t(2) , " number of interned strings " ) ;
+      b = "conditions.xml#temperature" ;
+      test( &b.str() == &c.str() , " assignment interns the new value " ) ;
+      test( a.str() , string( "conditions.xml#alignment" ) , " interned value is kept " ) ;
+    }
+    InternedString e( "conditions.xml#alignment" ) ;
+    InternedString f( e ) ;
+    test( e.str() , string( "conditions.xml#alignment" ) , " private string value " ) ;
+    test( &e.str() != &f.str() , " private strings are not shared " ) ;
+    test( arena->statistics().strings , size_t(2) , " private strings are not interned " ) ;
+    InternedString g, h( "" ) ;
+    test( &g.str() == &h.str() && g.empty() , " empty strings share one representation " ) ;
+
+    // interned strings keep the arena alive after the owner released it
+    InternedString* kept = 0 ;
+    {
+      ConditionsArena::Scope scope( arena ) ;
+      kept = new InternedString( "conditions.xml#survivor" ) ;
+    }
+    arena->release() ;
+    test( kept->str() , string( "conditions.xml#survivor" ) , " interned string outlives the owner " ) ;
+    delete kept ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
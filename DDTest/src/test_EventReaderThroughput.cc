@@ -0,0 +1,136 @@
+#include "DD4hep/DDTest.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <exception>
+
+#include "DD4hep/Plugins.h"
+#include "DD4hep/Primitives.h"
+#include "DDG4/Geant4InputAction.h"
+#include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4Vertex.h"
+
+typedef DD4hep::Simulation::Geant4EventReader Reader;
+typedef DD4hep::Simulation::Geant4Vertex      Vertex;
+typedef DD4hep::Simulation::Geant4Particle    Particle;
+
+static DD4hep::DDTest test( "EventReaderThroughput" ) ;
+
+/// Compare the iostream based event readers with the memory mapped readers:
+/// - both must deliver identical particles
+/// - the parse throughput of both is reported in events/s
+class TestTuple {
+public:
+  std::string referenceType;
+  std::string mappedType;
+  std::string inputFile;
+  TestTuple( std::string const& rT, std::string const& mT, std::string const& iF)
+    : referenceType(rT), mappedType(mT), inputFile(iF) {}
+};
+
+typedef std::vector<std::vector<Particle*> > Events;
+
+/// Read all events of a file. Returns the number of events read
+static size_t readAll(const std::string& type, const std::string& input, Events* events)  {
+  Reader* rdr = DD4hep::PluginService::Create<Reader*>(type, input);
+  size_t  num = 0;
+  if ( !rdr )  {
+    test.log( "Plugin not found: " + type );
+    return 0;
+  }
+  for(;;)  {
+    std::vector<Particle*> particles;
+    std::vector<Vertex*>   vertices;
+    Reader::EventReaderStatus sc = rdr->readParticles(int(num),vertices,particles);
+    std::for_each(vertices.begin(),vertices.end(),DD4hep::deleteObject<Vertex>);
+    if ( sc != Reader::EVENT_READER_OK )  {
+      std::for_each(particles.begin(),particles.end(),DD4hep::deleteObject<Particle>);
+      break;
+    }
+    if ( events ) events->push_back(particles);
+    else std::for_each(particles.begin(),particles.end(),DD4hep::deleteObject<Particle>);
+    ++num;
+  }
+  delete rdr;
+  return num;
+}
+
+/// Release the particles of all events
+static void clear(Events& events)  {
+  for(size_t i=0; i<events.size(); ++i)
+    std::for_each(events[i].begin(),events[i].end(),DD4hep::deleteObject<Particle>);
+  events.clear();
+}
+
+/// Check that two particles carry the same information
+static bool same(const Particle* a, const Particle* b)  {
+  return a->id == b->id && a->pdgID == b->pdgID && a->status == b->status &&
+    a->psx == b->psx && a->psy == b->psy && a->psz == b->psz && a->mass == b->mass &&
+    a->vsx == b->vsx && a->vsy == b->vsy && a->vsz == b->vsz &&
+    a->vex == b->vex && a->vey == b->vey && a->vez == b->vez &&
+    a->parents == b->parents && a->daughters == b->daughters;
+}
+
+/// Time repeated reading of a file. Returns the throughput in events/s
+static double throughput(const std::string& type, const std::string& input, int turns)  {
+  typedef std::chrono::high_resolution_clock clock;
+  size_t num = 0;
+  clock::time_point start = clock::now();
+  for(int i=0; i<turns; ++i)
+    num += readAll(type, input, 0);
+  std::chrono::duration<double> secs = clock::now() - start;
+  return secs.count() > 0 ? double(num)/secs.count() : 0e0;
+}
+
+int main(int argc, char** argv ){
+
+  if( argc < 2 ) {
+    std::cout << " usage:  test_EventReaderThroughput Path/To/InputFiles [turns]" << std::endl ;
+    exit(1) ;
+  }
+  int turns = argc > 2 ? ::atoi(argv[2]) : 200;
+
+  std::vector<TestTuple> tests;
+  tests.push_back( TestTuple( "Geant4EventReaderHepEvtShort", "Geant4EventReaderHepEvtShortMapped", "Muons10GeV.HEPEvt" ) );
+  tests.push_back( TestTuple( "Geant4EventReaderHepMC",       "Geant4EventReaderHepMCMapped",       "g4pythia.hepmc" ) );
+  tests.push_back( TestTuple( "Geant4EventReaderHepMC",       "Geant4EventReaderHepMCMapped",       "g4pythia_ascii.hepmc" ) );
+
+  try{
+    for(std::vector<TestTuple>::const_iterator it = tests.begin(); it != tests.end(); ++it) {
+      //InputFiles are in DDTest/inputFiles, argument is cmake_source directory
+      std::string inputFile = argv[1]+ std::string("/inputFiles/") + (*it).inputFile;
+      Events ref, mapped;
+      size_t nref = readAll( (*it).referenceType, inputFile, &ref );
+      size_t nmap = readAll( (*it).mappedType, inputFile, &mapped );
+      test( nref > 0 && nref == nmap , (*it).mappedType + std::string(" Number of events") );
+      bool identical = ref.size() == mapped.size();
+      for(size_t i=0; identical && i<ref.size(); ++i)  {
+        identical = ref[i].size() == mapped[i].size();
+        for(size_t j=0; identical && j<ref[i].size(); ++j)
+          identical = same(ref[i][j], mapped[i][j]);
+      }
+      test( identical , (*it).mappedType + std::string(" Identical particles") );
+      clear(ref);
+      clear(mapped);
+
+      double ref_rate = throughput( (*it).referenceType, inputFile, turns );
+      double map_rate = throughput( (*it).mappedType,    inputFile, turns );
+      std::cout << std::setw(34) << std::left << (*it).referenceType << " "
+                << std::setw(12) << std::right << std::fixed << std::setprecision(0) << ref_rate << " events/s" << std::endl
+                << std::setw(34) << std::left << (*it).mappedType << " "
+                << std::setw(12) << std::right << map_rate << " events/s"
+                << "  Speedup: " << std::setprecision(2) << (ref_rate > 0 ? map_rate/ref_rate : 0e0)
+                << std::endl;
+    }
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -41,6 +41,8 @@ int main(int argc, char** argv ){
   tests.push_back( TestTuple( "LCIOFileReader",   "muons.slcio" , /*skipEOF= */ true ) );
   tests.push_back( TestTuple( "Geant4EventReaderHepEvtShort", "Muons10GeV.HEPEvt" ) );
   tests.push_back( TestTuple( "Geant4EventReaderHepMC", "g4pythia.hepmc" ) );
+  tests.push_back( TestTuple( "Geant4EventReaderHepEvtShortMapped", "Muons10GeV.HEPEvt" ) );
+  tests.push_back( TestTuple( "Geant4EventReaderHepMCMapped", "g4pythia.hepmc" ) );
 
 
   try{
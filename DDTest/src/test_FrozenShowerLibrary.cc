@@ -0,0 +1,102 @@
+#include "DD4hep/DDTest.h"
+#include "DDG4/Geant4FrozenShowerLibrary.h"
+#include <exception>
+#include <iostream>
+#include <cstdio>
+
+using namespace std ;
+using namespace DD4hep ;
+using namespace DD4hep::Simulation ;
+
+// this should be the first line in your test
+static DDTest test( "FrozenShowerLibrary" ) ;
+
+typedef Geant4FrozenShowerLibrary Library ;
+
+//=============================================================================
+
+/// Shower with n spots, which can be recognized by the first coordinate
+static Library::Spots make_spots( int n, float tag ){
+  Library::Spots spots ;
+  for( int i=0 ; i<n ; ++i ){
+    Library::Spot s = { tag, float(i), float(2*i), 1.f/float(n) } ;
+    spots.push_back( s ) ;
+  }
+  return spots ;
+}
+
+/// Check the selected shower of a library
+static void check( const Library& lib, const string& tag, int pdg, double energy, double rndm,
+                   float expected_energy, unsigned int expected_count, float expected_tag ){
+  const Library::Shower* s = lib.sample( pdg, energy, rndm ) ;
+  test( s != 0 , tag + " shower found " ) ;
+  if( s ){
+    test( s->energy , expected_energy , tag + " nearest energy " ) ;
+    test( s->count , expected_count , tag + " number of spots " ) ;
+    test( lib.spots( *s )[0].x , expected_tag , tag + " spots belong to the shower " ) ;
+    test( lib.spots( *s )[s->count-1].z , float(2*(s->count-1)) , tag + " last spot " ) ;
+  }
+}
+
+/// Sample the showers added in main()
+static void check_all( const Library& lib, const string& tag ){
+  check( lib, tag + " photon 4 GeV   :", 22,    4.0, 0.5,   5.f, 2, 1.f ) ;
+  check( lib, tag + " photon 0.1 GeV :", 22,    0.1, 0.5,   1.f, 1, 5.f ) ;
+  check( lib, tag + " e- 12 GeV [0]  :", 11,   12.0, 0.0,  10.f, 1, 3.f ) ;
+  check( lib, tag + " e- 12 GeV [1]  :", 11,   12.0, 0.99, 10.f, 2, 4.f ) ;
+  check( lib, tag + " e+ 100 GeV     :", -11, 100.0, 0.3,  20.f, 3, 2.f ) ;
+  test( lib.sample( 2112, 10.0, 0.5 ) == 0 , tag + " no showers of unsupported particles " ) ;
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  const char* file_name = "test_FrozenShowerLibrary.fsl" ;
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test frozen shower library" );
+
+    // showers are added out of order: the library must sort them
+    Library lib ;
+    lib.add( 22,   5.0, make_spots( 2, 1.f ) ) ;
+    lib.add( 11,  20.0, make_spots( 3, 2.f ) ) ;
+    lib.add( 11,  10.0, make_spots( 1, 3.f ) ) ;
+    lib.add( -11, 10.0, make_spots( 2, 4.f ) ) ;
+    lib.add( 22,   1.0, make_spots( 1, 5.f ) ) ;
+    test( lib.numShowers() , size_t(5) , " number of added showers " ) ;
+    test( lib.numSpots() , size_t(9) , " number of added spots " ) ;
+
+    bool unsupported = false ;
+    try{
+      lib.add( 211, 10.0, make_spots( 1, 6.f ) ) ;
+    } catch( exception& ){
+      unsupported = true ;
+    }
+    test( unsupported , " showers of hadrons are refused " ) ;
+
+    lib.save( file_name ) ;
+    check_all( lib, "saved  " ) ;
+
+    Library loaded ;
+    loaded.load( file_name ) ;
+    test( loaded.numShowers() , lib.numShowers() , " number of loaded showers " ) ;
+    test( loaded.numSpots() , lib.numSpots() , " number of loaded spots " ) ;
+    test( loaded.bytes() , lib.bytes() , " size of the loaded library " ) ;
+    check_all( loaded, "loaded " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  ::remove( file_name ) ;
+  return 0;
+}
+
+//=============================================================================
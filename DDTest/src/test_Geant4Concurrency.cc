@@ -0,0 +1,88 @@
+#include "DD4hep/DDTest.h"
+#include "DDG4/Geant4Concurrency.h"
+#include <exception>
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std ;
+using namespace DD4hep ;
+using namespace DD4hep::Simulation ;
+
+// this should be the first line in your test
+static DDTest test( "Geant4Concurrency" ) ;
+
+//=============================================================================
+
+/// Run a batch of concurrent threads, each incrementing its thread local counter
+static vector<int> run_batch( Geant4PerThread<long>& counters, int num_threads, long turns ){
+  vector<int> slots( num_threads, -1 ) ;
+  vector<thread> threads ;
+  atomic<int> running( 0 ) ;
+  for( int i=0 ; i<num_threads ; ++i ){
+    threads.push_back( thread( [&counters, &slots, &running, num_threads, i, turns]() {
+          slots[i] = geant4ThreadSlot() ;
+          // Keep all slots busy until every thread of the batch has one
+          for( ++running ; running < num_threads ; ) this_thread::yield() ;
+          for( long j=0 ; j<turns ; ++j ) ++counters.local() ;
+        } ) ) ;
+  }
+  for( auto& t : threads ) t.join() ;
+  return slots ;
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test concurrency contract of shared actions" );
+
+    // the concurrency contract is an ordinary property of every action.
+    // As in python or XML setups the property is set after the action is shared.
+    Geant4Action* action = new Geant4Action( 0, "TestAction" ) ;
+    Geant4ActionLock* lock = Geant4ActionLock::acquire( action ) ;
+    test( lock == Geant4ActionLock::acquire( action ) , " one lock per shared action " ) ;
+    test( action->isReentrant() , false , " actions are not reentrant by default " ) ;
+    test( lock->reentrant() , false , " shared actions are serialized by default " ) ;
+    action->property( "Reentrant" ).str( "true" ) ;
+    test( action->isReentrant() , true , " Reentrant property sets the contract " ) ;
+    test( lock->reentrant() , true , " lock follows the contract set after sharing " ) ;
+    Geant4ActionLock::release( lock ) ;
+    Geant4ActionLock::release( lock ) ;
+    action->release() ;
+
+    // per thread accumulation with a merge once the threads are idle
+    Geant4PerThread<long> counters ;
+    vector<int> first  = run_batch( counters, 4, 10000 ) ;
+    long sum = 0, instances = 0 ;
+    counters.merge( [&sum, &instances](long n) { sum += n ; ++instances ; } ) ;
+    test( sum , 40000L , " merged counts of the first batch of threads " ) ;
+    test( instances , 4L , " one instance per thread " ) ;
+
+    // slots of finished threads are handed to new threads
+    vector<int> second = run_batch( counters, 4, 10000 ) ;
+    sort( first.begin(), first.end() ) ;
+    sort( second.begin(), second.end() ) ;
+    test( first == second , " thread slots are reused by new threads " ) ;
+    sum = instances = 0 ;
+    counters.merge( [&sum, &instances](long n) { sum += n ; ++instances ; } ) ;
+    test( sum , 80000L , " reused instances keep accumulating " ) ;
+    test( instances , 4L , " no new instances for reused slots " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
@@ -0,0 +1,89 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Volumes.h"
+#include <exception>
+#include <iostream>
+
+using namespace std ;
+using namespace DD4hep ;
+using namespace DD4hep::Geometry ;
+
+// this should be the first line in your test
+static DDTest test( "PackedVolIDs" ) ;
+
+typedef PlacedVolume::Object::PackedVolIDs PackedVolIDs ;
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test packed volume IDs" );
+
+    // interning returns the same index for the same name
+    unsigned int layer = PackedVolIDs::intern( "layer" ) ;
+    test( PackedVolIDs::intern( "layer" ) , layer , " interned name keeps its index " ) ;
+    test( PackedVolIDs::intern( "module" ) != layer , " different names get different indices " ) ;
+    test( &PackedVolIDs::name( layer ) == &PackedVolIDs::name( PackedVolIDs::intern( "layer" ) ) ,
+          " interned name is stored once " ) ;
+
+    // short lists are stored inline
+    PackedVolIDs ids ;
+    ids.push_back( "system" , 5 ) ;
+    ids.push_back( "layer"  , 12 ) ;
+    test( ids.size() , size_t(2) , " number of inline identifiers " ) ;
+    test( ids.heapBytes() , size_t(0) , " inline identifiers use no heap " ) ;
+    test( ids.find( "layer" )->value , 12 , " find inline identifier " ) ;
+    test( ids.find( "sensor" ) == ids.end() , " missing identifier is not found " ) ;
+
+    // the unpacked container is created on demand and follows later additions
+    const PlacedVolume::VolIDs& unpacked = ids.unpacked() ;
+    test( &unpacked == &ids.unpacked() , " unpacked identifiers are created once " ) ;
+    test( unpacked.size() , size_t(2) , " number of unpacked identifiers " ) ;
+    test( unpacked[0].first , string("system") , " first unpacked field name " ) ;
+    test( unpacked[1].second , 12 , " second unpacked field value " ) ;
+
+    // the last inline identifier must also reach the unpacked container
+    ids.push_back( "module" , 3 ) ;
+    test( ids.heapBytes() , sizeof(PlacedVolume::VolIDs)+unpacked.capacity()*sizeof(PlacedVolume::VolID) ,
+          " third identifier is stored inline " ) ;
+    test( unpacked.size() , ids.size() , " unpacked identifiers follow inline additions " ) ;
+    test( unpacked[2].first , string("module") , " inline unpacked field name " ) ;
+
+    // longer lists move to one heap block
+    ids.push_back( "sensor" , -1 ) ;
+    test( ids.size() , size_t(4) , " number of heap identifiers " ) ;
+    test( ids.heapBytes() > 4*sizeof(PackedVolIDs::Entry) , " heap identifiers are accounted " ) ;
+    test( ids.find( "sensor" )->value , -1 , " find heap identifier " ) ;
+    test( unpacked.size() , size_t(4) , " unpacked identifiers follow additions " ) ;
+    test( unpacked[3].first , string("sensor") , " last unpacked field name " ) ;
+
+    // copies hold the identifiers, but not the unpacked container
+    PackedVolIDs copy( ids ) ;
+    test( copy.size() , size_t(4) , " copied identifiers " ) ;
+    test( copy.heapBytes() , 4*sizeof(PackedVolIDs::Entry) , " copy has no unpacked container " ) ;
+    test( copy.find( "module" )->value , 3 , " find copied identifier " ) ;
+
+    // assignment refreshes the unpacked container in place
+    PackedVolIDs other ;
+    other.push_back( "barrel" , 1 ) ;
+    ids = other ;
+    test( ids.size() , size_t(1) , " assigned identifiers " ) ;
+    test( unpacked.size() , size_t(1) , " unpacked identifiers follow assignment " ) ;
+    test( unpacked[0].first , string("barrel") , " assigned unpacked field name " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
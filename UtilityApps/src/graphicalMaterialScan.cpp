@@ -26,6 +26,9 @@
 
 #include "TFile.h"
 #include "TH2F.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "TGeoManager.h"
 
 // Framework include files
 #include "DD4hep/LCDD.h"
@@ -33,8 +36,15 @@
 #include "DDRec/MaterialManager.h"
 
 #include <iostream>
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <map>
 
 #undef NDEBUG 
@@ -47,6 +57,117 @@ using DDSurfaces::Vector3D;
 using std::cout;
 using std::endl;
 
+namespace {
+
+  /// Reusable barrier to synchronize the scanning threads with the main thread slice by slice
+  class Barrier  {
+    std::mutex              m_lock;
+    std::condition_variable m_cond;
+    size_t                  m_count, m_waiting = 0, m_generation = 0;
+  public:
+    Barrier(size_t count) : m_count(count)  {}
+    void wait()  {
+      std::unique_lock<std::mutex> lock(m_lock);
+      size_t gen = m_generation;
+      if ( ++m_waiting == m_count )  {
+        m_waiting = 0;
+        ++m_generation;
+        m_cond.notify_all();
+        return;
+      }
+      m_cond.wait(lock, [this,gen] { return gen != m_generation; });
+    }
+  };
+
+  /// Material fraction of one histogram bin
+  struct Fraction  {
+    unsigned int bin;
+    int          material;
+    float        value;
+  };
+
+  /// Scan definition and results of one slice
+  struct Slice  {
+    unsigned int        index[3];
+    unsigned int        nbins, mm;
+    double              sz;
+    std::vector<double> xedges, yedges;
+    /// Results: X0 and lambda per unit length by bin (ix-1)*nbins+(iy-1)
+    std::vector<float>  x0, lambda;
+    /// Per-thread results: material fractions
+    std::vector<std::vector<Fraction> > fractions;
+  };
+
+  /// Scanning thread: owns a material manager (and hence its navigator) and the material accumulators
+  class Scanner  {
+    /// Map of TGeoMaterial index to unique material identifier
+    const std::vector<int>& m_matID;
+    std::vector<double>     m_lengths;
+    std::vector<int>        m_touched;
+  public:
+    Scanner(const std::vector<int>& ids, size_t num_materials)
+      : m_matID(ids), m_lengths(num_materials,0e0)  {}
+    /// Scan the rows id, id+stride, ... of the slice
+    void scan(Slice& slice, size_t id, size_t stride)   {
+      MaterialManager matMgr;
+      Vector3D p0, p1; // the two points between which material is calculated
+      const unsigned int* index = slice.index;
+      unsigned int nbins = slice.nbins, mm = slice.mm;
+      std::vector<Fraction>& fractions = slice.fractions[id];
+
+      p0.array()[ index[0] ] = slice.sz;
+      p1.array()[ index[0] ] = slice.sz;
+      for (size_t ix=id; ix<nbins; ix += stride) {  // loop over one axis of slice
+        double xmin = slice.xedges[ix];
+        double xmax = slice.xedges[ix+1];
+
+        for (unsigned int iy=0; iy<nbins; iy++) { // and the other axis
+          double ymin = slice.yedges[iy];
+          double ymax = slice.yedges[iy+1];
+          unsigned int bin = ix*nbins + iy;
+
+          // for this bin, estimate the material
+          double sum_lambda(0);
+          double sum_x0(0);
+          double sum_length(0);
+
+          for (unsigned int jx=0; jx<2*mm; jx++) {
+            if ( jx<mm ) {
+              double xcom = xmin + (1+jx)*( xmax - xmin )/(mm+1.);
+              p0.array()[index[1]] = xcom;  p0.array()[index[2]] = ymin;
+              p1.array()[index[1]] = xcom;  p1.array()[index[2]] = ymax;
+            } else {
+              double ycom =  ymin + (jx-mm+1)*( ymax - ymin )/(mm+1.);
+              p0.array()[index[1]] = xmin;  p0.array()[index[2]] = ycom;
+              p1.array()[index[1]] = xmax;  p1.array()[index[2]] = ycom;
+            }
+
+            const MaterialVec& materials = matMgr.materialsBetween(p0, p1);
+            for( unsigned i=0,n=materials.size();i<n;++i){
+              TGeoMaterial* mat =  materials[i].first->GetMaterial();
+              double length = materials[i].second;
+              sum_length += length;
+              sum_x0 += length / mat->GetRadLen();
+              sum_lambda += length / mat->GetIntLen();
+
+              int mid = m_matID[mat->GetIndex()];
+              if ( m_lengths[mid] == 0e0 ) m_touched.push_back(mid);
+              m_lengths[mid] += length;
+            }
+          }
+          slice.x0[bin]     = sum_x0/sum_length; // normalise to cm (ie x0/cm density: indep of bin size)
+          slice.lambda[bin] = sum_lambda/sum_length;
+          for ( int mid : m_touched )  {
+            fractions.push_back(Fraction{bin, mid, float(m_lengths[mid]/sum_length)});
+            m_lengths[mid] = 0e0;
+          }
+          m_touched.clear();
+        }
+      }
+    }
+  };
+}
+
 int main_wrapper(int argc, char** argv)   {
   struct Handler  {
     Handler() { SetErrorHandler(Handler::print); }
@@ -54,12 +175,13 @@ int main_wrapper(int argc, char** argv)   {
       if ( level > kInfo || abort ) ::printf("%s: %s\n", location, msg);
     }
     static void usage()  {
-      std::cout << " usage: graphicalMaterialScan compact.xml axis xMin yMin zMin xMax yMax zMax nSlices nBins nSamples" << std::endl
+      std::cout << " usage: graphicalMaterialScan compact.xml axis xMin yMin zMin xMax yMax zMax nSlices nBins nSamples [--threads N]" << std::endl
                 << " axis (X, Y, or Z)             : perpendicular to the slices" << std::endl 
                 << " xMin yMin zMin xMax yMax zMax : range of scans " << std::endl 
                 << " nSlices                       : number of slices (equally spaced along chose axis)" << std::endl 
                 << " nBins                         : number of bins along each axis of histograms" << std::endl 
                 << " nSamples                      : the number of times each bin is sampled " << std::endl 
+                << " --threads N                   : number of threads scanning the bins of a slice (default: 1)" << std::endl 
                 << "        -> produces graphical scans of the detector material "
                 << std::endl;
       exit(1);
@@ -70,6 +192,20 @@ int main_wrapper(int argc, char** argv)   {
   // each slice has nBins x nBins in the specified range
   // the material in each bin is sampled along 2*nTests paths
 
+  // Strip the options from the positional arguments
+  unsigned int nthreads = 1;
+  std::vector<char*> args;
+  for(int i=0; i<argc; ++i)  {
+    if ( (0 == ::strcmp(argv[i],"--threads") || 0 == ::strcmp(argv[i],"-threads")) && i+1 < argc )  {
+      int n = ::atoi(argv[++i]);
+      nthreads = n > 1 ? n : 1;
+      continue;
+    }
+    args.push_back(argv[i]);
+  }
+  argc = args.size();
+  argv = &args[0];
+
   if( argc != 12 ) Handler::usage();
 
   std::string inFile = argv[1]; // input geometry description compact xml file
@@ -126,29 +262,87 @@ int main_wrapper(int argc, char** argv)   {
   double mmin[3]={x0,y0,z0};
   double mmax[3]={x1,y1,z1};
 
+  for (int j=1; j<=2; j++) {
+    if ( mmax[index[j]] - mmin[index[j]] < 1e-4 ) {
+      cout << "ERROR: max and min of axis are the same!" << endl;
+      assert(0);
+    }
+  }
 
   //------
   
   Geometry::LCDD& lcdd = Geometry::LCDD::getInstance();
   lcdd.fromCompact(inFile);
 
+  //------
+
+  // Dense material identifiers: materials with the same name are merged.
+  // TGeoMaterial::GetIndex() caches the index: resolve it before the threads start.
+  TGeoManager& geoMgr = lcdd.manager();
+  std::vector<std::string> matNames;
+  std::vector<int>         matID(geoMgr.GetListOfMaterials()->GetSize(), -1);
+  std::map<std::string,int> nameID;
+  TIter next(geoMgr.GetListOfMaterials());
+  while ( TGeoMaterial* mat = (TGeoMaterial*)next() )  {
+    auto r = nameID.insert(std::make_pair(std::string(mat->GetName()),int(matNames.size())));
+    if ( r.second ) matNames.push_back(mat->GetName());
+    matID[mat->GetIndex()] = (*r.first).second;
+  }
+
   //-----
 
   TFile* f = new TFile("graphicalMaterialScan.root","recreate");
 
-  Vector3D p0, p1; // the two points between which material is calculated
-
-  MaterialManager matMgr;
+  Slice slice;
+  std::copy(index, index+3, slice.index);
+  slice.nbins = nbins;
+  slice.mm    = mm;
+  slice.x0.resize(nbins*nbins);
+  slice.lambda.resize(nbins*nbins);
+  slice.fractions.resize(nthreads);
+
+  // Each thread scans a stride of rows of every slice with its own navigator.
+  // Histograms are only touched by the main thread.
+  std::vector<std::thread> threads;
+  std::vector<std::string> errors(nthreads);
+  Barrier barrier(nthreads+1);
+  bool    stop = false;
+  auto    run_scan = [&](size_t id)  {
+    Scanner scanner(matID, matNames.size());
+    try  {
+      scanner.scan(slice, id, nthreads);
+    }
+    catch(const std::exception& e)  {
+      errors[id] = e.what();
+    }
+    catch(...)  {
+      errors[id] = "UNKNOWN exception";
+    }
+  };
+  if ( nthreads > 1 )  {
+    ROOT::EnableThreadSafety();
+    geoMgr.SetMaxThreads(nthreads);
+    for(size_t i=0; i<nthreads; ++i)  {
+      threads.push_back(std::thread([&,i]  {
+            for(;;)  {
+              barrier.wait();
+              if ( stop ) break;
+              run_scan(i);
+              barrier.wait();
+            }
+          }));
+    }
+  }
 
-  for (unsigned int isl=0; isl<nslice; isl++) { // loop over slices
+  typedef std::chrono::high_resolution_clock clock;
+  clock::time_point scan_start = clock::now();
+  std::string error;
+  for (unsigned int isl=0; isl<nslice && error.empty(); isl++) { // loop over slices
 
     double sz = nslice > 1 ? 
       mmin[index[0]] + isl*( mmax[index[0]] - mmin[index[0]] )/( nslice - 1 ) :
       (mmin[index[0]] + mmax[index[0]])/2. ;
 
-    p0.array()[ index[0] ] = sz;
-    p1.array()[ index[0] ] = sz;
-
     cout << "scanning slice " << isl << " at "+XYZ+" = " << sz << endl;
 
     TString dirn = "Slice"; dirn+=isl;
@@ -161,14 +355,6 @@ int main_wrapper(int argc, char** argv)   {
     TString hn = "slice"; hn+=isl; hn+="_X0";
     TString hnn = "X0 "; hnn += XYZ; hnn+="="; hnn += Form("%7.3f",sz); hnn+=" [cm]";
 
-    for (int j=1; j<=2; j++) {
-      if ( mmax[index[j]] - mmin[index[j]] < 1e-4 ) {
-        cout << "ERROR: max and min of axis are the same!" << endl;
-        assert(0);
-      }
-    }
-
-
     TH2F* h2slice = new TH2F( hn, hnn, nbins, mmin[index[1]], mmax[index[1]], nbins, mmin[index[2]], mmax[index[2]] );
     scanmap["x0"] = h2slice;
 
@@ -177,72 +363,53 @@ int main_wrapper(int argc, char** argv)   {
     h2slice = new TH2F( hn, hnn, nbins, mmin[index[1]], mmax[index[1]], nbins, mmin[index[2]], mmax[index[2]] );
     scanmap["lambda"] = h2slice;
 
+    slice.sz = sz;
+    slice.xedges.resize(nbins+1);
+    slice.yedges.resize(nbins+1);
+    for (unsigned int i=0; i<nbins; i++) {
+      slice.xedges[i] = h2slice->GetXaxis()->GetBinLowEdge(i+1);
+      slice.yedges[i] = h2slice->GetYaxis()->GetBinLowEdge(i+1);
+    }
+    slice.xedges[nbins] = h2slice->GetXaxis()->GetBinUpEdge(nbins);
+    slice.yedges[nbins] = h2slice->GetYaxis()->GetBinUpEdge(nbins);
+    for ( auto& fr : slice.fractions ) fr.clear();
+
+    clock::time_point start = clock::now();
+    if ( nthreads > 1 )  {
+      barrier.wait();  // start scanning the slice
+      barrier.wait();  // all rows scanned
+    }
+    else  {
+      run_scan(0);
+    }
+    std::chrono::duration<double> secs = clock::now() - start;
+    cout << "   slice " << isl << " scanned in " << secs.count() << " seconds" << endl;
 
-    for (int ix=1; ix<=h2slice->GetNbinsX(); ix++) {  // loop over one axis of slice
-
-      double xmin = h2slice->GetXaxis()->GetBinLowEdge(ix);
-      double xmax = h2slice->GetXaxis()->GetBinUpEdge(ix);
-
-      for (int iy=1; iy<=h2slice->GetNbinsY(); iy++) { // and the other axis
-
-        double ymin = h2slice->GetYaxis()->GetBinLowEdge(iy);
-        double ymax = h2slice->GetYaxis()->GetBinUpEdge(iy);
-
-        // for this bin, estimate the material
-        double sum_lambda(0);
-        double sum_x0(0);
-        double sum_length(0);
-
-        std::map < std::string , float > materialmap;
-
-        for (unsigned int jx=0; jx<2*mm; jx++) {
-          if ( jx<mm ) {
-            double xcom = xmin + (1+jx)*( xmax - xmin )/(mm+1.);
-            p0.array()[index[1]] = xcom;  p0.array()[index[2]] = ymin;
-            p1.array()[index[1]] = xcom;  p1.array()[index[2]] = ymax;
-          } else {
-            double ycom =  ymin + (jx-mm+1)*( ymax - ymin )/(mm+1.);
-            p0.array()[index[1]] = xmin;  p0.array()[index[2]] = ycom;
-            p1.array()[index[1]] = xmax;  p1.array()[index[2]] = ycom;
-          }
-
-          const MaterialVec& materials = matMgr.materialsBetween(p0, p1);
-          for( unsigned i=0,n=materials.size();i<n;++i){
-            TGeoMaterial* mat =  materials[i].first->GetMaterial();
-            double length = materials[i].second;
-            sum_length += length;
-            double nx0 = length / mat->GetRadLen();
-            sum_x0 += nx0;
-            double nLambda = length / mat->GetIntLen();
-            sum_lambda += nLambda;
-
-            std::string mname = mat->GetName();
-            if ( materialmap.find( mname )!=materialmap.end() ) {
-              materialmap[mname]+=length;
-            } else {
-              materialmap[mname]=length;
-            }
-
-          }
+    for ( const auto& e : errors ) {
+      if ( !e.empty() ) error = e;
+    }
 
+    // Merge the results of all threads into the histograms
+    for (unsigned int ix=0; ix<nbins; ix++) {
+      for (unsigned int iy=0; iy<nbins; iy++) {
+        scanmap["x0"]->SetBinContent(ix+1, iy+1, slice.x0[ix*nbins+iy]);
+        scanmap["lambda"]->SetBinContent(ix+1, iy+1, slice.lambda[ix*nbins+iy]);
+      }
+    }
+    std::vector<TH2F*> mathists(matNames.size(), (TH2F*)0);
+    for ( const auto& fr : slice.fractions )  {
+      for ( const Fraction& frac : fr )  {
+        TH2F*& h = mathists[frac.material];
+        if ( !h )  {
+          const std::string& mname = matNames[frac.material];
+          hn = "slice"; hn+=isl; hn+="_"+mname;
+          hnn = mname; hnn += " "+XYZ; hnn+="="; 
+          hnn += Form("%7.3f",sz);
+          hnn+=" [cm]";
+          h = new TH2F( hn, hnn, nbins, mmin[index[1]], mmax[index[1]], nbins, mmin[index[2]], mmax[index[2]] );
+          scanmap[mname] = h;
         }
-	
-        scanmap["x0"]->SetBinContent(ix, iy, sum_x0/sum_length); // normalise to cm (ie x0/cm density: indep of bin size)
-        scanmap["lambda"]->SetBinContent(ix, iy, sum_lambda/sum_length);
-
-        for (  std::map < std::string , float >::iterator jj = materialmap.begin(); jj!=materialmap.end(); jj++) {
-          if ( scanmap.find( jj->first )==scanmap.end() ) {
-            hn = "slice"; hn+=isl; hn+="_"+jj->first;
-            hnn = jj->first; hnn += " "+XYZ; hnn+="="; 
-            // hnn+=sz; 
-            hnn += Form("%7.3f",sz);
-            hnn+=" [cm]";
-            scanmap[jj->first] = new TH2F( hn, hnn, nbins, mmin[index[1]], mmax[index[1]], nbins, mmin[index[2]], mmax[index[2]] );
-          }
-          scanmap[jj->first]->SetBinContent(ix, iy, jj->second / sum_length );
-        }
-
-
+        h->SetBinContent(frac.bin/nbins+1, frac.bin%nbins+1, frac.value);
       }
     }
 
@@ -252,6 +419,19 @@ int main_wrapper(int argc, char** argv)   {
       jj->second->GetYaxis()->SetTitle(laby);
     }
   }
+  if ( nthreads > 1 )  {
+    stop = true;
+    barrier.wait();
+    for ( auto& t : threads ) t.join();
+  }
+  if ( !error.empty() )  {
+    throw std::runtime_error("graphicalMaterialScan: "+error);
+  }
+  std::chrono::duration<double> total = clock::now() - scan_start;
+  double rays = double(nslice)*double(nbins)*double(nbins)*2.0*double(mm);
+  cout << "Timing: " << nslice << " slices with " << nbins << "x" << nbins << " bins, "
+       << rays << " rays scanned by " << nthreads << " thread(s) in " << total.count() << " seconds"
+       << " [" << (total.count() > 0 ? rays/total.count() : 0e0) << " rays/sec]" << endl;
   f->Write();
   f->Close();
   return 0;
@@ -0,0 +1,79 @@
+"""
+
+   Subtest using CLICSid comparing the memory and timing of the standard
+   calorimeter sensitive action with the accumulating calorimeter action
+   in the high granularity electromagnetic calorimeters.
+
+   Usage:  python CLICSiDCaloAccumulate.py [standard|accumulate] [number of events]
+
+   The sensitive actions print their statistics at the end of the job,
+   the profiler the time spent in the sensitive detectors.
+   Without arguments both modes are run as separate processes and
+   their memory and timing are compared.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+def simulate(mode, events):
+  import resource, CLICSid, DDG4
+  from DDG4 import OutputLevel as Output
+  from SystemOfUnits import GeV
+
+  calo = 'Geant4CalorimeterAccumulateAction' if mode == 'accumulate' else 'Geant4CalorimeterAction'
+
+  sid = CLICSid.CLICSid()
+  geant4 = sid.geant4
+  kernel = sid.kernel
+  sid.loadGeometry()
+  kernel.UI = ''
+  sid.setupField(quiet=True)
+
+  prof = DDG4.RunAction(kernel,'Geant4ProfilerAction/Profiler')
+  prof.Histograms = False
+  prof.MaxLines   = 20
+  kernel.runAction().adopt(prof)
+
+  geant4.setupGun('Gun',particle='e-',energy=50*GeV,isotrop=True,multiplicity=1)
+
+  print "#  Calorimeters with sensitive action:",calo
+  for det in ['EcalBarrel','EcalEndcap']:
+    seq,act = geant4.setupCalorimeter(det,type=calo)
+    act.OutputLevel = Output.INFO
+
+  sid.setupPhysics('QGSP_BERT')
+  sid.test_config()
+  kernel.NumEvents = events
+  kernel.run()
+  kernel.terminate()
+  usage = resource.getrusage(resource.RUSAGE_SELF)
+  print '+++ Mode: %-10s Events: %d  Max. resident memory: %.1f MB  CPU: %.2f s'%\
+        (mode, events, usage.ru_maxrss/1024.0, usage.ru_utime+usage.ru_stime)
+
+def measure(mode, events):
+  import os, re, sys, subprocess
+  args = [sys.executable, os.path.abspath(__file__), mode, str(events)]
+  output = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT).communicate()[0]
+  match = re.search(r'\+\+\+ Mode: %s +Events: %d +Max. resident memory: ([0-9.]+) MB +CPU: ([0-9.]+) s'%\
+                    (mode, events), output)
+  if not match:
+    print output
+    print 'Calorimeter accumulation test FAILED: no statistics of mode',mode
+    return None
+  print match.group(0)
+  return (float(match.group(1)), float(match.group(2)))
+
+def run():
+  import sys
+  events = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+  if len(sys.argv) > 1:
+    simulate(sys.argv[1], events)
+    return
+  standard   = measure('standard', events)
+  accumulate = measure('accumulate', events)
+  if standard and accumulate and standard[0] > 0.0 and standard[1] > 0.0:
+    print '+++ Comparison accumulate/standard: memory ratio %.2f CPU ratio %.2f'%\
+          (accumulate[0]/standard[0], accumulate[1]/standard[1])
+
+if __name__ == "__main__":
+  run()
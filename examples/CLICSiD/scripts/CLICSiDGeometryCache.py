@@ -0,0 +1,96 @@
+"""
+
+   Subtest using CLICSid checking the cache of the converted Geant4 geometry.
+
+   The first job converts the geometry and saves it to the cache, the second
+   job restores the geometry from the cache. Both jobs perform a material scan
+   with geantinos, which must give identical results.
+
+   Usage:  python CLICSiDGeometryCache.py [cache file prefix]
+
+   The jobs are run as separate processes. Cache files of earlier tests
+   with the same prefix are removed first.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+def scan(prefix):
+  import os, DDG4, SystemOfUnits
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepINSTALL']
+  kernel.loadGeometry("file:"+install_dir+"/DDDetectors/compact/SiD.xml")
+  DDG4.Core.setPrintFormat("%-32s %6s %s")
+  geant4 = DDG4.Geant4(kernel)
+  geant4.setupCshUI(ui=None)
+  seq,act = geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  act.GeometryCache = prefix
+  gun = geant4.setupGun("Gun",
+                        Standalone=True,
+                        particle='geantino',
+                        energy=20*SystemOfUnits.GeV,
+                        position=(0,0,0),
+                        multiplicity=1,
+                        isotrop=False )
+  scanner = DDG4.SteppingAction(kernel,'Geant4MaterialScanner/MaterialScan')
+  kernel.steppingAction().adopt(scanner)
+  geant4.setupPhysics('QGSP_BERT')
+  kernel.configure()
+  kernel.initialize()
+  kernel.NumEvents = 1
+  for direction in [(0,1,0),(1,0,0),(1,1,1),(0,1,1)]:
+    gun.direction = direction
+    kernel.run()
+  kernel.terminate()
+
+def run_scan(prefix):
+  import os, re, sys, subprocess
+  args = [sys.executable, os.path.abspath(__file__), prefix, 'scan']
+  output = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT).communicate()[0]
+  # Material names may differ after the GDML round trip: compare the numbers only
+  layers = re.findall(r'^ \| +[0-9]+ +\S+ +(.*)$', output, re.MULTILINE)
+  return output, layers
+
+def run():
+  import os, re, sys, glob
+  prefix = sys.argv[1] if len(sys.argv) > 1 else 'CLICSiD_geometry_cache'
+  if len(sys.argv) > 2:
+    scan(prefix)
+    return
+  for f in glob.glob(prefix+'_*.gdml')+glob.glob(prefix+'_*.map'):
+    os.remove(f)
+
+  saved_output,    saved    = run_scan(prefix)
+  restored_output, restored = run_scan(prefix)
+  save    = re.search(r'Saved converted geometry to (\S+) \[([0-9]+) volumes, ([0-9]+) placements\]', saved_output)
+  restore = re.search(r'Restored converted geometry from (\S+) in [0-9.]+ seconds \[([0-9]+) volumes, ([0-9]+) placements\]', restored_output)
+  ok = True
+  if not save:
+    print saved_output
+    print '+++ The converted geometry was not saved to the cache.'
+    ok = False
+  if not restore:
+    print restored_output
+    print '+++ The geometry was not restored from the cache.'
+    ok = False
+  if ok:
+    print '+++ Saved:    %s [%s volumes, %s placements]'%save.groups()
+    print '+++ Restored: %s [%s volumes, %s placements]'%restore.groups()
+    if save.groups() != restore.groups():
+      print '+++ The restored geometry differs from the saved geometry.'
+      ok = False
+  if not saved or saved != restored:
+    print '+++ Material scans differ: %d layers converted, %d layers restored.'%(len(saved),len(restored))
+    for s,r in zip(saved,restored):
+      if s != r:
+        print '+++ Converted: ',s
+        print '+++ Restored:  ',r
+        break
+    ok = False
+  if ok:
+    print 'TEST_PASSED: identical material scans of %d layers with the cached geometry'%(len(saved),)
+  else:
+    print 'TEST_FAILED: the cached geometry differs from the converted geometry'
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,79 @@
+"""
+
+   Subtest using CLICSid checking the pile-up overlay.
+
+   Every signal event of a particle gun is overlaid with a poisson distributed
+   number of background events from a HepMC file in three bunch crossings.
+   The particles and vertices of the overlaid interactions must all show up in
+   the merged MC input record together with the signal particle.
+
+   Usage:  python CLICSiDPileup.py <HepMC background file> [number of events]
+
+   The simulation is run as a separate process. Its output is checked for
+   the counts of the overlay and of the interaction merger in every event.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+def simulate(input_file, events):
+  import CLICSid, DDG4
+  from DDG4 import OutputLevel as Output
+  from SystemOfUnits import GeV
+
+  sid = CLICSid.CLICSid()
+  geant4 = sid.geant4
+  kernel = sid.kernel
+  sid.loadGeometry()
+  kernel.UI = ''
+  sid.setupField(quiet=True)
+
+  gun = DDG4.GeneratorAction(kernel,'Geant4ParticleGun/Gun')
+  gun.Standalone = False
+  gun.Mask       = 0
+  gun.particle   = 'mu-'
+  gun.energy     = 10*GeV
+  gun.isotrop    = True
+  pileup = geant4.setupPileup('Pileup',['Geant4EventReaderHepMC|'+input_file],1.0,-1,1)
+  geant4.buildInputStage([gun,pileup],output_level=Output.DEBUG,have_mctruth=False)
+
+  sid.setupPhysics('QGSP_BERT')
+  sid.test_config()
+  kernel.NumEvents = events
+  kernel.run()
+  kernel.terminate()
+
+def run():
+  import os, re, sys, subprocess
+  if len(sys.argv) < 2:
+    print 'No background file given. Try again....'
+    sys.exit(2)  # ENOENT
+  events = int(sys.argv[2]) if len(sys.argv) > 2 else 5
+  if len(sys.argv) > 3:
+    simulate(sys.argv[1], events)
+    return
+
+  args = [sys.executable, os.path.abspath(__file__), sys.argv[1], str(events), 'simulate']
+  output = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT).communicate()[0]
+  overlay = re.findall(r'Overlaid ([0-9]+) pile-up interactions with ([0-9]+) particles and ([0-9]+) vertices', output)
+  merged  = re.findall(r'Merging MC input record from ([0-9]+) interactions: ([0-9]+) particles ([0-9]+) vertices', output)
+  ok = len(overlay) == events and len(merged) == events
+  if not ok:
+    print output
+  total = 0
+  for i in xrange(min(len(overlay),len(merged))):
+    interactions, particles, vertices = [int(n) for n in overlay[i]]
+    inputs, merged_particles, merged_vertices = [int(n) for n in merged[i]]
+    print '+++ Event %d: overlay %3d interactions %5d particles %3d vertices  merged: %3d interactions %5d particles %3d vertices'%\
+          (i, interactions, particles, vertices, inputs, merged_particles, merged_vertices)
+    # The signal adds one interaction with one vertex and one particle
+    if inputs != interactions+1 or merged_vertices != vertices+1 or merged_particles != particles+1:
+      ok = False
+    total = total + interactions
+  if ok and re.search(r'Overlaid %d interactions to %d events'%(total,events), output):
+    print 'TEST_PASSED: %d pile-up interactions overlaid to %d events'%(total,events)
+  else:
+    print 'TEST_FAILED: particle and vertex counts of the pile-up overlay differ'
+
+if __name__ == "__main__":
+  run()
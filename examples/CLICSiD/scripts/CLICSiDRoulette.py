@@ -0,0 +1,77 @@
+"""
+
+   Subtest using CLICSid checking the energy conservation of the Russian roulette.
+
+   Electrons are shot into the barrel calorimeters once without and once with the
+   Russian roulette on low energy secondaries. The surviving tracks carry the
+   weight of the killed tracks, hence the weighted energy deposit in the
+   calorimeters must be the same within the statistical fluctuations.
+
+   Usage:  python CLICSiDRoulette.py [off|on] [number of events]
+
+   Without arguments both configurations are run as separate processes
+   and the total energy deposits are compared.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+def simulate(mode, events):
+  import CLICSid, DDG4
+  from DDG4 import OutputLevel as Output
+  from SystemOfUnits import GeV
+
+  sid = CLICSid.CLICSid()
+  geant4 = sid.geant4
+  kernel = sid.kernel
+  sid.loadGeometry()
+  kernel.UI = ''
+  sid.setupField(quiet=True)
+  sid.setupRandom('R1',seed=987654321)
+
+  geant4.setupGun('Gun',particle='e-',energy=10*GeV,isotrop=False,direction=(1.0,0.0,0.0))
+  for det in ['EcalBarrel','HcalBarrel']:
+    seq,act = geant4.setupCalorimeter(det,type='Geant4CalorimeterAccumulateAction')
+    act.OutputLevel = Output.INFO
+
+  if mode == 'on':
+    roulette = DDG4.StackingAction(kernel,'Geant4RussianRoulette/Roulette')
+    roulette.Regions = ['DefaultRegionForTheWorld']
+    roulette.SurvivalProbability = 0.5
+    kernel.stackingAction().adopt(roulette)
+
+  sid.setupPhysics('QGSP_BERT')
+  sid.test_config()
+  kernel.NumEvents = events
+  kernel.run()
+  kernel.terminate()
+
+def deposit(mode, events):
+  import os, re, sys, subprocess
+  args = [sys.executable, os.path.abspath(__file__), mode, str(events)]
+  output = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT).communicate()[0]
+  energies = [float(e) for e in re.findall(r'Total energy deposit: *([0-9.eE+-]+) MeV', output)]
+  if len(energies) != 2:
+    print output
+    print 'Roulette test FAILED: no energy deposits found with roulette',mode
+    return 0.0
+  return sum(energies)
+
+def run():
+  import sys
+  if len(sys.argv) > 1:
+    events = int(sys.argv[2]) if len(sys.argv) > 2 else 20
+    simulate(sys.argv[1], events)
+    return
+  events    = 20
+  tolerance = 0.05
+  off = deposit('off', events)
+  on  = deposit('on',  events)
+  print '+++ Energy deposit without roulette: %.1f MeV  with roulette: %.1f MeV'%(off, on)
+  if off > 0.0 and abs(on-off) < tolerance*off:
+    print 'TEST_PASSED: weighted energy deposit conserved within %.0f %%'%(100*tolerance)
+  else:
+    print 'TEST_FAILED: weighted energy deposit differs by more than %.0f %%'%(100*tolerance)
+
+if __name__ == "__main__":
+  run()
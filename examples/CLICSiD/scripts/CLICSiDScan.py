@@ -2,6 +2,11 @@
 
    Perform a material scan using Geant4 shotting geantinos
 
+   Usage:  python CLICSiDScan.py [profile]
+
+   With the argument 'profile' the action sequences are profiled
+   and the profile is printed at the end of each run.
+
    @author  M.Frank
    @version 1.0
 
@@ -24,6 +29,10 @@ def run():
                         isotrop=False )
   scan = DDG4.SteppingAction(kernel,'Geant4MaterialScanner/MaterialScan')
   kernel.steppingAction().adopt(scan)
+  if 'profile' in sys.argv[1:]:
+    prof = DDG4.RunAction(kernel,'Geant4ProfilerAction/Profiler')
+    prof.MaxLines = 20
+    kernel.runAction().adopt(prof)
 
   # Now build the physics list:
   phys = geant4.setupPhysics('QGSP_BERT')
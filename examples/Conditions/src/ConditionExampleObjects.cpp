@@ -14,6 +14,8 @@
 // Framework include files
 #include "ConditionExampleObjects.h"
 #include "DD4hep/DD4hepUnits.h"
+#include "DD4hep/objects/ConditionsArena.h"
+#include "DDCond/ConditionsPool.h"
 
 using namespace std;
 using namespace DD4hep;
@@ -195,6 +197,7 @@ ConditionsCreator::~ConditionsCreator()  {
 
 /// Callback to process a single detector element
 int ConditionsCreator::operator()(DetElement de, int)    {
+  Conditions::ConditionsArena::Scope scope(pool ? pool->arena : 0);
   DetConditions dc(de);
   Condition temperature = make_condition<double>(de,"temperature",1.222);
   Condition pressure    = make_condition<double>(de,"pressure",888.88);
@@ -22,15 +22,23 @@
    Populate the conditions store by hand for a set of IOVs.
    Then compute the corresponding alignment entries....
 
+   With the option -publish the plugin runs a scaling benchmark:
+   One thread walks through the IOVs, prepares the slice and publishes an
+   immutable view of the conditions. Reader threads access the currently
+   published view concurrently without locking. The benchmark is repeated
+   for 1, 2, 4, ... reader threads up to the number given with -threads.
+
 */
 // Framework include files
 #include "ConditionExampleObjects.h"
 #include "DDCond/ConditionsManagerObject.h"
+#include "DDCond/ConditionsView.h"
 #include "DD4hep/Factories.h"
 #include "TStatistic.h"
 #include "TTimeStamp.h"
 #include "TRandom3.h"
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <unistd.h>
@@ -38,6 +46,8 @@
 using namespace std;
 using namespace DD4hep;
 using namespace DD4hep::ConditionExamples;
+using Conditions::ConditionsView;
+using Conditions::ConditionsPublisher;
 
 namespace {
   mutex printout_lock;
@@ -138,6 +148,78 @@ namespace {
       }
     }
   };
+
+  /// Reader of published conditions views for the scaling benchmark
+  class ViewReader {
+  public:
+    ConditionsPublisher& publisher;
+    DetElement           world;
+    atomic<bool>&        stop;
+    long                 accesses = 0;
+    long                 loops    = 0;
+    ViewReader(ConditionsPublisher& p, DetElement w, atomic<bool>& s)
+      : publisher(p), world(w), stop(s)
+    {
+    }
+    void run()  {
+      ConditionsPublisher::Reader reader(publisher);
+      while ( !stop )  {
+        ConditionsPublisher::Access view(reader);
+        if ( view.get() )  {
+          // The data access only uses the const interface of the pool
+          ConditionsDataAccess access(view->validity(), const_cast<ConditionsView*>(view.get()));
+          accesses += access.processElement(world);
+          ++loops;
+        }
+      }
+    }
+  };
+
+  /// Scaling benchmark: prepare and publish conditions views while readers access them
+  void publish_benchmark(ConditionsManager manager, ConditionsSlice& slice, const IOVType* iov_typ,
+                         int num_iov, int num_run, int num_threads)
+  {
+    DetElement world = manager->lcdd().world();
+    double     rate1 = 0e0;
+    for(int n=1; ; n = (2*n > num_threads && n < num_threads) ? num_threads : 2*n)  {
+      ConditionsPublisher publisher(manager);
+      vector<ViewReader*> readers;
+      vector<thread*>     threads;
+      atomic<bool>        stop(false);
+      long                accesses = 0, loops = 0;
+      for(int i=0; i<n; ++i)  {
+        ViewReader* r = new ViewReader(publisher, world, stop);
+        readers.push_back(r);
+        threads.push_back(new thread([r]{ r->run(); }));
+      }
+      TTimeStamp start;
+      for(int r=0; r<num_run; ++r)  {
+        for(int i=0; i<num_iov; ++i)  {
+          IOV iov(iov_typ, i*10+5);
+          manager.prepare(iov, slice);
+          publisher.publish(*slice.pool);
+        }
+      }
+      stop = true;
+      for(size_t i=0; i<threads.size(); ++i)  {
+        threads[i]->join();
+        accesses += readers[i]->accesses;
+        loops    += readers[i]->loops;
+        delete threads[i];
+        delete readers[i];
+      }
+      TTimeStamp stop_time;
+      double elapsed = stop_time.AsDouble()-start.AsDouble();
+      double rate = elapsed > 0e0 ? double(accesses)/elapsed : 0e0;
+      if ( n == 1 ) rate1 = rate;
+      ConditionsPublisher::Statistics s = publisher.statistics();
+      printout(INFO,"Statistics","+  Readers:%3d  %10ld views read %12ld accesses %12.4g accesses/sec "
+               "Speedup:%6.2f  [%ld published, %ld reclaimed, %8.3f sec]",
+               n, loops, accesses, rate, rate1 > 0e0 ? rate/rate1 : 0e0,
+               long(s.published), long(s.reclaimed), elapsed);
+      if ( n >= num_threads ) break;
+    }
+  }
 }
 
 /// Plugin function: Condition program example
@@ -151,7 +233,7 @@ namespace {
 static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
   string input;
   int    num_iov = 10, num_threads = 1, num_run = 30;
-  bool   arg_error = false;
+  bool   arg_error = false, publish = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -161,6 +243,8 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
       num_run = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-threads",argv[i],4) )
       num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-publish",argv[i],4) )
+      publish = true;
     else
       arg_error = true;
   }
@@ -173,6 +257,7 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
       "     -threads <number>        Number of execution threads.                    \n"
+      "     -publish                 Scaling benchmark of published conditions views.\n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -220,6 +305,13 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
     }
   }
 
+  if ( publish )  {
+    printout(INFO,"Statistics",
+             "+======= Publish: # of IOV: %3d  # of runs: %3d  up to %3d reader threads ======",
+             num_iov, num_run, num_threads);
+    publish_benchmark(condMgr, *slice, iov_typ, num_iov, num_run, num_threads);
+    return 1;
+  }
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
   vector<thread*> threads;
   for(int i=0; i<num_threads; ++i)  {
@@ -0,0 +1,185 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_multisource \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -sources 4 -threads 4
+
+   Write a set of XML conditions sources for the Telescope modules and load
+   them through the multi-source conditions loader: once sequentially and
+   once with several threads reading the sources concurrently.
+   Every source carries its own conditions and one condition common to all
+   sources. Both passes must load the same number of conditions and the
+   common condition must always be taken from the first source.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsDataLoader.h"
+#include "DD4hep/Factories.h"
+
+// C/C++ include files
+#include <fstream>
+#include <cstdio>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::ConditionExamples;
+
+namespace {
+
+  /// Name of the common condition of all modules, which is present in every source
+  const char* COMMON = "pressure";
+
+  /// Write the XML conditions source number 'id' for all modules
+  string write_source(const vector<DetElement>& modules, int id)   {
+    char text[64];
+    ::snprintf(text,sizeof(text),"Telescope_conditions_source_%d.xml",id);
+    ofstream out(text);
+    out << "<conditions>" << endl;
+    for(DetElement de : modules)  {
+      out << "  <detelement path=\"" << de.path().substr(string("/world/").length()) << "\">" << endl
+          << "    <temperature name=\"temperature_" << id << "\" value=\"" << 20+id << "\"/>" << endl
+          << "    <pressure    name=\"" << COMMON << "\" value=\"" << id << "\"/>" << endl
+          << "  </detelement>" << endl;
+    }
+    out << "</conditions>" << endl;
+    if ( !out.good() )  {
+      except("ConditionsMultiSource","++ Failed to write conditions source %s.",text);
+    }
+    return text;
+  }
+
+  /// Load all conditions of the modules from the sources with the given number of threads
+  size_t load(ConditionsManager manager, const IOVType* iov_typ, const vector<DetElement>& modules,
+              const vector<string>& sources, int num_threads)
+  {
+    char text[32];
+    size_t num_common = 0;
+    ::snprintf(text,sizeof(text),"%d",num_threads);
+    manager.clear();
+    manager.loader()->property("Threads") = text;
+    dd4hep_ptr<ConditionsSlice> slice(Conditions::createSlice(manager,*iov_typ));
+    for(DetElement de : modules)  {
+      for(size_t i=0; i<sources.size(); ++i)  {
+        ::snprintf(text,sizeof(text),"#temperature_%ld",long(i));
+        // The load-info names the source: the condition is only requested from this source
+        slice->insert(ConditionKey(de.path()+text),ConditionsSlice::loadInfo(sources[i]));
+      }
+      // No source hint: the common condition is requested from all sources
+      slice->insert(ConditionKey(de.path()+"#"+COMMON),ConditionsSlice::loadInfo(string()));
+    }
+    IOV iov(iov_typ, 100);
+    ConditionsManager::Result r = manager.prepare(iov,*slice);
+    for(DetElement de : modules)  {
+      Condition c = slice->pool->get(ConditionKey(de.path()+"#"+COMMON));
+      if ( c.isValid() && c->value == "0" ) ++num_common;
+    }
+    printout(INFO,"ConditionsMultiSource",
+             "+++ Threads:%2d Sources:%2ld Requested %ld conditions: loaded:%ld missing:%ld "
+             "common conditions from the first source:%ld",
+             num_threads, long(sources.size()), long(slice->conditions().size()),
+             long(r.loaded), long(r.missing), long(num_common));
+    if ( r.missing != 0 || num_common != modules.size() )  {
+      except("ConditionsMultiSource","++ Inconsistent conditions loaded with %d threads.",num_threads);
+    }
+    slice->pool->clear();
+    return r.loaded;
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_multisource
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
+
+  string input;
+  int    num_sources = 4;
+  int    num_threads = 4;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-sources",argv[i],4) )
+      num_sources = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_sources < 1 || num_threads < 1 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_multisource             \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -sources <number>        Number of XML conditions sources (default: 4)   \n"
+      "     -threads <number>        Number of loader threads (default: 4)           \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  lcdd.fromXML(input);
+  installManagers(lcdd);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager condMgr = ConditionsManager::from(lcdd);
+  condMgr["LoaderType"]     = "multi";
+  condMgr["PoolType"]       = "DD4hep_ConditionsLinearPool";
+  condMgr["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
+  condMgr["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  condMgr.initialize();
+
+  const IOVType*  iov_typ  = condMgr.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )  {
+    except("ConditionsMultiSource","++ Unknown IOV type supplied.");
+  }
+
+  /******************** Write and register the data sources ***************/
+  vector<DetElement> modules;
+  vector<string>     sources;
+  for(const auto& c : lcdd.detector("Telescope").children())
+    modules.push_back(c.second);
+  for(int i=0; i<num_sources; ++i)  {
+    // Nested IOVs: every source fills its own IOV pool containing the requested run
+    IOV iov(iov_typ, IOV::Key(0,1000-i));
+    string source = "xml:"+write_source(modules, i);
+    condMgr.loader()->addSource(source, iov);
+    sources.push_back(source);
+  }
+
+  /******************** Load sequentially and concurrently ****************/
+  size_t expected = modules.size()*(sources.size()+1);
+  size_t serial   = load(condMgr, iov_typ, modules, sources, 1);
+  size_t parallel = load(condMgr, iov_typ, modules, sources, num_threads);
+  for(const auto& s : sources)
+    ::remove(s.substr(4).c_str());
+  printout(INFO,"ConditionsMultiSource","+++ Expected %ld conditions. Loaded with 1 thread:%ld with %d threads:%ld  Test %s",
+           long(expected), long(serial), num_threads, long(parallel),
+           serial == expected && parallel == expected ? "PASSED" : "FAILED");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_multisource,condition_example)
@@ -0,0 +1,160 @@
+//==========================================================================
+//  AIDA Detector description implementation for LCD
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_snapshot \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml      \
+   -output Telescope_conditions.snapshot
+
+   Populate the conditions store by hand and prepare a user pool.
+   Save the prepared user pool to a binary snapshot, clear the
+   conditions store, reload the snapshot and prepare the user pool
+   again. All conditions must be restored with identical values.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsSnapshot.h"
+#include "DD4hep/objects/ConditionsInterna.h"
+#include "DD4hep/Factories.h"
+
+// C/C++ include files
+#include <chrono>
+
+using namespace std;
+using namespace DD4hep;
+using namespace DD4hep::ConditionExamples;
+
+namespace {
+  /// Collect the string representation of all conditions of a user pool
+  struct ValueCollector : public Conditions::ConditionsSelect  {
+    map<Condition::key_type,string>& values;
+    ValueCollector(map<Condition::key_type,string>& v) : values(v) {}
+    virtual bool operator()(Condition::Object* o) const  {
+      values[o->hash] = o->is_bound() ? o->data.str() : string("<unbound>");
+      return true;
+    }
+  };
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_snapshot
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
+  typedef chrono::duration<double,milli> millisec;
+  map<Condition::key_type,string> original, restored;
+  string input, output = "ConditionsSnapshot.dat";
+  int    num_iov = 10;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-output",argv[i],4) )
+      output = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || output.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_snapshot                \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -output  <string>        Snapshot file                                   \n"
+      "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  lcdd.fromXML(input);
+  installManagers(lcdd);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager condMgr = ConditionsManager::from(lcdd);
+  condMgr["PoolType"]       = "DD4hep_ConditionsLinearPool";
+  condMgr["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
+  condMgr["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  condMgr.initialize();
+
+  const IOVType*  iov_typ  = condMgr.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )  {
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+  }
+
+  /******************** Now as usual: create the slice ********************/
+  dd4hep_ptr<ConditionsSlice> slice(Conditions::createSlice(condMgr,*iov_typ));
+  ConditionsKeys(DEBUG).process(lcdd.world(),0,true);
+  ConditionsDependencyCreator(*slice,DEBUG).process(lcdd.world(),0,true);
+
+  /******************** Populate the conditions store *********************/
+  for(int i=0; i<num_iov; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool*   iov_pool = condMgr.registerIOV(*iov.iovType, iov.key());
+    ConditionsCreator creator(condMgr, iov_pool, DEBUG);  // Use a generic creator
+    creator.process(lcdd.world(),0,true);                 // Create conditions with all deltas
+  }
+
+  /******************** Prepare the user pool and take the snapshot ******/
+  IOV  req_iov(iov_typ,5);
+  auto start = chrono::steady_clock::now();
+  ConditionsManager::Result r = condMgr.prepare(req_iov,*slice);
+  auto stop  = chrono::steady_clock::now();
+  printout(INFO,"Snapshot","Prepared %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) of IOV %s in %.3f ms",
+           r.total(), r.selected, r.loaded, r.computed, r.missing, req_iov.str().c_str(),
+           millisec(stop-start).count());
+  slice->pool->select_all(ValueCollector(original));
+  Conditions::ConditionsSnapshot::Result saved = Conditions::ConditionsSnapshot().save(*slice->pool, output);
+
+  /******************** Clear the store and reload the snapshot **********/
+  condMgr.clear();
+  IOV  snap_iov(iov_typ);
+  start = chrono::steady_clock::now();
+  Conditions::ConditionsSnapshot::Result loaded = Conditions::ConditionsSnapshot().load(output, condMgr, &snap_iov);
+  r     = condMgr.prepare(req_iov,*slice);
+  stop  = chrono::steady_clock::now();
+  printout(INFO,"Snapshot","Reloaded %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) of IOV %s in %.3f ms",
+           r.total(), r.selected, r.loaded, r.computed, r.missing, snap_iov.str().c_str(),
+           millisec(stop-start).count());
+  slice->pool->select_all(ValueCollector(restored));
+
+  /******************** Compare the original and the restored values ****/
+  size_t num_diff = 0;
+  for(const auto& o : original)  {
+    auto i = restored.find(o.first);
+    if ( i == restored.end() || (*i).second != o.second )  {
+      printout(ERROR,"Snapshot","Condition %016llX differs after reload: '%s' <> '%s'",
+               o.first, o.second.c_str(), i == restored.end() ? "<missing>" : (*i).second.c_str());
+      ++num_diff;
+    }
+  }
+  printout(num_diff == 0 ? INFO : ERROR,"Snapshot",
+           "Snapshot of %ld conditions [%ld bytes] restored %ld conditions with %ld differences.",
+           long(saved.conditions), long(saved.bytes), long(loaded.conditions), long(num_diff));
+  // All done.
+  return num_diff == 0 ? 1 : 0;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_snapshot,condition_example)
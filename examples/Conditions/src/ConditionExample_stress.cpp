@@ -25,6 +25,7 @@
 */
 // Framework include files
 #include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsIOVPool.h"
 #include "DD4hep/Factories.h"
 #include "TStatistic.h"
 #include "TTimeStamp.h"
@@ -44,8 +45,8 @@ using namespace DD4hep::ConditionExamples;
  */
 static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
   string input;
-  int    num_iov = 10, num_runs = 10;
-  bool   arg_error = false;
+  int    num_iov = 10, num_runs = 10, budget = 0;
+  bool   arg_error = false, prefetch = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -53,6 +54,10 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
       num_iov = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-runs",argv[i],4) )
       num_runs = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-prefetch",argv[i],4) )
+      prefetch = true;
+    else if ( 0 == ::strncmp("-budget",argv[i],4) )
+      budget = ::atol(argv[++i]);
     else
       arg_error = true;
   }
@@ -64,6 +69,9 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
       "     -input   <string>        Geometry file                                   \n"
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
+      "     -prefetch                Prepare the next IOV in the background.         \n"
+      "     -budget  <number>        Memory budget in units of the average IOV pool. \n"
+      "                              Evicted IOVs are populated again when required. \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -90,9 +98,7 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
   ConditionsDependencyCreator(*slice,DEBUG).process(lcdd.world(),0,true);
 
   TStatistic cr_stat("Creation"), acc_stat("Access");
-  /******************** Populate the conditions store *********************/
-  // Have 10 run-slices [11,20] .... [91,100]
-  for(int i=0; i<num_iov; ++i)  {
+  auto populate = [&](int i)  {
     TTimeStamp start;
     IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
     ConditionsPool*   iov_pool = condMgr.registerIOV(*iov.iovType, iov.key());
@@ -103,14 +109,61 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
     printout(INFO,"Example", "Setup %ld conditions for IOV:%s [%8.3f sec]",
              creator.conditionCount, iov.str().c_str(),
              stop.AsDouble()-start.AsDouble());
+  };
+  /******************** Populate the conditions store *********************/
+  // Have 10 run-slices [11,20] .... [91,100]
+  for(int i=0; i<num_iov; ++i)
+    populate(i);
+
+  /******************** Limit the memory of the conditions store **********/
+  ConditionsIOVPool* iov_pools = condMgr.iovPool(*iov_typ);
+  size_t budget_bytes = 0;
+  if ( budget > 0 )  {
+    char text[32];
+    ConditionsIOVPool::Statistics s = iov_pools->statistics();
+    budget_bytes = budget*(s.bytes/s.pools);
+    ::snprintf(text,sizeof(text),"%ld",long(budget_bytes));
+    condMgr["MemoryBudget"] = text;
+    printout(INFO,"Example","Memory budget of %d IOV pools: %ld bytes.",budget,long(budget_bytes));
   }
 
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
   TRandom3 random;
-  for(int i=0; i<num_runs; ++i)  {
+  if ( prefetch )  {
+    // The sequence of IOVs is known in advance: prepare the next one in a second
+    // slice while the conditions of the current one are accessed.
+    dd4hep_ptr<ConditionsSlice> second(new ConditionsSlice(*slice));
+    ConditionsSlice* current = slice.get(), *next = second.get();
+    IOV req_iov(iov_typ,1+random.Integer(num_iov*10));
+    condMgr.prepare(req_iov,*current);
+    for(int i=0; i<num_runs; ++i)  {
+      IOV next_iov(iov_typ,1+random.Integer(num_iov*10));
+      ConditionsManager::AsyncResult pending = condMgr.prepareAsync(next_iov,*next);
+      TTimeStamp start;
+      ConditionsDataAccess access(req_iov, current->pool.get());
+      int count = access.processElement(lcdd.world());
+      ConditionsManager::Result res = pending.get();
+      TTimeStamp stop;
+      acc_stat.Fill(stop.AsDouble()-start.AsDouble());
+      printout(INFO,"Prefetch","Accessed %d conditions of %s. Next: %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld) of %s [%8.3f sec]",
+               count, req_iov.str().c_str(), res.total(), res.selected, res.loaded, res.computed, res.missing,
+               next_iov.str().c_str(), stop.AsDouble()-start.AsDouble());
+      // Swap in the prefetched slice at the IOV boundary
+      std::swap(current, next);
+      req_iov = next_iov;
+    }
+    ConditionsManager::AsyncStatistics s = condMgr.asyncStatistics();
+    printout(INFO,"Statistics","+  Prefetch: %ld requests  %ld stalls  Work: %8.3f sec  Stalled: %8.3f sec  Saved: %8.3f sec",
+             long(s.requests), long(s.stalls), s.workTime, s.stallTime, s.savedTime);
+  }
+  for(int i=0; !prefetch && i<num_runs; ++i)  {
     TTimeStamp start;
     unsigned int rndm = 1+random.Integer(num_iov*10);
     IOV req_iov(iov_typ,rndm);
+    // Pools evicted to respect the memory budget are populated again
+    int slot = (rndm-1)/10;
+    if ( budget > 0 && iov_pools->elements.find(IOV::Key(1+slot*10,(slot+1)*10)) == iov_pools->elements.end() )
+      populate(slot);
     // Attach the proper set of conditions to the user pool
     ConditionsManager::Result res = condMgr.prepare(req_iov,*slice);
     TTimeStamp stop;
@@ -126,6 +179,14 @@ static int condition_example (Geometry::LCDD& lcdd, int argc, char** argv)  {
   printout(INFO,"Statistics","+  %-12s:  %11.5g +- %11.4g  RMS = %11.5g  N = %lld",
            acc_stat.GetName(), acc_stat.GetMean(), acc_stat.GetMeanErr(), acc_stat.GetRMS(), acc_stat.GetN());
   printout(INFO,"Statistics","+=========================================================================");
+  if ( budget > 0 )  {
+    ConditionsIOVPool::Statistics s = iov_pools->statistics();
+    bool ok = s.evictions > 0 && s.reloads > 0 && s.reloads <= s.evictions && s.bytes <= budget_bytes;
+    printout(ok ? INFO : ERROR,"Statistics","+  Memory budget: %ld of %ld bytes in %ld pools. "
+             "Evicted: %ld pools Reloads: %ld  Test %s",
+             long(s.bytes), long(budget_bytes), long(s.pools), long(s.evictions), long(s.reloads),
+             ok ? "PASSED" : "FAILED");
+  }
   // All done.
   return 1;
 }
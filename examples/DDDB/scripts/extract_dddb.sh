@@ -25,6 +25,7 @@ else
 fi;
 source=${DD4hepINSTALL}/examples/DDDB/DDDB.tar.gz;
 clean="NO";
+archive="NO";
 #
 # Check for arguments:
 while [[ "$1" == -* ]]; do
@@ -46,6 +47,9 @@ while [[ "$1" == -* ]]; do
         -clean)
             clean="YES";
             ;;
+        -archive)
+            archive="YES";
+            ;;
         -input)
 	    source=$2;
 	    shift
@@ -54,6 +58,8 @@ while [[ "$1" == -* ]]; do
             echo "Usage: $0 -arg [-arg]";
             echo "  -target <directory>  Installation target directory. Default: $target";
             echo "  -input  <tar-file>   Input data file. Default: $source";
+            echo "  -archive             Only decompress the archive to <target>/DDDB.tar";
+            echo "                       to be used with the DDDB_ArchiveReader.";
             exit 13;    # EACCES
 	    ;;
     esac
@@ -69,6 +75,24 @@ if test ! -f ${source}; then
     source=${dir}/data/${base};
 fi;
 #
+# Decompressed archive for direct access by the DDDB_ArchiveReader
+#
+if test "${archive}" = "YES"; then
+    if test "${clean}" = "YES";then
+        rm -f ${target}/DDDB.tar;
+        echo "DDDB Archive successfully removed ${target}";
+        exit 0;
+    fi;
+    mkdir -p ${target};
+    if gunzip -c ${source} > ${target}/DDDB.tar; then
+        echo "DDDB Archive successfully installed.";
+        exit 0;
+    fi;
+    rm -f ${target}/DDDB.tar;
+    echo "DDDB Archive installation FAILED";
+    exit 2;  # ENOENT
+fi;
+#
 # Now do the installation
 #
 if test -d ${target}/DDDB; then
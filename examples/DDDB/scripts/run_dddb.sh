@@ -92,6 +92,13 @@ while [[ "$1" == -* ]]; do
             last_cmd="";
             shift;
             ;;
+	-tar)
+            loader="-tar $2";
+            input="-input DDDB/DDDB/lhcb.xml";
+            params="-params conddb:/../Parameters.xml";
+            last_cmd="";
+            shift;
+            ;;
 	-config)
             config="${config} -config $2";
             last_cmd="config";